@@ -0,0 +1,282 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests the deferred work task (deferred_work.h).
+ *
+ * vDeferredWorkPeriodicISRTest(), called from the tick hook, posts a one-off
+ * call carrying a sequence number on every tick, and posts the same work item
+ * dwISR_POSTS_PER_TICK times.  The one-off calls must run in the deferred work
+ * task in sequence, with none lost, and the work item must run no more than
+ * once for each tick that posted it, as the posts made by one interrupt are
+ * always coalesced.
+ *
+ * A task does the same from task level with the ring full: it posts a work
+ * item twice, then one-off calls until the ring has no space, all with the
+ * scheduler suspended so the deferred work task cannot run in between.  The
+ * second post of the work item must be coalesced, a post must fail, and every
+ * call that was accepted must have run in sequence, and the work item once, by
+ * the time the task next runs.  The tick hook only moves its own sequence
+ * number on when a post is accepted, so its posts can fail while the ring is
+ * full without breaking the sequence check.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred_work.h"
+
+/* Demo program include files. */
+#include "DeferredWork.h"
+
+#if( configUSE_DEFERRED_WORK != 1 )
+	#error configUSE_DEFERRED_WORK must be set to 1 in FreeRTOSConfig.h to use DeferredWork.c
+#endif
+
+/* The number of times the tick hook posts its work item on each tick. */
+#define dwISR_POSTS_PER_TICK	( 4 )
+
+/* The task posts a ring full of requests on each cycle. */
+#define dwTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define dwTASK_DELAY			pdMS_TO_TICKS( 20 )
+#define dwSTACK_SIZE			( configMINIMAL_STACK_SIZE )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task described at the top of this file.
+ */
+static void prvDeferredWorkTestTask( void *pvParameters );
+
+/*
+ * The one-off calls posted by the tick hook and the task.  ulParameter2 is the
+ * sequence number, and pvParameter1 points to the number expected next.
+ */
+static void prvOneOffCall( void *pvParameter1, uint32_t ulParameter2 );
+
+/*
+ * The work items posted by the tick hook and the task.  pvParameter1 points to
+ * the count of times the item has run.
+ */
+static void prvWorkItem( void *pvParameter1, uint32_t ulParameter2 );
+
+/*-----------------------------------------------------------*/
+
+/* The work items, and the number of times each has run. */
+static DeferredWork_t xISRWorkItem, xTaskWorkItem;
+static volatile uint32_t ulISRWorkItemRuns = 0UL, ulTaskWorkItemRuns = 0UL;
+
+/* The number of ticks on which the tick hook posted its work item. */
+static volatile uint32_t ulISRWorkItemTicks = 0UL;
+
+/* The sequence numbers of the one-off calls posted, and of the next call
+expected to run, by the tick hook and the task. */
+static uint32_t ulISRCallsPosted = 0UL, ulTaskCallsPosted = 0UL;
+static volatile uint32_t ulISRCallsRun = 0UL, ulTaskCallsRun = 0UL;
+
+/* Incremented on each cycle of the task, to detect a stalled test. */
+static volatile uint32_t ulTaskCycles = 0UL;
+
+/* Flag that will be latched to pdTRUE should any unexpected behaviour be
+detected in any of the tasks or the tick hook. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartDeferredWorkTasks( void )
+{
+	vDeferredWorkInit( &xISRWorkItem, prvWorkItem, ( void * ) &ulISRWorkItemRuns, 0UL );
+	vDeferredWorkInit( &xTaskWorkItem, prvWorkItem, ( void * ) &ulTaskWorkItemRuns, 0UL );
+
+	xTaskCreate( prvDeferredWorkTestTask, "DWTest", dwSTACK_SIZE, NULL, dwTASK_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvOneOffCall( void *pvParameter1, uint32_t ulParameter2 )
+{
+volatile uint32_t *pulExpected = ( volatile uint32_t * ) pvParameter1;
+
+	if( xTaskGetCurrentTaskHandle() != xDeferredWorkGetTaskHandle() )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	/* Calls must be run in the order they were posted, and none lost. */
+	if( ulParameter2 != *pulExpected )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	*pulExpected = ulParameter2 + 1UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkItem( void *pvParameter1, uint32_t ulParameter2 )
+{
+volatile uint32_t *pulRuns = ( volatile uint32_t * ) pvParameter1;
+
+	( void ) ulParameter2;
+
+	if( xTaskGetCurrentTaskHandle() != xDeferredWorkGetTaskHandle() )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	( *pulRuns )++;
+
+	/* Every post made by one tick is coalesced, so the tick hook's item cannot
+	run more often than the ticks that posted it. */
+	if( ulISRWorkItemRuns > ulISRWorkItemTicks )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredWorkTestTask( void *pvParameters )
+{
+DeferredWorkStats_t xStatsBefore, xStatsAfter;
+uint32_t ulWorkItemRunsBefore;
+BaseType_t xPosted;
+UBaseType_t ux;
+
+	/* Remove compiler warning about unused parameter. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vDeferredWorkGetStats( &xStatsBefore );
+		ulWorkItemRunsBefore = ulTaskWorkItemRuns;
+
+		/* The deferred work task cannot run until the scheduler is resumed, so
+		the second post of the work item must be coalesced and the ring must
+		fill. */
+		vTaskSuspendAll();
+		{
+			if( xDeferredWorkPost( &xTaskWorkItem ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( xDeferredWorkPost( &xTaskWorkItem ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			for( ux = 0; ux <= ( UBaseType_t ) configDEFERRED_WORK_QUEUE_LENGTH; ux++ )
+			{
+				xPosted = xDeferredFunctionCall( prvOneOffCall, ( void * ) &ulTaskCallsRun, ulTaskCallsPosted );
+
+				if( xPosted == pdPASS )
+				{
+					ulTaskCallsPosted++;
+				}
+				else
+				{
+					break;
+				}
+			}
+
+			/* More calls were posted than the ring holds, so the last post
+			must have failed. */
+			if( xPosted == pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		vDeferredWorkGetStats( &xStatsAfter );
+
+		if( ( xStatsAfter.ulCoalesced == xStatsBefore.ulCoalesced ) ||
+			( xStatsAfter.ulDropped == xStatsBefore.ulDropped ) ||
+			( xStatsAfter.uxMostUsed != ( UBaseType_t ) configDEFERRED_WORK_QUEUE_LENGTH ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		vTaskDelay( dwTASK_DELAY );
+
+		/* The deferred work task has a higher priority, so has run everything
+		posted above. */
+		if( ( ulTaskCallsRun != ulTaskCallsPosted ) || ( ulTaskWorkItemRuns != ( ulWorkItemRunsBefore + 1UL ) ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulTaskCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredWorkPeriodicISRTest( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+BaseType_t x;
+
+	if( xDeferredFunctionCallFromISR( prvOneOffCall, ( void * ) &ulISRCallsRun, ulISRCallsPosted, &xHigherPriorityTaskWoken ) == pdPASS )
+	{
+		ulISRCallsPosted++;
+	}
+
+	ulISRWorkItemTicks++;
+
+	for( x = 0; x < dwISR_POSTS_PER_TICK; x++ )
+	{
+		/* Can fail while the task has filled the ring. */
+		( void ) xDeferredWorkPostFromISR( &xISRWorkItem, &xHigherPriorityTaskWoken );
+	}
+
+	/* The tick hook is called from the tick interrupt, which performs its own
+	context switch if one is needed. */
+	( void ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreDeferredWorkTasksStillRunning( void )
+{
+static uint32_t ulLastTaskCycles = 0UL, ulLastISRCallsRun = 0UL, ulLastISRWorkItemRuns = 0UL;
+
+	/* If the tests are still running then the task should have cycled, and
+	calls and the work item posted by the tick hook should have run, since this
+	function was last called. */
+	if( ( ulLastTaskCycles == ulTaskCycles ) ||
+		( ulLastISRCallsRun == ulISRCallsRun ) ||
+		( ulLastISRWorkItemRuns == ulISRWorkItemRuns ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	ulLastTaskCycles = ulTaskCycles;
+	ulLastISRCallsRun = ulISRCallsRun;
+	ulLastISRWorkItemRuns = ulISRWorkItemRuns;
+
+	/* Errors detected in the tasks or the tick hook will have latched
+	xErrorDetected to true. */
+
+	return ( BaseType_t ) !xErrorDetected;
+}
@@ -0,0 +1,543 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests the order in which tasks leave the delayed task lists, and, when
+ * configUSE_INDEXED_DELAY_LISTS is 1, the red-black tree that indexes them.
+ *
+ * A controller task releases dloNUM_WAKERS waker tasks at a time.  Each waker
+ * calls vTaskDelayUntil() with the same start time and its own wake time.  The
+ * wake times are a different permutation on every cycle, so each waker is added
+ * to the middle of the delayed list, and pairs of wakers share a wake time.
+ * Once the wakers have blocked the controller suspends and resumes one of
+ * them, which removes it from the middle of the delayed list.  When all the
+ * wakers have run the controller checks that none ran before its wake time
+ * (other than the one it suspended), and that none ran on an earlier tick than
+ * a waker with an earlier wake time.
+ *
+ * When the tick count is about to overflow the controller waits until half of
+ * the wake times of the next cycle fall after the overflow, so the wakers are
+ * split between the two delayed lists and the lists swap while they are
+ * blocked.  An error is latched if the tick count is found to have overflowed
+ * without a cycle spanning the overflow.  Setting configINITIAL_TICK_COUNT to
+ * just below the overflow brings this forward to the start of a test run.
+ *
+ * The tree task inserts items into and removes them from a list initialised
+ * with vListInitialiseIndexed(), using a small range of item values so most
+ * items share their value with others.  After every insertion and removal it
+ * checks that the linked list is sorted, that items with equal values are in
+ * the order they were inserted, that an in-order walk of the tree visits the
+ * items in the same order as the linked list, that the parent links agree with
+ * the child links, and that the tree is a valid red-black tree.  From time to
+ * time it also empties the list from the head, as the tick does with the
+ * delayed lists.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "DelayOrder.h"
+
+#if( INCLUDE_vTaskSuspend != 1 )
+	#error INCLUDE_vTaskSuspend must be set to 1 in FreeRTOSConfig.h to use DelayOrder.c
+#endif
+
+/* The number of waker tasks.  dloSTRIDE must not share a factor with it, so
+each cycle's wake times are a permutation of the same offsets. */
+#define dloNUM_WAKERS			( 12 )
+#define dloSTRIDE				( 5 )
+
+/* Wake times are dloMIN_DELAY ticks or more after the start of a cycle, which
+leaves time for the wakers to block first.  Each offset is shared by two
+wakers. */
+#define dloMIN_DELAY			( ( TickType_t ) 10 )
+#define dloSPACING				( ( TickType_t ) 3 )
+#define dloMAX_DELAY			( dloMIN_DELAY + ( ( ( dloNUM_WAKERS - 1 ) / 2 ) * dloSPACING ) )
+
+/* The controller suspends a waker dloRELEASE_TICKS after releasing the wakers,
+and reports an error if they have not all run within dloMAX_WAIT. */
+#define dloRELEASE_TICKS		( ( TickType_t ) 2 )
+#define dloMAX_WAIT				pdMS_TO_TICKS( 2000UL )
+
+/* A cycle that would start less than dloWRAP_LEAD ticks before the tick count
+overflows instead waits until the overflow falls in the middle of its wake
+times. */
+#define dloWRAP_LEAD			pdMS_TO_TICKS( 500UL )
+
+/* The number of items used by the tree task, the insertions and removals it
+makes between delays, and how often it empties the list. */
+#define dloTREE_ITEMS			( 48 )
+#define dloTREE_OPERATIONS		( 64 )
+#define dloTREE_EMPTY_CYCLES	( 16UL )
+
+/* The task priorities.  The controller is above the wakers so it can suspend a
+waker as soon as they have blocked. */
+#define dloTREE_PRIORITY		( tskIDLE_PRIORITY )
+#define dloWAKER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define dloCONTROL_PRIORITY		( tskIDLE_PRIORITY + 3 )
+
+/* The stack size of the tasks created by this file. */
+#define dloSTACK_SIZE			( configMINIMAL_STACK_SIZE )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks described at the top of this file.
+ */
+static void prvControllerTask( void *pvParameters );
+static void prvWakerTask( void *pvParameters );
+
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	static void prvTreeTask( void *pvParameters );
+
+	/*
+	 * Check the linked list and the tree of xTreeList as described at the top
+	 * of this file.
+	 */
+	static void prvCheckTreeList( void );
+
+	/*
+	 * Check the subtree rooted at pxNode, which an in-order walk must visit
+	 * starting with *ppxNextInList, and return its black height.
+	 */
+	static BaseType_t prvCheckSubtree( const ListItem_t *pxNode, const ListItem_t **ppxNextInList );
+
+	/*
+	 * A simple pseudo random number generator, so the test does not depend on
+	 * the C library.
+	 */
+	static uint32_t prvRand( void );
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+
+/*-----------------------------------------------------------*/
+
+/* The controller and waker tasks. */
+static TaskHandle_t xController = NULL;
+static TaskHandle_t xWakers[ dloNUM_WAKERS ] = { NULL };
+
+/* The start of the current cycle, the offset of each waker's wake time from
+it, and the offset of the tick count each waker ran at. */
+static TickType_t xCycleStart = 0;
+static TickType_t xWakeOffsets[ dloNUM_WAKERS ] = { 0 };
+static TickType_t xRunOffsets[ dloNUM_WAKERS ] = { 0 };
+
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	/* The list used by the tree task, its items, and the order the items were
+	last inserted in. */
+	static List_t xTreeList;
+	static ListItem_t xTreeItems[ dloTREE_ITEMS ];
+	static uint32_t ulInsertOrder[ dloTREE_ITEMS ] = { 0 };
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+
+/* Flag that will be latched to pdTRUE should any unexpected behaviour be
+detected in any of the tasks. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/* Incremented on each cycle of each test, to detect a stalled test. */
+static volatile uint32_t ulControllerCycles = 0UL;
+
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	static volatile uint32_t ulTreeCycles = 0UL;
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vStartDelayOrderTasks( void )
+{
+UBaseType_t x;
+
+	for( x = 0; x < dloNUM_WAKERS; x++ )
+	{
+		xTaskCreate( prvWakerTask, "DLWake", dloSTACK_SIZE, ( void * ) x, dloWAKER_PRIORITY, &( xWakers[ x ] ) );
+	}
+
+	xTaskCreate( prvControllerTask, "DLCtrl", dloSTACK_SIZE, NULL, dloCONTROL_PRIORITY, &xController );
+
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+		vListInitialiseIndexed( &xTreeList );
+
+		for( x = 0; x < dloTREE_ITEMS; x++ )
+		{
+			vListInitialiseItem( &( xTreeItems[ x ] ) );
+		}
+
+		xTaskCreate( prvTreeTask, "DLTree", dloSTACK_SIZE, NULL, dloTREE_PRIORITY, NULL );
+	}
+	#endif /* configUSE_INDEXED_DELAY_LISTS */
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+TickType_t xToOverflow, xLastStart = 0;
+BaseType_t xSpansOverflow = pdFALSE;
+UBaseType_t x, y, uxSuspended, uxReported;
+uint32_t ulReceived;
+
+	/* Remove compiler warning about unused parameter. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xCycleStart = xTaskGetTickCount();
+
+		/* If the tick count will overflow soon, but after the last wake time
+		of a cycle started now, wait until it is half way through the wake
+		times. */
+		xToOverflow = ( TickType_t ) 0 - xCycleStart;
+
+		if( ( xToOverflow > dloMAX_DELAY ) && ( xToOverflow <= dloWRAP_LEAD ) )
+		{
+			vTaskDelay( xToOverflow - ( dloMAX_DELAY / 2 ) );
+			xCycleStart = xTaskGetTickCount();
+		}
+
+		/* The tick count can only have gone backwards since the start of the
+		last cycle if the last cycle spanned the overflow. */
+		if( ( ulControllerCycles != 0UL ) && ( xCycleStart < xLastStart ) && ( xSpansOverflow == pdFALSE ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		xSpansOverflow = pdFALSE;
+
+		for( x = 0; x < dloNUM_WAKERS; x++ )
+		{
+			xWakeOffsets[ x ] = dloMIN_DELAY + ( ( ( ( x * dloSTRIDE ) + ( UBaseType_t ) ulControllerCycles ) % dloNUM_WAKERS ) / 2 ) * dloSPACING;
+
+			if( ( TickType_t ) ( xCycleStart + xWakeOffsets[ x ] ) < xCycleStart )
+			{
+				xSpansOverflow = pdTRUE;
+			}
+		}
+
+		for( x = 0; x < dloNUM_WAKERS; x++ )
+		{
+			xTaskNotifyGive( xWakers[ x ] );
+		}
+
+		/* Remove a different waker from the middle of the delayed list on each
+		cycle.  If it has not blocked yet it will only be held back. */
+		vTaskDelay( dloRELEASE_TICKS );
+		uxSuspended = ( UBaseType_t ) ( ulControllerCycles % dloNUM_WAKERS );
+		vTaskSuspend( xWakers[ uxSuspended ] );
+		vTaskResume( xWakers[ uxSuspended ] );
+
+		/* Each waker notifies the controller once it has run. */
+		for( uxReported = 0; uxReported < dloNUM_WAKERS; uxReported += ( UBaseType_t ) ulReceived )
+		{
+			ulReceived = ulTaskNotifyTake( pdTRUE, dloMAX_WAIT );
+
+			if( ulReceived == 0UL )
+			{
+				xErrorDetected = pdTRUE;
+				break;
+			}
+		}
+
+		for( x = 0; ( x < dloNUM_WAKERS ) && ( uxReported == dloNUM_WAKERS ); x++ )
+		{
+			if( xRunOffsets[ x ] < xWakeOffsets[ x ] )
+			{
+				/* Only the waker that was suspended can run before its wake
+				time. */
+				if( x != uxSuspended )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+			else
+			{
+				/* A waker that ran at or after its wake time cannot have run
+				on an earlier tick than a waker with an earlier wake time, as
+				that waker was ready first. */
+				for( y = 0; y < dloNUM_WAKERS; y++ )
+				{
+					if( ( xWakeOffsets[ y ] < xWakeOffsets[ x ] ) && ( xRunOffsets[ y ] >= xWakeOffsets[ y ] ) && ( xRunOffsets[ y ] > xRunOffsets[ x ] ) )
+					{
+						xErrorDetected = pdTRUE;
+					}
+				}
+			}
+		}
+
+		xLastStart = xCycleStart;
+		ulControllerCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakerTask( void *pvParameters )
+{
+const UBaseType_t uxWaker = ( UBaseType_t ) pvParameters;
+TickType_t xWakeTime;
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		xWakeTime = xCycleStart;
+		vTaskDelayUntil( &xWakeTime, xWakeOffsets[ uxWaker ] );
+
+		xRunOffsets[ uxWaker ] = xTaskGetTickCount() - xCycleStart;
+		xTaskNotifyGive( xController );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	static void prvTreeTask( void *pvParameters )
+	{
+	uint32_t ulNextInsert = 0UL, ulRandom;
+	UBaseType_t x, uxOperation;
+	ListItem_t *pxHead;
+	TickType_t xLastValue;
+
+		/* Remove compiler warning about unused parameter. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			for( uxOperation = 0; uxOperation < dloTREE_OPERATIONS; uxOperation++ )
+			{
+				ulRandom = prvRand();
+				x = ( UBaseType_t ) ( ulRandom % dloTREE_ITEMS );
+
+				if( listIS_CONTAINED_WITHIN( &xTreeList, &( xTreeItems[ x ] ) ) != pdFALSE )
+				{
+					( void ) uxListRemove( &( xTreeItems[ x ] ) );
+				}
+				else
+				{
+					/* Mostly small values, with some just below portMAX_DELAY
+					so the end of the range is covered too. */
+					ulRandom = prvRand();
+
+					if( ( ulRandom & 0x07UL ) == 0UL )
+					{
+						listSET_LIST_ITEM_VALUE( &( xTreeItems[ x ] ), portMAX_DELAY - ( TickType_t ) ( ( ulRandom >> 3 ) & 0x03UL ) );
+					}
+					else
+					{
+						listSET_LIST_ITEM_VALUE( &( xTreeItems[ x ] ), ( TickType_t ) ( ( ulRandom >> 3 ) & 0x0fUL ) );
+					}
+
+					ulInsertOrder[ x ] = ulNextInsert;
+					ulNextInsert++;
+					vListInsert( &xTreeList, &( xTreeItems[ x ] ) );
+				}
+
+				prvCheckTreeList();
+			}
+
+			/* Empty the list from the head, checking the items come out in
+			order. */
+			if( ( ulTreeCycles % dloTREE_EMPTY_CYCLES ) == 0UL )
+			{
+				xLastValue = 0;
+
+				while( listLIST_IS_EMPTY( &xTreeList ) == pdFALSE )
+				{
+					pxHead = listGET_HEAD_ENTRY( &xTreeList );
+
+					if( listGET_LIST_ITEM_VALUE( pxHead ) < xLastValue )
+					{
+						xErrorDetected = pdTRUE;
+					}
+
+					xLastValue = listGET_LIST_ITEM_VALUE( pxHead );
+					( void ) uxListRemove( pxHead );
+					prvCheckTreeList();
+				}
+			}
+
+			ulTreeCycles++;
+			vTaskDelay( 1 );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckTreeList( void )
+	{
+	const ListItem_t *pxItem, *pxNextInList;
+	UBaseType_t uxItems = 0;
+
+		/* The linked list must be sorted by value, and items of equal value
+		must be in the order they were inserted. */
+		for( pxItem = listGET_HEAD_ENTRY( &xTreeList ); pxItem != listGET_END_MARKER( &xTreeList ); pxItem = pxItem->pxNext )
+		{
+			if( pxItem->pxContainer != &xTreeList )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( pxItem->pxNext != listGET_END_MARKER( &xTreeList ) )
+			{
+				if( pxItem->xItemValue > pxItem->pxNext->xItemValue )
+				{
+					xErrorDetected = pdTRUE;
+				}
+				else if( ( pxItem->xItemValue == pxItem->pxNext->xItemValue ) && ( ulInsertOrder[ pxItem - xTreeItems ] > ulInsertOrder[ pxItem->pxNext - xTreeItems ] ) )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+
+			uxItems++;
+		}
+
+		if( uxItems != listCURRENT_LIST_LENGTH( &xTreeList ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The root must be black and have no parent, and an in-order walk of
+		the tree must visit every item in the linked list. */
+		if( xTreeList.pxTreeRoot != NULL )
+		{
+			if( ( xTreeList.pxTreeRoot->pxTreeParent != NULL ) || ( xTreeList.pxTreeRoot->xTreeRed != pdFALSE ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		pxNextInList = listGET_HEAD_ENTRY( &xTreeList );
+		( void ) prvCheckSubtree( xTreeList.pxTreeRoot, &pxNextInList );
+
+		if( pxNextInList != listGET_END_MARKER( &xTreeList ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCheckSubtree( const ListItem_t *pxNode, const ListItem_t **ppxNextInList )
+	{
+	BaseType_t xLeftHeight, xRightHeight;
+
+		/* Empty subtrees count as black. */
+		if( pxNode == NULL )
+		{
+			return 1;
+		}
+
+		if( pxNode->pxTreeLeft != NULL )
+		{
+			if( ( pxNode->pxTreeLeft->pxTreeParent != pxNode ) || ( ( pxNode->xTreeRed != pdFALSE ) && ( pxNode->pxTreeLeft->xTreeRed != pdFALSE ) ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		if( pxNode->pxTreeRight != NULL )
+		{
+			if( ( pxNode->pxTreeRight->pxTreeParent != pxNode ) || ( ( pxNode->xTreeRed != pdFALSE ) && ( pxNode->pxTreeRight->xTreeRed != pdFALSE ) ) )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+
+		xLeftHeight = prvCheckSubtree( pxNode->pxTreeLeft, ppxNextInList );
+
+		if( pxNode != *ppxNextInList )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		*ppxNextInList = pxNode->pxNext;
+
+		xRightHeight = prvCheckSubtree( pxNode->pxTreeRight, ppxNextInList );
+
+		/* Every path down from a node must pass the same number of black
+		nodes. */
+		if( xLeftHeight != xRightHeight )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( pxNode->xTreeRed != pdFALSE )
+		{
+			return xLeftHeight;
+		}
+		else
+		{
+			return xLeftHeight + 1;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvRand( void )
+	{
+	static uint32_t ulSeed = 1UL;
+
+		ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+		return ulSeed >> 16;
+	}
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreDelayOrderTasksStillRunning( void )
+{
+static uint32_t ulLastControllerCycles = 0UL;
+
+	/* If the tests are still running then we expect the cycle counts to have
+	incremented since this function was last called. */
+	if( ulLastControllerCycles == ulControllerCycles )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	ulLastControllerCycles = ulControllerCycles;
+
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+	static uint32_t ulLastTreeCycles = 0UL;
+
+		if( ulLastTreeCycles == ulTreeCycles )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulLastTreeCycles = ulTreeCycles;
+	}
+	#endif /* configUSE_INDEXED_DELAY_LISTS */
+
+	/* Errors detected in the tasks will have latched xErrorDetected to
+	true. */
+
+	return ( BaseType_t ) !xErrorDetected;
+}
+
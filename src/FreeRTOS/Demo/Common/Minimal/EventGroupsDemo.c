@@ -88,6 +88,18 @@ event bits in a group are unblocked as appropriate as different bits get set. */
 #define ebSELECTIVE_BITS_1		0x03
 #define ebSELECTIVE_BITS_2		0x05
 
+/* Used by xRunEventGroupLatencyTest().  Each rendezvous task synchronises on its
+own bit, starting from bit 0, and the task that calls the test on the bit above
+the last rendezvous task, so the most rendezvous tasks there can be is two less
+than the number of bits.  The latency task waits for the top bit. */
+#if configUSE_16_BIT_TICKS == 1
+	#define ebLATENCY_BIT				( ( EventBits_t ) 0x80U )
+	#define ebMAX_RENDEZVOUS_TASKS		( 6U )
+#else
+	#define ebLATENCY_BIT				( ( EventBits_t ) 0x800000UL )
+	#define ebMAX_RENDEZVOUS_TASKS		( 22U )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -147,6 +159,19 @@ static void prvSyncTask( void *pvParameters );
 static BaseType_t prvSelectiveBitsTestMasterFunction( void );
 static void prvSelectiveBitsTestSlaveFunction( void );
 
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/*
+	 * The tasks created by xRunEventGroupLatencyTest().  The rendezvous tasks
+	 * each call xEventGroupSync() in a loop, setting the bit passed in as the
+	 * task parameter.  The latency task waits for ebLATENCY_BIT, then adds the
+	 * time since the bit was set to the total.
+	 */
+	static void prvLatencyRendezvousTask( void *pvParameters );
+	static void prvLatencyTask( void *pvParameters );
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
 /*-----------------------------------------------------------*/
 
 /* Variables that are incremented by the tasks on each cycle provided no errors
@@ -162,6 +187,20 @@ static EventGroupHandle_t xISREventGroup = NULL;
 /* Handles to the tasks that only take part in the synchronisation calls. */
 static TaskHandle_t xSyncTask1 = NULL, xSyncTask2 = NULL;
 
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/* Used by xRunEventGroupLatencyTest() and the tasks it creates.  The bits
+	the rendezvous tasks wait for, the run time counter value when
+	ebLATENCY_BIT was last set, and the number of times the latency task ran
+	with the total time from the bit being set. */
+	static EventGroupHandle_t xLatencyEventGroup = NULL;
+	static EventBits_t uxLatencyRendezvousBits = 0;
+	static volatile configRUN_TIME_COUNTER_TYPE ulLatencySetTime = 0;
+	static volatile configRUN_TIME_COUNTER_TYPE ulLatencyTotal = 0;
+	static volatile uint32_t ulLatencyWakes = 0;
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
 /*-----------------------------------------------------------*/
 
 void vStartEventGroupTasks( void )
@@ -988,6 +1027,17 @@ BaseType_t xMessagePosted;
 			{
 				xISRTestError = pdTRUE;
 			}
+
+			#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+			{
+				/* The bits are set by the interrupt itself, not by the timer
+				task, so must already be set. */
+				if( xEventGroupGetBitsFromISR( xISREventGroup ) != uxBitsToSet )
+				{
+					xISRTestError = pdTRUE;
+				}
+			}
+			#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
 		}
 	}
 	else if( xCallCount == xGetBitsCount )
@@ -1010,6 +1060,15 @@ BaseType_t xMessagePosted;
 			xISRTestError = pdTRUE;
 		}
 
+		#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+		{
+			if( xEventGroupGetBitsFromISR( xISREventGroup ) != 0x00 )
+			{
+				xISRTestError = pdTRUE;
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+
 		/* Go back to the start. */
 		xCallCount = 0;
 
@@ -1054,6 +1113,146 @@ BaseType_t xStatus = pdPASS;
 
 	return xStatus;
 }
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	BaseType_t xRunEventGroupLatencyTest( UBaseType_t uxNumberOfTasks, uint32_t ulIterations, configRUN_TIME_COUNTER_TYPE *pulSetToRunTime, configRUN_TIME_COUNTER_TYPE *pulRendezvousTime )
+	{
+	TaskHandle_t xRendezvousTasks[ ebMAX_RENDEZVOUS_TASKS ], xLatencyTask = NULL;
+	const UBaseType_t uxTaskPriority = uxTaskPriorityGet( NULL ) + 1U;
+	const EventBits_t uxThisTasksBit = ( EventBits_t ) 1 << uxNumberOfTasks;
+	configRUN_TIME_COUNTER_TYPE ulStart;
+	UBaseType_t ux, uxCreated = 0;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xHigherPriorityTaskWoken, xStatus = pdPASS;
+	uint32_t ul;
+
+		configASSERT( uxNumberOfTasks <= ebMAX_RENDEZVOUS_TASKS );
+		configASSERT( uxTaskPriority < configTIMER_TASK_PRIORITY );
+
+		xLatencyEventGroup = xEventGroupCreate();
+
+		if( xLatencyEventGroup == NULL )
+		{
+			return pdFAIL;
+		}
+
+		uxLatencyRendezvousBits = ( uxThisTasksBit << 1 ) - ( EventBits_t ) 1;
+		ulLatencyTotal = 0;
+		ulLatencyWakes = 0;
+
+		/* The rendezvous tasks have a higher priority than this task, so each
+		sets its bit and blocks before it is created, and stays blocked until
+		this task sets the last bit. */
+		for( uxCreated = 0; uxCreated < uxNumberOfTasks; uxCreated++ )
+		{
+			if( xTaskCreate( prvLatencyRendezvousTask, "EGRndv", configMINIMAL_STACK_SIZE, ( void * ) ( ( EventBits_t ) 1 << uxCreated ), uxTaskPriority, &( xRendezvousTasks[ uxCreated ] ) ) != pdPASS )
+			{
+				xStatus = pdFAIL;
+				break;
+			}
+		}
+
+		if( ( xStatus == pdPASS ) && ( xTaskCreate( prvLatencyTask, "EGLat", configMINIMAL_STACK_SIZE, NULL, uxTaskPriority, &xLatencyTask ) != pdPASS ) )
+		{
+			xStatus = pdFAIL;
+		}
+
+		if( xStatus == pdPASS )
+		{
+			/* Set ebLATENCY_BIT as an interrupt would, while the rendezvous
+			tasks are blocked waiting for this task's bit.  The latency task
+			has a higher priority than this task, so it has run, and blocked
+			again, by the time this task continues - either directly, or after
+			the timer task has run the set if configUSE_EVENT_GROUP_DIRECT_ISR
+			is 0. */
+			for( ul = 0; ul < ulIterations; ul++ )
+			{
+				xHigherPriorityTaskWoken = pdFALSE;
 
+				uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+				{
+					ulLatencySetTime = portGET_RUN_TIME_COUNTER_VALUE();
+					( void ) xEventGroupSetBitsFromISR( xLatencyEventGroup, ebLATENCY_BIT, &xHigherPriorityTaskWoken );
+				}
+				taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+				portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+			}
+
+			if( ulLatencyWakes != ulIterations )
+			{
+				xStatus = pdFAIL;
+			}
+
+			/* Each call sets the last bit the rendezvous tasks are waiting for,
+			so they all unblock, then each synchronises again before this task
+			continues. */
+			ulStart = portGET_RUN_TIME_COUNTER_VALUE();
+
+			for( ul = 0; ul < ulIterations; ul++ )
+			{
+				if( ( xEventGroupSync( xLatencyEventGroup, uxThisTasksBit, uxLatencyRendezvousBits, 0 ) & uxLatencyRendezvousBits ) != uxLatencyRendezvousBits )
+				{
+					xStatus = pdFAIL;
+					break;
+				}
+			}
+
+			*pulRendezvousTime = ( portGET_RUN_TIME_COUNTER_VALUE() - ulStart ) / ulIterations;
+			*pulSetToRunTime = ulLatencyTotal / ulIterations;
+		}
+
+		for( ux = 0; ux < uxCreated; ux++ )
+		{
+			vTaskDelete( xRendezvousTasks[ ux ] );
+		}
+
+		if( xLatencyTask != NULL )
+		{
+			vTaskDelete( xLatencyTask );
+		}
+
+		vEventGroupDelete( xLatencyEventGroup );
+		xLatencyEventGroup = NULL;
+
+		return xStatus;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static void prvLatencyRendezvousTask( void *pvParameters )
+	{
+	const EventBits_t uxThisTasksBit = ( EventBits_t ) pvParameters;
+
+		for( ;; )
+		{
+			( void ) xEventGroupSync( xLatencyEventGroup, uxThisTasksBit, uxLatencyRendezvousBits, portMAX_DELAY );
+		}
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static void prvLatencyTask( void *pvParameters )
+	{
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			if( ( xEventGroupWaitBits( xLatencyEventGroup, ebLATENCY_BIT, pdTRUE, pdFALSE, portMAX_DELAY ) & ebLATENCY_BIT ) != ( EventBits_t ) 0 )
+			{
+				ulLatencyTotal += portGET_RUN_TIME_COUNTER_VALUE() - ulLatencySetTime;
+				ulLatencyWakes++;
+			}
+		}
+	}
 
+#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -56,6 +56,11 @@
 #define genqMUTEX_MEDIUM_PRIORITY	( tskIDLE_PRIORITY + 2 )
 #define genqMUTEX_HIGH_PRIORITY		( tskIDLE_PRIORITY + 3 )
 
+/* The time for which the low priority task keeps the inherited priority in the
+priority inheritance chain test, standing in for the work done while the mutex
+is held. */
+#define genqCHAIN_HOLD_TICKS		( ( TickType_t ) 2 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -105,6 +110,21 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex, S
 	static void prvHighPriorityTimeout( SemaphoreHandle_t xMutex );
 #endif
 
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	#if( configUSE_PREEMPTION == 0 )
+		#error The additional tests included when configUSE_PRIORITY_INHERITANCE_CHAINS is 1 expect preemption to be used.
+	#endif
+
+	/* Tests the behaviour when the high priority task waits for a mutex held
+	by a task that is itself waiting for a mutex held by the low priority task.
+	The low priority task should inherit the priority of the high priority task
+	through the task in the middle, and the time the high priority task is kept
+	waiting is recorded.  prvChainMutexTask() is the task in the middle. */
+	static void prvPriorityInheritanceChain( void );
+	static void prvChainMutexTask( void *pvParameters );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Flag that will be latched to pdTRUE should any unexpected behaviour be
@@ -134,6 +154,21 @@ was aborted, in which case not being able to obtain the semaphore is not to be
 considered an error. */
 static volatile BaseType_t xBlockWasAborted = pdFALSE;
 
+/* The tick count at which the high priority task last obtained the mutex. */
+static volatile TickType_t xHighPriorityMutexObtained = 0;
+
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+	/* The task in the middle of the priority inheritance chain, and the mutex
+	it waits for while holding the mutex the high priority task waits for. */
+	static TaskHandle_t xChainMutexTask;
+	static SemaphoreHandle_t xChainMutex;
+#endif
+
+/* The time the high priority task waited in the priority inheritance chain
+test - the longest and the total, and the number of times it was measured. */
+static TickType_t xLongestInversion = 0, xTotalInversion = 0;
+static uint32_t ulInversionsMeasured = 0;
+
 /*-----------------------------------------------------------*/
 
 void vStartGenericQueueTasks( UBaseType_t uxPriority )
@@ -188,6 +223,16 @@ SemaphoreHandle_t xMutex;
 			xTaskCreate( prvHighPriorityMutexTask, "MuHigh2", configMINIMAL_STACK_SIZE, ( void * ) xMutex, genqMUTEX_MEDIUM_PRIORITY, &xSecondMediumPriorityMutexTask );
 		}
 		#endif /* INCLUDE_xTaskAbortDelay */
+
+		/* If configUSE_PRIORITY_INHERITANCE_CHAINS is set then a task that
+		holds one mutex while waiting for another is needed too. */
+		#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		{
+			xChainMutex = xSemaphoreCreateMutex();
+			configASSERT( xChainMutex );
+			xTaskCreate( prvChainMutexTask, "MuChain", configMINIMAL_STACK_SIZE, ( void * ) xMutex, genqMUTEX_TEST_PRIORITY, &xChainMutexTask );
+		}
+		#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 	}
 }
 /*-----------------------------------------------------------*/
@@ -717,18 +762,37 @@ static void prvTakeTwoMutexesReturnInDifferentOrder( SemaphoreHandle_t xMutex, S
 		taskYIELD();
 	#endif
 
-	/* The guarded variable is only incremented by the medium priority task,
-	which still should not have executed as this task should remain at the
-	higher priority, ensure this is the case. */
-	if( ulGuardedVariable != 0 )
+	#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
 	{
-		xErrorDetected = pdTRUE;
-	}
+		/* Unless the mutexes held are listed, in which case no task is
+		waiting for the local mutex so the priority drops straight back to
+		genqMUTEX_TEST_PRIORITY, and the medium priority task executes. */
+		if( ulGuardedVariable != 1 )
+		{
+			xErrorDetected = pdTRUE;
+		}
 
-	if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_TEST_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	#else
 	{
-		xErrorDetected = pdTRUE;
+		/* The guarded variable is only incremented by the medium priority
+		task, which still should not have executed as this task should remain
+		at the higher priority, ensure this is the case. */
+		if( ulGuardedVariable != 0 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
 	}
+	#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 
 	/* Now also give back the local mutex, taking the held count back to 0.
 	This time the priority of this task should be disinherited back to the
@@ -931,6 +995,17 @@ SemaphoreHandle_t xMutex = ( SemaphoreHandle_t ) pvParameters, xLocalMutex;
 			prvHighPriorityTimeout( xMutex );
 		}
 		#endif
+
+		#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		{
+			/* Tests a priority being inherited through a task that holds
+			one mutex while waiting for another. */
+			prvPriorityInheritanceChain();
+
+			/* Just to show this task is still running. */
+			ulLoopCounter2++;
+		}
+		#endif
 	}
 }
 /*-----------------------------------------------------------*/
@@ -983,6 +1058,7 @@ SemaphoreHandle_t xMutex = ( SemaphoreHandle_t ) pvParameters;
 		{
 			/* When the mutex is eventually obtained it is just given back before
 			returning to suspend ready for the next cycle. */
+			xHighPriorityMutexObtained = xTaskGetTickCount();
 			if( xSemaphoreGive( xMutex ) != pdPASS )
 			{
 				xErrorDetected = pdTRUE;
@@ -992,6 +1068,188 @@ SemaphoreHandle_t xMutex = ( SemaphoreHandle_t ) pvParameters;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	static void prvPriorityInheritanceChain( void )
+	{
+	TickType_t xStartTime, xInversion;
+
+		/* Take the mutex the task in the middle of the chain will wait for.
+		It should be available now. */
+		if( xSemaphoreTake( xChainMutex, intsemNO_BLOCK ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulGuardedVariable = 0;
+
+		/* Unsuspend the task in the middle of the chain.  It takes the mutex
+		shared with the high priority task then blocks on the mutex held by
+		this task, so this task inherits its priority. */
+		vTaskResume( xChainMutexTask );
+
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_TEST_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		#if( INCLUDE_xTaskAbortDelay == 1 )
+		{
+			/* Complete the chain, then abort the high priority task's wait.
+			Both the task in the middle and this task should disinherit the
+			high priority again, but only as far as the task in the middle's
+			priority. */
+			vTaskResume( xHighPriorityMutexTask );
+
+			if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			xBlockWasAborted = pdTRUE;
+			if( xTaskAbortDelay( xHighPriorityMutexTask ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			while( uxTaskPriorityGet( NULL ) != genqMUTEX_TEST_PRIORITY )
+			{
+				/* If this task gets stuck here then the check variables will
+				stop incrementing and the check task will detect the error. */
+				vTaskDelay( genqSHORT_BLOCK );
+			}
+
+			if( uxTaskPriorityGet( xChainMutexTask ) != genqMUTEX_TEST_PRIORITY )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+		#endif /* INCLUDE_xTaskAbortDelay */
+
+		/* Now unsuspend the high priority task.  It blocks on the mutex held
+		by the task in the middle, whose inherited priority is passed on to
+		this task. */
+		xStartTime = xTaskGetTickCount();
+		vTaskResume( xHighPriorityMutexTask );
+
+		if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( uxTaskPriorityGet( xChainMutexTask ) != genqMUTEX_HIGH_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* The medium priority task should not run while the high priority
+		task is waiting on the chain, however long this task holds the
+		mutex. */
+		vTaskResume( xMediumPriorityMutexTask );
+
+		while( ( xTaskGetTickCount() - xStartTime ) < genqCHAIN_HOLD_TICKS )
+		{
+			/* Stand in for the work done while the mutex is held. */
+		}
+
+		if( ulGuardedVariable != 0 )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* Giving the mutex back lets the task in the middle and then the high
+		priority task run, followed by the medium priority task, before this
+		task - back at its own priority - runs again. */
+		if( xSemaphoreGive( xChainMutex ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( ( ulGuardedVariable != 1 ) || ( uxTaskPriorityGet( NULL ) != genqMUTEX_LOW_PRIORITY ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( uxTaskPriorityGet( xChainMutexTask ) != genqMUTEX_TEST_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		/* Record how long the high priority task was kept waiting. */
+		xInversion = xHighPriorityMutexObtained - xStartTime;
+
+		if( xInversion < genqCHAIN_HOLD_TICKS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		if( xInversion > xLongestInversion )
+		{
+			xLongestInversion = xInversion;
+		}
+
+		xTotalInversion += xInversion;
+		ulInversionsMeasured++;
+
+		configASSERT( xErrorDetected == pdFALSE );
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	static void prvChainMutexTask( void *pvParameters )
+	{
+	SemaphoreHandle_t xMutex = ( SemaphoreHandle_t ) pvParameters;
+
+		for( ;; )
+		{
+			/* The task in the middle of the chain starts by suspending itself.
+			The low priority task will unsuspend this task when required. */
+			vTaskSuspend( NULL );
+
+			/* Take the mutex the high priority task will wait for, then wait
+			for the mutex held by the low priority task. */
+			if( xSemaphoreTake( xMutex, intsemNO_BLOCK ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( xSemaphoreTake( xChainMutex, portMAX_DELAY ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			/* The high priority task is waiting for xMutex, so its priority is
+			kept until xMutex is given back too. */
+			if( xSemaphoreGive( xChainMutex ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( uxTaskPriorityGet( NULL ) != genqMUTEX_HIGH_PRIORITY )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			if( xSemaphoreGive( xMutex ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+void vGetGenericQueueInversionTimes( TickType_t *pxLongest, TickType_t *pxTotal, uint32_t *pulMeasured )
+{
+	*pxLongest = xLongestInversion;
+	*pxTotal = xTotalInversion;
+	*pulMeasured = ulInversionsMeasured;
+}
+/*-----------------------------------------------------------*/
 
 /* This is called to check that all the created tasks are still running. */
 BaseType_t xAreGenericQueueTasksStillRunning( void )
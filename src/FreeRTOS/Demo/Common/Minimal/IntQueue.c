@@ -98,7 +98,7 @@ from within the interrupts. */
 	if( xQueueIsQueueFullFromISR( xNormallyEmptyQueue ) != pdTRUE )															\
 	{																														\
 	UBaseType_t uxSavedInterruptStatus;																						\
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();															\
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();																\
 		{																													\
 			uxValueForNormallyEmptyQueue++;																					\
 			if( xQueueSendFromISR( xNormallyEmptyQueue, ( void * ) &uxValueForNormallyEmptyQueue, &xHigherPriorityTaskWoken ) != pdPASS ) \
@@ -106,7 +106,7 @@ from within the interrupts. */
 				uxValueForNormallyEmptyQueue--;																				\
 			}																												\
 		}																													\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );														\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );																\
 	}																														\
 
 /* Send the next value to the queue that is normally full.  This is called
@@ -115,7 +115,7 @@ from within the interrupts. */
 	if( xQueueIsQueueFullFromISR( xNormallyFullQueue ) != pdTRUE )															\
 	{																														\
 	UBaseType_t uxSavedInterruptStatus;																						\
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();															\
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();																\
 		{																													\
 			uxValueForNormallyFullQueue++;																					\
 			if( xQueueSendFromISR( xNormallyFullQueue, ( void * ) &uxValueForNormallyFullQueue, &xHigherPriorityTaskWoken ) != pdPASS ) \
@@ -123,7 +123,7 @@ from within the interrupts. */
 				uxValueForNormallyFullQueue--;																				\
 			} 																												\
 		}																													\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );														\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );																\
 	}																														\
 
 /* Receive a value from the normally empty queue.  This is called from within
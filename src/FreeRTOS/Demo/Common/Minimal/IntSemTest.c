@@ -345,11 +345,23 @@ static void prvTakeAndGiveInTheOppositeOrder( void )
 
 	/* Should still be at the priority of the slave task as this task still
 	holds one semaphore (this is a simplification in the priority inheritance
-	mechanism. */
-	if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+	mechanism.  When the mutexes held are listed no task is waiting for the
+	ISR mutex, so the priority is disinherited straight away. */
+	#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
 	{
-		xErrorDetected = pdTRUE;
+		if( uxTaskPriorityGet( NULL ) != intsemMASTER_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+	#else
+	{
+		if( uxTaskPriorityGet( NULL ) != intsemSLAVE_PRIORITY )
+		{
+			xErrorDetected = pdTRUE;
+		}
 	}
+	#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
 
 	/* Give back the ISR semaphore, which should result in the priority being
 	disinherited as it was the last mutex held. */
@@ -86,6 +86,18 @@ static void prvEchoServer( void *pvParameters );
 static void prvNonBlockingReceiverTask( void *pvParameters );
 static void prvNonBlockingSenderTask( void *pvParameters );
 
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+	/*
+	 * Sends a message gathered from three blocks with xMessageBufferSendV(),
+	 * then checks xMessageBufferReceiveAcquire() describes it correctly and
+	 * xMessageBufferReceiveConsume() only removes it when given its length.  This
+	 * is repeated with the message starting at every offset within the message
+	 * buffer's storage area, so both the message and its length wrap around the
+	 * end of the storage area at every possible point.
+	 */
+	static void prvScatterGatherTests( MessageBufferHandle_t xMessageBuffer );
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1  )
 	/* This file tests both statically and dynamically allocated message buffers.
 	Allocate the structures and buffers to be used by the statically allocated
@@ -420,6 +432,164 @@ UBaseType_t uxOriginalPriority;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	static void prvScatterGatherTests( MessageBufferHandle_t xMessageBuffer )
+	{
+	StreamBufferIOVec_t xVectors[ 3 ], xSpans[ 2 ];
+	size_t xOffset, xMessageLength, xReturned, xDataStart, xExpectedFirstSpan, xStepLength;
+	uint8_t *pucReadData;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* The storage area is one byte longer than the size passed to
+	xMessageBufferCreate(), see xStreamBufferGenericCreate(). */
+	const size_t xStorageLength = mbMESSAGE_BUFFER_LENGTH_BYTES + 1;
+
+		pucReadData = ( uint8_t * ) pvPortMalloc( mbMESSAGE_BUFFER_LENGTH_BYTES );
+		configASSERT( pucReadData );
+
+		xMessageBufferReset( xMessageBuffer );
+
+		/* Nothing to acquire from an empty message buffer. */
+		xReturned = xMessageBufferReceiveAcquire( xMessageBuffer, xSpans, mbDONT_BLOCK );
+		configASSERT( xReturned == 0 );
+		configASSERT( ( xSpans[ 0 ].xLength == 0 ) && ( xSpans[ 1 ].xLength == 0 ) );
+		configASSERT( xMessageBufferReceiveConsume( xMessageBuffer, 1 ) == pdFAIL );
+
+		/* A message that is one byte too long to fit, when gathered, must not
+		be written at all. */
+		xVectors[ 0 ].pvData = ( const void * ) pc55ByteString;
+		xVectors[ 0 ].xLength = 1;
+		xVectors[ 1 ].pvData = ( const void * ) &( pc55ByteString[ 1 ] );
+		xVectors[ 1 ].xLength = mbMESSAGE_BUFFER_LENGTH_BYTES - mbBYTES_TO_STORE_MESSAGE_LENGTH;
+		xReturned = xMessageBufferSendV( xMessageBuffer, xVectors, 2, mbDONT_BLOCK );
+		configASSERT( xReturned == 0 );
+		configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+
+		for( xOffset = 0; xOffset < xStorageLength; xOffset++ )
+		{
+			/* Move the start of the next message to xOffset by sending then
+			receiving messages that together occupy xOffset bytes - or, if
+			that is not enough to hold a length and at least one byte of data,
+			xOffset bytes more than the whole storage area. */
+			xMessageBufferReset( xMessageBuffer );
+
+			if( xOffset > mbBYTES_TO_STORE_MESSAGE_LENGTH )
+			{
+				xStepLength = xOffset - mbBYTES_TO_STORE_MESSAGE_LENGTH;
+			}
+			else if( xOffset > 0 )
+			{
+				xStepLength = ( xStorageLength + xOffset - ( 2 * mbBYTES_TO_STORE_MESSAGE_LENGTH ) ) / 2;
+				xReturned = xMessageBufferSend( xMessageBuffer, ( const void * ) pc55ByteString, xStepLength, mbDONT_BLOCK );
+				configASSERT( xReturned == xStepLength );
+				xReturned = xMessageBufferReceive( xMessageBuffer, ( void * ) pucReadData, mbMESSAGE_BUFFER_LENGTH_BYTES, mbDONT_BLOCK );
+				configASSERT( xReturned == xStepLength );
+				xStepLength = ( xStorageLength + xOffset - ( 2 * mbBYTES_TO_STORE_MESSAGE_LENGTH ) ) - xStepLength;
+			}
+			else
+			{
+				xStepLength = 0;
+			}
+
+			if( xStepLength > 0 )
+			{
+				xReturned = xMessageBufferSend( xMessageBuffer, ( const void * ) pc55ByteString, xStepLength, mbDONT_BLOCK );
+				configASSERT( xReturned == xStepLength );
+				xReturned = xMessageBufferReceive( xMessageBuffer, ( void * ) pucReadData, mbMESSAGE_BUFFER_LENGTH_BYTES, mbDONT_BLOCK );
+				configASSERT( xReturned == xStepLength );
+			}
+
+			/* Vary the length of the message, and split it into three blocks,
+			some of which are empty when the message is short. */
+			xMessageLength = ( size_t ) 1 + ( xOffset % ( mbMESSAGE_BUFFER_LENGTH_BYTES - mbBYTES_TO_STORE_MESSAGE_LENGTH ) );
+			xVectors[ 0 ].pvData = ( const void * ) pc55ByteString;
+			xVectors[ 0 ].xLength = xMessageLength / 3;
+			xVectors[ 1 ].pvData = ( const void * ) &( pc55ByteString[ xVectors[ 0 ].xLength ] );
+			xVectors[ 1 ].xLength = xMessageLength / 2;
+			xVectors[ 2 ].pvData = ( const void * ) &( pc55ByteString[ xVectors[ 0 ].xLength + xVectors[ 1 ].xLength ] );
+			xVectors[ 2 ].xLength = xMessageLength - ( xVectors[ 0 ].xLength + xVectors[ 1 ].xLength );
+
+			if( ( xOffset & 0x01 ) == 0 )
+			{
+				xReturned = xMessageBufferSendV( xMessageBuffer, xVectors, 3, mbDONT_BLOCK );
+			}
+			else
+			{
+				xReturned = xMessageBufferSendVFromISR( xMessageBuffer, xVectors, 3, &xHigherPriorityTaskWoken );
+			}
+			configASSERT( xReturned == xMessageLength );
+
+			/* The message data follows its length, and is split over the two
+			spans if it runs past the end of the storage area. */
+			xDataStart = ( xOffset + mbBYTES_TO_STORE_MESSAGE_LENGTH ) % xStorageLength;
+			xExpectedFirstSpan = configMIN( xStorageLength - xDataStart, xMessageLength );
+
+			if( ( xOffset & 0x01 ) == 0 )
+			{
+				xReturned = xMessageBufferReceiveAcquire( xMessageBuffer, xSpans, mbDONT_BLOCK );
+			}
+			else
+			{
+				xReturned = xMessageBufferReceiveAcquireFromISR( xMessageBuffer, xSpans );
+			}
+			configASSERT( xReturned == xMessageLength );
+			configASSERT( xSpans[ 0 ].xLength == xExpectedFirstSpan );
+			configASSERT( xSpans[ 1 ].xLength == ( xMessageLength - xExpectedFirstSpan ) );
+			configASSERT( memcmp( xSpans[ 0 ].pvData, ( const void * ) pc55ByteString, xSpans[ 0 ].xLength ) == 0 );
+			configASSERT( memcmp( xSpans[ 1 ].pvData, ( const void * ) &( pc55ByteString[ xSpans[ 0 ].xLength ] ), xSpans[ 1 ].xLength ) == 0 );
+
+			/* Nothing has been removed, so acquiring again gives the same
+			message. */
+			xReturned = xMessageBufferReceiveAcquire( xMessageBuffer, xSpans, mbDONT_BLOCK );
+			configASSERT( xReturned == xMessageLength );
+			configASSERT( xSpans[ 0 ].xLength == xExpectedFirstSpan );
+
+			/* Only the whole message can be consumed, and consuming nothing
+			leaves it in place. */
+			configASSERT( xMessageBufferReceiveConsume( xMessageBuffer, xMessageLength + 1 ) == pdFAIL );
+			configASSERT( xMessageBufferReceiveConsume( xMessageBuffer, xMessageLength - 1 ) == ( ( xMessageLength == 1 ) ? pdPASS : pdFAIL ) );
+			configASSERT( xMessageBufferReceiveConsume( xMessageBuffer, 0 ) == pdPASS );
+			xReturned = xMessageBufferNextLengthBytes( xMessageBuffer );
+			configASSERT( xReturned == xMessageLength );
+
+			/* Remove the message by consuming it in place, or by copying it
+			out, which must give the same data. */
+			switch( xOffset % 3 )
+			{
+				case 0:
+					xReturned = xMessageBufferReceiveConsume( xMessageBuffer, xMessageLength );
+					configASSERT( xReturned == pdPASS );
+					break;
+
+				case 1:
+					xReturned = xMessageBufferReceiveConsumeFromISR( xMessageBuffer, xMessageLength, &xHigherPriorityTaskWoken );
+					configASSERT( xReturned == pdPASS );
+					break;
+
+				default:
+					xReturned = xMessageBufferReceive( xMessageBuffer, ( void * ) pucReadData, mbMESSAGE_BUFFER_LENGTH_BYTES, mbDONT_BLOCK );
+					configASSERT( xReturned == xMessageLength );
+					configASSERT( memcmp( ( const void * ) pucReadData, ( const void * ) pc55ByteString, xMessageLength ) == 0 );
+					break;
+			}
+
+			configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+			configASSERT( xMessageBufferSpaceAvailable( xMessageBuffer ) == mbMESSAGE_BUFFER_LENGTH_BYTES );
+		}
+
+		/* In case configASSERT() is not defined. */
+		( void ) xReturned;
+		( void ) xExpectedFirstSpan;
+		( void ) xHigherPriorityTaskWoken;
+
+		vPortFree( pucReadData );
+		xMessageBufferReset( xMessageBuffer );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
 static void prvNonBlockingSenderTask( void *pvParameters )
 {
 MessageBufferHandle_t xMessageBuffer;
@@ -736,6 +906,9 @@ static void prvEchoServer( void *pvParameters )
 MessageBufferHandle_t xTempMessageBuffer;
 size_t xReceivedLength;
 char *pcReceivedString;
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+	StreamBufferIOVec_t xSpans[ 2 ];
+#endif
 EchoMessageBuffers_t xMessageBuffers;
 TickType_t xTimeOnEntering;
 const TickType_t xTicksToBlock = pdMS_TO_TICKS( 250UL );
@@ -780,20 +953,42 @@ const TickType_t xTicksToBlock = pdMS_TO_TICKS( 250UL );
 
 	for( ;; )
 	{
-		memset( pcReceivedString, 0x00, mbMESSAGE_BUFFER_LENGTH_BYTES );
+		#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+		if( uxTaskPriorityGet( NULL ) == mbLOWER_PRIORITY )
+		{
+			/* Echo the message straight from the client's message buffer to
+			the server's, without copying it anywhere else in between.  The
+			two spans are gathered back into one message. */
+			xReceivedLength = xMessageBufferReceiveAcquire( xMessageBuffers.xEchoClientBuffer, xSpans, xTicksToBlock );
+			configASSERT( xReceivedLength > 0 );
+
+			xMessageBufferSendV( xMessageBuffers.xEchoServerBuffer, xSpans, 2, portMAX_DELAY );
+			configASSERT( xMessageBufferReceiveConsume( xMessageBuffers.xEchoClientBuffer, xReceivedLength ) == pdPASS );
+		}
+		else
+		#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+		{
+			memset( pcReceivedString, 0x00, mbMESSAGE_BUFFER_LENGTH_BYTES );
 
-		/* Has any data been sent by the client? */
-		xReceivedLength = xMessageBufferReceive( xMessageBuffers.xEchoClientBuffer, ( void * ) pcReceivedString, mbMESSAGE_BUFFER_LENGTH_BYTES, xTicksToBlock );
+			/* Has any data been sent by the client? */
+			xReceivedLength = xMessageBufferReceive( xMessageBuffers.xEchoClientBuffer, ( void * ) pcReceivedString, mbMESSAGE_BUFFER_LENGTH_BYTES, xTicksToBlock );
 
-		/* Should always receive data as a delay was used. */
-		configASSERT( xReceivedLength > 0 );
+			/* Should always receive data as a delay was used. */
+			configASSERT( xReceivedLength > 0 );
 
-		/* Echo the received data back to the client. */
-		xMessageBufferSend( xMessageBuffers.xEchoServerBuffer, ( void * ) pcReceivedString, xReceivedLength, portMAX_DELAY );
+			/* Echo the received data back to the client. */
+			xMessageBufferSend( xMessageBuffers.xEchoServerBuffer, ( void * ) pcReceivedString, xReceivedLength, portMAX_DELAY );
+		}
 
 		/* This message buffer is just created and deleted to ensure no memory
-		leaks. */
+		leaks.  It is used for the scatter/gather tests first, which leave it
+		empty. */
 		xTempMessageBuffer = xMessageBufferCreate( mbMESSAGE_BUFFER_LENGTH_BYTES );
+		#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+		{
+			prvScatterGatherTests( xTempMessageBuffer );
+		}
+		#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
 		vMessageBufferDelete( xTempMessageBuffer );
 	}
 }
@@ -0,0 +1,423 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests xQueueSendMultiple(), xQueueReceiveMultiple() and their FromISR()
+ * equivalents, in the style of the QueueSet.c tests.
+ *
+ * Records are two words - the number of the queue they are sent to and a
+ * sequence number that is incremented for every record sent to that queue - so
+ * the receiver of each queue can check that no record is lost, duplicated or
+ * reordered, and that it came from the queue it was expected to.
+ *
+ * A sender task posts bursts of 1 to qbMAX_BURST records to four queues in
+ * turn, the burst length changing on every burst.  None of the queue lengths
+ * divides the burst lengths, so bursts wrap around the end of the queue storage
+ * areas at every possible position, and most bursts do not fit in one pass so
+ * the sender blocks part way through them.
+ *
+ * The first two queues are members of a queue set, as is a third queue that
+ * vQueueBatchPeriodicISRTest() posts bursts to from the tick hook.  The set
+ * receiver task receives one record per handle returned by
+ * xQueueSelectFromSet(), which must always succeed if the set was notified once
+ * per record.  After each record it also checks, in a critical section, that
+ * the set holds exactly as many handles as its members hold records.  The set
+ * receiver runs at a lower priority than the sender, so the set members are
+ * usually full.
+ *
+ * The fourth queue is read by a batch receiver task, which runs at a higher
+ * priority than the sender and receives up to a changing maximum number of
+ * records at a time.  Every other burst to this queue is first sent with the
+ * scheduler suspended and no block time, to check that exactly the records
+ * there is space for are sent, and the rest are then sent with a block time.
+ *
+ * The fifth queue is emptied a few records at a time by
+ * vQueueBatchPeriodicISRTest(), so the sender also has to wait for space to be
+ * made by an interrupt.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "QueueBatch.h"
+
+#if( configUSE_QUEUE_BATCH != 1 )
+	#error configUSE_QUEUE_BATCH must be set to 1 in FreeRTOSConfig.h to use QueueBatch.c
+#endif
+
+#if( configUSE_QUEUE_SETS != 1 )
+	#error configUSE_QUEUE_SETS must be set to 1 in FreeRTOSConfig.h to use QueueBatch.c
+#endif
+
+/* The queues.  The first qbNUM_SET_QUEUES are members of the queue set, and the
+last of those is posted to by the tick hook. */
+#define qbNUM_SET_QUEUES		( 3 )
+#define qbISR_SET_QUEUE			( 2 )
+#define qbBATCH_QUEUE			( 3 )
+#define qbISR_RX_QUEUE			( 4 )
+#define qbNUM_QUEUES			( 5 )
+
+/* The queue lengths - deliberately not factors of the burst lengths. */
+#define qbSET_QUEUE_LENGTH		( 19 )
+#define qbQUEUE_LENGTH			( 13 )
+
+/* The longest burst sent by the sender task, and the longest sent or received
+by the tick hook. */
+#define qbMAX_BURST				( 32 )
+#define qbMAX_ISR_BURST			( 7 )
+
+/* The task priorities.  The set receiver is below the sender so the set members
+fill, the batch receiver above it so it is woken part way through bursts. */
+#define qbSET_RX_PRIORITY		( tskIDLE_PRIORITY )
+#define qbTX_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define qbBATCH_RX_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+/* The stack size of the tasks created by this file. */
+#define qbSTACK_SIZE			( configMINIMAL_STACK_SIZE )
+
+/*-----------------------------------------------------------*/
+
+/* The record passed through the queues. */
+typedef struct BATCH_RECORD
+{
+	uint32_t ulQueue;
+	uint32_t ulSequence;
+} BatchRecord_t;
+
+/*
+ * The tasks described at the top of this file.
+ */
+static void prvSenderTask( void *pvParameters );
+static void prvSetReceiverTask( void *pvParameters );
+static void prvBatchReceiverTask( void *pvParameters );
+
+/*
+ * Fill pxRecords with the uxCount records that follow ulSequence on queue
+ * ulQueue.
+ */
+static void prvFillRecords( BatchRecord_t *pxRecords, UBaseType_t uxCount, uint32_t ulQueue, uint32_t ulSequence );
+
+/*
+ * Check that pxRecords holds the uxCount records that follow *pulSequence on
+ * queue ulQueue, and move *pulSequence on past them.
+ */
+static void prvCheckRecords( const BatchRecord_t *pxRecords, UBaseType_t uxCount, uint32_t ulQueue, uint32_t *pulSequence );
+
+/*-----------------------------------------------------------*/
+
+/* The queues, and the set the first qbNUM_SET_QUEUES of them belong to. */
+static QueueHandle_t xQueues[ qbNUM_QUEUES ] = { NULL };
+static QueueSetHandle_t xQueueSet = NULL;
+
+/* The records sent and received by each task and the tick hook.  Static to
+keep the task stacks small. */
+static BatchRecord_t xSenderRecords[ qbMAX_BURST ];
+static BatchRecord_t xBatchReceiverRecords[ qbMAX_BURST ];
+static BatchRecord_t xISRRecords[ qbMAX_ISR_BURST ];
+
+/* Flag that will be latched to pdTRUE should any unexpected behaviour be
+detected in any of the tasks or the tick hook. */
+static volatile BaseType_t xErrorDetected = pdFALSE;
+
+/* The number of records received from each queue, which is also the sequence
+number expected next.  These are used to detect a stalled test. */
+static volatile uint32_t ulRecordsReceived[ qbNUM_QUEUES ] = { 0 };
+
+/*-----------------------------------------------------------*/
+
+void vStartQueueBatchTasks( void )
+{
+BaseType_t x;
+
+	xQueueSet = xQueueCreateSet( qbNUM_SET_QUEUES * qbSET_QUEUE_LENGTH );
+	configASSERT( xQueueSet );
+
+	for( x = 0; x < qbNUM_QUEUES; x++ )
+	{
+		if( x < qbNUM_SET_QUEUES )
+		{
+			xQueues[ x ] = xQueueCreate( qbSET_QUEUE_LENGTH, sizeof( BatchRecord_t ) );
+			configASSERT( xQueues[ x ] );
+			xQueueAddToSet( xQueues[ x ], xQueueSet );
+		}
+		else
+		{
+			xQueues[ x ] = xQueueCreate( qbQUEUE_LENGTH, sizeof( BatchRecord_t ) );
+			configASSERT( xQueues[ x ] );
+		}
+	}
+
+	/* The queue registry is provided as a means for kernel aware debuggers to
+	locate queues and has no purpose if a kernel aware debugger is not being
+	used.  The call to vQueueAddToRegistry() will be removed by the
+	pre-processor if configQUEUE_REGISTRY_SIZE is not defined or is defined to
+	be less than 1.  Only the set is added, as the registry is shared with the
+	other demo tasks. */
+	vQueueAddToRegistry( xQueueSet, "Batch_Queue_Set" );
+
+	xTaskCreate( prvSenderTask, "QBTx", qbSTACK_SIZE, NULL, qbTX_PRIORITY, NULL );
+	xTaskCreate( prvSetReceiverTask, "QBSetRx", qbSTACK_SIZE, NULL, qbSET_RX_PRIORITY, NULL );
+	xTaskCreate( prvBatchReceiverTask, "QBRx", qbSTACK_SIZE, NULL, qbBATCH_RX_PRIORITY, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void *pvParameters )
+{
+uint32_t ulSequence[ qbNUM_QUEUES ] = { 0 }, ulBursts = 0UL, ulQueue = 0UL;
+UBaseType_t uxBurst, uxSent, uxSpaces;
+
+	/* Remove compiler warning about unused parameter. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The tick hook is the only sender to its set member. */
+		if( ulQueue == qbISR_SET_QUEUE )
+		{
+			ulQueue++;
+		}
+
+		uxBurst = ( UBaseType_t ) ( ulBursts % qbMAX_BURST ) + 1;
+		prvFillRecords( xSenderRecords, uxBurst, ulQueue, ulSequence[ ulQueue ] );
+		uxSent = 0;
+
+		if( ( ulQueue == qbBATCH_QUEUE ) && ( ( ulBursts & 0x01UL ) != 0UL ) )
+		{
+			/* With the scheduler suspended the batch receiver cannot run, so
+			exactly the records there is space for should be sent. */
+			vTaskSuspendAll();
+			{
+				uxSpaces = uxQueueSpacesAvailable( xQueues[ ulQueue ] );
+				uxSent = xQueueSendMultiple( xQueues[ ulQueue ], xSenderRecords, uxBurst, 0 );
+
+				if( uxSent != ( ( uxSpaces < uxBurst ) ? uxSpaces : uxBurst ) )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+			xTaskResumeAll();
+		}
+
+		/* Send the rest of the burst, blocking until there is space for all of
+		it. */
+		if( xQueueSendMultiple( xQueues[ ulQueue ], &( xSenderRecords[ uxSent ] ), uxBurst - uxSent, portMAX_DELAY ) != ( uxBurst - uxSent ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulSequence[ ulQueue ] += ( uint32_t ) uxBurst;
+		ulBursts++;
+		ulQueue = ( ulQueue + 1UL ) % qbNUM_QUEUES;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetReceiverTask( void *pvParameters )
+{
+QueueSetMemberHandle_t xActivatedMember;
+BatchRecord_t xRecord;
+uint32_t ulQueue, ulSequence;
+UBaseType_t uxRecordsInMembers;
+
+	/* Remove compiler warning about unused parameter. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xActivatedMember = xQueueSelectFromSet( xQueueSet, portMAX_DELAY );
+
+		for( ulQueue = 0; ulQueue < qbNUM_SET_QUEUES; ulQueue++ )
+		{
+			if( xActivatedMember == xQueues[ ulQueue ] )
+			{
+				break;
+			}
+		}
+
+		if( ulQueue == qbNUM_SET_QUEUES )
+		{
+			xErrorDetected = pdTRUE;
+			continue;
+		}
+
+		/* The set was notified once per record, so the member must hold a
+		record for each handle the set returns. */
+		if( xQueueReceive( xActivatedMember, &xRecord, 0 ) != pdPASS )
+		{
+			xErrorDetected = pdTRUE;
+		}
+		else
+		{
+			ulSequence = ulRecordsReceived[ ulQueue ];
+			prvCheckRecords( &xRecord, 1, ulQueue, &ulSequence );
+			ulRecordsReceived[ ulQueue ] = ulSequence;
+		}
+
+		/* Nothing can post to a member without also posting to the set, so
+		the counts must match when neither is being accessed. */
+		taskENTER_CRITICAL();
+		{
+			uxRecordsInMembers = 0;
+
+			for( ulQueue = 0; ulQueue < qbNUM_SET_QUEUES; ulQueue++ )
+			{
+				uxRecordsInMembers += uxQueueMessagesWaiting( xQueues[ ulQueue ] );
+			}
+
+			if( uxQueueMessagesWaiting( xQueueSet ) != uxRecordsInMembers )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchReceiverTask( void *pvParameters )
+{
+UBaseType_t uxMaxRecords = 1, uxReceived;
+uint32_t ulSequence;
+
+	/* Remove compiler warning about unused parameter. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		uxReceived = xQueueReceiveMultiple( xQueues[ qbBATCH_QUEUE ], xBatchReceiverRecords, uxMaxRecords, portMAX_DELAY );
+
+		if( ( uxReceived == 0 ) || ( uxReceived > uxMaxRecords ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+		else
+		{
+			ulSequence = ulRecordsReceived[ qbBATCH_QUEUE ];
+			prvCheckRecords( xBatchReceiverRecords, uxReceived, qbBATCH_QUEUE, &ulSequence );
+			ulRecordsReceived[ qbBATCH_QUEUE ] = ulSequence;
+		}
+
+		uxMaxRecords = ( uxMaxRecords % qbMAX_BURST ) + 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vQueueBatchPeriodicISRTest( void )
+{
+static uint32_t ulSendSequence = 0UL, ulCalls = 0UL;
+UBaseType_t uxBurst, uxCount;
+uint32_t ulSequence;
+
+	/* Called from the tick hook, so there is no need to request a context
+	switch if a task is unblocked - NULL is passed in place of
+	pxHigherPriorityTaskWoken. */
+
+	/* Post a burst to the set member.  Whatever does not fit is dropped, and
+	sent again as part of the next burst. */
+	uxBurst = ( UBaseType_t ) ( ulCalls % qbMAX_ISR_BURST ) + 1;
+	prvFillRecords( xISRRecords, uxBurst, qbISR_SET_QUEUE, ulSendSequence );
+	uxCount = xQueueSendMultipleFromISR( xQueues[ qbISR_SET_QUEUE ], xISRRecords, uxBurst, NULL );
+
+	if( uxCount > uxBurst )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	ulSendSequence += ( uint32_t ) uxCount;
+
+	/* Make space in the queue the sender task fills for the tick hook. */
+	uxCount = xQueueReceiveMultipleFromISR( xQueues[ qbISR_RX_QUEUE ], xISRRecords, uxBurst, NULL );
+
+	if( uxCount > uxBurst )
+	{
+		xErrorDetected = pdTRUE;
+	}
+	else
+	{
+		ulSequence = ulRecordsReceived[ qbISR_RX_QUEUE ];
+		prvCheckRecords( xISRRecords, uxCount, qbISR_RX_QUEUE, &ulSequence );
+		ulRecordsReceived[ qbISR_RX_QUEUE ] = ulSequence;
+	}
+
+	ulCalls++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillRecords( BatchRecord_t *pxRecords, UBaseType_t uxCount, uint32_t ulQueue, uint32_t ulSequence )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxCount; ux++ )
+	{
+		pxRecords[ ux ].ulQueue = ulQueue;
+		pxRecords[ ux ].ulSequence = ulSequence + ( uint32_t ) ux;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckRecords( const BatchRecord_t *pxRecords, UBaseType_t uxCount, uint32_t ulQueue, uint32_t *pulSequence )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxCount; ux++ )
+	{
+		if( ( pxRecords[ ux ].ulQueue != ulQueue ) || ( pxRecords[ ux ].ulSequence != *pulSequence ) )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		( *pulSequence )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreQueueBatchTasksStillRunning( void )
+{
+static uint32_t ulLastRecordsReceived[ qbNUM_QUEUES ] = { 0 };
+BaseType_t x;
+
+	/* If the tests are still running then we expect records to have been
+	received from every queue since this function was last called. */
+	for( x = 0; x < qbNUM_QUEUES; x++ )
+	{
+		if( ulLastRecordsReceived[ x ] == ulRecordsReceived[ x ] )
+		{
+			xErrorDetected = pdTRUE;
+		}
+
+		ulLastRecordsReceived[ x ] = ulRecordsReceived[ x ];
+	}
+
+	/* Errors detected in the tasks or the tick hook will have latched
+	xErrorDetected to true. */
+
+	return ( BaseType_t ) !xErrorDetected;
+}
+
@@ -68,6 +68,15 @@ the Blocked state so it can read the bytes. */
 test.  The stack size is over generous in most cases. */
 #define sbSTACK_SIZE				( configMINIMAL_STACK_SIZE + ( configMINIMAL_STACK_SIZE >> 1 ) )
 
+/* The throughput tasks pass sbTHROUGHPUT_BYTES_PER_PHASE bytes through one
+sbTHROUGHPUT_BUFFER_LENGTH_BYTES byte stream buffer, then the same number
+through another, sbTHROUGHPUT_CHUNK_BYTES at a time.  Only one of the two
+buffers is created with sbFLAGS_LOCKFREE_SPSC. */
+#define sbTHROUGHPUT_BUFFER_LENGTH_BYTES	( ( size_t ) 256 )
+#define sbTHROUGHPUT_CHUNK_BYTES			( ( size_t ) 32 )
+#define sbTHROUGHPUT_BYTES_PER_PHASE		( ( uint32_t ) 4096 )
+#define sbTHROUGHPUT_NUM_PHASES				( 2 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -92,6 +101,19 @@ static void prvEchoServer( void *pvParameters );
 static void prvNonBlockingReceiverTask( void *pvParameters );
 static void prvNonBlockingSenderTask( void *pvParameters );
 
+/*
+ * Tasks of equal priority that stream bytes through a stream buffer created
+ * with sbFLAGS_LOCKFREE_SPSC, then through a stream buffer created without it,
+ * alternately.  The sender fills the buffer until it blocks, then the receiver
+ * empties it until it blocks, so the sends and receives that do not block
+ * dominate - which are the ones sbFLAGS_LOCKFREE_SPSC makes cheaper.  Every
+ * byte is checked, and the time taken by each phase is accumulated so
+ * ulGetStreamBufferThroughput() can report the bytes per second achieved with
+ * and without the flag.
+ */
+static void prvThroughputSenderTask( void *pvParameters );
+static void prvThroughputReceiverTask( void *pvParameters );
+
 /* Performs an assert() like check in a way that won't get removed when
 performing a code coverage analysis. */
 static void prvCheckExpectedState( BaseType_t xState );
@@ -159,6 +181,15 @@ static const char *pc54ByteString = "01234567891abcdefghijklmnopqrstuvwxyzABCDEF
 to a monitoring task ('check' task). */
 static BaseType_t xErrorStatus = pdPASS;
 
+/* The buffers used by the throughput tasks, indexed by phase, the bytes and
+ticks accumulated by each phase, and a count of the phases completed without
+error so the check task knows the throughput tasks are still running.  Phase 1
+uses the buffer created with sbFLAGS_LOCKFREE_SPSC. */
+static StreamBufferHandle_t xThroughputBuffers[ sbTHROUGHPUT_NUM_PHASES ] = { NULL };
+static volatile uint32_t ulPhaseBytes[ sbTHROUGHPUT_NUM_PHASES ] = { 0 };
+static volatile TickType_t xPhaseTicks[ sbTHROUGHPUT_NUM_PHASES ] = { 0 };
+static volatile uint32_t ulThroughputPhases = 0;
+
 /*-----------------------------------------------------------*/
 
 void vStartStreamBufferTasks( void )
@@ -184,6 +215,9 @@ StreamBufferHandle_t xStreamBuffer;
 	unblocked. */
 	xTaskCreate( prvInterruptTriggerLevelTest, "StrTrig", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
 
+	/* The throughput tasks run at the lowest priority, as they never stop. */
+	vStartStreamBufferThroughputTasks( sbLOWER_PRIORITY );
+
 	#if( configSUPPORT_STATIC_ALLOCATION == 1  )
 	{
 		/* The sender tasks set up the stream buffers before creating the
@@ -196,6 +230,18 @@ StreamBufferHandle_t xStreamBuffer;
 }
 /*-----------------------------------------------------------*/
 
+void vStartStreamBufferThroughputTasks( UBaseType_t uxPriority )
+{
+	xThroughputBuffers[ 0 ] = xStreamBufferCreate( sbTHROUGHPUT_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1 );
+	xThroughputBuffers[ 1 ] = xStreamBufferCreateWithFlags( sbTHROUGHPUT_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1, sbFLAGS_LOCKFREE_SPSC );
+	configASSERT( xThroughputBuffers[ 0 ] );
+	configASSERT( xThroughputBuffers[ 1 ] );
+
+	xTaskCreate( prvThroughputSenderTask, "StrSPSCTx", sbSTACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvThroughputReceiverTask, "StrSPSCRx", sbSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
 static void prvCheckExpectedState( BaseType_t xState )
 {
 	configASSERT( xState );
@@ -559,6 +605,138 @@ BaseType_t xNonBlockingReceiveError = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+static void prvThroughputSenderTask( void *pvParameters )
+{
+uint8_t ucTxData[ sbTHROUGHPUT_CHUNK_BYTES ];
+uint32_t ulBytesSent = 0, ulBytesLeftInPhase;
+size_t xBytesToSend, x;
+BaseType_t xPhase;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Never send past the end of a phase, so the receiver finds exactly
+		sbTHROUGHPUT_BYTES_PER_PHASE bytes in each buffer. */
+		xPhase = ( BaseType_t ) ( ( ulBytesSent / sbTHROUGHPUT_BYTES_PER_PHASE ) % ( uint32_t ) sbTHROUGHPUT_NUM_PHASES );
+		ulBytesLeftInPhase = sbTHROUGHPUT_BYTES_PER_PHASE - ( ulBytesSent % sbTHROUGHPUT_BYTES_PER_PHASE );
+		xBytesToSend = configMIN( sbTHROUGHPUT_CHUNK_BYTES, ( size_t ) ulBytesLeftInPhase );
+
+		/* Each byte is the low byte of its position in the stream. */
+		for( x = 0; x < xBytesToSend; x++ )
+		{
+			ucTxData[ x ] = ( uint8_t ) ( ulBytesSent + ( uint32_t ) x );
+		}
+
+		/* Bytes that do not fit are generated again next time round. */
+		ulBytesSent += ( uint32_t ) xStreamBufferSend( xThroughputBuffers[ xPhase ], ( const void * ) ucTxData, xBytesToSend, sbRX_TX_BLOCK_TIME );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvThroughputReceiverTask( void *pvParameters )
+{
+uint8_t ucRxData[ sbTHROUGHPUT_CHUNK_BYTES ];
+uint32_t ulBytesReceived = 0, ulBytesLeftInPhase;
+size_t xBytesToReceive, xReceivedLength, x;
+TickType_t xPhaseStartTime, xTimeNow;
+BaseType_t xPhase, xThroughputError = pdFALSE;
+
+	( void ) pvParameters;
+
+	xPhaseStartTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		xPhase = ( BaseType_t ) ( ( ulBytesReceived / sbTHROUGHPUT_BYTES_PER_PHASE ) % ( uint32_t ) sbTHROUGHPUT_NUM_PHASES );
+		ulBytesLeftInPhase = sbTHROUGHPUT_BYTES_PER_PHASE - ( ulBytesReceived % sbTHROUGHPUT_BYTES_PER_PHASE );
+		xBytesToReceive = configMIN( sbTHROUGHPUT_CHUNK_BYTES, ( size_t ) ulBytesLeftInPhase );
+
+		xReceivedLength = xStreamBufferReceive( xThroughputBuffers[ xPhase ], ( void * ) ucRxData, xBytesToReceive, sbRX_TX_BLOCK_TIME );
+
+		for( x = 0; x < xReceivedLength; x++ )
+		{
+			if( ucRxData[ x ] != ( uint8_t ) ( ulBytesReceived + ( uint32_t ) x ) )
+			{
+				xThroughputError = pdTRUE;
+			}
+		}
+
+		ulBytesReceived += ( uint32_t ) xReceivedLength;
+
+		if( ( xReceivedLength != ( size_t ) 0 ) && ( ( ulBytesReceived % sbTHROUGHPUT_BYTES_PER_PHASE ) == 0UL ) )
+		{
+			/* End of a phase.  The buffer used by the phase must now be empty,
+			as the sender moves to the other buffer. */
+			if( xStreamBufferIsEmpty( xThroughputBuffers[ xPhase ] ) != pdTRUE )
+			{
+				xThroughputError = pdTRUE;
+			}
+
+			xTimeNow = xTaskGetTickCount();
+
+			taskENTER_CRITICAL();
+			{
+				/* Halve both totals before the byte count can overflow, which
+				leaves the rate they give unchanged. */
+				if( ulPhaseBytes[ xPhase ] >= 0x80000000UL )
+				{
+					ulPhaseBytes[ xPhase ] >>= 1;
+					xPhaseTicks[ xPhase ] >>= 1;
+				}
+
+				ulPhaseBytes[ xPhase ] += sbTHROUGHPUT_BYTES_PER_PHASE;
+				xPhaseTicks[ xPhase ] += ( xTimeNow - xPhaseStartTime );
+			}
+			taskEXIT_CRITICAL();
+
+			xPhaseStartTime = xTimeNow;
+
+			if( xThroughputError == pdFALSE )
+			{
+				ulThroughputPhases++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetStreamBufferThroughput( BaseType_t xLockFree )
+{
+BaseType_t xPhase;
+uint32_t ulBytes;
+TickType_t xTicks;
+
+	if( xLockFree != pdFALSE )
+	{
+		xPhase = 1;
+	}
+	else
+	{
+		xPhase = 0;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		ulBytes = ulPhaseBytes[ xPhase ];
+		xTicks = xPhaseTicks[ xPhase ];
+	}
+	taskEXIT_CRITICAL();
+
+	/* Bytes per second, or 0 if no phase of this kind has completed yet. */
+	if( xTicks == ( TickType_t ) 0 )
+	{
+		ulBytes = 0UL;
+	}
+	else
+	{
+		ulBytes = ( uint32_t ) ( ( ( uint64_t ) ulBytes * ( uint64_t ) configTICK_RATE_HZ ) / ( uint64_t ) xTicks );
+	}
+
+	return ulBytes;
+}
+/*-----------------------------------------------------------*/
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1  )
 
 	static void prvSenderTask( void *pvParameters )
@@ -785,9 +963,19 @@ const TickType_t xTicksToBlock = pdMS_TO_TICKS( 1000UL );		//! エラーが発
 
 	/* Create the stream buffer used to send data from the client to the server,
 	and the stream buffer used to echo the data from the server back to the
-	client. */
-	xStreamBuffers.xEchoClientBuffer = xStreamBufferCreate( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1 );
-	xStreamBuffers.xEchoServerBuffer = xStreamBufferCreate( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1 );
+	client.  Each has one writer and one reader, so the higher priority server
+	creates them with sbFLAGS_LOCKFREE_SPSC to test the flag with blocking
+	tasks. */
+	if( uxTaskPriorityGet( NULL ) == sbLOWER_PRIORITY )
+	{
+		xStreamBuffers.xEchoClientBuffer = xStreamBufferCreate( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1 );
+		xStreamBuffers.xEchoServerBuffer = xStreamBufferCreate( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1 );
+	}
+	else
+	{
+		xStreamBuffers.xEchoClientBuffer = xStreamBufferCreateWithFlags( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1, sbFLAGS_LOCKFREE_SPSC );
+		xStreamBuffers.xEchoServerBuffer = xStreamBufferCreateWithFlags( sbSTREAM_BUFFER_LENGTH_BYTES, sbTRIGGER_LEVEL_1, sbFLAGS_LOCKFREE_SPSC );
+	}
 	configASSERT( xStreamBuffers.xEchoClientBuffer );
 	configASSERT( xStreamBuffers.xEchoServerBuffer );
 
@@ -956,6 +1144,7 @@ BaseType_t xAreStreamBufferTasksStillRunning( void )
 static uint32_t ulLastEchoLoopCounters[ sbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
 static uint32_t ulLastNonBlockingRxCounter = 0;
 static uint32_t ulLastInterruptTriggerCounter = 0;
+static uint32_t ulLastThroughputPhases = 0;
 BaseType_t x;
 
 	for( x = 0; x < sbNUMBER_OF_ECHO_CLIENTS; x++ )
@@ -988,6 +1177,15 @@ BaseType_t x;
 		ulLastInterruptTriggerCounter = ulInterruptTriggerCounter;
 	}
 
+	if( ulLastThroughputPhases == ulThroughputPhases )
+	{
+		xErrorStatus = pdFAIL;
+	}
+	else
+	{
+		ulLastThroughputPhases = ulThroughputPhases;
+	}
+
 	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 	{
 		static uint32_t ulLastSenderLoopCounters[ sbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
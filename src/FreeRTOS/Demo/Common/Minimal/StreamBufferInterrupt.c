@@ -34,6 +34,11 @@
  * a few bytes of pcStringToSend to a stream buffer ever few times that it
  * executes.  A task reads the bytes from the stream buffer, looking for the
  * substring, and flagging an error if the received data is invalid.
+ *
+ * The interrupt is the only writer and the task the only reader, so the stream
+ * buffer is created with sbFLAGS_LOCKFREE_SPSC.  The interrupt then only
+ * notifies the task when the task is blocked on the stream buffer, and the task
+ * only enters a critical section when it has to block.
  */
 
 /* Standard includes. */
@@ -83,10 +88,12 @@ void vStartStreamBufferInterruptDemo( void )
 {
 	/* Create the stream buffer that sends data from the interrupt to the
 	task, and create the task. */
-	xStreamBuffer = xStreamBufferCreate( /* The buffer length in bytes. */
-										 sbiSTREAM_BUFFER_LENGTH_BYTES,
-										 /* The stream buffer's trigger level. */
-										 sbiSTREAM_BUFFER_TRIGGER_LEVEL_10 );
+	xStreamBuffer = xStreamBufferCreateWithFlags( /* The buffer length in bytes. */
+												  sbiSTREAM_BUFFER_LENGTH_BYTES,
+												  /* The stream buffer's trigger level. */
+												  sbiSTREAM_BUFFER_TRIGGER_LEVEL_10,
+												  /* Only one writer and one reader. */
+												  sbFLAGS_LOCKFREE_SPSC );
 
 	xTaskCreate( prvReceivingTask, /* The function that implements the task. */
 				 "StrIntRx",	   /* Human readable name for the task. */
@@ -191,11 +198,27 @@ static BaseType_t xCallCount = 0;
 	{
 		xCallCount = 0;
 
-		/* Send the next four bytes to the stream buffer. */
-		xStreamBufferSendFromISR( xStreamBuffer,
-								  ( const void * ) ( pcStringToSend + xNextByteToSend ),
-								  xBytesToSend,
-								  NULL );
+		#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+		{
+		StreamBufferIOVec_t xVectors[ 2 ];
+
+			/* Send the next four bytes to the stream buffer, gathered from two
+			blocks, to show the receiving task sees one contiguous stream. */
+			xVectors[ 0 ].pvData = ( const void * ) ( pcStringToSend + xNextByteToSend );
+			xVectors[ 0 ].xLength = 1;
+			xVectors[ 1 ].pvData = ( const void * ) ( pcStringToSend + xNextByteToSend + 1 );
+			xVectors[ 1 ].xLength = xBytesToSend - 1;
+			xStreamBufferSendVFromISR( xStreamBuffer, xVectors, 2, NULL );
+		}
+		#else
+		{
+			/* Send the next four bytes to the stream buffer. */
+			xStreamBufferSendFromISR( xStreamBuffer,
+									  ( const void * ) ( pcStringToSend + xNextByteToSend ),
+									  xBytesToSend,
+									  NULL );
+		}
+		#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
 
 		/* Send the next four bytes the next time around, wrapping to the start
 		of the string if necessary. */
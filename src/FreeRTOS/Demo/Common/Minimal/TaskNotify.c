@@ -45,6 +45,11 @@
 #define notifyUINT32_MAX	( ( uint32_t ) 0xffffffff )
 #define notifySUSPENDED_TEST_TIMER_PERIOD pdMS_TO_TICKS( 50 )
 
+/* The notification index that the interrupt gives to, alongside index 0, to
+check notifications sent to one index do not unblock a task waiting on
+another. */
+#define notifyLAST_INDEX		( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -58,6 +63,17 @@ static void prvNotifiedTask( void *pvParameters );
  */
 static void prvSingleTaskTests( void );
 
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+
+	/*
+	 * Tests performed by the task on itself to check that each notification in
+	 * the task's array has its own value and state, and that waiting on, taking
+	 * from, and clearing one index does not change the others.
+	 */
+	static void prvIndexedNotificationTests( void );
+
+#endif /* configTASK_NOTIFICATION_ARRAY_ENTRIES */
+
 /*
  * Software timer callback function from which xTaskNotify() is called.
  */
@@ -92,6 +108,10 @@ the number of notifications received by the task from the software timer.  The
 two should stay synchronised. */
 static uint32_t ulTimerNotificationsReceived = 0UL, ulTimerNotificationsSent = 0UL;
 
+/* Used to count the notifications sent to notifyLAST_INDEX from the interrupt,
+and received by the task. */
+static volatile uint32_t ulIndexedNotificationsReceived = 0UL, ulIndexedNotificationsSent = 0UL;
+
 /* The timer used to notify the task. */
 static TimerHandle_t xTimer = NULL;
 
@@ -446,9 +466,163 @@ TimerHandle_t xSingleTaskTimer;
 
 	/* Leave all bits cleared. */
 	xTaskNotifyWait( notifyUINT32_MAX, 0, NULL, 0 );
+
+	#if( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+	{
+		prvIndexedNotificationTests();
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+
+	static void prvIndexedNotificationTests( void )
+	{
+	const TickType_t xTicksToWait = pdMS_TO_TICKS( 20UL );
+	const uint32_t ulValueBase = 0x1000UL;
+	BaseType_t xReturned;
+	uint32_t ulNotifiedValue, ulPreviousValue;
+	TickType_t xTimeOnEntering;
+	UBaseType_t uxIndex, uxOtherIndex;
+
+		/* --------------------------------------------------------------------
+		No index should have a notification pending. */
+		for( uxIndex = 0; uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+		{
+			ulNotifiedValue = ulValueBase;
+			xReturned = xTaskNotifyWaitIndexed( uxIndex, notifyUINT32_MAX, 0, &ulNotifiedValue, 0 );
+
+			if( ( xReturned != pdFAIL ) || ( ulNotifiedValue != 0UL ) )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+
+		/* --------------------------------------------------------------------
+		Give each index its own value, then check each index reads back its own
+		value, and that reading it with a clear on exit leaves the indexes that
+		have not been read yet pending. */
+		for( uxIndex = 0; uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+		{
+			xReturned = xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndex, ulValueBase + uxIndex, eSetValueWithoutOverwrite, &ulPreviousValue );
+
+			if( ( xReturned != pdPASS ) || ( ulPreviousValue != 0UL ) )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+
+		for( uxIndex = 0; uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+		{
+			/* The index is already pending, so the value must not be written. */
+			if( xTaskNotifyIndexed( xTaskToNotify, uxIndex, 0UL, eSetValueWithoutOverwrite ) != pdFAIL )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			xReturned = xTaskNotifyWaitIndexed( uxIndex, 0, notifyUINT32_MAX, &ulNotifiedValue, 0 );
+
+			if( ( xReturned != pdPASS ) || ( ulNotifiedValue != ( ulValueBase + uxIndex ) ) )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			/* The indexes above this one have not been read yet. */
+			for( uxOtherIndex = uxIndex + 1; uxOtherIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxOtherIndex++ )
+			{
+				if( xTaskNotifyAndQueryIndexed( xTaskToNotify, uxOtherIndex, 0UL, eNoAction, &ulPreviousValue ) != pdPASS )
+				{
+					xErrorStatus = pdFAIL;
+				}
+
+				if( ulPreviousValue != ( ulValueBase + uxOtherIndex ) )
+				{
+					xErrorStatus = pdFAIL;
+				}
+			}
+		}
+
+		/* --------------------------------------------------------------------
+		A notification pending on index 0 must not stop the task blocking on
+		another index, and must still be pending when the block times out. */
+		xTaskNotifyGive( xTaskToNotify );
+		xTimeOnEntering = xTaskGetTickCount();
+		xReturned = xTaskNotifyWaitIndexed( notifyLAST_INDEX, 0, 0, NULL, xTicksToWait );
+
+		if( ( xReturned != pdFAIL ) || ( ( xTaskGetTickCount() - xTimeOnEntering ) < xTicksToWait ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( ulTaskNotifyTakeIndexed( notifyLAST_INDEX, pdTRUE, xTicksToWait ) != 0UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( ulTaskNotifyTake( pdTRUE, 0 ) != 1UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		/* --------------------------------------------------------------------
+		Counts given to one index are taken from that index only. */
+		xTaskNotifyGiveIndexed( xTaskToNotify, notifyLAST_INDEX );
+		xTaskNotifyGiveIndexed( xTaskToNotify, notifyLAST_INDEX );
+
+		if( ulTaskNotifyTake( pdFALSE, 0 ) != 0UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( ulTaskNotifyTakeIndexed( notifyLAST_INDEX, pdFALSE, 0 ) != 2UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( ulTaskNotifyTakeIndexed( notifyLAST_INDEX, pdFALSE, 0 ) != 1UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( ulTaskNotifyTakeIndexed( notifyLAST_INDEX, pdFALSE, 0 ) != 0UL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		/* --------------------------------------------------------------------
+		Clearing the state of one index leaves the others pending. */
+		xTaskNotify( xTaskToNotify, 0UL, eNoAction );
+		xTaskNotifyIndexed( xTaskToNotify, notifyLAST_INDEX, 0UL, eNoAction );
+
+		if( xTaskNotifyStateClearIndexed( NULL, notifyLAST_INDEX ) != pdPASS )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( xTaskNotifyStateClearIndexed( NULL, notifyLAST_INDEX ) != pdFAIL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( xTaskNotifyStateClear( NULL ) != pdPASS )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		/* Incremented to show the task is still running. */
+		ulNotifyCycleCount++;
+
+		/* Leave all the indexes cleared. */
+		for( uxIndex = 0; uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+		{
+			xTaskNotifyWaitIndexed( uxIndex, notifyUINT32_MAX, notifyUINT32_MAX, NULL, 0 );
+		}
+	}
+
+#endif /* configTASK_NOTIFICATION_ARRAY_ENTRIES */
+/*-----------------------------------------------------------*/
+
 static void prvSuspendedTaskTimerTestCallback( TimerHandle_t xExpiredTimer )
 {
 static uint32_t ulCallCount = 0;
@@ -586,6 +760,15 @@ const uint32_t ulCyclesToRaisePriority = 50UL;
 			ulTimerNotificationsReceived += ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
 		}
 
+		#if( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+		{
+			/* The interrupt also gives to notifyLAST_INDEX, which must never
+			have unblocked the indefinite waits on index 0 above.  Take the
+			count that has built up without blocking. */
+			ulIndexedNotificationsReceived += ulTaskNotifyTakeIndexed( notifyLAST_INDEX, pdTRUE, xDontBlock );
+		}
+		#endif
+
 		/* Incremented to show the task is still running. */
 		ulNotifyCycleCount++;
 	}
@@ -636,6 +819,23 @@ const uint32_t ulUnexpectedValue = 0xff;
 
 			ulTimerNotificationsSent++;
 		}
+		#if( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+			else if( xCallCount == ( xCallInterval / 2 ) )
+			{
+				/* Half way between the notifications to index 0, give to
+				notifyLAST_INDEX instead - alternating between the two APIs. */
+				if( ( ulIndexedNotificationsSent & 1UL ) == 0UL )
+				{
+					vTaskNotifyGiveIndexedFromISR( xTaskToNotify, notifyLAST_INDEX, NULL );
+				}
+				else
+				{
+					xTaskNotifyIndexedFromISR( xTaskToNotify, notifyLAST_INDEX, 0, eIncrement, NULL );
+				}
+
+				ulIndexedNotificationsSent++;
+			}
+		#endif /* configTASK_NOTIFICATION_ARRAY_ENTRIES */
 	}
 }
 /*-----------------------------------------------------------*/
@@ -668,6 +868,20 @@ const uint32_t ulMaxSendReceiveDeviation = 5UL;
 		}
 	}
 
+	/* Likewise the notifications given to notifyLAST_INDEX by the interrupt,
+	which must never be taken from index 0. */
+	if( ulIndexedNotificationsSent > ulIndexedNotificationsReceived )
+	{
+		if( ( ulIndexedNotificationsSent - ulIndexedNotificationsReceived ) > ulMaxSendReceiveDeviation )
+		{
+			xErrorStatus = pdFAIL;
+		}
+	}
+	else if( ulIndexedNotificationsReceived > ulIndexedNotificationsSent )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
 	return xErrorStatus;
 }
 /*-----------------------------------------------------------*/
@@ -50,6 +50,10 @@
 #define tmrdemoONE_SHOT_TIMER_PERIOD	( xBasePeriod * ( TickType_t ) 3 )
 #define trmdemoNUM_TIMER_RESETS			( ( uint8_t ) 10 )
 
+/* The period of every timer created by xRunTimerScalingTest(), which are all
+started together so they all expire on the same ticks. */
+#define tmrdemoSCALING_PERIOD			( ( TickType_t ) 10 )
+
 /*-----------------------------------------------------------*/
 
 /* The callback functions used by the timers.  These each increment a counter
@@ -65,6 +69,13 @@ static void prvTimerTestTask( void *pvParameters );
 static void prvISRAutoReloadTimerCallback( TimerHandle_t pxExpiredTimer );
 static void prvISROneShotTimerCallback( TimerHandle_t pxExpiredTimer );
 
+/*
+ * The callback used by every timer created by xRunTimerScalingTest().  It
+ * counts the expiries of each timer and the most ticks any callback ran late,
+ * and restarts the one-shot timers.
+ */
+static void prvScalingTimerCallback( TimerHandle_t pxExpiredTimer );
+
 /* The test functions used by the timer test task.  These manipulate the auto
 reload and one shot timers in various ways, then delay, then inspect the timers
 to ensure they have behaved as expected. */
@@ -114,6 +125,13 @@ static uint8_t ucISROneShotTimerCounter = ( uint8_t ) 0;
 period is configured by the parameter to vStartTimerDemoTask(). */
 static TickType_t xBasePeriod = 0;
 
+/* The expiries of each timer created by xRunTimerScalingTest(), and the totals
+it reports.  Only the timer service task writes them while the test runs. */
+static uint32_t *pulScalingTimerExpiries = NULL;
+static uint32_t ulScalingCallbacks = 0, ulScalingRestartsFailed = 0;
+static TickType_t xScalingMaxLateness = 0;
+static volatile BaseType_t xScalingTestRunning = pdFALSE;
+
 /*-----------------------------------------------------------*/
 
 void vStartTimerDemoTask( TickType_t xBasePeriodIn )
@@ -997,6 +1015,102 @@ static TickType_t uxTick = ( TickType_t ) -1;
 }
 /*-----------------------------------------------------------*/
 
+/*
+ * Creates uxNumberOfTimers timers with the same period and starts them together,
+ * so they all expire on the same ticks, and leaves them to run for xRunTime
+ * ticks.  The even numbered timers are auto-reload timers.  The odd numbered
+ * timers are one-shot timers that restart themselves from their callback, which
+ * means the timer service task sends commands to itself - as many at once as
+ * there are one-shot timers.  Returns pdFAIL if an auto-reload timer missed an
+ * expiry, or the timers could not be created.  Must be called from a task with
+ * a priority below configTIMER_TASK_PRIORITY, and not while the other tests in
+ * this file run.
+ */
+BaseType_t xRunTimerScalingTest( UBaseType_t uxNumberOfTimers, TickType_t xRunTime, uint32_t *pulCallbacks, uint32_t *pulRestartsFailed, TickType_t *pxMaxLateness )
+{
+TimerHandle_t *pxTimers;
+UBaseType_t ux, uxCreated = 0;
+uint32_t ulExpectedExpiries;
+BaseType_t xStatus = pdPASS;
+
+	pxTimers = ( TimerHandle_t * ) pvPortMalloc( uxNumberOfTimers * sizeof( TimerHandle_t ) );
+	pulScalingTimerExpiries = ( uint32_t * ) pvPortMalloc( uxNumberOfTimers * sizeof( uint32_t ) );
+
+	if( ( pxTimers != NULL ) && ( pulScalingTimerExpiries != NULL ) )
+	{
+		memset( pulScalingTimerExpiries, 0x00, uxNumberOfTimers * sizeof( uint32_t ) );
+		ulScalingCallbacks = 0;
+		ulScalingRestartsFailed = 0;
+		xScalingMaxLateness = 0;
+
+		/* The timer ID is the index of the timer's expiry count. */
+		for( uxCreated = 0; uxCreated < uxNumberOfTimers; uxCreated++ )
+		{
+			pxTimers[ uxCreated ] = xTimerCreate( "Scaling", tmrdemoSCALING_PERIOD, ( ( uxCreated & 1U ) == 0U ) ? pdTRUE : pdFALSE, ( void * ) uxCreated, prvScalingTimerCallback );
+
+			if( pxTimers[ uxCreated ] == NULL )
+			{
+				xStatus = pdFAIL;
+				break;
+			}
+		}
+	}
+	else
+	{
+		xStatus = pdFAIL;
+	}
+
+	if( xStatus == pdPASS )
+	{
+		xScalingTestRunning = pdTRUE;
+
+		/* Start at the beginning of a tick, so the timer service task, which
+		has the higher priority, can process all the start commands before the
+		tick count changes. */
+		vTaskDelay( 1 );
+
+		for( ux = 0; ux < uxNumberOfTimers; ux++ )
+		{
+			xTimerStart( pxTimers[ ux ], portMAX_DELAY );
+		}
+
+		vTaskDelay( xRunTime );
+		xScalingTestRunning = pdFALSE;
+
+		/* Every auto-reload timer should have expired once per period.  The
+		test finishes one tick or so after the last timer was started, so one
+		more expiry is allowed. */
+		ulExpectedExpiries = ( uint32_t ) ( xRunTime / tmrdemoSCALING_PERIOD );
+
+		for( ux = 0; ux < uxNumberOfTimers; ux += 2U )
+		{
+			if( ( pulScalingTimerExpiries[ ux ] < ulExpectedExpiries ) || ( pulScalingTimerExpiries[ ux ] > ( ulExpectedExpiries + 1UL ) ) )
+			{
+				xStatus = pdFAIL;
+			}
+		}
+
+		*pulCallbacks = ulScalingCallbacks;
+		*pulRestartsFailed = ulScalingRestartsFailed;
+		*pxMaxLateness = xScalingMaxLateness;
+	}
+
+	for( ux = 0; ux < uxCreated; ux++ )
+	{
+		xTimerDelete( pxTimers[ ux ], portMAX_DELAY );
+	}
+
+	/* Let the timer service task delete the timers before their expiry counts
+	are freed. */
+	vTaskDelay( 1 );
+	vPortFree( pxTimers );
+	vPortFree( pulScalingTimerExpiries );
+	pulScalingTimerExpiries = NULL;
+
+	return xStatus;
+}
+/*-----------------------------------------------------------*/
+
 /*** Timer callback functions are defined below here. ***/
 
 static void prvAutoReloadTimerCallback( TimerHandle_t pxExpiredTimer )
@@ -1060,6 +1174,45 @@ static void prvISROneShotTimerCallback( TimerHandle_t pxExpiredTimer )
 }
 /*-----------------------------------------------------------*/
 
+static void prvScalingTimerCallback( TimerHandle_t pxExpiredTimer )
+{
+size_t uxTimerID;
+TickType_t xLateness;
+
+	if( xScalingTestRunning != pdFALSE )
+	{
+		uxTimerID = ( size_t ) pvTimerGetTimerID( pxExpiredTimer );
+		( pulScalingTimerExpiries[ uxTimerID ] )++;
+		ulScalingCallbacks++;
+
+		/* An auto-reload timer has already been given its next expiry time
+		when its callback is called. */
+		xLateness = xTaskGetTickCount() - xTimerGetExpiryTime( pxExpiredTimer );
+
+		if( ( uxTimerID & 1U ) == 0U )
+		{
+			xLateness += xTimerGetPeriod( pxExpiredTimer );
+		}
+		else
+		{
+			/* Restart the one-shot timer.  Unless configUSE_TIMER_DIRECT_COMMANDS
+			is 1 the command is posted to the timer queue, which is full once
+			more than configTIMER_QUEUE_LENGTH one-shot timers expire
+			together. */
+			if( xTimerReset( pxExpiredTimer, tmrdemoDONT_BLOCK ) != pdPASS )
+			{
+				ulScalingRestartsFailed++;
+			}
+		}
+
+		if( xLateness > xScalingMaxLateness )
+		{
+			xScalingMaxLateness = xLateness;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
 
 
 
@@ -197,6 +197,23 @@ static UBaseType_t uxTasksRunningNow;
 		/* Everything is okay. */
 	}
 
+	#if( ( configTASK_CLEANUP_THRESHOLD > 0 ) && ( configNUMBER_OF_CORES == 1 ) )
+	{
+	TaskCleanupStats_t xCleanupStats;
+
+		/* vTaskDelete() frees the tasks waiting to be cleaned up before it
+		adds a task deleting itself to them, if there are already
+		configTASK_CLEANUP_THRESHOLD, so however little the idle task runs no
+		more than that many can ever be waiting. */
+		vTaskGetCleanupStats( &xCleanupStats );
+
+		if( xCleanupStats.uxMostWaiting > ( UBaseType_t ) configTASK_CLEANUP_THRESHOLD )
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	#endif /* configTASK_CLEANUP_THRESHOLD */
+
 	return xReturn;
 }
 
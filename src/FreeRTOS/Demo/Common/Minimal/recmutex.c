@@ -97,6 +97,13 @@ static SemaphoreHandle_t xMutex;
 static volatile BaseType_t xErrorOccurred = pdFALSE, xControllingIsSuspended = pdFALSE, xBlockingIsSuspended = pdFALSE;
 static volatile UBaseType_t uxControllingCycles = 0, uxBlockingCycles = 0, uxPollingCycles = 0;
 
+/* The time the controlling task waited for the mutex when it first took it on
+each cycle - on all but the first cycle the polling task holds the mutex at
+that point, at the inherited priority of the controlling task.  The longest and
+the total, and the number of times it was measured. */
+static TickType_t xLongestInversion = 0, xTotalInversion = 0;
+static uint32_t ulInversionsMeasured = 0;
+
 /* Handles of the two higher priority tasks, required so they can be resumed
 (unsuspended). */
 static TaskHandle_t xControllingTaskHandle, xBlockingTaskHandle;
@@ -129,6 +136,7 @@ void vStartRecursiveMutexTasks( void )
 static void prvRecursiveMutexControllingTask( void *pvParameters )
 {
 UBaseType_t ux;
+TickType_t xStartTime, xInversion;
 
 	/* Just to remove compiler warning. */
 	( void ) pvParameters;
@@ -156,11 +164,27 @@ UBaseType_t ux;
 			long enough to ensure the polling task will execute again before the
 			block time expires.  If the block time does expire then the error
 			flag will be set here. */
+			xStartTime = xTaskGetTickCount();
 			if( xSemaphoreTakeRecursive( xMutex, recmu15ms_DELAY ) != pdPASS )
 			{
 				xErrorOccurred = pdTRUE;
 			}
 
+			/* Only the first take can have to wait - the others are
+			recursive. */
+			if( ux == 0 )
+			{
+				xInversion = xTaskGetTickCount() - xStartTime;
+
+				if( xInversion > xLongestInversion )
+				{
+					xLongestInversion = xInversion;
+				}
+
+				xTotalInversion += xInversion;
+				ulInversionsMeasured++;
+			}
+
 			/* Ensure the other task attempting to access the mutex (and the
 			other demo tasks) are able to execute to ensure they either block
 			(where a block time is specified) or return an error (where no
@@ -359,6 +383,14 @@ static void prvRecursiveMutexPollingTask( void *pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+void vGetRecursiveMutexInversionTimes( TickType_t *pxLongest, TickType_t *pxTotal, uint32_t *pulMeasured )
+{
+	*pxLongest = xLongestInversion;
+	*pxTotal = xTotalInversion;
+	*pulMeasured = ulInversionsMeasured;
+}
+/*-----------------------------------------------------------*/
+
 /* This is called to check that all the created tasks are still running. */
 BaseType_t xAreRecursiveMutexTasksStillRunning( void )
 {
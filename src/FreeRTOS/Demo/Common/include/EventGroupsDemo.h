@@ -40,5 +40,15 @@ void vStartEventGroupTasks( void );
 BaseType_t xAreEventGroupTasksStillRunning( void );
 void vPeriodicEventGroupsProcessing( void );
 
+/*
+ * Time setting a bit with xEventGroupSetBitsFromISR() until the task waiting
+ * for it runs, and a rendezvous of uxNumberOfTasks tasks and the calling task
+ * with xEventGroupSync(), ulIterations times each, using the run time stats
+ * counter.  The uxNumberOfTasks rendezvous tasks are blocked waiting for the
+ * calling task while the latency is measured.  Returns pdFAIL if a set did not
+ * unblock the waiting task or a rendezvous did not complete.
+ */
+BaseType_t xRunEventGroupLatencyTest( UBaseType_t uxNumberOfTasks, uint32_t ulIterations, configRUN_TIME_COUNTER_TYPE *pulSetToRunTime, configRUN_TIME_COUNTER_TYPE *pulRendezvousTime );
+
 #endif /* EVENT_GROUPS_DEMO_H */
 
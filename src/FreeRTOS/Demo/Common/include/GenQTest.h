@@ -32,6 +32,11 @@ void vStartGenericQueueTasks( UBaseType_t uxPriority );
 BaseType_t xAreGenericQueueTasksStillRunning( void );
 void vMutexISRInteractionTest( void );
 
+/* The longest and total time the high priority task was kept waiting by the
+priority inheritance chain test, and the number of times it was measured.  The
+test is only included when configUSE_PRIORITY_INHERITANCE_CHAINS is 1. */
+void vGetGenericQueueInversionTimes( TickType_t *pxLongest, TickType_t *pxTotal, uint32_t *pulMeasured );
+
 #endif /* GEN_Q_TEST_H */
 
 
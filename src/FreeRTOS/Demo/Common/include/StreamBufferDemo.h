@@ -31,6 +31,8 @@
 void vStartStreamBufferTasks( void );
 BaseType_t xAreStreamBufferTasksStillRunning( void );
 void vPeriodicStreamBufferProcessing( void );
+void vStartStreamBufferThroughputTasks( UBaseType_t uxPriority );
+uint32_t ulGetStreamBufferThroughput( BaseType_t xLockFree );
 
 #endif /* STREAM_BUFFER_TEST_H */
 
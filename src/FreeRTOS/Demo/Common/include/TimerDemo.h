@@ -31,6 +31,7 @@
 void vStartTimerDemoTask( TickType_t xBaseFrequencyIn );
 BaseType_t xAreTimerDemoTasksStillRunning( TickType_t xCycleFrequency );
 void vTimerPeriodicISRTests( void );
+BaseType_t xRunTimerScalingTest( UBaseType_t uxNumberOfTimers, TickType_t xRunTime, uint32_t *pulCallbacks, uint32_t *pulRestartsFailed, TickType_t *pxMaxLateness );
 
 #endif /* TIMER_DEMO_H */
 
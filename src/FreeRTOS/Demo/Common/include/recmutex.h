@@ -31,5 +31,9 @@
 void vStartRecursiveMutexTasks( void );
 BaseType_t xAreRecursiveMutexTasksStillRunning( void );
 
+/* The longest and total time the controlling task waited for the mutex held
+by the polling task, and the number of times it was measured. */
+void vGetRecursiveMutexInversionTimes( TickType_t *pxLongest, TickType_t *pxTotal, uint32_t *pulMeasured );
+
 #endif
 
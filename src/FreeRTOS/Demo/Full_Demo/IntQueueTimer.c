@@ -18,8 +18,21 @@
 #define tmrTPU4_FREQUENCY	( 2000UL )
 #define tmrTPU5_FREQUENCY	( 2001UL )
 
+/* The vectors the two timer interrupts are recorded against when
+configGENERATE_ISR_LATENCY_STATS is 1.  TPU4 runs at a higher priority than
+TPU5, so can nest within it. */
+#define tmrTPU4_LATENCY_VECTOR	( tskISR_LATENCY_FIRST_APPLICATION_VECTOR )
+#define tmrTPU5_LATENCY_VECTOR	( tskISR_LATENCY_FIRST_APPLICATION_VECTOR + 1U )
+
 void vInitialiseTimerForIntQueueTest( void )
 {
+	#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+	{
+		vTaskSetISRLatencyName( tmrTPU4_LATENCY_VECTOR, "TPU4" );
+		vTaskSetISRLatencyName( tmrTPU5_LATENCY_VECTOR, "TPU5" );
+	}
+	#endif
+
 	/* Ensure interrupts do not start until full configuration is complete. */
 	portENTER_CRITICAL();
 	{
@@ -101,7 +114,15 @@ void vInitialiseTimerForIntQueueTest( void )
 #endif
 static void r_Config_TPU4_tgi4a_interrupt(void)
 {
-	portYIELD_FROM_ISR( xFirstTimerHandler() );
+BaseType_t xHigherPriorityTaskWoken;
+
+	taskCPU_LOAD_ENTER_ISR();
+	taskISR_LATENCY_ENTER( tmrTPU4_LATENCY_VECTOR );
+	xHigherPriorityTaskWoken = xFirstTimerHandler();
+	taskISR_LATENCY_EXIT();
+	taskCPU_LOAD_EXIT_ISR();
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 /*-----------------------------------------------------------*/
 
@@ -113,6 +134,14 @@ static void r_Config_TPU4_tgi4a_interrupt(void)
 #endif
 static void r_Config_TPU5_tgi5a_interrupt(void)
 {
-	portYIELD_FROM_ISR( xSecondTimerHandler() );
+BaseType_t xHigherPriorityTaskWoken;
+
+	taskCPU_LOAD_ENTER_ISR();
+	taskISR_LATENCY_ENTER( tmrTPU5_LATENCY_VECTOR );
+	xHigherPriorityTaskWoken = xSecondTimerHandler();
+	taskISR_LATENCY_EXIT();
+	taskCPU_LOAD_EXIT_ISR();
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 /*-----------------------------------------------------------*/
@@ -63,6 +63,15 @@
  * toggles every three seconds, then no issues have been discovered.  If the LED
  * toggles every 200ms, then an issue has been discovered with at least one
  * task.
+ *
+ * The tasks above, and the other tasks defined in this file, are listed in the
+ * table mainSTATIC_TASKS.  When configSUPPORT_STATIC_ALLOCATION is 1 the table
+ * lays out their stacks and TCBs at compile time and is created in one call to
+ * xTaskCreateStaticSet(), and also holds the "Static timer" test - an auto
+ * reload timer, started by the table rather than by xTimerStart(), that posts
+ * to a queue that is also created from the table.  The check task reports an
+ * error if nothing has been posted since it last ran.  Otherwise each task in
+ * the table is created with xTaskCreate().
  */
 
 /* Standard includes. */
@@ -105,6 +114,9 @@
 #include "QPeek.h"
 #include "QueueSet.h"
 #include "QueueSetPolling.h"
+#include "QueueBatch.h"
+#include "DeferredWork.h"
+#include "DelayOrder.h"
 #include "integer.h"
 
 /* Priorities for the demo application tasks. */
@@ -144,6 +156,32 @@ purpose of ensuring parameters are passed into tasks correctly. */
 #define mainREG_TEST_TASK_1_PARAMETER		( ( void * ) 0x12345678 )
 #define mainREG_TEST_TASK_2_PARAMETER		( ( void * ) 0x87654321 )
 
+/* The period of the "Static timer" test timer. */
+#define mainSTATIC_TIMER_PERIOD				pdMS_TO_TICKS( 100UL )
+
+/* The tasks created by this file.  Each entry is the name, function, stack
+depth, parameter and priority of a task.  With static allocation it is expanded
+once to declare the stack and TCB of the task, and once to build its entry in
+xStaticTasks[].  Without, it is expanded to a call to xTaskCreate(). */
+#define mainSTATIC_TASKS( X )																										\
+	X( QSpace,		prvDemoQueueSpaceFunctions,				configMINIMAL_STACK_SIZE,	NULL,							tskIDLE_PRIORITY )			\
+	X( BlockSem,	prvPermanentlyBlockingSemaphoreTask,	configMINIMAL_STACK_SIZE,	NULL,							tskIDLE_PRIORITY )			\
+	X( BlockNoti,	prvPermanentlyBlockingNotificationTask,	configMINIMAL_STACK_SIZE,	NULL,							tskIDLE_PRIORITY )			\
+	X( Reg1,		prvRegTestTaskEntry1,					configMINIMAL_STACK_SIZE,	mainREG_TEST_TASK_1_PARAMETER,	tskIDLE_PRIORITY )			\
+	X( Reg2,		prvRegTestTaskEntry2,					configMINIMAL_STACK_SIZE,	mainREG_TEST_TASK_2_PARAMETER,	tskIDLE_PRIORITY )			\
+	X( Rnd,			prvPseudoRandomiser,					configMINIMAL_STACK_SIZE,	NULL,							configMAX_PRIORITIES - 1 )	\
+	X( Check,		prvCheckTask,							configMINIMAL_STACK_SIZE,	NULL,							mainCHECK_TASK_PRIORITY )
+
+#define mainDECLARE_TASK_MEMORY( xName, pxCode, usDepth, pvParameter, uxPriority )		\
+	static StackType_t uxStack##xName[ usDepth ];										\
+	static StaticTask_t xTCB##xName;
+
+#define mainTASK_DEFINITION( xName, pxCode, usDepth, pvParameter, uxPriority )			\
+	{ pxCode, #xName, usDepth, pvParameter, uxPriority, uxStack##xName, &xTCB##xName, NULL },
+
+#define mainCREATE_TASK( xName, pxCode, usDepth, pvParameter, uxPriority )				\
+	xTaskCreate( pxCode, #xName, usDepth, pvParameter, uxPriority, NULL );
+
 /* The base period used by the timer test tasks. */
 #define mainTIMER_TEST_PERIOD				( 50 )
 
@@ -190,6 +228,13 @@ static void prvDemoQueueSpaceFunctions( void *pvParameters );
 static void prvPermanentlyBlockingSemaphoreTask( void *pvParameters );
 static void prvPermanentlyBlockingNotificationTask( void *pvParameters );
 
+/*
+ * The callback of the "Static timer" test timer.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	static void prvStaticTimerCallback( TimerHandle_t xTimer );
+#endif
+
 
 /*-----------------------------------------------------------*/
 
@@ -203,8 +248,42 @@ volatile uint32_t ulRegTest1LoopCounter = 0UL, ulRegTest2LoopCounter = 0UL;
 semaphore tracing API functions.  It has no other purpose. */
 static SemaphoreHandle_t xMutexToDelete = NULL;
 
-/* The variable into which error messages are latched. */
-static char *pcStatusMessage = "All tasks running without error";
+/* The variable into which error messages are latched, and the first error
+latched.  Once an error is latched the check task runs more often, which some
+of the tests cannot keep up with, so later errors can be a consequence of the
+first.  Not static so a simulator can report which test failed. */
+char *pcStatusMessage = "All tasks running without error";
+char *pcFirstErrorMessage = NULL;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* The memory of the tasks in mainSTATIC_TASKS, and of the "Static timer"
+	test. */
+	mainSTATIC_TASKS( mainDECLARE_TASK_MEMORY )
+	static StaticQueue_t xStaticTimerQueueBuffer;
+	static uint8_t ucStaticTimerQueueStorage[ sizeof( TickType_t ) ];
+	static StaticTimer_t xStaticTimerBuffer;
+
+	/* The queue the "Static timer" test timer posts to. */
+	static QueueHandle_t xStaticTimerQueue = NULL;
+
+	/* The static object table. */
+	static const StaticTaskDefinition_t xStaticTasks[] =
+	{
+		mainSTATIC_TASKS( mainTASK_DEFINITION )
+	};
+
+	static const StaticQueueDefinition_t xStaticQueues[] =
+	{
+		{ 1, sizeof( TickType_t ), ucStaticTimerQueueStorage, &xStaticTimerQueueBuffer, &xStaticTimerQueue }
+	};
+
+	static const StaticTimerDefinition_t xStaticTimers[] =
+	{
+		{ "StaticTmr", mainSTATIC_TIMER_PERIOD, pdTRUE, NULL, prvStaticTimerCallback, &xStaticTimerBuffer, pdTRUE, NULL }
+	};
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 /*-----------------------------------------------------------*/
 
@@ -231,6 +310,13 @@ void main_full( void )
 	vCreateBlockTimeTasks();
 	vStartCountingSemaphoreTasks();
 	vStartGenericQueueTasks( tskIDLE_PRIORITY );
+#if( configUSE_QUEUE_BATCH == 1 )
+	vStartQueueBatchTasks();
+#endif
+#if( configUSE_DEFERRED_WORK == 1 )
+	vStartDeferredWorkTasks();
+#endif
+	vStartDelayOrderTasks();
 	vStartRecursiveMutexTasks();
 	vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
 
@@ -247,20 +333,23 @@ void main_full( void )
 	vStartEventGroupTasks();
 	vStartLEDFlashTasks( mainFLASH_PRIORITY );
 
-	xTaskCreate( prvDemoQueueSpaceFunctions, "QSpace", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
-	xTaskCreate( prvPermanentlyBlockingSemaphoreTask, "BlockSem", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
-	xTaskCreate( prvPermanentlyBlockingNotificationTask, "BlockNoti", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
-
-	/* Create the register check tasks, as described at the top of this	file */
-	xTaskCreate( prvRegTestTaskEntry1, "Reg1", configMINIMAL_STACK_SIZE, mainREG_TEST_TASK_1_PARAMETER, tskIDLE_PRIORITY, NULL );
-	xTaskCreate( prvRegTestTaskEntry2, "Reg2", configMINIMAL_STACK_SIZE, mainREG_TEST_TASK_2_PARAMETER, tskIDLE_PRIORITY, NULL );
-
-	/* Create the task that just adds a little random behaviour. */
-	xTaskCreate( prvPseudoRandomiser, "Rnd", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
-
-	/* Create the task that performs the 'check' functionality,	as described at
-	the top of this file. */
-	xTaskCreate( prvCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY, NULL );
+	/* Create the tasks defined in this file, as described at the top of this
+	file. */
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		/* None of the objects of the static object table use the heap. */
+		if( ( xQueueCreateStaticSet( xStaticQueues, sizeof( xStaticQueues ) / sizeof( xStaticQueues[ 0 ] ) ) != pdPASS ) ||
+			( xTimerCreateStaticSet( xStaticTimers, sizeof( xStaticTimers ) / sizeof( xStaticTimers[ 0 ] ) ) != pdPASS ) ||
+			( xTaskCreateStaticSet( xStaticTasks, sizeof( xStaticTasks ) / sizeof( xStaticTasks[ 0 ] ) ) != pdPASS ) )
+		{
+			pcStatusMessage = "Error: Static object table";
+		}
+	}
+	#else
+	{
+		mainSTATIC_TASKS( mainCREATE_TASK )
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 	/* The set of tasks created by the following function call have to be
 	created last as they keep account of the number of tasks they expect to see
@@ -340,6 +429,25 @@ static uint32_t ulLastRegTest1Value = 0, ulLastRegTest2Value = 0;
 			pcStatusMessage = "Error: GenQueue";
 		}
 
+#if( configUSE_QUEUE_BATCH == 1 )
+		if( xAreQueueBatchTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Queue batch";
+		}
+#endif
+
+#if( configUSE_DEFERRED_WORK == 1 )
+		if( xAreDeferredWorkTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Deferred work";
+		}
+#endif
+
+		if( xAreDelayOrderTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: Delay order";
+		}
+
 		if ( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
 		{
 			pcStatusMessage = "Error: RecMutex";
@@ -451,6 +559,19 @@ static uint32_t ulLastRegTest1Value = 0, ulLastRegTest2Value = 0;
 			pcStatusMessage = "Error: Message buffer AMP";
 		}
 
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		TickType_t xStaticTimerTime;
+
+			/* The static timer posts every mainSTATIC_TIMER_PERIOD, so has
+			posted since the check task last ran. */
+			if( xQueueReceive( xStaticTimerQueue, &xStaticTimerTime, mainDONT_BLOCK ) != pdPASS )
+			{
+				pcStatusMessage = "Error: Static timer";
+			}
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 
 		/* Toggle the check LED to give an indication of the system status.  If
 		the LED toggles every mainNO_ERROR_CHECK_TASK_PERIOD milliseconds then
@@ -464,11 +585,31 @@ static uint32_t ulLastRegTest1Value = 0, ulLastRegTest2Value = 0;
 			gone wrong (it might just be that the loop back connector required
 			by the comtest tasks has not been fitted). */
 			xDelayPeriod = mainERROR_CHECK_TASK_PERIOD;
+
+			if( pcFirstErrorMessage == NULL )
+			{
+				pcFirstErrorMessage = pcStatusMessage;
+			}
 		}
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	static void prvStaticTimerCallback( TimerHandle_t xTimer )
+	{
+	TickType_t xTimeNow = xTaskGetTickCount();
+
+		( void ) xTimer;
+
+		/* The check task only looks for the latest post. */
+		xQueueOverwrite( xStaticTimerQueue, &xTimeNow );
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 static void prvRegTestTaskEntry1( void *pvParameters )
 {
 	/* Although the regtest task is written in assembler, its entry point is
@@ -476,6 +617,10 @@ static void prvRegTestTaskEntry1( void *pvParameters )
 	in correctly. */
 	if( pvParameters == mainREG_TEST_TASK_1_PARAMETER )
 	{
+		/* The test uses the accumulators, so they must be saved and restored
+		with the rest of the task's context. */
+		portTASK_USES_ACCUMULATOR();
+
 		/* Start the part of the test that is written in assembler. */
 		vRegTest1Implementation();
 	}
@@ -494,6 +639,10 @@ static void prvRegTestTaskEntry2( void *pvParameters )
 	in correctly. */
 	if( pvParameters == mainREG_TEST_TASK_2_PARAMETER )
 	{
+		/* The test uses the accumulators, so they must be saved and restored
+		with the rest of the task's context. */
+		portTASK_USES_ACCUMULATOR();
+
 		/* Start the part of the test that is written in assembler. */
 		vRegTest2Implementation();
 	}
@@ -706,6 +855,20 @@ TaskHandle_t xTimerTask;
 	vQueueSetAccessQueueSetFromISR();
 	vQueueSetPollingInterruptAccess();
 
+	/* Exercise sending and receiving bursts of queue items from an ISR. */
+	#if( configUSE_QUEUE_BATCH == 1 )
+	{
+		vQueueBatchPeriodicISRTest();
+	}
+	#endif
+
+	/* Exercise posting deferred work from an ISR. */
+	#if( configUSE_DEFERRED_WORK == 1 )
+	{
+		vDeferredWorkPeriodicISRTest();
+	}
+	#endif
+
 	/* Exercise event groups from interrupts. */
 	vPeriodicEventGroupsProcessing();
 
@@ -0,0 +1,257 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions for the Posix simulator build.
+ *
+ * These definitions mirror ../../FreeRTOSConfig.h, which is used for the
+ * RX65N target, so kernel behaviour measured in the simulator matches the
+ * board as closely as possible.  Only the settings that are meaningless on a
+ * host (clocks, interrupt priorities and vectors) differ.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION					1
+#define configUSE_IDLE_HOOK						1
+#define configUSE_TICK_HOOK						1
+#define configUSE_TASK_NOTIFICATIONS			1
+#define configSUPPORT_DYNAMIC_ALLOCATION		1
+#define configSUPPORT_STATIC_ALLOCATION			1
+#define configTICK_RATE_HZ						( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE				( ( unsigned short ) 120 )
+#define configTOTAL_HEAP_SIZE					( ( size_t ) ( 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN					( 12 )
+#define configUSE_TRACE_FACILITY				1
+#define configUSE_16_BIT_TICKS					0
+#define configIDLE_SHOULD_YIELD					1
+#define configUSE_CO_ROUTINES 					0
+#define configUSE_MUTEXES						1
+#define configGENERATE_RUN_TIME_STATS			1
+#define configCHECK_FOR_STACK_OVERFLOW			2
+#define configUSE_RECURSIVE_MUTEXES				1
+#define configQUEUE_REGISTRY_SIZE				20
+#define configUSE_MALLOC_FAILED_HOOK			1
+#define configUSE_APPLICATION_TASK_TAG			0
+#define configUSE_QUEUE_SETS					1
+#define configUSE_COUNTING_SEMAPHORES			1
+#define configMAX_CO_ROUTINE_PRIORITIES 		( 2 )
+#define configUSE_STATS_FORMATTING_FUNCTIONS	1
+#define configUSE_QUEUE_BATCH					1
+#define configUSE_STREAM_BUFFER_SCATTER_GATHER	1
+#define configHEAP_POOL_COUNT					4
+
+/* Start the tick count five seconds before it overflows, so each run of the
+full demo also covers the overflow, and DelayOrder.c can check the delayed task
+lists across it. */
+#define configINITIAL_TICK_COUNT				( ( TickType_t ) 0U - pdMS_TO_TICKS( 5000UL ) )
+
+/* Kernel options that are compared using main_bench.c or heap_bench.c can be
+set from the make command line, so are only defaulted here. */
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES				( 32 )
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+#endif
+
+#ifndef configUSE_INDEXED_DELAY_LISTS
+	#define configUSE_INDEXED_DELAY_LISTS		1
+#endif
+
+#ifndef configUSE_TIME_SLICE_QUANTA
+	#define configUSE_TIME_SLICE_QUANTA			1
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE				0
+#endif
+
+#ifndef configUSE_HEAP_POOLS
+	#define configUSE_HEAP_POOLS				1
+#endif
+
+#ifndef configUSE_HEAP_ACCOUNTING
+	#define configUSE_HEAP_ACCOUNTING			1
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER			1
+#endif
+
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	#define configUSE_TIMER_DIRECT_COMMANDS		1
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL				0
+#endif
+
+#ifndef configUSE_DEFERRED_WORK
+	#define configUSE_DEFERRED_WORK				1
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+	#define configUSE_EVENT_GROUP_DIRECT_ISR	1
+#endif
+
+#ifndef configUSE_EVENT_GROUP_BIT_INDEX
+	#define configUSE_EVENT_GROUP_BIT_INDEX		1
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES	3
+#endif
+
+#ifndef configTASK_CLEANUP_THRESHOLD
+	#define configTASK_CLEANUP_THRESHOLD		1
+#endif
+
+#ifndef configUSE_PRIORITY_INHERITANCE_CHAINS
+	#define configUSE_PRIORITY_INHERITANCE_CHAINS	1
+#endif
+
+/* More than one core needs configUSE_PORT_OPTIMISED_TASK_SELECTION,
+configUSE_TRACE_RECORDER, configGENERATE_CPU_LOAD_STATS and
+configGENERATE_ISR_LATENCY_STATS to be set to 0, see make smp. */
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES				1
+#endif
+
+/* The passive idle tasks that run on the other cores wait for an interrupt,
+rather than spin, so the simulated cores do not compete for the host processor
+when they have nothing to do. */
+#define configUSE_PASSIVE_IDLE_HOOK				1
+
+/* Message lengths are stored using size_t by default, which is four bytes on
+the RX but eight on a 64-bit host.  Keep the RX size so the message buffer demos,
+which assume four byte lengths, behave identically. */
+#define configMESSAGE_BUFFER_LENGTH_TYPE		uint32_t
+
+/* The heap pool sizes suit the same objects as on the RX, which are about twice
+the size with 64-bit pointers and stack entries.  A pool block also holds the
+40 byte heap accounting record when configUSE_HEAP_ACCOUNTING is 1. */
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+	#define configHEAP_POOL_BLOCK_SIZES			{ 104, 168, 232, 1000 }
+#else
+	#define configHEAP_POOL_BLOCK_SIZES			{ 64, 128, 192, 960 }
+#endif
+#define configHEAP_POOL_BLOCK_COUNTS			{ 32, 32, 96, 96 }
+
+/* Record the code that called pvPortMalloc() with each heap block. */
+#define configHEAP_CALL_SITE()					__builtin_return_address( 0 )
+
+/* The run time stats and CPU load are measured in host time stamp counter
+cycles, which need 64 bits.  The counter is always running. */
+#define configRUN_TIME_COUNTER_TYPE				uint64_t
+#ifndef configGENERATE_CPU_LOAD_STATS
+	#define configGENERATE_CPU_LOAD_STATS		1
+#endif
+
+/* The interrupt latency histograms are in host cycles too, so need more
+buckets than on the RX to cover the host's scheduling delays. */
+#ifndef configGENERATE_ISR_LATENCY_STATS
+	#define configGENERATE_ISR_LATENCY_STATS	1
+#endif
+#define configISR_LATENCY_BUCKETS				32
+
+/* The task stacks are not used by the simulator, other than to hold the host
+thread structure at the top, so main.c writes to the stack of a test task to
+check the watermark scanner finds it. */
+#define configUSE_STACK_WATERMARK_SCANNER		1
+#define configSTACK_WATERMARK_SCAN_WORDS		16
+#define configSTACK_WATERMARK_WARNING_PERCENT	90
+
+/* The same time slices as the RX65N build.  main_bench.c changes the time slice
+of its own priority to measure the switches saved. */
+#define configTIME_SLICE_TICKS( uxPriority )	( ( ( uxPriority ) == tskIDLE_PRIORITY ) ? pdMS_TO_TICKS( 10 ) : ( TickType_t ) 1 )
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()		ullPortGetHostCycles()
+
+/* The trace recorder is built in, but records nothing until main.c starts it
+(posix_demo trace).  Records are time stamped with the host monotonic clock in
+nanoseconds, truncated to 32 bits, which trace_decode.c extends again.  The full
+demo names more tasks, queues and timers than the default name table holds. */
+uint32_t ulSimulatorGetTraceTimestamp( void );
+#define configTRACE_RECORDER_TIMESTAMP()		ulSimulatorGetTraceTimestamp()
+#define configTRACE_RECORDER_TIMESTAMP_HZ		( 1000000000UL )
+#define configTRACE_RECORDER_BUFFER_RECORDS		( 8192 )
+#define configTRACE_RECORDER_NAMES				( 128 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS						1
+#define configTIMER_TASK_PRIORITY				( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH				5
+#define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE )
+
+/* Deferred work definitions.  configDEFERRED_WORK_TASK_PRIORITY is left at its
+default, one below the timer task. */
+#define configDEFERRED_WORK_QUEUE_LENGTH		32
+#define configDEFERRED_WORK_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet				1
+#define INCLUDE_uxTaskPriorityGet				1
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskCleanUpResources			0
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+#define INCLUDE_uxTaskGetStackHighWaterMark		1
+#define INCLUDE_xTaskGetSchedulerState			1
+#define INCLUDE_eTaskGetState					1
+#define INCLUDE_xTimerPendFunctionCall			1
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) { vAssertCalled( __FILE__, __LINE__ ); }
+
+/* Override some of the priorities set in the common demo tasks.  This is
+required to ensure flase positive timing errors are not reported. */
+#define bktPRIMARY_PRIORITY						( configMAX_PRIORITIES - 3 )
+#define bktSECONDARY_PRIORITY					( configMAX_PRIORITIES - 4 )
+#define intqHIGHER_PRIORITY						( configMAX_PRIORITIES - 3 )
+
+/* The stream buffer demo expects a task blocked on a stream buffer to run
+before the next tick interrupt sends it another byte.  The simulated tick is a
+host signal, so cannot guarantee that on a loaded host. */
+#define configSTREAM_BUFFER_TRIGGER_LEVEL_TEST_MARGIN	2
+
+/* main_full.c is shared with the RX65N build unmodified, and uses the CC-RX
+nop() intrinsic directly. */
+#define nop()									portNOP()
+
+/* Set mainCREATE_SIMPLE_BLINKY_DEMO_ONLY to one to run the simple blinky demo,
+or 0 to run the more comprehensive test and demo application. */
+#define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY		0
+
+#endif /* FREERTOS_CONFIG_H */
+
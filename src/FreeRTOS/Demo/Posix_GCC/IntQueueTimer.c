@@ -0,0 +1,95 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * This file contains the non-portable and therefore simulator specific parts
+ * of the IntQueue standard demo task.  The RX65N build drives the two queue
+ * access handlers from TPU4 and TPU5 at slightly different frequencies.  The
+ * simulator has a single simulated interrupt, so both handlers are called from
+ * the tick instead, with the second handler skipping every seventh tick so the
+ * two interrupt sources still drift relative to each other.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "IntQueueTimer.h"
+#include "IntQueue.h"
+
+#define tmrSECOND_HANDLER_SKIP_PERIOD	( 7UL )
+
+/* The vectors the two handlers are recorded against when
+configGENERATE_ISR_LATENCY_STATS is 1.  They run nested within the tick, so
+the time they take is left out of the tick's own histogram. */
+#define tmrFIRST_LATENCY_VECTOR			( tskISR_LATENCY_FIRST_APPLICATION_VECTOR )
+#define tmrSECOND_LATENCY_VECTOR		( tskISR_LATENCY_FIRST_APPLICATION_VECTOR + 1U )
+
+/* Set once the IntQueue tasks have started, before which the queues the
+handlers access do not exist. */
+static volatile BaseType_t xTimerRunning = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vInitialiseTimerForIntQueueTest( void )
+{
+	#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+	{
+		vTaskSetISRLatencyName( tmrFIRST_LATENCY_VECTOR, "IntQ1" );
+		vTaskSetISRLatencyName( tmrSECOND_LATENCY_VECTOR, "IntQ2" );
+	}
+	#endif
+
+	xTimerRunning = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vIntQueueTimerTickHook( void )
+{
+static unsigned long ulTicks = 0;
+BaseType_t xHigherPriorityTaskWoken;
+
+	if( xTimerRunning != pdFALSE )
+	{
+		taskISR_LATENCY_ENTER( tmrFIRST_LATENCY_VECTOR );
+		xHigherPriorityTaskWoken = xFirstTimerHandler();
+		taskISR_LATENCY_EXIT();
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+
+		ulTicks++;
+		if( ( ulTicks % tmrSECOND_HANDLER_SKIP_PERIOD ) != 0UL )
+		{
+			taskISR_LATENCY_ENTER( tmrSECOND_LATENCY_VECTOR );
+			xHigherPriorityTaskWoken = xSecondTimerHandler();
+			taskISR_LATENCY_EXIT();
+			portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,125 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Simulated LEDs for the Posix build.  Nothing is displayed - the state of
+ * each LED and the period at which it was last toggled are recorded so the
+ * simulator can inspect the status reported by the check task in main_full.c,
+ * which indicates errors by toggling its LED faster.
+ *-----------------------------------------------------------*/
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "partest.h"
+
+#define partestNUM_LEDS ( 2 )
+
+static BaseType_t xLEDState[ partestNUM_LEDS ] = { pdFALSE };
+static TickType_t xLastToggleTime[ partestNUM_LEDS ] = { 0 };
+static TickType_t xTogglePeriod[ partestNUM_LEDS ] = { 0 };
+
+long lParTestGetLEDState( unsigned long ulLED );
+TickType_t xParTestGetTogglePeriod( unsigned long ulLED );
+
+/*-----------------------------------------------------------*/
+
+void vParTestInitialise( void )
+{
+	/* Nothing to initialise in the simulator. */
+}
+/*-----------------------------------------------------------*/
+
+void vParTestSetLED( unsigned long ulLED, signed long xValue )
+{
+	if( ulLED < partestNUM_LEDS )
+	{
+		taskENTER_CRITICAL();
+		{
+			xLEDState[ ulLED ] = ( xValue != 0 ) ? pdTRUE : pdFALSE;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vParTestToggleLED( unsigned long ulLED )
+{
+TickType_t xNow;
+
+	if( ulLED < partestNUM_LEDS )
+	{
+		xNow = xTaskGetTickCount();
+
+		taskENTER_CRITICAL();
+		{
+			xLEDState[ ulLED ] = !xLEDState[ ulLED ];
+
+			if( xLastToggleTime[ ulLED ] != 0 )
+			{
+				xTogglePeriod[ ulLED ] = xNow - xLastToggleTime[ ulLED ];
+			}
+
+			xLastToggleTime[ ulLED ] = xNow;
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+long lParTestGetLEDState( unsigned long ulLED )
+{
+long lReturn = pdFALSE;
+
+	if( ulLED < partestNUM_LEDS )
+	{
+		lReturn = ( long ) xLEDState[ ulLED ];
+	}
+
+	return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xParTestGetTogglePeriod( unsigned long ulLED )
+{
+TickType_t xReturn = 0;
+
+	if( ulLED < partestNUM_LEDS )
+	{
+		taskENTER_CRITICAL();
+		{
+			xReturn = xTogglePeriod[ ulLED ];
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
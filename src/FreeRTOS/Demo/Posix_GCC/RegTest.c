@@ -0,0 +1,100 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * C implementation of the register check tasks used by main_full.c.  On the
+ * RX65N these are written in assembler (../RegTest.src) and fill every
+ * register with a known value.  The host ABI makes that impractical, so these
+ * versions keep a set of known values live across preemption instead - each
+ * task thread's registers are saved by the host when its thread is switched
+ * out, so any corruption of task context shows up as a changed value.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Loop counters that are inspected by the check task in main_full.c. */
+extern volatile uint32_t ulRegTest1LoopCounter, ulRegTest2LoopCounter;
+
+void vRegTest1Implementation( void );
+void vRegTest2Implementation( void );
+
+/*
+ * Common implementation.  Only returns if an error is found, after which the
+ * loop counter stops incrementing and the check task latches an error.
+ */
+static void prvRegTest( uint64_t ullSeed, double dSeed, volatile uint32_t *pulLoopCounter );
+
+/*-----------------------------------------------------------*/
+
+void vRegTest1Implementation( void )
+{
+	prvRegTest( 0x0101010101010101ULL, 1.1, &ulRegTest1LoopCounter );
+}
+/*-----------------------------------------------------------*/
+
+void vRegTest2Implementation( void )
+{
+	prvRegTest( 0x1010101010101010ULL, -2.2, &ulRegTest2LoopCounter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRegTest( uint64_t ullSeed, double dSeed, volatile uint32_t *pulLoopCounter )
+{
+register uint64_t r1 = ullSeed * 1ULL, r2 = ullSeed * 2ULL, r3 = ullSeed * 3ULL, r4 = ullSeed * 4ULL;
+register uint64_t r5 = ullSeed * 5ULL, r6 = ullSeed * 6ULL, r7 = ullSeed * 7ULL, r8 = ullSeed * 8ULL;
+register double d1 = dSeed * 1.0, d2 = dSeed * 2.0, d3 = dSeed * 3.0, d4 = dSeed * 4.0;
+
+	for( ;; )
+	{
+		/* Force the values through the compiler's view of memory so they are
+		not constant folded, while still being held in registers in between. */
+		__asm volatile( "" : "+r" ( r1 ), "+r" ( r2 ), "+r" ( r3 ), "+r" ( r4 ) );
+		__asm volatile( "" : "+r" ( r5 ), "+r" ( r6 ), "+r" ( r7 ), "+r" ( r8 ) );
+		#if defined( __x86_64__ )
+		{
+			__asm volatile( "" : "+x" ( d1 ), "+x" ( d2 ), "+x" ( d3 ), "+x" ( d4 ) );
+		}
+		#endif
+
+		if( ( r1 != ullSeed * 1ULL ) || ( r2 != ullSeed * 2ULL ) || ( r3 != ullSeed * 3ULL ) || ( r4 != ullSeed * 4ULL ) ||
+			( r5 != ullSeed * 5ULL ) || ( r6 != ullSeed * 6ULL ) || ( r7 != ullSeed * 7ULL ) || ( r8 != ullSeed * 8ULL ) )
+		{
+			break;
+		}
+
+		if( ( d1 != dSeed * 1.0 ) || ( d2 != dSeed * 2.0 ) || ( d3 != dSeed * 3.0 ) || ( d4 != dSeed * 4.0 ) )
+		{
+			break;
+		}
+
+		( *pulLoopCounter )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
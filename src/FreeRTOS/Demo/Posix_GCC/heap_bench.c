@@ -0,0 +1,486 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ * Heap fragmentation and latency benchmark for the Posix simulator build.
+ *
+ * Unlike the other simulator builds this is not linked with the kernel - it is
+ * built once for each of heap_2.c, heap_4.c, heap_5.c and heap_6.c (make
+ * heapbench), with the functions the heap files call from tasks.c replaced by
+ * the stubs below, so nothing but the allocator is measured.  heap_5.c is
+ * given the same amount of memory as the others, as two regions.  heap_4.c is
+ * also built with configUSE_HEAP_POOLS set to 1, in which case the use of each
+ * pool is reported too.
+ *
+ * The workload is a deterministic mix of the allocations made by a TCP/IP
+ * stack under load - control blocks and buffer headers, small and full sized
+ * packet buffers, and the occasional large buffer - allocated and freed in a
+ * random order while the memory allocated is kept close to
+ * heapbenchTARGET_PERCENT of the heap.  The results reported are:
+ *
+ * + The median, 99th percentile and maximum host cycles taken by
+ *   pvPortMalloc() and vPortFree().  The first two show the typical cost, the
+ *   maximum is the figure that matters to a real time system, but is affected
+ *   by anything else the host did while the benchmark ran.
+ *
+ * + The number of allocations that failed although the total free space was
+ *   sufficient - failures caused by fragmentation.
+ *
+ * + The free space, and the largest single block that could still be
+ *   allocated, once the workload has finished.
+ *
+ * Every allocated block is filled with a pattern that is checked before the
+ * block is freed, so an allocator that hands out overlapping blocks fails the
+ * benchmark.
+ ******************************************************************************/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+	#include <x86intrin.h>
+#endif
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The heap file under test, set by the makefile. */
+#ifndef heapbenchHEAP
+	#error heapbenchHEAP must be set to the number of the heap file being tested
+#endif
+
+/* The number of allocations and frees made, and the proportion of the heap
+the workload tries to keep allocated. */
+#define heapbenchOPERATIONS			( 400000UL )
+#define heapbenchTARGET_PERCENT		( 85UL )
+
+/* The most blocks that are allocated at once. */
+#define heapbenchMAX_BLOCKS			( 4096 )
+
+/*-----------------------------------------------------------*/
+
+/* A block allocated by the workload. */
+typedef struct HEAP_BENCH_BLOCK
+{
+	uint8_t *pucData;
+	size_t xSize;
+} HeapBenchBlock_t;
+
+/*
+ * Returns the size of the next allocation made by the workload.
+ */
+static size_t prvNextSize( void );
+
+/*
+ * Returns the next value from a fixed sequence of pseudo random numbers, so
+ * every heap sees the same workload.
+ */
+static uint32_t prvRandom( void );
+
+/*
+ * Allocate, or free, a block, recording how long the call took.
+ */
+static void prvAllocate( HeapBenchBlock_t *pxBlock, size_t xSize );
+static void prvFree( HeapBenchBlock_t *pxBlock );
+
+/*
+ * Returns the largest block that can be allocated.
+ */
+static size_t prvLargestAllocatableBlock( void );
+
+/*
+ * Prints the median, 99th percentile and maximum of the ulCount values in
+ * pulCycles, sorting the array in the process.
+ */
+static void prvPrintLatency( const char *pcName, uint32_t *pulCycles, uint32_t ulCount );
+static int prvCompareCycles( const void *pv1, const void *pv2 );
+
+/*
+ * Returns the host time stamp counter where one is available, or a nanosecond
+ * count otherwise, as ullPortGetHostCycles() does in the full simulator.
+ */
+static uint64_t prvGetCycles( void );
+
+/*
+ * Report a failure and exit.
+ */
+static void prvFail( const char *pcMessage );
+
+/*
+ * The kernel and application functions called by the heap files.
+ */
+void vTaskSuspendAll( void );
+BaseType_t xTaskResumeAll( void );
+void vApplicationMallocFailedHook( void );
+void vAssertCalled( const char *pcFile, unsigned long ulLine );
+
+/*-----------------------------------------------------------*/
+
+static HeapBenchBlock_t xBlocks[ heapbenchMAX_BLOCKS ];
+static uint32_t ulMallocCycles[ heapbenchOPERATIONS ], ulFreeCycles[ heapbenchOPERATIONS ];
+static uint32_t ulMallocCount = 0, ulFreeCount = 0, ulFailedCount = 0;
+static uint32_t ulRandomState = 0x12345678UL;
+
+#if( heapbenchHEAP == 5 )
+	/* heap_5.c has no memory of its own.  Give it the same amount as the other
+	heaps, split into two regions. */
+	static uint8_t ucRegion1[ configTOTAL_HEAP_SIZE / 2 ], ucRegion2[ configTOTAL_HEAP_SIZE / 2 ];
+#endif
+
+#if( heapbenchHEAP == 6 )
+	/* Added to heap_6.c once the workload has finished, to check heap regions
+	can be added after the heap is in use. */
+	static uint8_t ucExtraRegion[ 64 * 1024 ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+size_t xAllocated = 0, xTarget, xInitialFree, xFree, xLargest, xSize;
+uint32_t ulOperation, ulIndex, ulBlockCount = 0;
+
+	#if( heapbenchHEAP == 5 )
+	{
+	HeapRegion_t xRegions[ 3 ] = { { NULL, 0 }, { NULL, 0 }, { NULL, 0 } };
+
+		/* Regions must be in address order. */
+		xRegions[ 0 ].pucStartAddress = ( &( ucRegion1[ 0 ] ) < &( ucRegion2[ 0 ] ) ) ? ucRegion1 : ucRegion2;
+		xRegions[ 0 ].xSizeInBytes = sizeof( ucRegion1 );
+		xRegions[ 1 ].pucStartAddress = ( &( ucRegion1[ 0 ] ) < &( ucRegion2[ 0 ] ) ) ? ucRegion2 : ucRegion1;
+		xRegions[ 1 ].xSizeInBytes = sizeof( ucRegion2 );
+		vPortDefineHeapRegions( xRegions );
+	}
+	#endif
+
+	/* heap_2.c, heap_4.c and heap_6.c initialise themselves on the first call
+	to pvPortMalloc(), so report the free space after one. */
+	vPortFree( pvPortMalloc( 1 ) );
+	xInitialFree = xPortGetFreeHeapSize();
+	xTarget = ( xInitialFree / 100UL ) * heapbenchTARGET_PERCENT;
+
+	for( ulOperation = 0; ulOperation < heapbenchOPERATIONS; ulOperation++ )
+	{
+		/* Allocate while below the target, otherwise free a random block. */
+		if( ( ulBlockCount < heapbenchMAX_BLOCKS ) && ( ( xAllocated < xTarget ) || ( ulBlockCount == 0 ) ) )
+		{
+			xSize = prvNextSize();
+			prvAllocate( &( xBlocks[ ulBlockCount ] ), xSize );
+
+			if( xBlocks[ ulBlockCount ].pucData != NULL )
+			{
+				xAllocated += xSize;
+				ulBlockCount++;
+			}
+			else
+			{
+				/* Only count failures that were not caused by the heap being
+				genuinely full.  The heaps all add less than 64 bytes to each
+				block. */
+				if( ( xSize + 64 ) < xPortGetFreeHeapSize() )
+				{
+					ulFailedCount++;
+				}
+
+				/* Free something instead. */
+				ulIndex = prvRandom() % ulBlockCount;
+				xAllocated -= xBlocks[ ulIndex ].xSize;
+				prvFree( &( xBlocks[ ulIndex ] ) );
+				ulBlockCount--;
+				xBlocks[ ulIndex ] = xBlocks[ ulBlockCount ];
+			}
+		}
+		else
+		{
+			ulIndex = prvRandom() % ulBlockCount;
+			xAllocated -= xBlocks[ ulIndex ].xSize;
+			prvFree( &( xBlocks[ ulIndex ] ) );
+			ulBlockCount--;
+			xBlocks[ ulIndex ] = xBlocks[ ulBlockCount ];
+		}
+	}
+
+	xFree = xPortGetFreeHeapSize();
+	xLargest = prvLargestAllocatableBlock();
+
+	printf( "heap_%d.c%s, %lu operations keeping %lu%% of %lu bytes allocated, host cycles\n", heapbenchHEAP, ( configUSE_HEAP_POOLS == 1 ) ? " with pools" : "", heapbenchOPERATIONS, heapbenchTARGET_PERCENT, ( unsigned long ) xInitialFree );
+	prvPrintLatency( "pvPortMalloc()", ulMallocCycles, ulMallocCount );
+	prvPrintLatency( "vPortFree()", ulFreeCycles, ulFreeCount );
+	printf( "  failed allocations with space free      %10lu\n", ( unsigned long ) ulFailedCount );
+	printf( "  free bytes / largest allocatable block  %10lu / %lu\n", ( unsigned long ) xFree, ( unsigned long ) xLargest );
+
+	#if( configUSE_HEAP_POOLS == 1 )
+	{
+	HeapPoolStats_t xPoolStats[ configHEAP_POOL_COUNT ];
+
+		vPortGetPoolStats( xPoolStats );
+
+		for( ulIndex = 0; ulIndex < configHEAP_POOL_COUNT; ulIndex++ )
+		{
+			printf( "  pool of %4lu x %4lu bytes, hits / misses / most used  %lu / %lu / %lu\n", ( unsigned long ) xPoolStats[ ulIndex ].xNumberOfBlocks, ( unsigned long ) xPoolStats[ ulIndex ].xBlockSize, ( unsigned long ) xPoolStats[ ulIndex ].ulHits, ( unsigned long ) xPoolStats[ ulIndex ].ulMisses, ( unsigned long ) xPoolStats[ ulIndex ].xMaximumBlocksInUse );
+		}
+	}
+	#endif
+
+	/* Free everything, which must return all the memory, and for the heaps
+	that combine adjacent free blocks, leave a single block again. */
+	while( ulBlockCount > 0 )
+	{
+		ulBlockCount--;
+		prvFree( &( xBlocks[ ulBlockCount ] ) );
+	}
+
+	if( xPortGetFreeHeapSize() != xInitialFree )
+	{
+		prvFail( "memory was not returned to the heap" );
+	}
+
+	#if( heapbenchHEAP == 4 ) || ( heapbenchHEAP == 6 )
+	{
+		if( prvLargestAllocatableBlock() < ( xInitialFree - 64 ) )
+		{
+			prvFail( "free blocks were not combined" );
+		}
+	}
+	#endif
+
+	#if( heapbenchHEAP == 6 )
+	{
+	HeapRegion_t xRegions[ 2 ] = { { NULL, 0 }, { NULL, 0 } };
+	uint8_t *pucMain, *pucExtra;
+
+		xRegions[ 0 ].pucStartAddress = ucExtraRegion;
+		xRegions[ 0 ].xSizeInBytes = sizeof( ucExtraRegion );
+		vPortDefineHeapRegions( xRegions );
+
+		/* The new region must add to the free space, and still be usable once
+		the rest of the heap is allocated. */
+		xFree = xPortGetFreeHeapSize();
+		if( ( xFree <= xInitialFree ) || ( ( xFree - xInitialFree ) < ( sizeof( ucExtraRegion ) - 64 ) ) )
+		{
+			prvFail( "heap region was not added" );
+		}
+
+		pucMain = ( uint8_t * ) pvPortMalloc( prvLargestAllocatableBlock() );
+		pucExtra = ( uint8_t * ) pvPortMalloc( sizeof( ucExtraRegion ) - 64 );
+
+		if( ( pucMain == NULL ) || ( pucExtra < ucExtraRegion ) || ( pucExtra >= &( ucExtraRegion[ sizeof( ucExtraRegion ) ] ) ) )
+		{
+			prvFail( "heap region was not used" );
+		}
+
+		vPortFree( pucMain );
+		vPortFree( pucExtra );
+
+		if( xPortGetFreeHeapSize() != xFree )
+		{
+			prvFail( "memory was not returned to the heap region" );
+		}
+	}
+	#endif
+
+	return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvNextSize( void )
+{
+uint32_t ulChoice = prvRandom() % 100UL;
+size_t xSize;
+
+	if( ulChoice < 45UL )
+	{
+		/* Control blocks and buffer headers. */
+		xSize = 16 + ( prvRandom() % 112UL );
+	}
+	else if( ulChoice < 75UL )
+	{
+		/* Small packets. */
+		xSize = 128 + ( prvRandom() % 512UL );
+	}
+	else if( ulChoice < 95UL )
+	{
+		/* Full sized Ethernet frames. */
+		xSize = 1536;
+	}
+	else
+	{
+		/* Large buffers, such as TCP windows. */
+		xSize = 2048 + ( prvRandom() % 6144UL );
+	}
+
+	return xSize;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+	/* Xorshift. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+
+	return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocate( HeapBenchBlock_t *pxBlock, size_t xSize )
+{
+uint64_t ullStart;
+
+	ullStart = prvGetCycles();
+	pxBlock->pucData = ( uint8_t * ) pvPortMalloc( xSize );
+	ulMallocCycles[ ulMallocCount ] = ( uint32_t ) ( prvGetCycles() - ullStart );
+	ulMallocCount++;
+
+	pxBlock->xSize = xSize;
+
+	if( pxBlock->pucData != NULL )
+	{
+		memset( pxBlock->pucData, ( int ) ( xSize & 0xffU ), xSize );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( HeapBenchBlock_t *pxBlock )
+{
+uint64_t ullStart;
+size_t x;
+
+	/* Check nothing else has written over the block. */
+	for( x = 0; x < pxBlock->xSize; x++ )
+	{
+		if( pxBlock->pucData[ x ] != ( uint8_t ) ( pxBlock->xSize & 0xffU ) )
+		{
+			prvFail( "allocated blocks overlap" );
+		}
+	}
+
+	ullStart = prvGetCycles();
+	vPortFree( pxBlock->pucData );
+	ulFreeCycles[ ulFreeCount ] = ( uint32_t ) ( prvGetCycles() - ullStart );
+	ulFreeCount++;
+
+	pxBlock->pucData = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestAllocatableBlock( void )
+{
+size_t xLow = 0, xHigh = xPortGetFreeHeapSize(), xSize;
+void *pv;
+
+	/* Binary search for the largest size pvPortMalloc() succeeds with.  The
+	malloc failed hook ignores the failures. */
+	while( xLow < xHigh )
+	{
+		xSize = xLow + ( ( xHigh - xLow + 1 ) / 2 );
+		pv = pvPortMalloc( xSize );
+
+		if( pv != NULL )
+		{
+			vPortFree( pv );
+			xLow = xSize;
+		}
+		else
+		{
+			xHigh = xSize - 1;
+		}
+	}
+
+	return xLow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintLatency( const char *pcName, uint32_t *pulCycles, uint32_t ulCount )
+{
+	qsort( pulCycles, ulCount, sizeof( uint32_t ), prvCompareCycles );
+	printf( "  %-16s median / 99%% / max      %10lu / %lu / %lu\n", pcName, ( unsigned long ) pulCycles[ ulCount / 2 ], ( unsigned long ) pulCycles[ ( ulCount * 99UL ) / 100UL ], ( unsigned long ) pulCycles[ ulCount - 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareCycles( const void *pv1, const void *pv2 )
+{
+uint32_t ul1 = *( const uint32_t * ) pv1, ul2 = *( const uint32_t * ) pv2;
+
+	return ( ul1 > ul2 ) - ( ul1 < ul2 );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetCycles( void )
+{
+	#if defined( __x86_64__ ) || defined( __i386__ )
+	{
+		return ( uint64_t ) __rdtsc();
+	}
+	#else
+	{
+	struct timespec xNow;
+
+		( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+		return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char *pcMessage )
+{
+	printf( "FAIL: heap_%d.c: %s\n", heapbenchHEAP, pcMessage );
+	exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+	/* There is only one thread, so nothing to do. */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* Failures are expected, and counted by the caller. */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	printf( "FAIL: assert at %s:%lu\n", pcFile, ulLine );
+	exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
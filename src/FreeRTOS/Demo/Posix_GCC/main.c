@@ -0,0 +1,1134 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ * Entry point of the Posix simulator build.  The simulator runs the same
+ * kernel configuration as the RX65N target, using the port in
+ * Source/portable/ThirdParty/GCC/Posix, so kernel changes can be exercised and
+ * measured on a host before being flashed to the board.
+ *
+ * Usage: posix_demo [full|bench|tickless|trace] [seconds] [trace file prefix]
+ *
+ * full:  Runs main_full() from ../Full_Demo/main_full.c, unmodified, for the
+ *        given number of seconds (default 30), then reports whether the check
+ *        task found an error in any of the standard demo tasks.  The exit
+ *        status is zero only if no errors were reported.
+ *
+ * bench: Runs main_bench() from main_bench.c, which reports the cost of kernel
+ *        hot paths in host cycles.
+ *
+ * tickless: Runs main_tickless() from main_tickless.c for the given number of
+ *        seconds, which checks the tick count does not drift from the host
+ *        clock while ticks are suppressed.  Requires a build with
+ *        configUSE_TICKLESS_IDLE set to 1 (make tickless).
+ *
+ * trace: Runs the full demo as above while a task streams the trace recorder
+ *        to <prefix>.bin (default prefix "trace").  At the end of the run a
+ *        snapshot of every event class is taken and written to
+ *        <prefix>_snapshot.bin.  trace_decode.c converts both to JSON (make
+ *        trace).
+ ******************************************************************************/
+
+/* Standard includes. */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Simulator includes. */
+#include "IntQueueTimer.h"
+#include "GenQTest.h"
+#include "recmutex.h"
+
+/* The check task in main_full.c toggles its LED every 3 seconds while no
+errors have been found, and every 200ms once an error has been latched. */
+#define mainCHECK_LED						( 1 )
+#define mainNO_ERROR_CHECK_TASK_PERIOD		pdMS_TO_TICKS( 3000UL )
+
+/* The default run time of the full demo, in seconds. */
+#define mainDEFAULT_RUN_TIME_SECONDS		( 30UL )
+
+/* The trace mode streams the scheduling, interrupt and inter-task signalling
+events, emptying the ring every mainTRACE_READ_PERIOD.  The queue and stream
+buffer calls made by tasks are left out, as the demo tasks that poll them would
+otherwise make up most of the stream.  The snapshot then records every class
+for mainTRACE_SNAPSHOT_TIME, which is long enough to fill the ring. */
+#define mainTRACE_STREAM_CLASSES			( traceCLASS_TASK | traceCLASS_ISR | traceCLASS_NOTIFY | traceCLASS_EVENT_GROUP | traceCLASS_TIMER | traceCLASS_USER )
+#define mainTRACE_READ_PERIOD				pdMS_TO_TICKS( 5UL )
+#define mainTRACE_READ_RECORDS				( 256 )
+#define mainTRACE_SNAPSHOT_TIME				pdMS_TO_TICKS( 500UL )
+
+/* The stack watermark test task writes to all but mainSTACK_MARK_FREE_WORDS
+words of the lower half of its stack, so it has used more than
+configSTACK_WATERMARK_WARNING_PERCENT of it.  The upper half holds the host
+thread structure. */
+#define mainSTACK_MARK_STACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+#define mainSTACK_MARK_FREE_WORDS			( 10 )
+#define mainMAX_STACK_WATERMARKS			( 150 )
+
+/* The timer overflow test starts an auto-reload timer from the tick hook at
+mainOVERFLOW_START_TICK, so it is due two ticks before the tick count overflows,
+while a one-shot timer that expires at mainOVERFLOW_HOLD_TICK keeps the timer
+service task busy until after the overflow.  The command is therefore processed
+after the timer was due, and after the overflow, so the timer must be reloaded
+to expire at tick 0 - relative to when it was due rather than to when the
+command was processed. */
+#define mainOVERFLOW_RELOAD_PERIOD			( ( TickType_t ) 2U )
+#define mainOVERFLOW_START_TICK				( ( TickType_t ) 0U - ( TickType_t ) 4U )
+#define mainOVERFLOW_HOLD_TICK				( ( TickType_t ) 0U - ( TickType_t ) 6U )
+#define mainOVERFLOW_RELOAD_TICK			( ( TickType_t ) ( mainOVERFLOW_START_TICK + ( 2U * mainOVERFLOW_RELOAD_PERIOD ) ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Monitors the status reported by the check task in main_full.c, and exits the
+ * simulator once the requested run time has elapsed.
+ */
+static void prvSimulatorControlTask( void *pvParameters );
+
+/*
+ * Print a message and terminate the simulator.  Used where the target build
+ * would stop in a loop for the debugger to inspect.
+ */
+static void prvExit( int iStatus, const char *pcFormat, ... ) __attribute__( ( format( printf, 2, 3 ) ) );
+
+/*
+ * Creates the timers used by the timer overflow test described above
+ * mainOVERFLOW_RELOAD_PERIOD, if the tick count is far enough from overflowing
+ * for the test to run.
+ */
+static void prvStartTimerOverflowTest( void );
+
+/*
+ * Exits the simulator if the timer overflow test was started but the auto
+ * reload timer did not expire, or was reloaded to the wrong time.
+ */
+static void prvCheckTimerOverflowTest( void );
+
+/*
+ * The callbacks of the one-shot and auto-reload timers used by the timer
+ * overflow test.
+ */
+static void prvOverflowHoldCallback( TimerHandle_t xTimer );
+static void prvOverflowReloadCallback( TimerHandle_t xTimer );
+
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/*
+	 * Checks that a block allocated by the calling task is reported against
+	 * that task and its call site, and exits the simulator if it is not.
+	 */
+	static void prvCheckHeapAccounting( void );
+
+	/*
+	 * The vPortHeapDump() callback used by prvCheckHeapAccounting().
+	 */
+	static void prvHeapDumpCallback( void *pvBlock, size_t xRequestedSize, void *pvOwner, const void *pvCallSite, void *pvParameter );
+
+	/*
+	 * Created by prvCheckHeapAccounting() to allocate a block that is still
+	 * held when the task is deleted.
+	 */
+	static void prvHeapOwnerTask( void *pvParameters );
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	/*
+	 * Starts streaming the trace recorder to <prefix>.bin, and creates the
+	 * task that reads the records from the recorder.
+	 */
+	static void prvStartTrace( void );
+
+	/*
+	 * Stops the stream, then takes a snapshot and writes it to
+	 * <prefix>_snapshot.bin.  Exits the simulator if either is empty.
+	 */
+	static void prvFinishTrace( void );
+
+	/*
+	 * Reads records from the recorder every mainTRACE_READ_PERIOD, and writes
+	 * them to the stream file, until prvFinishTrace() notifies it to stop.
+	 */
+	static void prvTraceReadTask( void *pvParameters );
+
+	/*
+	 * The vTraceRecorderDump() callback used to write the snapshot.
+	 */
+	static void prvWriteTraceSnapshot( const TraceRecord_t *pxRecords, size_t xNumberOfRecords, void *pvParameter );
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#if( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	/*
+	 * Prints the tasks that used the most CPU time over the last second, and
+	 * exits the simulator if the loads of the tasks and interrupts do not add
+	 * up to the whole of the CPU time.
+	 */
+	static void prvCheckCpuLoad( void );
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	/*
+	 * Prints the interrupt latency histograms, and exits the simulator if the
+	 * tick, yield, IntQueue and critical section histograms are empty or do not
+	 * add up, or the IntQueue handlers were not seen nested within the tick.
+	 */
+	static void prvCheckISRLatency( void );
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	/*
+	 * Uses most of its stack, as described above mainSTACK_MARK_STACK_SIZE,
+	 * then suspends itself.
+	 */
+	static void prvStackMarkTask( void *pvParameters );
+
+	/*
+	 * Prints the tasks with the least free stack, and exits the simulator if
+	 * the watermark of the stack mark task was not found by the idle task or
+	 * vApplicationStackWatermarkHook() was not called for it, or was called
+	 * for any other task.
+	 */
+	static void prvCheckStackWatermarks( void );
+
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
+
+/*
+ * Prototypes for the standard FreeRTOS callback/hook functions implemented
+ * within this file.
+ */
+void vApplicationMallocFailedHook( void );
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName );
+void vApplicationIdleHook( void );
+#if( configNUMBER_OF_CORES > 1 )
+	void vApplicationPassiveIdleHook( void );
+#endif
+void vApplicationTickHook( void );
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
+#if( configNUMBER_OF_CORES > 1 )
+	void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex );
+#endif
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+	void vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName, uint32_t ulWatermark );
+#endif
+
+/*
+ * The demos and the hooks they require.
+ */
+extern void main_full( void );
+extern void vFullDemoTickHookFunction( void );
+extern void vFullDemoIdleFunction( void );
+extern void main_bench( void );
+extern int main_tickless( unsigned long ulRunTimeSeconds );
+
+/* Implemented in ParTest.c. */
+extern TickType_t xParTestGetTogglePeriod( unsigned long ulLED );
+
+/* The errors latched by the check task in main_full.c. */
+extern char *pcStatusMessage;
+extern char *pcFirstErrorMessage;
+
+/*-----------------------------------------------------------*/
+
+/* Set to pdTRUE when running main_full(), as the full demo hook functions must
+not be called by the benchmark build. */
+static BaseType_t xRunningFullDemo = pdFALSE;
+
+/* The auto-reload timer used by the timer overflow test, NULL if the test is
+not running, and the expiry time it had when its callback was called. */
+static TimerHandle_t xOverflowReloadTimer = NULL;
+static volatile BaseType_t xOverflowReloadExpired = pdFALSE;
+static volatile TickType_t xOverflowReloadTime = ( TickType_t ) 0U;
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	/* The file name prefix given in trace mode, NULL otherwise. */
+	static const char *pcTraceFilePrefix = NULL;
+
+	/* The task that reads the stream, the task waiting for it to finish, the
+	number of records it has written, and the stream file. */
+	static TaskHandle_t xTraceReadTask = NULL, xTraceFinishTask = NULL;
+	static unsigned long ulTraceRecordsStreamed = 0UL, ulTraceRecordsDropped = 0UL;
+	static FILE *pxTraceStreamFile = NULL;
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	/* The stack watermark test task, its memory, the watermark passed to
+	vApplicationStackWatermarkHook() for it, and the name of any other task the
+	hook was called for. */
+	static TaskHandle_t xStackMarkTask = NULL;
+	static StackType_t uxStackMarkStack[ mainSTACK_MARK_STACK_SIZE ];
+	static StaticTask_t xStackMarkTCB;
+	static volatile uint32_t ulStackMarkWarning = 0UL;
+	static const char * volatile pcUnexpectedStackWarning = NULL;
+
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+unsigned long ulRunTimeSeconds = mainDEFAULT_RUN_TIME_SECONDS;
+const char *pcMode = "full";
+
+	if( argc > 1 )
+	{
+		pcMode = argv[ 1 ];
+	}
+
+	if( argc > 2 )
+	{
+		ulRunTimeSeconds = strtoul( argv[ 2 ], NULL, 10 );
+	}
+
+	/* Unbuffered output so messages are not lost if the simulator is
+	terminated from a task. */
+	setvbuf( stdout, NULL, _IONBF, 0 );
+
+	if( strcmp( pcMode, "bench" ) == 0 )
+	{
+		main_bench();
+
+		/* main_bench() returns when the benchmark task ends the scheduler. */
+		return EXIT_SUCCESS;
+	}
+	else if( strcmp( pcMode, "tickless" ) == 0 )
+	{
+		return main_tickless( ulRunTimeSeconds );
+	}
+	else if( ( strcmp( pcMode, "full" ) == 0 ) || ( ( configUSE_TRACE_RECORDER == 1 ) && ( strcmp( pcMode, "trace" ) == 0 ) ) )
+	{
+		xRunningFullDemo = pdTRUE;
+
+		#if( configUSE_TRACE_RECORDER == 1 )
+		{
+			if( strcmp( pcMode, "trace" ) == 0 )
+			{
+				pcTraceFilePrefix = ( argc > 3 ) ? argv[ 3 ] : "trace";
+			}
+		}
+		#endif
+
+		/* Created before main_full() so it is in place before main_full()
+		starts the scheduler. */
+		xTaskCreate( prvSimulatorControlTask, "SimCtrl", configMINIMAL_STACK_SIZE, ( void * ) ulRunTimeSeconds, configMAX_PRIORITIES - 1, NULL );
+
+		#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		{
+			xStackMarkTask = xTaskCreateStatic( prvStackMarkTask, "StkMark", mainSTACK_MARK_STACK_SIZE, NULL, tskIDLE_PRIORITY, uxStackMarkStack, &xStackMarkTCB );
+		}
+		#endif
+		main_full();
+	}
+	else
+	{
+		fprintf( stderr, "Usage: %s [full|bench|tickless|trace] [seconds] [trace file prefix]\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	/* Only reached if the scheduler could not be started. */
+	return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimulatorControlTask( void *pvParameters )
+{
+const TickType_t xReportPeriod = pdMS_TO_TICKS( 5000UL );
+TickType_t xTimeNow, xEndTime, xPeriod;
+
+	xEndTime = xTaskGetTickCount() + pdMS_TO_TICKS( ( unsigned long ) pvParameters * 1000UL );
+
+	prvStartTimerOverflowTest();
+
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		prvCheckHeapAccounting();
+	}
+	#endif
+
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		if( pcTraceFilePrefix != NULL )
+		{
+			prvStartTrace();
+		}
+	}
+	#endif
+
+	for( ;; )
+	{
+		vTaskDelay( xReportPeriod );
+
+		xTimeNow = xTaskGetTickCount();
+		xPeriod = xParTestGetTogglePeriod( mainCHECK_LED );
+
+		taskENTER_CRITICAL();
+		{
+			printf( "tick %lu: check period %lu, free heap %lu\n", ( unsigned long ) xTimeNow, ( unsigned long ) xPeriod, ( unsigned long ) xPortGetFreeHeapSize() );
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xPeriod != 0 ) && ( xPeriod < mainNO_ERROR_CHECK_TASK_PERIOD ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the check task reported an error: %s (first %s)\n", pcStatusMessage, ( pcFirstErrorMessage != NULL ) ? pcFirstErrorMessage : pcStatusMessage );
+		}
+
+		if( ( TickType_t ) ( xTimeNow - xEndTime ) < ( TickType_t ) ( portMAX_DELAY / 2 ) )
+		{
+			if( xPeriod == 0 )
+			{
+				prvExit( EXIT_FAILURE, "FAIL: the check task did not run\n" );
+			}
+
+			#if( configUSE_HEAP_POOLS == 1 )
+			{
+			HeapPoolStats_t xPoolStats[ configHEAP_POOL_COUNT ];
+			UBaseType_t uxPool;
+
+				/* Show how well the heap pools suit the demo's allocations. */
+				vPortGetPoolStats( xPoolStats );
+
+				for( uxPool = 0; uxPool < configHEAP_POOL_COUNT; uxPool++ )
+				{
+					printf( "heap pool of %lu x %lu bytes: hits %lu, misses %lu, most used %lu\n", ( unsigned long ) xPoolStats[ uxPool ].xNumberOfBlocks, ( unsigned long ) xPoolStats[ uxPool ].xBlockSize, ( unsigned long ) xPoolStats[ uxPool ].ulHits, ( unsigned long ) xPoolStats[ uxPool ].ulMisses, ( unsigned long ) xPoolStats[ uxPool ].xMaximumBlocksInUse );
+				}
+			}
+			#endif /* configUSE_HEAP_POOLS */
+
+			prvCheckTimerOverflowTest();
+
+			{
+			TaskCleanupStats_t xCleanupStats;
+
+				/* Show how long the memory of deleted tasks was held. */
+				vTaskGetCleanupStats( &xCleanupStats );
+				printf( "task cleanup: %lu freed, %lu bulk reclaims, most waiting %lu, longest wait %lu ticks, total wait %lu ticks\n", ( unsigned long ) xCleanupStats.ulTasksFreed, ( unsigned long ) xCleanupStats.ulBulkReclaims, ( unsigned long ) xCleanupStats.uxMostWaiting, ( unsigned long ) xCleanupStats.xLongestWait, ( unsigned long ) xCleanupStats.ulTotalWaitTicks );
+			}
+
+			{
+			TickType_t xLongest, xTotal;
+			uint32_t ulMeasured;
+
+				/* Show how long high priority tasks were kept waiting for
+				mutexes held by lower priority tasks. */
+				vGetGenericQueueInversionTimes( &xLongest, &xTotal, &ulMeasured );
+				printf( "inversion, mutex chain: %lu measured, longest %lu ticks, total %lu ticks\n", ( unsigned long ) ulMeasured, ( unsigned long ) xLongest, ( unsigned long ) xTotal );
+				vGetRecursiveMutexInversionTimes( &xLongest, &xTotal, &ulMeasured );
+				printf( "inversion, recursive mutex: %lu measured, longest %lu ticks, total %lu ticks\n", ( unsigned long ) ulMeasured, ( unsigned long ) xLongest, ( unsigned long ) xTotal );
+			}
+
+			#if( configGENERATE_CPU_LOAD_STATS == 1 )
+			{
+				prvCheckCpuLoad();
+			}
+			#endif
+
+			#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+			{
+				prvCheckISRLatency();
+			}
+			#endif
+
+			#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+			{
+				prvCheckStackWatermarks();
+			}
+			#endif
+
+			#if( configUSE_TRACE_RECORDER == 1 )
+			{
+				if( pcTraceFilePrefix != NULL )
+				{
+					prvFinishTrace();
+				}
+			}
+			#endif
+
+			prvExit( EXIT_SUCCESS, "PASS: all tasks running without error\n" );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* What vPortHeapDump() reported for the block being looked for. */
+	typedef struct HEAP_DUMP_CHECK
+	{
+		void *pvBlock;
+		size_t xRequestedSize;
+		void *pvOwner;
+		const void *pvCallSite;
+		BaseType_t xFound;
+	} HeapDumpCheck_t;
+
+	static void prvHeapDumpCallback( void *pvBlock, size_t xRequestedSize, void *pvOwner, const void *pvCallSite, void *pvParameter )
+	{
+	HeapDumpCheck_t *pxCheck = ( HeapDumpCheck_t * ) pvParameter;
+
+		if( pvBlock == pxCheck->pvBlock )
+		{
+			pxCheck->xRequestedSize = xRequestedSize;
+			pxCheck->pvOwner = pvOwner;
+			pxCheck->pvCallSite = pvCallSite;
+			pxCheck->xFound++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckHeapAccounting( void )
+	{
+	const size_t xTestSize = 100;
+	UBaseType_t uxUsageBefore;
+	HeapDumpCheck_t xCheck;
+	TaskHandle_t xOwnerTask;
+
+		/* The tasks and queues created by main_full() were allocated before the
+		scheduler started, so belong to no task. */
+		if( xPortGetHeapUsage( NULL ) == 0 )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: heap allocated before the scheduler started was not accounted\n" );
+		}
+
+		uxUsageBefore = uxTaskGetHeapUsage( NULL );
+
+		memset( &xCheck, 0x00, sizeof( xCheck ) );
+		xCheck.pvBlock = pvPortMalloc( xTestSize );
+		configASSERT( xCheck.pvBlock );
+
+		if( uxTaskGetHeapUsage( NULL ) != ( uxUsageBefore + xTestSize ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: heap usage did not include a new block\n" );
+		}
+
+		vPortHeapDump( prvHeapDumpCallback, &xCheck );
+
+		if( ( xCheck.xFound != 1 ) || ( xCheck.xRequestedSize != xTestSize ) || ( xCheck.pvOwner != ( void * ) xTaskGetCurrentTaskHandle() ) || ( xCheck.pvCallSite == NULL ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the heap dump did not report a new block correctly\n" );
+		}
+
+		vPortFree( xCheck.pvBlock );
+
+		if( uxTaskGetHeapUsage( NULL ) != uxUsageBefore )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: heap usage still included a freed block\n" );
+		}
+
+		/* A block still held by a task when the task is deleted must no longer
+		name the task as its owner, as a new task could reuse the handle. */
+		memset( &xCheck, 0x00, sizeof( xCheck ) );
+		xTaskCreate( prvHeapOwnerTask, "HeapOwn", configMINIMAL_STACK_SIZE, &( xCheck.pvBlock ), configMAX_PRIORITIES - 1, &xOwnerTask );
+
+		while( eTaskGetState( xOwnerTask ) != eSuspended )
+		{
+			vTaskDelay( 1 );
+		}
+
+		configASSERT( xCheck.pvBlock );
+		vTaskDelete( xOwnerTask );
+		vPortHeapDump( prvHeapDumpCallback, &xCheck );
+
+		if( ( xCheck.xFound != 1 ) || ( xCheck.pvOwner != NULL ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the heap dump still named a deleted task as the owner of a block\n" );
+		}
+
+		vPortFree( xCheck.pvBlock );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvHeapOwnerTask( void *pvParameters )
+	{
+	void **ppvBlock = ( void ** ) pvParameters;
+
+		*ppvBlock = pvPortMalloc( 100 );
+
+		/* Wait to be deleted. */
+		vTaskSuspend( NULL );
+	}
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	static void prvStartTrace( void )
+	{
+	char cFileName[ 256 ];
+
+		snprintf( cFileName, sizeof( cFileName ), "%s.bin", pcTraceFilePrefix );
+		pxTraceStreamFile = fopen( cFileName, "wb" );
+
+		if( pxTraceStreamFile == NULL )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: could not create %s\n", cFileName );
+		}
+
+		vTraceRecorderStart( eTraceStreaming, mainTRACE_STREAM_CLASSES );
+
+		/* The same priority as this task, which spends most of its time
+		blocked, so the reads are not held up by the demo tasks. */
+		xTaskCreate( prvTraceReadTask, "TraceRd", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xTraceReadTask );
+		configASSERT( xTraceReadTask );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTraceReadTask( void *pvParameters )
+	{
+	static TraceRecord_t xRecords[ mainTRACE_READ_RECORDS ];
+	size_t xRead, xWritten, x;
+	uint32_t ulFinish;
+
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			ulFinish = ulTaskNotifyTake( pdTRUE, mainTRACE_READ_PERIOD );
+
+			/* Empty the ring.  Once asked to finish the recorder has already
+			been stopped, so this reads the last of the records. */
+			do
+			{
+				xRead = xTraceRecorderRead( xRecords, mainTRACE_READ_RECORDS );
+
+				for( x = 0; x < xRead; x++ )
+				{
+					if( xRecords[ x ].ucEvent == traceEVENT_DROPPED )
+					{
+						ulTraceRecordsDropped += xRecords[ x ].ulValue;
+					}
+				}
+
+				/* Host calls are made in critical sections, as elsewhere in the
+				simulator. */
+				taskENTER_CRITICAL();
+				{
+					xWritten = fwrite( xRecords, sizeof( TraceRecord_t ), xRead, pxTraceStreamFile );
+				}
+				taskEXIT_CRITICAL();
+
+				configASSERT( xWritten == xRead );
+
+				ulTraceRecordsStreamed += ( unsigned long ) xRead;
+			} while( xRead == mainTRACE_READ_RECORDS );
+
+			if( ulFinish != 0UL )
+			{
+				taskENTER_CRITICAL();
+				{
+					fclose( pxTraceStreamFile );
+				}
+				taskEXIT_CRITICAL();
+
+				xTaskNotifyGive( xTraceFinishTask );
+				vTaskDelete( NULL );
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWriteTraceSnapshot( const TraceRecord_t *pxRecords, size_t xNumberOfRecords, void *pvParameter )
+	{
+	FILE *pxFile = ( FILE * ) pvParameter;
+	size_t xWritten;
+
+		xWritten = fwrite( pxRecords, sizeof( TraceRecord_t ), xNumberOfRecords, pxFile );
+		configASSERT( xWritten == xNumberOfRecords );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvFinishTrace( void )
+	{
+	char cFileName[ 256 ];
+	FILE *pxFile;
+	long lSnapshotRecords;
+
+		/* Stop the stream and wait for the read task to write out the last of
+		it. */
+		vTraceRecorderStop();
+		xTraceFinishTask = xTaskGetCurrentTaskHandle();
+		xTaskNotifyGive( xTraceReadTask );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		/* Take a snapshot of every event class. */
+		vTraceRecorderStart( eTraceSnapshot, traceCLASS_ALL );
+		vTaskDelay( mainTRACE_SNAPSHOT_TIME );
+		vTraceRecorderStop();
+
+		snprintf( cFileName, sizeof( cFileName ), "%s_snapshot.bin", pcTraceFilePrefix );
+
+		taskENTER_CRITICAL();
+		{
+			pxFile = fopen( cFileName, "wb" );
+
+			if( pxFile == NULL )
+			{
+				prvExit( EXIT_FAILURE, "FAIL: could not create %s\n", cFileName );
+			}
+
+			vTraceRecorderDump( prvWriteTraceSnapshot, pxFile );
+			lSnapshotRecords = ftell( pxFile ) / ( long ) sizeof( TraceRecord_t );
+			fclose( pxFile );
+
+			printf( "trace: %lu records streamed, %lu dropped, %ld records in the snapshot\n", ulTraceRecordsStreamed, ulTraceRecordsDropped, lSnapshotRecords );
+		}
+		taskEXIT_CRITICAL();
+
+		/* The snapshot ran for long enough to fill the ring. */
+		if( ( ulTraceRecordsStreamed == 0UL ) || ( lSnapshotRecords <= ( long ) configTRACE_RECORDER_BUFFER_RECORDS ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the trace recorder did not record the demo\n" );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulSimulatorGetTraceTimestamp( void )
+	{
+	struct timespec xNow;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+		return ( uint32_t ) ( ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec );
+	}
+
+#endif /* configUSE_TRACE_RECORDER */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	static void prvCheckCpuLoad( void )
+	{
+	/* The time used by tasks that were deleted during the last second is no
+	longer counted, and the full demo deletes tasks continuously, so the total
+	is allowed to fall a little short. */
+	const unsigned long ulMinimumTotal = 9000UL, ulMaximumTotal = 10100UL, ulTasksToPrint = 5UL;
+	TaskStatus_t *pxTaskStatusArray;
+	CpuLoad_t *pxLoads, xLoad;
+	UBaseType_t uxArraySize, x, uxBusiest;
+	unsigned long ulTotal = 0UL, ulPrinted;
+
+		uxArraySize = uxTaskGetNumberOfTasks();
+		pxTaskStatusArray = pvPortMalloc( uxArraySize * sizeof( TaskStatus_t ) );
+		pxLoads = pvPortMalloc( uxArraySize * sizeof( CpuLoad_t ) );
+		configASSERT( pxTaskStatusArray );
+		configASSERT( pxLoads );
+
+		/* The loads are read with the scheduler suspended so they are all from
+		the same sample. */
+		vTaskSuspendAll();
+		{
+			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				ulTotal += ( unsigned long ) uxTaskGetCpuLoad( pxTaskStatusArray[ x ].xHandle, &( pxLoads[ x ] ) );
+			}
+
+			for( x = 0; x < configCPU_LOAD_ISR_LEVELS; x++ )
+			{
+				ulTotal += ( unsigned long ) uxTaskGetISRCpuLoad( x, NULL );
+			}
+
+			( void ) uxTaskGetISRCpuLoad( 0, &xLoad );
+		}
+		( void ) xTaskResumeAll();
+
+		for( ulPrinted = 0UL; ( ulPrinted < ulTasksToPrint ) && ( ulPrinted < ( unsigned long ) uxArraySize ); ulPrinted++ )
+		{
+			/* Find the busiest task not yet printed, marking printed tasks by
+			clearing their handle. */
+			uxBusiest = uxArraySize;
+
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				if( ( pxTaskStatusArray[ x ].xHandle != NULL ) && ( ( uxBusiest == uxArraySize ) || ( pxLoads[ x ].usLoad1s > pxLoads[ uxBusiest ].usLoad1s ) ) )
+				{
+					uxBusiest = x;
+				}
+			}
+
+			printf( "cpu load %-12s 1s %3u.%02u%%, 10s %3u.%02u%%, 60s %3u.%02u%%\n", pxTaskStatusArray[ uxBusiest ].pcTaskName,
+					pxLoads[ uxBusiest ].usLoad1s / 100U, pxLoads[ uxBusiest ].usLoad1s % 100U,
+					pxLoads[ uxBusiest ].usLoad10s / 100U, pxLoads[ uxBusiest ].usLoad10s % 100U,
+					pxLoads[ uxBusiest ].usLoad60s / 100U, pxLoads[ uxBusiest ].usLoad60s % 100U );
+			pxTaskStatusArray[ uxBusiest ].xHandle = NULL;
+		}
+
+		printf( "cpu load %-12s 1s %3u.%02u%%, 10s %3u.%02u%%, 60s %3u.%02u%%\n", "interrupts",
+				xLoad.usLoad1s / 100U, xLoad.usLoad1s % 100U,
+				xLoad.usLoad10s / 100U, xLoad.usLoad10s % 100U,
+				xLoad.usLoad60s / 100U, xLoad.usLoad60s % 100U );
+		printf( "cpu load total 1s %lu.%02lu%%\n", ulTotal / 100UL, ulTotal % 100UL );
+
+		vPortFree( pxLoads );
+		vPortFree( pxTaskStatusArray );
+
+		if( ( ulTotal < ulMinimumTotal ) || ( ulTotal > ulMaximumTotal ) )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the task and interrupt CPU loads do not add up to the CPU time\n" );
+		}
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	static void prvCheckISRLatency( void )
+	{
+	/* The histograms that the full demo must have recorded times in. */
+	const UBaseType_t uxExpected[] = { tskISR_LATENCY_TICK_VECTOR, tskISR_LATENCY_YIELD_VECTOR, tskISR_LATENCY_FIRST_APPLICATION_VECTOR, tskISR_LATENCY_CRITICAL_SECTION, tskISR_LATENCY_MASK_FROM_ISR };
+	static char cReport[ tskISR_LATENCY_HISTOGRAMS * ( 60 + ( configISR_LATENCY_BUCKETS * 14 ) ) ];
+	ISRLatency_t xLatency, xTick;
+	UBaseType_t x, uxBucket;
+	uint32_t ulTotal;
+
+		vTaskGetISRLatencyReport( cReport );
+		printf( "isr latency (host cycles): name, samples, max, max nested, log2 buckets\n%s", cReport );
+
+		for( x = 0; x < ( UBaseType_t ) ( sizeof( uxExpected ) / sizeof( uxExpected[ 0 ] ) ); x++ )
+		{
+			( void ) uxTaskGetISRLatency( uxExpected[ x ], &xLatency );
+
+			ulTotal = 0UL;
+			for( uxBucket = 0; uxBucket < configISR_LATENCY_BUCKETS; uxBucket++ )
+			{
+				ulTotal += xLatency.ulBuckets[ uxBucket ];
+			}
+
+			if( ( xLatency.ulSamples == 0UL ) || ( ulTotal != xLatency.ulSamples ) )
+			{
+				prvExit( EXIT_FAILURE, "FAIL: the %s latency histogram is empty or does not add up\n", xLatency.pcName );
+			}
+		}
+
+		/* The IntQueue handlers run from the tick hook, so the tick must have
+		been seen to be interrupted by them. */
+		( void ) uxTaskGetISRLatency( tskISR_LATENCY_TICK_VECTOR, &xTick );
+
+		if( xTick.ulMaxNestedTime == 0UL )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: no interrupt was recorded nested within the tick\n" );
+		}
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	static void prvStackMarkTask( void *pvParameters )
+	{
+		( void ) pvParameters;
+
+		/* Simulator task threads run on their own host stacks, so stand in for
+		the deepest calls the task could make by writing to its stack from the
+		far end, as a task on the RX would. */
+		( void ) memset( &( uxStackMarkStack[ mainSTACK_MARK_FREE_WORDS ] ), 0x00, ( ( mainSTACK_MARK_STACK_SIZE / 2 ) - mainSTACK_MARK_FREE_WORDS ) * sizeof( StackType_t ) );
+
+		vTaskSuspend( NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckStackWatermarks( void )
+	{
+	static TaskStackWatermark_t xWatermarks[ mainMAX_STACK_WATERMARKS ];
+	UBaseType_t uxTasks, x, uxLeast = 0;
+	BaseType_t xStackMarkFound = pdFALSE;
+
+		uxTasks = uxTaskGetAllStackWatermarks( xWatermarks, mainMAX_STACK_WATERMARKS );
+
+		for( x = 0; x < uxTasks; x++ )
+		{
+			if( xWatermarks[ x ].xHandle == xStackMarkTask )
+			{
+				/* The stack was written before the first scan reached it, and
+				is not written again, so the latest scan has found the exact
+				watermark. */
+				if( ( xWatermarks[ x ].ulWatermark != ( uint32_t ) mainSTACK_MARK_FREE_WORDS ) || ( uxTaskGetStackHighWaterMark( xStackMarkTask ) != ( UBaseType_t ) mainSTACK_MARK_FREE_WORDS ) )
+				{
+					prvExit( EXIT_FAILURE, "FAIL: stack watermark of %s is %lu words, expected %lu\n", xWatermarks[ x ].pcTaskName, ( unsigned long ) xWatermarks[ x ].ulWatermark, ( unsigned long ) mainSTACK_MARK_FREE_WORDS );
+				}
+
+				xStackMarkFound = pdTRUE;
+			}
+			else if( ( xWatermarks[ x ].ulWatermark * xWatermarks[ uxLeast ].ulStackDepth ) < ( xWatermarks[ uxLeast ].ulWatermark * xWatermarks[ x ].ulStackDepth ) )
+			{
+				/* The least free as a share of the stack, other than the
+				test task. */
+				uxLeast = x;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		printf( "stack watermarks: %lu tasks, least free %s %lu of %lu words\n", ( unsigned long ) uxTasks, xWatermarks[ uxLeast ].pcTaskName, ( unsigned long ) xWatermarks[ uxLeast ].ulWatermark, ( unsigned long ) xWatermarks[ uxLeast ].ulStackDepth );
+
+		if( xStackMarkFound == pdFALSE )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the stack mark task is missing from the stack watermarks\n" );
+		}
+
+		if( ulStackMarkWarning != ( uint32_t ) mainSTACK_MARK_FREE_WORDS )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the stack watermark hook was not called for the stack mark task\n" );
+		}
+
+		if( pcUnexpectedStackWarning != NULL )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the stack watermark hook was called for %s\n", pcUnexpectedStackWarning );
+		}
+	}
+
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
+/*-----------------------------------------------------------*/
+
+static void prvStartTimerOverflowTest( void )
+{
+const TickType_t xTicksToHold = ( TickType_t ) ( mainOVERFLOW_HOLD_TICK - xTaskGetTickCount() );
+TimerHandle_t xHoldTimer;
+BaseType_t xResult;
+
+	/* Only run if the tick count overflows within the run time, but not so
+	soon the timers could miss it. */
+	if( ( xTicksToHold > pdMS_TO_TICKS( 100UL ) ) && ( xTicksToHold < ( portMAX_DELAY / 2 ) ) )
+	{
+		xHoldTimer = xTimerCreate( "OvfHold", xTicksToHold, pdFALSE, NULL, prvOverflowHoldCallback );
+		configASSERT( xHoldTimer );
+
+		/* Created before the one-shot timer is started, so the tick hook sees
+		it before mainOVERFLOW_START_TICK. */
+		xOverflowReloadTimer = xTimerCreate( "OvfReload", mainOVERFLOW_RELOAD_PERIOD, pdTRUE, NULL, prvOverflowReloadCallback );
+		configASSERT( xOverflowReloadTimer );
+
+		/* The timer queue can be full of the commands sent by the demo tasks
+		as they start, so wait for space. */
+		xResult = xTimerStart( xHoldTimer, portMAX_DELAY );
+		configASSERT( xResult );
+		( void ) xResult;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimerOverflowTest( void )
+{
+	if( xOverflowReloadTimer != NULL )
+	{
+		if( xOverflowReloadExpired == pdFALSE )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the timer started just before the tick count overflowed did not expire\n" );
+		}
+		else if( xOverflowReloadTime != mainOVERFLOW_RELOAD_TICK )
+		{
+			prvExit( EXIT_FAILURE, "FAIL: the timer started just before the tick count overflowed was reloaded to tick %lu, not %lu\n", ( unsigned long ) xOverflowReloadTime, ( unsigned long ) mainOVERFLOW_RELOAD_TICK );
+		}
+
+		printf( "timer overflow: reloaded to tick %lu\n", ( unsigned long ) xOverflowReloadTime );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverflowHoldCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	/* Keep the timer service task busy until the tick count has overflowed,
+	so the command sent by the tick hook at mainOVERFLOW_START_TICK waits on
+	the timer queue until after the overflow. */
+	while( xTaskGetTickCount() >= mainOVERFLOW_HOLD_TICK )
+	{
+		/* Busy wait, the tick interrupt still runs. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverflowReloadCallback( TimerHandle_t xTimer )
+{
+	/* The list item value of an auto-reload timer has already been moved on
+	to its next expiry time when its callback is called. */
+	if( xOverflowReloadExpired == pdFALSE )
+	{
+		xOverflowReloadTime = xTimerGetExpiryTime( xTimer );
+		xOverflowReloadExpired = pdTRUE;
+		xTimerStop( xTimer, 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvExit( int iStatus, const char *pcFormat, ... )
+{
+va_list xArgs;
+
+	/* Other task threads are suspended and may never run again, so output is
+	flushed and the process terminated without running exit handlers. */
+	vPortDisableInterrupts();
+	va_start( xArgs, pcFormat );
+	vprintf( pcFormat, xArgs );
+	va_end( xArgs );
+	fflush( stdout );
+	_exit( iStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* Called if a call to pvPortMalloc() fails because there is insufficient
+	free memory available in the FreeRTOS heap. */
+	prvExit( EXIT_FAILURE, "FAIL: malloc failed\n" );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
+{
+	( void ) pxTask;
+
+	/* Run time stack overflow checking is performed if
+	configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	function is called if a stack overflow is detected. */
+	prvExit( EXIT_FAILURE, "FAIL: stack overflow in %s\n", pcTaskName );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	if( xRunningFullDemo != pdFALSE )
+	{
+		vFullDemoIdleFunction();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vApplicationPassiveIdleHook( void )
+	{
+		vPortWaitForInterrupt();
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	if( xRunningFullDemo != pdFALSE )
+	{
+		vFullDemoTickHookFunction();
+
+		if( ( xOverflowReloadTimer != NULL ) && ( xTaskGetTickCountFromISR() == mainOVERFLOW_START_TICK ) )
+		{
+			xTimerStartFromISR( xOverflowReloadTimer, NULL );
+		}
+
+		/* Stands in for the TPU interrupts used by the IntQueue test on the
+		RX65N. */
+		vIntQueueTimerTickHook();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+	{
+	static StaticTask_t xIdleTaskTCBs[ configNUMBER_OF_CORES - 1 ];
+	static StackType_t uxIdleTaskStacks[ configNUMBER_OF_CORES - 1 ][ configMINIMAL_STACK_SIZE ];
+
+		*ppxIdleTaskTCBBuffer = &( xIdleTaskTCBs[ xPassiveIdleTaskIndex ] );
+		*ppxIdleTaskStackBuffer = uxIdleTaskStacks[ xPassiveIdleTaskIndex ];
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+static StaticTask_t xTimerTaskTCB;
+static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	void vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName, uint32_t ulWatermark )
+	{
+		/* Called within a critical section, so only records the warning for
+		prvCheckStackWatermarks(). */
+		if( xTask == xStackMarkTask )
+		{
+			ulStackMarkWarning = ulWatermark;
+		}
+		else
+		{
+			pcUnexpectedStackWarning = pcTaskName;
+		}
+	}
+
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	prvExit( EXIT_FAILURE, "FAIL: assert at %s:%lu\n", pcFile, ulLine );
+}
+/*-----------------------------------------------------------*/
+
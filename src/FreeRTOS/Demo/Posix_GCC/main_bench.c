@@ -0,0 +1,1043 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ * Kernel hot path benchmark for the Posix simulator build.
+ *
+ * A single benchmark task measures the cost of the operations below, in host
+ * cycles, using ullPortGetHostCycles().  No other application tasks run, and
+ * the tick hook does nothing, so the only other activity is the tick
+ * interrupt, the idle task and the (idle) timer service and deferred work
+ * tasks.  Each measurement is repeated benchROUNDS times and the median
+ * reported, which keeps the results stable from run to run so kernel changes
+ * can be compared against each other:
+ *
+ * + Context switch - two tasks of equal priority yielding to each other.
+ *
+ * + Queue send and queue receive - items written to and read from a queue
+ *   that no task is blocked on, with a block time of zero.
+ *
+ * + Batched queue send and receive - the same items moved
+ *   benchQUEUE_LENGTH at a time by xQueueSendMultiple() and
+ *   xQueueReceiveMultiple(), reported per item so they compare directly with
+ *   the single item figures.
+ *
+ * + Queue round trip - a value sent to a higher priority task that is blocked
+ *   on a queue, which then sends a value back, so each round trip includes two
+ *   context switches caused by unblocking a task.
+ *
+ * + Tick processing - the mean and worst case time spent in
+ *   xTaskIncrementTick() while the benchmark ran, as recorded by the port.
+ *
+ * + Timed block scaling - the queue round trip repeated with the higher
+ *   priority task blocking with a timeout, while an increasing number of other
+ *   tasks are in the Blocked state with earlier wake times.  This shows how the
+ *   cost of adding a task to the delayed task list grows with the number of
+ *   tasks already delayed (see configUSE_INDEXED_DELAY_LISTS).
+ *
+ * + Task selection - the benchmark task drops to priority benchLOW_PRIORITY
+ *   and resumes a task of priority benchHIGH_PRIORITY, which suspends itself
+ *   again straight away.  The mean time spent in vTaskSwitchContext(), as
+ *   recorded by the port, and the time for each resume and suspend are
+ *   reported.  Without configUSE_PORT_OPTIMISED_TASK_SELECTION each switch
+ *   back down walks the empty ready lists between the two priorities, so the
+ *   cost grows with configMAX_PRIORITIES.  make switchbench compares 7 and 32
+ *   priorities with and without the port optimised selection.
+ *
+ * + Time slicing - benchTIME_SLICE_TASKS tasks that never block share priority
+ *   benchLOW_PRIORITY for benchTIME_SLICE_RUN_TIME with each of the time
+ *   slices in xBenchTimeSlices[] set by vTaskSetTimeSlice().  The number of
+ *   times the tasks switched between themselves, and the number of tick
+ *   interrupts that switched tasks, are reported.  A time slice of
+ *   portMAX_DELAY leaves the first task to run to completion.  Only built
+ *   with configUSE_TIME_SLICE_QUANTA set to 1.
+ *
+ * + Stream buffer throughput - the sender and receiver tasks from
+ *   Demo/Common/Minimal/StreamBufferDemo.c are left to run for
+ *   benchSTREAM_BUFFER_RUN_TIME, then the bytes per second they achieved
+ *   through a stream buffer created with and without sbFLAGS_LOCKFREE_SPSC are
+ *   reported.  These tasks are not deleted, so this measurement is made last.
+ *
+ * + Trace recorder overhead - the context switch and queue round trip
+ *   measurements repeated with the trace recorder stopped, then recording
+ *   every event class in snapshot mode.  Each context switch then writes one
+ *   record, and each round trip ten.  The time to write one record is also
+ *   measured on its own, from a critical section as the context switch, tick,
+ *   queue and notification events are, and with the recorder masking
+ *   interrupts itself as the other events do.  Masking interrupts is a system
+ *   call in the simulator but a single instruction on the RX, so the simulator
+ *   overstates the cost of the second.
+ *
+ * + Software timers - xRunTimerScalingTest() from
+ *   Demo/Common/Minimal/TimerDemo.c is run with each of the counts of timers in
+ *   uxTimerCounts[] for benchTIMER_RUN_TIME.  All the timers expire on the same
+ *   ticks, and half of them are one-shot timers restarted from their callback.
+ *   The callbacks made, the restarts that could not be sent, the most ticks a
+ *   callback ran late, and the timer service task's host cycles per callback
+ *   (including the commands that start and delete the timers) are reported.
+ *   make timerbench compares configUSE_TIMER_DIRECT_COMMANDS and
+ *   configUSE_TIMER_WHEEL.
+ *
+ * + Deferred function calls - a function that does nothing is run by the
+ *   timer service task, using xTimerPendFunctionCall(), and by the deferred
+ *   work task, using xDeferredFunctionCall().  Both tasks have a higher
+ *   priority than the benchmark task, so a single call is run before the post
+ *   returns, and the time per call includes two task switches.  The calls are
+ *   then posted benchDEFERRED_BURST at a time with the scheduler suspended,
+ *   when the deferred work task is only notified once per burst.  Last, a work
+ *   item is posted benchDEFERRED_BURST times with the scheduler suspended, so
+ *   it is run once per burst.
+ *
+ * + Event groups - xRunEventGroupLatencyTest() from
+ *   Demo/Common/Minimal/EventGroupsDemo.c is run with each of the counts of
+ *   tasks in uxRendezvousTaskCounts[].  The host cycles from a bit being set by
+ *   xEventGroupSetBitsFromISR(), called with interrupts masked, until the task
+ *   waiting for it runs are reported while the other tasks are blocked on the
+ *   same event group, then the host cycles per rendezvous of all the tasks
+ *   with xEventGroupSync().  make eventbench compares
+ *   configUSE_EVENT_GROUP_DIRECT_ISR and configUSE_EVENT_GROUP_BIT_INDEX.
+ *
+ * The results are expected to be compared between builds of the same host,
+ * not against the target - they show relative cost, not RX65N cycles.  Kernel
+ * options can be compared without editing FreeRTOSConfig.h by defining them on
+ * the make command line, for example:
+ *
+ *   make bench BUILD_DIR=build/indexed KERNEL_OPTIONS=-DconfigUSE_INDEXED_DELAY_LISTS=1
+ ******************************************************************************/
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "deferred_work.h"
+
+/* Demo includes. */
+#include "EventGroupsDemo.h"
+#include "StreamBufferDemo.h"
+#include "TimerDemo.h"
+
+/* The number of times each measurement is repeated.  The median is reported. */
+#define benchROUNDS						( 7 )
+
+/* The number of operations timed in each round. */
+#define benchITERATIONS					( 20000UL )
+
+/* The length of the queue used to time send and receive without blocking. */
+#define benchQUEUE_LENGTH				( 16 )
+
+/* Priorities of the benchmark task and the tasks it communicates with.  All
+are below the timer service task so it can never be starved. */
+#define benchTASK_PRIORITY				( configMAX_PRIORITIES - 3 )
+#define benchPARTNER_PRIORITY			( configMAX_PRIORITIES - 2 )
+
+/* The priorities used by the task selection measurement, which are as far
+apart as the timer service task and the idle task allow. */
+#define benchLOW_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define benchHIGH_PRIORITY				( configMAX_PRIORITIES - 2 )
+
+/* The block time used by the echo task in the timed block measurements, and
+the range of block times used by the tasks that are delayed while it runs.  All
+the delayed tasks wake before the echo task times out, so the echo task is
+always added to the end of the delayed task list. */
+#define benchTIMED_BLOCK_TICKS			pdMS_TO_TICKS( 60000UL )
+#define benchSLEEP_MIN_TICKS			pdMS_TO_TICKS( 20000UL )
+#define benchSLEEP_RANGE_TICKS			pdMS_TO_TICKS( 10000UL )
+
+/* How long the stream buffer throughput tasks are left to run, and their
+priority. */
+#define benchSTREAM_BUFFER_RUN_TIME		pdMS_TO_TICKS( 3000UL )
+#define benchSTREAM_BUFFER_PRIORITY		( benchTASK_PRIORITY - 1 )
+
+/* The number of delayed tasks used in each timed block measurement. */
+static const UBaseType_t uxDelayedTaskCounts[] = { 0, 16, 64, 256 };
+#define benchNUM_DELAYED_TASK_COUNTS	( sizeof( uxDelayedTaskCounts ) / sizeof( uxDelayedTaskCounts[ 0 ] ) )
+
+/* The number of tasks sharing a priority in the time slicing measurement, how
+long each time slice is measured for, and the time slices measured. */
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+	#define benchTIME_SLICE_TASKS		( 3 )
+	#define benchTIME_SLICE_RUN_TIME	pdMS_TO_TICKS( 1000UL )
+	static const TickType_t xBenchTimeSlices[] = { 1, 4, 20, portMAX_DELAY };
+	#define benchNUM_TIME_SLICES		( sizeof( xBenchTimeSlices ) / sizeof( xBenchTimeSlices[ 0 ] ) )
+#endif
+
+/* The number of software timers used in each timer measurement, and how long
+each measurement runs. */
+static const UBaseType_t uxTimerCounts[] = { 16, 64, 256, 1024 };
+#define benchNUM_TIMER_COUNTS			( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) )
+#define benchTIMER_RUN_TIME				pdMS_TO_TICKS( 1000UL )
+
+/* The number of deferred function calls posted at once, which must be less
+than the length of the timer queue. */
+#define benchDEFERRED_BURST				( 4UL )
+
+/* The number of tasks that wait on the event group in each event group
+measurement, and the number of sets and rendezvous timed. */
+static const UBaseType_t uxRendezvousTaskCounts[] = { 2, 8, 22 };
+#define benchNUM_RENDEZVOUS_TASK_COUNTS	( sizeof( uxRendezvousTaskCounts ) / sizeof( uxRendezvousTaskCounts[ 0 ] ) )
+#define benchEVENT_GROUP_ITERATIONS		( 2000UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Performs the measurements, prints the results, then ends the scheduler.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The individual measurements.  Each returns the cost of one operation, in
+ * host cycles.
+ */
+static uint64_t prvMeasureContextSwitch( void );
+static void prvMeasureQueueNoBlock( uint64_t *pullSendCycles, uint64_t *pullReceiveCycles );
+static void prvMeasureQueueBatch( uint64_t *pullSendCycles, uint64_t *pullReceiveCycles );
+static uint64_t prvMeasureQueueRoundTrip( void );
+
+/*
+ * Measure the timed block round trip with each of the counts of delayed tasks
+ * in uxDelayedTaskCounts[], and print the results.
+ */
+static void prvMeasureTimedBlockScaling( void );
+
+/*
+ * Measure the cost of switching between two tasks with widely separated
+ * priorities, and print the results.
+ */
+static void prvMeasureTaskSelection( void );
+
+/*
+ * Count the switches between tasks of equal priority that never block with
+ * each of the time slices in xBenchTimeSlices[], and print the results.
+ */
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+	static void prvMeasureTimeSlicing( void );
+#endif
+
+/*
+ * Measure the context switch and queue round trip with and without the trace
+ * recorder running, and the cost of writing one record, and print the results.
+ */
+#if( configUSE_TRACE_RECORDER == 1 )
+	static void prvMeasureTraceRecorder( void );
+	static uint64_t prvMeasureTraceRecord( BaseType_t xAlreadyMasked );
+#endif
+
+/*
+ * Run the TimerDemo.c timer scaling test with each of the counts of timers in
+ * uxTimerCounts[], and print the results.
+ */
+static void prvMeasureSoftwareTimers( void );
+
+/*
+ * Time deferred function calls made through the timer service task and the
+ * deferred work task, and print the results.
+ */
+static void prvMeasureDeferredCalls( void );
+
+/*
+ * The function run by the deferred function call measurement, which counts
+ * the calls.
+ */
+static void prvDeferredFunction( void *pvParameter1, uint32_t ulParameter2 );
+
+/*
+ * Times setting event group bits from an interrupt until the waiting task runs,
+ * and rendezvous of several tasks, with different numbers of tasks waiting.
+ */
+static void prvMeasureEventGroups( void );
+
+/*
+ * Start the stream buffer throughput tasks, and report the bytes per second
+ * they achieve with and without sbFLAGS_LOCKFREE_SPSC.
+ */
+static void prvMeasureStreamBuffer( void );
+
+/*
+ * Tasks the benchmark task communicates with.
+ */
+static void prvYieldTask( void *pvParameters );
+static void prvEchoTask( void *pvParameters );
+static void prvTimedEchoTask( void *pvParameters );
+static void prvSleepingTask( void *pvParameters );
+static void prvSuspendingTask( void *pvParameters );
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+	static void prvSpinningTask( void *pvParameters );
+#endif
+
+/*
+ * Returns the median of the benchROUNDS values in pullValues, sorting the
+ * array in the process.
+ */
+static uint64_t prvMedian( uint64_t *pullValues );
+
+/*-----------------------------------------------------------*/
+
+/* The queues used by the round trip measurement. */
+static QueueHandle_t xToEchoTask = NULL, xFromEchoTask = NULL;
+
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+
+	/* The index of the spinning task that ran last, and the number of times a
+	different spinning task has run since the count was cleared. */
+	static volatile UBaseType_t uxLastSpinningTask = 0;
+	static volatile uint32_t ulSpinningTaskSwitches = 0UL;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+void main_bench( void )
+{
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, NULL );
+
+	/* Returns when the benchmark task calls vTaskEndScheduler(). */
+	vTaskStartScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+uint64_t ullSwitch[ benchROUNDS ], ullSend[ benchROUNDS ], ullReceive[ benchROUNDS ], ullRoundTrip[ benchROUNDS ];
+uint64_t ullBatchSend[ benchROUNDS ], ullBatchReceive[ benchROUNDS ];
+PortTickStats_t xTickStats;
+BaseType_t xRound;
+
+	( void ) pvParameters;
+
+	xToEchoTask = xQueueCreate( 1, sizeof( uint32_t ) );
+	xFromEchoTask = xQueueCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xToEchoTask );
+	configASSERT( xFromEchoTask );
+
+	/* Let the tick settle before statistics are collected. */
+	vTaskDelay( pdMS_TO_TICKS( 10 ) );
+	vPortResetTickStats();
+
+	for( xRound = 0; xRound < benchROUNDS; xRound++ )
+	{
+		ullSwitch[ xRound ] = prvMeasureContextSwitch();
+		prvMeasureQueueNoBlock( &( ullSend[ xRound ] ), &( ullReceive[ xRound ] ) );
+		prvMeasureQueueBatch( &( ullBatchSend[ xRound ] ), &( ullBatchReceive[ xRound ] ) );
+		ullRoundTrip[ xRound ] = prvMeasureQueueRoundTrip();
+	}
+
+	vPortGetTickStats( &xTickStats );
+
+	taskENTER_CRITICAL();
+	{
+		printf( "FreeRTOS kernel benchmark, host cycles per operation, median of %d rounds of %lu\n", benchROUNDS, benchITERATIONS );
+		printf( "  context switch (taskYIELD)               %10llu\n", ( unsigned long long ) prvMedian( ullSwitch ) );
+		printf( "  queue send, no task waiting              %10llu\n", ( unsigned long long ) prvMedian( ullSend ) );
+		printf( "  queue receive, no blocking               %10llu\n", ( unsigned long long ) prvMedian( ullReceive ) );
+		printf( "  queue send, per item in batches of %2d    %10llu\n", benchQUEUE_LENGTH, ( unsigned long long ) prvMedian( ullBatchSend ) );
+		printf( "  queue receive, per item in batches of %2d %10llu\n", benchQUEUE_LENGTH, ( unsigned long long ) prvMedian( ullBatchReceive ) );
+		printf( "  queue round trip, two task switches      %10llu\n", ( unsigned long long ) prvMedian( ullRoundTrip ) );
+
+		if( xTickStats.ullTickCount > 0 )
+		{
+			printf( "  tick processing, mean                    %10llu\n", ( unsigned long long ) ( xTickStats.ullTickCycles / xTickStats.ullTickCount ) );
+			printf( "  tick processing, worst case              %10llu\n", ( unsigned long long ) xTickStats.ullMaxTickCycles );
+			printf( "  ticks processed / ticks that switched    %10llu / %llu\n", ( unsigned long long ) xTickStats.ullTickCount, ( unsigned long long ) xTickStats.ullTickSwitchCount );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	prvMeasureTimedBlockScaling();
+	prvMeasureTaskSelection();
+
+	#if( configUSE_TIME_SLICE_QUANTA == 1 )
+	{
+		prvMeasureTimeSlicing();
+	}
+	#endif
+
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		prvMeasureTraceRecorder();
+	}
+	#endif
+
+	prvMeasureSoftwareTimers();
+	prvMeasureDeferredCalls();
+	prvMeasureEventGroups();
+	prvMeasureStreamBuffer();
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMeasureContextSwitch( void )
+{
+TaskHandle_t xPartner = NULL;
+uint64_t ullStart, ullCycles;
+uint32_t ul;
+
+	/* The partner task has the same priority as this task, so does not run
+	until this task yields. */
+	xTaskCreate( prvYieldTask, "Yield", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, &xPartner );
+	configASSERT( xPartner );
+
+	/* Ensure the partner task's thread has started before timing begins. */
+	taskYIELD();
+
+	ullStart = ullPortGetHostCycles();
+	for( ul = 0; ul < benchITERATIONS; ul++ )
+	{
+		taskYIELD();
+	}
+	ullCycles = ullPortGetHostCycles() - ullStart;
+
+	vTaskDelete( xPartner );
+
+	/* Each yield switches to the partner task and back again. */
+	return ullCycles / ( benchITERATIONS * 2UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureQueueNoBlock( uint64_t *pullSendCycles, uint64_t *pullReceiveCycles )
+{
+QueueHandle_t xQueue;
+uint64_t ullStart, ullSendCycles = 0, ullReceiveCycles = 0;
+uint32_t ul, ulValue = 0;
+BaseType_t x;
+
+	xQueue = xQueueCreate( benchQUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	for( ul = 0; ul < benchITERATIONS; ul += benchQUEUE_LENGTH )
+	{
+		ullStart = ullPortGetHostCycles();
+		for( x = 0; x < benchQUEUE_LENGTH; x++ )
+		{
+			( void ) xQueueSend( xQueue, &ulValue, 0 );
+		}
+		ullSendCycles += ullPortGetHostCycles() - ullStart;
+
+		ullStart = ullPortGetHostCycles();
+		for( x = 0; x < benchQUEUE_LENGTH; x++ )
+		{
+			( void ) xQueueReceive( xQueue, &ulValue, 0 );
+		}
+		ullReceiveCycles += ullPortGetHostCycles() - ullStart;
+	}
+
+	vQueueDelete( xQueue );
+
+	*pullSendCycles = ullSendCycles / benchITERATIONS;
+	*pullReceiveCycles = ullReceiveCycles / benchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureQueueBatch( uint64_t *pullSendCycles, uint64_t *pullReceiveCycles )
+{
+QueueHandle_t xQueue;
+uint64_t ullStart, ullSendCycles = 0, ullReceiveCycles = 0;
+uint32_t ul, ulValues[ benchQUEUE_LENGTH ] = { 0 };
+
+	xQueue = xQueueCreate( benchQUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	for( ul = 0; ul < benchITERATIONS; ul += benchQUEUE_LENGTH )
+	{
+		ullStart = ullPortGetHostCycles();
+		( void ) xQueueSendMultiple( xQueue, ulValues, benchQUEUE_LENGTH, 0 );
+		ullSendCycles += ullPortGetHostCycles() - ullStart;
+
+		ullStart = ullPortGetHostCycles();
+		( void ) xQueueReceiveMultiple( xQueue, ulValues, benchQUEUE_LENGTH, 0 );
+		ullReceiveCycles += ullPortGetHostCycles() - ullStart;
+	}
+
+	vQueueDelete( xQueue );
+
+	*pullSendCycles = ullSendCycles / benchITERATIONS;
+	*pullReceiveCycles = ullReceiveCycles / benchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMeasureQueueRoundTrip( void )
+{
+TaskHandle_t xPartner = NULL;
+uint64_t ullStart, ullCycles;
+uint32_t ul, ulValue;
+
+	/* The echo task has a higher priority than this task so runs immediately
+	and blocks on xToEchoTask. */
+	xTaskCreate( prvEchoTask, "Echo", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, &xPartner );
+	configASSERT( xPartner );
+
+	ullStart = ullPortGetHostCycles();
+	for( ul = 0; ul < benchITERATIONS; ul++ )
+	{
+		( void ) xQueueSend( xToEchoTask, &ul, portMAX_DELAY );
+		( void ) xQueueReceive( xFromEchoTask, &ulValue, portMAX_DELAY );
+		configASSERT( ulValue == ul );
+	}
+	ullCycles = ullPortGetHostCycles() - ullStart;
+
+	vTaskDelete( xPartner );
+
+	return ullCycles / benchITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTimedBlockScaling( void )
+{
+TaskHandle_t xEchoTask = NULL, xSleepingTasks[ 256 ];
+uint64_t ullRoundTrip[ benchROUNDS ], ullStart;
+UBaseType_t uxCount, uxCreated = 0;
+BaseType_t xRound;
+uint32_t ul, ulValue;
+
+	configASSERT( uxDelayedTaskCounts[ benchNUM_DELAYED_TASK_COUNTS - 1 ] <= ( sizeof( xSleepingTasks ) / sizeof( xSleepingTasks[ 0 ] ) ) );
+
+	xTaskCreate( prvTimedEchoTask, "TEcho", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, &xEchoTask );
+	configASSERT( xEchoTask );
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  queue round trip with timeout, by number of delayed tasks:\n" );
+	}
+	taskEXIT_CRITICAL();
+
+	for( uxCount = 0; uxCount < benchNUM_DELAYED_TASK_COUNTS; uxCount++ )
+	{
+		/* Top up the number of tasks in the Blocked state.  The sleeping
+		tasks have a higher priority than this task, so each runs and blocks
+		as soon as it is created. */
+		while( uxCreated < uxDelayedTaskCounts[ uxCount ] )
+		{
+			xTaskCreate( prvSleepingTask, "Sleep", configMINIMAL_STACK_SIZE, ( void * ) uxCreated, benchPARTNER_PRIORITY, &( xSleepingTasks[ uxCreated ] ) );
+			configASSERT( xSleepingTasks[ uxCreated ] );
+			uxCreated++;
+		}
+
+		for( xRound = 0; xRound < benchROUNDS; xRound++ )
+		{
+			ullStart = ullPortGetHostCycles();
+			for( ul = 0; ul < benchITERATIONS; ul++ )
+			{
+				( void ) xQueueSend( xToEchoTask, &ul, portMAX_DELAY );
+				( void ) xQueueReceive( xFromEchoTask, &ulValue, portMAX_DELAY );
+			}
+			ullRoundTrip[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+		}
+
+		taskENTER_CRITICAL();
+		{
+			printf( "    %4lu delayed tasks                      %10llu\n", ( unsigned long ) uxDelayedTaskCounts[ uxCount ], ( unsigned long long ) prvMedian( ullRoundTrip ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	while( uxCreated > 0 )
+	{
+		uxCreated--;
+		vTaskDelete( xSleepingTasks[ uxCreated ] );
+	}
+
+	vTaskDelete( xEchoTask );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTaskSelection( void )
+{
+TaskHandle_t xSuspendingTask = NULL;
+uint64_t ullSelect[ benchROUNDS ], ullRoundTrip[ benchROUNDS ], ullStart;
+PortTickStats_t xStatsBefore, xStatsAfter;
+BaseType_t xRound;
+uint32_t ul;
+
+	/* The suspending task runs as soon as it is created, and suspends itself
+	until this task resumes it. */
+	vTaskPrioritySet( NULL, benchLOW_PRIORITY );
+	xTaskCreate( prvSuspendingTask, "Susp", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xSuspendingTask );
+	configASSERT( xSuspendingTask );
+
+	for( xRound = 0; xRound < benchROUNDS; xRound++ )
+	{
+		vPortGetTickStats( &xStatsBefore );
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul++ )
+		{
+			vTaskResume( xSuspendingTask );
+		}
+		ullRoundTrip[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+		vPortGetTickStats( &xStatsAfter );
+
+		ullSelect[ xRound ] = ( xStatsAfter.ullSwitchCycles - xStatsBefore.ullSwitchCycles ) / ( xStatsAfter.ullSwitchCount - xStatsBefore.ullSwitchCount );
+	}
+
+	vTaskDelete( xSuspendingTask );
+	vTaskPrioritySet( NULL, benchTASK_PRIORITY );
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  task selection, %d priorities, configUSE_PORT_OPTIMISED_TASK_SELECTION %d:\n", configMAX_PRIORITIES, configUSE_PORT_OPTIMISED_TASK_SELECTION );
+		printf( "    vTaskSwitchContext(), priority %2d and %d %10llu\n", ( int ) benchHIGH_PRIORITY, ( int ) benchLOW_PRIORITY, ( unsigned long long ) prvMedian( ullSelect ) );
+		printf( "    resume and suspend, two task switches  %10llu\n", ( unsigned long long ) prvMedian( ullRoundTrip ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+
+	static void prvMeasureTimeSlicing( void )
+	{
+	TaskHandle_t xSpinningTasks[ benchTIME_SLICE_TASKS ];
+	uint32_t ulSwitches[ benchNUM_TIME_SLICES ];
+	uint64_t ullTickSwitches[ benchNUM_TIME_SLICES ];
+	PortTickStats_t xStatsBefore, xStatsAfter;
+	UBaseType_t uxSlice, x;
+
+		for( uxSlice = 0; uxSlice < benchNUM_TIME_SLICES; uxSlice++ )
+		{
+			vTaskSetTimeSlice( benchLOW_PRIORITY, xBenchTimeSlices[ uxSlice ] );
+
+			/* The spinning tasks have a lower priority than this task, so do not
+			run until it blocks.  Their indexes start from 1 so the first to run
+			counts as a switch. */
+			uxLastSpinningTask = 0;
+			ulSpinningTaskSwitches = 0UL;
+			for( x = 0; x < benchTIME_SLICE_TASKS; x++ )
+			{
+				xSpinningTasks[ x ] = NULL;
+				xTaskCreate( prvSpinningTask, "Spin", configMINIMAL_STACK_SIZE, ( void * ) ( x + 1 ), benchLOW_PRIORITY, &( xSpinningTasks[ x ] ) );
+				configASSERT( xSpinningTasks[ x ] );
+			}
+
+			vPortGetTickStats( &xStatsBefore );
+			vTaskDelay( benchTIME_SLICE_RUN_TIME );
+			vPortGetTickStats( &xStatsAfter );
+
+			ulSwitches[ uxSlice ] = ulSpinningTaskSwitches;
+			ullTickSwitches[ uxSlice ] = xStatsAfter.ullTickSwitchCount - xStatsBefore.ullTickSwitchCount;
+
+			for( x = 0; x < benchTIME_SLICE_TASKS; x++ )
+			{
+				vTaskDelete( xSpinningTasks[ x ] );
+			}
+		}
+
+		/* Back to configTIME_SLICE_TICKS(). */
+		vTaskSetTimeSlice( benchLOW_PRIORITY, 0 );
+
+		taskENTER_CRITICAL();
+		{
+			printf( "  time slicing, %d tasks of priority %d for %lu ticks, switches between them / ticks that switched:\n", benchTIME_SLICE_TASKS, ( int ) benchLOW_PRIORITY, ( unsigned long ) benchTIME_SLICE_RUN_TIME );
+			for( uxSlice = 0; uxSlice < benchNUM_TIME_SLICES; uxSlice++ )
+			{
+				if( xBenchTimeSlices[ uxSlice ] == portMAX_DELAY )
+				{
+					printf( "    run to completion                      %10lu / %llu\n", ( unsigned long ) ulSwitches[ uxSlice ], ( unsigned long long ) ullTickSwitches[ uxSlice ] );
+				}
+				else
+				{
+					printf( "    time slice of %2lu ticks                  %10lu / %llu\n", ( unsigned long ) xBenchTimeSlices[ uxSlice ], ( unsigned long ) ulSwitches[ uxSlice ], ( unsigned long long ) ullTickSwitches[ uxSlice ] );
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIME_SLICE_QUANTA */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	static void prvMeasureTraceRecorder( void )
+	{
+	uint64_t ullSwitch[ benchROUNDS ], ullRoundTrip[ benchROUNDS ], ullTracedSwitch[ benchROUNDS ], ullTracedRoundTrip[ benchROUNDS ];
+	uint64_t ullMaskedRecord[ benchROUNDS ], ullRecord[ benchROUNDS ];
+	uint64_t ullSwitchMedian, ullTracedSwitchMedian, ullRoundTripMedian, ullTracedRoundTripMedian;
+	BaseType_t xRound;
+
+		/* Alternate between the two so both see the same host conditions. */
+		for( xRound = 0; xRound < benchROUNDS; xRound++ )
+		{
+			ullSwitch[ xRound ] = prvMeasureContextSwitch();
+			ullRoundTrip[ xRound ] = prvMeasureQueueRoundTrip();
+
+			vTraceRecorderStart( eTraceSnapshot, traceCLASS_ALL );
+			ullTracedSwitch[ xRound ] = prvMeasureContextSwitch();
+			ullTracedRoundTrip[ xRound ] = prvMeasureQueueRoundTrip();
+			ullMaskedRecord[ xRound ] = prvMeasureTraceRecord( pdTRUE );
+			ullRecord[ xRound ] = prvMeasureTraceRecord( pdFALSE );
+			vTraceRecorderStop();
+		}
+
+		ullSwitchMedian = prvMedian( ullSwitch );
+		ullTracedSwitchMedian = prvMedian( ullTracedSwitch );
+		ullRoundTripMedian = prvMedian( ullRoundTrip );
+		ullTracedRoundTripMedian = prvMedian( ullTracedRoundTrip );
+
+		taskENTER_CRITICAL();
+		{
+			printf( "  trace recorder stopped / recording every class:\n" );
+			printf( "    context switch (taskYIELD)             %10llu / %llu (%+.1f%%)\n", ( unsigned long long ) ullSwitchMedian, ( unsigned long long ) ullTracedSwitchMedian, ( ( ( double ) ullTracedSwitchMedian - ( double ) ullSwitchMedian ) * 100.0 ) / ( double ) ullSwitchMedian );
+			printf( "    queue round trip, two task switches    %10llu / %llu (%+.1f%%)\n", ( unsigned long long ) ullRoundTripMedian, ( unsigned long long ) ullTracedRoundTripMedian, ( ( ( double ) ullTracedRoundTripMedian - ( double ) ullRoundTripMedian ) * 100.0 ) / ( double ) ullRoundTripMedian );
+			printf( "  trace record, already masked / masked by the recorder:\n" );
+			printf( "    one record                             %10llu / %llu\n", ( unsigned long long ) prvMedian( ullMaskedRecord ), ( unsigned long long ) prvMedian( ullRecord ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint64_t prvMeasureTraceRecord( BaseType_t xAlreadyMasked )
+	{
+	uint64_t ullStart, ullCycles;
+	uint32_t ul;
+
+		/* Both write user event records.  The first is written as the context
+		switch, tick, queue and notification events are, where interrupts are
+		already masked, and the second as the other events are. */
+		if( xAlreadyMasked != pdFALSE )
+		{
+			ullStart = ullPortGetHostCycles();
+			taskENTER_CRITICAL();
+			{
+				for( ul = 0; ul < benchITERATIONS; ul++ )
+				{
+					traceRECORD_MASKED( traceCLASS_USER, traceEVENT_USER, ul, 0 );
+				}
+			}
+			taskEXIT_CRITICAL();
+			ullCycles = ullPortGetHostCycles() - ullStart;
+		}
+		else
+		{
+			ullStart = ullPortGetHostCycles();
+			for( ul = 0; ul < benchITERATIONS; ul++ )
+			{
+				vTraceRecorderUserEvent( ul, 0 );
+			}
+			ullCycles = ullPortGetHostCycles() - ullStart;
+		}
+
+		return ullCycles / benchITERATIONS;
+	}
+
+#endif /* configUSE_TRACE_RECORDER */
+/*-----------------------------------------------------------*/
+
+static void prvMeasureSoftwareTimers( void )
+{
+TaskStatus_t xTimerTaskStatus;
+configRUN_TIME_COUNTER_TYPE ullStartRunTime, ullRunTime;
+uint32_t ulCallbacks, ulRestartsFailed;
+TickType_t xMaxLateness;
+BaseType_t xResult;
+size_t x;
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  software timers, configUSE_TIMER_DIRECT_COMMANDS %d, configUSE_TIMER_WHEEL %d:\n", configUSE_TIMER_DIRECT_COMMANDS, configUSE_TIMER_WHEEL );
+		printf( "    timers  callbacks  restarts failed  max late ticks  cycles per callback\n" );
+	}
+	taskEXIT_CRITICAL();
+
+	for( x = 0; x < benchNUM_TIMER_COUNTS; x++ )
+	{
+		vTaskGetInfo( xTimerGetTimerDaemonTaskHandle(), &xTimerTaskStatus, pdFALSE, eBlocked );
+		ullStartRunTime = xTimerTaskStatus.ulRunTimeCounter;
+
+		xResult = xRunTimerScalingTest( uxTimerCounts[ x ], benchTIMER_RUN_TIME, &ulCallbacks, &ulRestartsFailed, &xMaxLateness );
+
+		vTaskGetInfo( xTimerGetTimerDaemonTaskHandle(), &xTimerTaskStatus, pdFALSE, eBlocked );
+		ullRunTime = xTimerTaskStatus.ulRunTimeCounter - ullStartRunTime;
+
+		taskENTER_CRITICAL();
+		{
+			if( ( xResult == pdPASS ) && ( ulCallbacks > 0 ) )
+			{
+				printf( "    %6lu %10lu %16lu %15lu %20llu\n", ( unsigned long ) uxTimerCounts[ x ], ( unsigned long ) ulCallbacks, ( unsigned long ) ulRestartsFailed, ( unsigned long ) xMaxLateness, ( unsigned long long ) ( ullRunTime / ulCallbacks ) );
+			}
+			else
+			{
+				printf( "    %6lu timers missed expiries\n", ( unsigned long ) uxTimerCounts[ x ] );
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+	( void ) ulParameter2;
+
+	( *( ( volatile uint32_t * ) pvParameter1 ) )++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureDeferredCalls( void )
+{
+uint64_t ullTimerSingle[ benchROUNDS ], ullTimerBurst[ benchROUNDS ], ullDeferredSingle[ benchROUNDS ], ullDeferredBurst[ benchROUNDS ], ullWorkItem[ benchROUNDS ];
+uint64_t ullStart;
+static volatile uint32_t ulCalls = 0UL;
+DeferredWork_t xWorkItem;
+BaseType_t xRound;
+uint32_t ul, ulBurst;
+
+	vDeferredWorkInit( &xWorkItem, prvDeferredFunction, ( void * ) &ulCalls, 0UL );
+
+	for( xRound = 0; xRound < benchROUNDS; xRound++ )
+	{
+		ulCalls = 0UL;
+
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul++ )
+		{
+			( void ) xTimerPendFunctionCall( prvDeferredFunction, ( void * ) &ulCalls, 0UL, portMAX_DELAY );
+		}
+		ullTimerSingle[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul++ )
+		{
+			( void ) xDeferredFunctionCall( prvDeferredFunction, ( void * ) &ulCalls, 0UL );
+		}
+		ullDeferredSingle[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul += benchDEFERRED_BURST )
+		{
+			vTaskSuspendAll();
+			for( ulBurst = 0; ulBurst < benchDEFERRED_BURST; ulBurst++ )
+			{
+				( void ) xTimerPendFunctionCall( prvDeferredFunction, ( void * ) &ulCalls, 0UL, 0 );
+			}
+			( void ) xTaskResumeAll();
+		}
+		ullTimerBurst[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul += benchDEFERRED_BURST )
+		{
+			vTaskSuspendAll();
+			for( ulBurst = 0; ulBurst < benchDEFERRED_BURST; ulBurst++ )
+			{
+				( void ) xDeferredFunctionCall( prvDeferredFunction, ( void * ) &ulCalls, 0UL );
+			}
+			( void ) xTaskResumeAll();
+		}
+		ullDeferredBurst[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+
+		ullStart = ullPortGetHostCycles();
+		for( ul = 0; ul < benchITERATIONS; ul += benchDEFERRED_BURST )
+		{
+			vTaskSuspendAll();
+			for( ulBurst = 0; ulBurst < benchDEFERRED_BURST; ulBurst++ )
+			{
+				( void ) xDeferredWorkPost( &xWorkItem );
+			}
+			( void ) xTaskResumeAll();
+		}
+		ullWorkItem[ xRound ] = ( ullPortGetHostCycles() - ullStart ) / benchITERATIONS;
+
+		/* The four function call measurements each made benchITERATIONS
+		calls, and the work item runs once per burst. */
+		configASSERT( ulCalls == ( ( 4UL * benchITERATIONS ) + ( benchITERATIONS / benchDEFERRED_BURST ) ) );
+	}
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  deferred function calls, timer task / deferred work task:\n" );
+		printf( "    one call, run before the post returns  %10llu / %llu\n", ( unsigned long long ) prvMedian( ullTimerSingle ), ( unsigned long long ) prvMedian( ullDeferredSingle ) );
+		printf( "    per call in bursts of %lu                %10llu / %llu\n", benchDEFERRED_BURST, ( unsigned long long ) prvMedian( ullTimerBurst ), ( unsigned long long ) prvMedian( ullDeferredBurst ) );
+		printf( "    work item, per post in bursts of %lu                  %llu\n", benchDEFERRED_BURST, ( unsigned long long ) prvMedian( ullWorkItem ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureEventGroups( void )
+{
+configRUN_TIME_COUNTER_TYPE ullSetToRun, ullRendezvous;
+BaseType_t xResult;
+size_t x;
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  event groups, configUSE_EVENT_GROUP_DIRECT_ISR %d, configUSE_EVENT_GROUP_BIT_INDEX %d:\n", configUSE_EVENT_GROUP_DIRECT_ISR, configUSE_EVENT_GROUP_BIT_INDEX );
+		printf( "    tasks  set from ISR to task running  rendezvous\n" );
+	}
+	taskEXIT_CRITICAL();
+
+	for( x = 0; x < benchNUM_RENDEZVOUS_TASK_COUNTS; x++ )
+	{
+		xResult = xRunEventGroupLatencyTest( uxRendezvousTaskCounts[ x ], benchEVENT_GROUP_ITERATIONS, &ullSetToRun, &ullRendezvous );
+
+		taskENTER_CRITICAL();
+		{
+			if( xResult == pdPASS )
+			{
+				printf( "    %5lu %28llu %11llu\n", ( unsigned long ) uxRendezvousTaskCounts[ x ], ( unsigned long long ) ullSetToRun, ( unsigned long long ) ullRendezvous );
+			}
+			else
+			{
+				printf( "    %5lu tasks failed\n", ( unsigned long ) uxRendezvousTaskCounts[ x ] );
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureStreamBuffer( void )
+{
+uint32_t ulLocked, ulLockFree;
+
+	/* The tasks have a lower priority than this task, so only run while this
+	task is delayed. */
+	vStartStreamBufferThroughputTasks( benchSTREAM_BUFFER_PRIORITY );
+	vTaskDelay( benchSTREAM_BUFFER_RUN_TIME );
+
+	ulLocked = ulGetStreamBufferThroughput( pdFALSE );
+	ulLockFree = ulGetStreamBufferThroughput( pdTRUE );
+
+	taskENTER_CRITICAL();
+	{
+		printf( "  stream buffer bytes per second, default / sbFLAGS_LOCKFREE_SPSC:\n" );
+		printf( "    32 byte writes and reads               %10lu / %lu\n", ( unsigned long ) ulLocked, ( unsigned long ) ulLockFree );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEchoTask( void *pvParameters )
+{
+uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xQueueReceive( xToEchoTask, &ulValue, portMAX_DELAY );
+		( void ) xQueueSend( xFromEchoTask, &ulValue, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimedEchoTask( void *pvParameters )
+{
+uint32_t ulValue;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xToEchoTask, &ulValue, benchTIMED_BLOCK_TICKS ) == pdPASS )
+		{
+			( void ) xQueueSend( xFromEchoTask, &ulValue, portMAX_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSleepingTask( void *pvParameters )
+{
+uint32_t ulNextRand = ( uint32_t ) ( UBaseType_t ) pvParameters;
+
+	for( ;; )
+	{
+		/* Spread the wake times so tasks are inserted throughout the delayed
+		list rather than always at one end. */
+		ulNextRand = ( ulNextRand * 1103515245UL ) + 12345UL;
+		vTaskDelay( benchSLEEP_MIN_TICKS + ( ( ulNextRand >> 16 ) % benchSLEEP_RANGE_TICKS ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendingTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIME_SLICE_QUANTA == 1 )
+
+	static void prvSpinningTask( void *pvParameters )
+	{
+	const UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+		for( ;; )
+		{
+			if( uxLastSpinningTask != uxIndex )
+			{
+				uxLastSpinningTask = uxIndex;
+				ulSpinningTaskSwitches++;
+			}
+		}
+	}
+
+#endif /* configUSE_TIME_SLICE_QUANTA */
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMedian( uint64_t *pullValues )
+{
+BaseType_t x, y;
+uint64_t ullValue;
+
+	/* Insertion sort - there are only benchROUNDS values. */
+	for( x = 1; x < benchROUNDS; x++ )
+	{
+		ullValue = pullValues[ x ];
+
+		for( y = x - 1; ( y >= 0 ) && ( pullValues[ y ] > ullValue ); y-- )
+		{
+			pullValues[ y + 1 ] = pullValues[ y ];
+		}
+
+		pullValues[ y + 1 ] = ullValue;
+	}
+
+	return pullValues[ benchROUNDS / 2 ];
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,300 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ * Tickless idle drift test for the Posix simulator build.  Must be built with
+ * configUSE_TICKLESS_IDLE set to 1 - "make tickless" does that in its own build
+ * directory.
+ *
+ * The simulator port suppresses ticks the way the RX600v2 port does: the next
+ * tick interrupt is moved to the end of the tick period in which the idle time
+ * ends, without losing the phase of the tick, and the tick count is stepped
+ * forward on wake.  This test checks that the tick count does not drift from
+ * the host clock by more than one tick however long the test runs:
+ *
+ * + The drift check task blocks for a mix of short and long periods, including
+ *   periods longer than the most ticks that can be suppressed in one go, and
+ *   compares the tick count against the host clock each time it wakes.
+ *
+ * + A host thread, standing in for a peripheral, generates a simulated
+ *   interrupt at random times.  The interrupt gives a semaphore to a handler
+ *   task, so the idle task's sleep is regularly ended by something other than
+ *   the tick, part way through a tick period.
+ *
+ * Ticks lost because the host delayed the tick signal (which would not happen
+ * on the target) are reported separately and are not counted as drift.
+ ******************************************************************************/
+
+/* Standard includes. */
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* The simulated interrupt number used by the peripheral thread. */
+#define ticklessINTERRUPT_NUMBER		( 0UL )
+
+/* The peripheral thread generates its interrupt at a random time between
+ticklessMIN_INTERRUPT_GAP_US and ticklessMIN_INTERRUPT_GAP_US +
+ticklessINTERRUPT_GAP_RANGE_US microseconds after the last. */
+#define ticklessMIN_INTERRUPT_GAP_US	( 300UL )
+#define ticklessINTERRUPT_GAP_RANGE_US	( 20000UL )
+
+/* Drift of more than this many ticks fails the test. */
+#define ticklessMAX_DRIFT_TICKS			( 1LL )
+
+/* Priorities of the test tasks. */
+#define ticklessCHECK_TASK_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define ticklessHANDLER_TASK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+/* The length of a tick period in host nanoseconds. */
+#define ticklessTICK_PERIOD_NS			( 1000000000LL / ( long long ) configTICK_RATE_HZ )
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Blocks for the periods in xBlockTimes[] in turn, checking the drift between
+ * the tick count and the host clock each time it unblocks.  Ends the scheduler
+ * once the run time has elapsed.
+ */
+static void prvDriftCheckTask( void *pvParameters );
+
+/*
+ * Takes the semaphore given by the simulated interrupt.
+ */
+static void prvInterruptHandlerTask( void *pvParameters );
+
+/*
+ * The simulated interrupt handler, and the host thread that generates the
+ * interrupt.
+ */
+static uint32_t prvPeripheralInterruptHandler( void );
+static void *prvPeripheralThread( void *pvParameters );
+
+/*
+ * The host monotonic clock, in nanoseconds.
+ */
+static long long prvGetHostTime( void );
+
+/*-----------------------------------------------------------*/
+
+/* The periods the drift check task blocks for, in ticks.  Includes periods
+that are shorter than, equal to and longer than the default maximum number of
+ticks that can be suppressed in one go. */
+static const TickType_t xBlockTimes[] = { 2, 3, 7, 33, 34, 35, 68, 100, 250, 1000 };
+#define ticklessNUM_BLOCK_TIMES			( sizeof( xBlockTimes ) / sizeof( xBlockTimes[ 0 ] ) )
+
+/* Given by the simulated interrupt. */
+static SemaphoreHandle_t xInterruptSemaphore = NULL;
+
+/* Results, read by main_tickless() once the scheduler has ended. */
+static volatile long long llMaxDrift = 0;
+static volatile uint32_t ulChecks = 0, ulInterruptsHandled = 0;
+static PortTickStats_t xTickStats;
+static TickType_t xTicksElapsed = 0;
+
+/* Stops the peripheral thread. */
+static volatile BaseType_t xPeripheralRunning = pdTRUE;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+/*-----------------------------------------------------------*/
+
+int main_tickless( unsigned long ulRunTimeSeconds )
+{
+int iStatus = EXIT_FAILURE;
+
+	#if( configUSE_TICKLESS_IDLE == 1 )
+	{
+	pthread_t xPeripheral;
+	sigset_t xAllSignals;
+
+		xInterruptSemaphore = xSemaphoreCreateBinary();
+		configASSERT( xInterruptSemaphore );
+
+		xTaskCreate( prvDriftCheckTask, "Drift", configMINIMAL_STACK_SIZE, ( void * ) ulRunTimeSeconds, ticklessCHECK_TASK_PRIORITY, NULL );
+		xTaskCreate( prvInterruptHandlerTask, "IntHnd", configMINIMAL_STACK_SIZE, NULL, ticklessHANDLER_TASK_PRIORITY, NULL );
+		vPortSetInterruptHandler( ticklessINTERRUPT_NUMBER, prvPeripheralInterruptHandler );
+
+		/* Simulated interrupts must only be taken by task threads, so the
+		peripheral thread is created with all signals blocked. */
+		sigfillset( &xAllSignals );
+		( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+		( void ) pthread_create( &xPeripheral, NULL, prvPeripheralThread, NULL );
+
+		/* Returns when the drift check task calls vTaskEndScheduler(). */
+		vTaskStartScheduler();
+
+		xPeripheralRunning = pdFALSE;
+		( void ) pthread_join( xPeripheral, NULL );
+
+		printf( "tickless idle drift test, %lu seconds\n", ulRunTimeSeconds );
+		printf( "  ticks elapsed                            %10lu\n", ( unsigned long ) xTicksElapsed );
+		printf( "  tick interrupts taken                    %10llu\n", ( unsigned long long ) xTickStats.ullTickInterruptCount );
+		printf( "  sleeps / ticks suppressed                %10llu / %llu\n", ( unsigned long long ) xTickStats.ullSleepCount, ( unsigned long long ) xTickStats.ullSuppressedTickCount );
+		printf( "  ticks lost by the host                   %10llu\n", ( unsigned long long ) xTickStats.ullLostTickCount );
+		printf( "  peripheral interrupts handled            %10lu\n", ( unsigned long ) ulInterruptsHandled );
+		printf( "  drift checks / worst drift in ticks      %10lu / %lld\n", ( unsigned long ) ulChecks, llMaxDrift );
+
+		if( llMaxDrift > ticklessMAX_DRIFT_TICKS )
+		{
+			printf( "FAIL: the tick count drifted from the host clock\n" );
+		}
+		else if( ( xTickStats.ullSuppressedTickCount == 0 ) || ( ulInterruptsHandled == 0 ) )
+		{
+			printf( "FAIL: ticks were not suppressed, or the peripheral interrupt did not run\n" );
+		}
+		else
+		{
+			printf( "PASS: tick count within %lld tick of the host clock\n", ticklessMAX_DRIFT_TICKS );
+			iStatus = EXIT_SUCCESS;
+		}
+	}
+	#else
+	{
+		( void ) ulRunTimeSeconds;
+		printf( "FAIL: configUSE_TICKLESS_IDLE is not 1 - use make tickless\n" );
+	}
+	#endif /* configUSE_TICKLESS_IDLE */
+
+	return iStatus;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+static void prvDriftCheckTask( void *pvParameters )
+{
+const long long llRunTime = ( long long ) ( unsigned long ) pvParameters * 1000000000LL;
+TickType_t xStartTick, xTicks;
+long long llStartTime, llElapsed, llDrift;
+PortTickStats_t xStats;
+size_t xIndex = 0;
+
+	/* Start on a tick boundary, so the host time that corresponds to the tick
+	count is known to within the time taken to unblock this task. */
+	vTaskDelay( 1 );
+	xStartTick = xTaskGetTickCount();
+	llStartTime = prvGetHostTime();
+	vPortResetTickStats();
+
+	do
+	{
+		vTaskDelay( xBlockTimes[ xIndex ] );
+		xIndex = ( xIndex + 1 ) % ticklessNUM_BLOCK_TIMES;
+
+		xTicks = xTaskGetTickCount() - xStartTick;
+		llElapsed = prvGetHostTime() - llStartTime;
+		vPortGetTickStats( &xStats );
+
+		/* The number of whole tick periods that have passed on the host clock
+		is compared with the tick count, plus any ticks the host lost. */
+		llDrift = ( long long ) xTicks + ( long long ) xStats.ullLostTickCount - ( llElapsed / ticklessTICK_PERIOD_NS );
+
+		if( llDrift < 0 )
+		{
+			llDrift = -llDrift;
+		}
+
+		if( llDrift > llMaxDrift )
+		{
+			llMaxDrift = llDrift;
+		}
+
+		ulChecks++;
+
+	} while( llElapsed < llRunTime );
+
+	xTicksElapsed = xTicks;
+	xTickStats = xStats;
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptHandlerTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSemaphoreTake( xInterruptSemaphore, portMAX_DELAY ) == pdPASS )
+		{
+			ulInterruptsHandled++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPeripheralInterruptHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xSemaphoreGiveFromISR( xInterruptSemaphore, &xHigherPriorityTaskWoken );
+	return ( uint32_t ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPeripheralThread( void *pvParameters )
+{
+unsigned int uiSeed = 1;
+struct timespec xGap;
+unsigned long ulGap;
+
+	( void ) pvParameters;
+
+	while( xPeripheralRunning != pdFALSE )
+	{
+		ulGap = ticklessMIN_INTERRUPT_GAP_US + ( ( unsigned long ) rand_r( &uiSeed ) % ticklessINTERRUPT_GAP_RANGE_US );
+		xGap.tv_sec = 0;
+		xGap.tv_nsec = ( long ) ( ulGap * 1000UL );
+		( void ) nanosleep( &xGap, NULL );
+
+		vPortGenerateSimulatedInterrupt( ticklessINTERRUPT_NUMBER );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static long long prvGetHostTime( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( long long ) xNow.tv_sec * 1000000000LL ) + ( long long ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
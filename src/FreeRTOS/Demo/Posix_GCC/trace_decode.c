@@ -0,0 +1,603 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/******************************************************************************
+ * Host side decoder for the binary trace recorder (Source/trace_recorder.c).
+ *
+ * Usage: trace_decode <records file> <JSON file>
+ *
+ * Reads a stream or snapshot written by the recorder, from the simulator or
+ * from the RX65N (the byte order is taken from the header record), and writes
+ * it out in the Trace Event JSON format read by chrome://tracing and
+ * ui.perfetto.dev:
+ *
+ * + The time each task ran is shown as a slice on a track named after the
+ *   task.  Task switches are taken from the task recorded with every record,
+ *   so are shown even when traceCLASS_TASK was not recorded, although only to
+ *   the nearest recorded event.
+ *
+ * + Every other event is shown as an instant on the track of the task that was
+ *   running, with the object it relates to (named where the name was recorded)
+ *   and its value as arguments.  Events recorded by interrupts have the "isr"
+ *   category.
+ *
+ * The 32-bit time stamps are extended by assuming the time between two records
+ * is less than one period of the time stamp counter.
+ *
+ * The exit status is non-zero if the input is not a valid trace.
+ ******************************************************************************/
+
+/* Standard includes. */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Kernel includes.  Only the record definitions in trace_recorder.h are used,
+so the decoder is not linked with the kernel. */
+#include "FreeRTOS.h"
+
+#if( configUSE_TRACE_RECORDER != 1 )
+	#error trace_decode.c must be built with configUSE_TRACE_RECORDER set to 1.
+#endif
+
+/* The most names, and the highest task number, that can be decoded. */
+#define decodeMAX_NAMES					( 1024 )
+#define decodeMAX_TASKS					( 65536 )
+
+/* The longest name a trace can hold - sixteen records of four characters. */
+#define decodeMAX_NAME_LENGTH			( 64 )
+
+/* What the object of an event identifies. */
+#define decodeOBJECT_NONE				( 0 )
+#define decodeOBJECT_TASK				( 1 )
+#define decodeOBJECT_ADDRESS			( 2 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct DECODE_EVENT
+{
+	uint8_t ucEvent;
+	const char *pcName;
+	const char *pcCategory;
+	uint8_t ucObjectKind;
+	const char *pcValueName;		/* NULL if the value is not used. */
+} DecodeEvent_t;
+
+typedef struct DECODE_NAME
+{
+	uint8_t ucObjectType;
+	uint32_t ulObject;
+	char cName[ decodeMAX_NAME_LENGTH + 1 ];
+} DecodeName_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Print a message and exit with a failure status.
+ */
+static void prvFail( const char *pcFormat, ... ) __attribute__( ( format( printf, 1, 2 ) ) );
+
+/*
+ * Reverse the byte order of the fields of a record written by a target of the
+ * other byte order.
+ */
+static void prvSwapRecord( TraceRecord_t *pxRecord );
+
+/*
+ * Add the four characters held by a traceEVENT_NAME record to the name of its
+ * object.
+ */
+static void prvAddName( const TraceRecord_t *pxRecord );
+
+/*
+ * Return the name of an object, or NULL if it was not recorded.
+ */
+static const char *prvFindName( uint8_t ucObjectType, uint32_t ulObject );
+
+/*
+ * Return the description of an event code, or NULL if it is not known.
+ */
+static const DecodeEvent_t *prvFindEvent( uint8_t ucEvent );
+
+/*
+ * Write a string as a JSON string, with quotes.
+ */
+static void prvWriteString( FILE *pxFile, const char *pcString );
+
+/*
+ * Write the separator that goes before every event but the first, then the
+ * common fields of an event.  The time is in time stamp counts from the first
+ * event.
+ */
+static void prvStartEvent( FILE *pxFile, const char *pcPhase, const char *pcCategory, uint16_t usTask, uint64_t ullTime );
+
+/*
+ * Write the slice of time a task ran for.
+ */
+static void prvWriteSlice( FILE *pxFile, uint16_t usTask, uint64_t ullStartTime, uint64_t ullEndTime );
+
+/*
+ * Convert time stamp counts to microseconds, the unit of Trace Event times.
+ */
+static double prvMicroseconds( uint64_t ullTime );
+
+/*-----------------------------------------------------------*/
+
+static const DecodeEvent_t xEvents[] =
+{
+	{ traceEVENT_TASK_SWITCHED_IN,					"task switched in",			"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TASK_READY,						"task ready",				"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TASK_CREATE,						"task create",				"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TASK_DELETE,						"task delete",				"task",			decodeOBJECT_TASK,		NULL },
+	{ traceEVENT_TASK_DELAY,						"task delay",				"task",			decodeOBJECT_TASK,		"ticks" },
+	{ traceEVENT_TASK_DELAY_UNTIL,					"task delay until",			"task",			decodeOBJECT_TASK,		"wake tick" },
+	{ traceEVENT_TASK_SUSPEND,						"task suspend",				"task",			decodeOBJECT_TASK,		NULL },
+	{ traceEVENT_TASK_RESUME,						"task resume",				"task",			decodeOBJECT_TASK,		NULL },
+	{ traceEVENT_TASK_RESUME_FROM_ISR,				"task resume from ISR",		"isr",			decodeOBJECT_TASK,		NULL },
+	{ traceEVENT_TASK_PRIORITY_SET,					"task priority set",		"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TASK_PRIORITY_INHERIT,				"priority inherit",			"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TASK_PRIORITY_DISINHERIT,			"priority disinherit",		"task",			decodeOBJECT_TASK,		"priority" },
+	{ traceEVENT_TICK,								"tick",						"tick",			decodeOBJECT_NONE,		"tick count" },
+	{ traceEVENT_QUEUE_CREATE,						"queue create",				"queue",		decodeOBJECT_ADDRESS,	"type" },
+	{ traceEVENT_QUEUE_DELETE,						"queue delete",				"queue",		decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_QUEUE_SEND,						"queue send",				"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_SEND_FAILED,					"queue send failed",		"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_RECEIVE,						"queue receive",			"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_RECEIVE_FAILED,				"queue receive failed",		"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_PEEK,						"queue peek",				"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_BLOCK_ON_SEND,				"queue block on send",		"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_BLOCK_ON_RECEIVE,			"queue block on receive",	"queue",		decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_SEND_FROM_ISR,				"queue send from ISR",		"isr",			decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_SEND_FROM_ISR_FAILED,		"queue send from ISR failed",		"isr",	decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_RECEIVE_FROM_ISR,			"queue receive from ISR",	"isr",			decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED,		"queue receive from ISR failed",	"isr",	decodeOBJECT_ADDRESS,	"items" },
+	{ traceEVENT_NOTIFY_FROM_ISR,					"notify from ISR",			"isr",			decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_NOTIFY_GIVE_FROM_ISR,				"notify give from ISR",		"isr",			decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR,		"event group set bits from ISR",	"isr",	decodeOBJECT_ADDRESS,	"bits" },
+	{ traceEVENT_STREAM_BUFFER_SEND_FROM_ISR,		"stream buffer send from ISR",		"isr",	decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR,	"stream buffer receive from ISR",	"isr",	decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_NOTIFY,							"notify",					"notify",		decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_NOTIFY_TAKE,						"notify take",				"notify",		decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_NOTIFY_TAKE_BLOCK,					"notify take block",		"notify",		decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_NOTIFY_WAIT,						"notify wait",				"notify",		decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_NOTIFY_WAIT_BLOCK,					"notify wait block",		"notify",		decodeOBJECT_TASK,		"value" },
+	{ traceEVENT_EVENT_GROUP_CREATE,				"event group create",		"event_group",	decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_EVENT_GROUP_DELETE,				"event group delete",		"event_group",	decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_EVENT_GROUP_SET_BITS,				"event group set bits",		"event_group",	decodeOBJECT_ADDRESS,	"bits" },
+	{ traceEVENT_EVENT_GROUP_CLEAR_BITS,			"event group clear bits",	"event_group",	decodeOBJECT_ADDRESS,	"bits" },
+	{ traceEVENT_EVENT_GROUP_WAIT_BLOCK,			"event group wait block",	"event_group",	decodeOBJECT_ADDRESS,	"bits" },
+	{ traceEVENT_EVENT_GROUP_WAIT_END,				"event group wait end",		"event_group",	decodeOBJECT_ADDRESS,	"timed out" },
+	{ traceEVENT_EVENT_GROUP_SYNC_BLOCK,			"event group sync block",	"event_group",	decodeOBJECT_ADDRESS,	"bits" },
+	{ traceEVENT_EVENT_GROUP_SYNC_END,				"event group sync end",		"event_group",	decodeOBJECT_ADDRESS,	"timed out" },
+	{ traceEVENT_TIMER_CREATE,						"timer create",				"timer",		decodeOBJECT_ADDRESS,	"period" },
+	{ traceEVENT_TIMER_COMMAND_SEND,				"timer command send",		"timer",		decodeOBJECT_ADDRESS,	"command" },
+	{ traceEVENT_TIMER_COMMAND_RECEIVED,			"timer command received",	"timer",		decodeOBJECT_ADDRESS,	"command" },
+	{ traceEVENT_TIMER_EXPIRED,						"timer expired",			"timer",		decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_STREAM_BUFFER_CREATE,				"stream buffer create",		"stream_buffer",	decodeOBJECT_ADDRESS,	"message buffer" },
+	{ traceEVENT_STREAM_BUFFER_DELETE,				"stream buffer delete",		"stream_buffer",	decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_STREAM_BUFFER_SEND,				"stream buffer send",		"stream_buffer",	decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_STREAM_BUFFER_RECEIVE,				"stream buffer receive",	"stream_buffer",	decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_STREAM_BUFFER_BLOCK_ON_SEND,		"stream buffer block on send",		"stream_buffer",	decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_STREAM_BUFFER_BLOCK_ON_RECEIVE,	"stream buffer block on receive",	"stream_buffer",	decodeOBJECT_ADDRESS,	NULL },
+	{ traceEVENT_MALLOC,							"malloc",					"heap",			decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_FREE,								"free",						"heap",			decodeOBJECT_ADDRESS,	"bytes" },
+	{ traceEVENT_USER,								"user event",				"user",			decodeOBJECT_NONE,		"value" },
+	{ traceEVENT_DROPPED,							"records dropped",			"recorder",		decodeOBJECT_NONE,		"records" }
+};
+
+static DecodeName_t xNames[ decodeMAX_NAMES ];
+static size_t xNumberOfNames = 0;
+
+/* Set for each task that appears in the trace, so its track can be named. */
+static uint8_t ucTaskSeen[ decodeMAX_TASKS ];
+
+/* The number of events written so far, so the separators can be written. */
+static unsigned long ulEventsWritten = 0UL;
+
+/* From the header record. */
+static uint32_t ulTimestampHz = 0UL;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxInput, *pxOutput;
+TraceRecord_t xRecord;
+const DecodeEvent_t *pxEvent;
+const char *pcName;
+BaseType_t xSwapBytes = pdFALSE;
+unsigned long ulRecord = 0UL, ulDropped = 0UL;
+uint32_t ulLastTimestamp = 0UL;
+uint64_t ullTime = 0ULL, ullSliceStart = 0ULL;
+BaseType_t xHaveTime = pdFALSE;
+uint16_t usRunningTask = 0U;
+size_t xRead;
+unsigned long ulTask;
+
+	if( argc != 3 )
+	{
+		fprintf( stderr, "Usage: %s <records file> <JSON file>\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	pxInput = fopen( argv[ 1 ], "rb" );
+	if( pxInput == NULL )
+	{
+		prvFail( "trace_decode: cannot open %s\n", argv[ 1 ] );
+	}
+
+	pxOutput = fopen( argv[ 2 ], "w" );
+	if( pxOutput == NULL )
+	{
+		prvFail( "trace_decode: cannot create %s\n", argv[ 2 ] );
+	}
+
+	fprintf( pxOutput, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+
+	for( ;; )
+	{
+		xRead = fread( &xRecord, 1, sizeof( xRecord ), pxInput );
+
+		if( xRead == 0 )
+		{
+			break;
+		}
+		else if( xRead != sizeof( xRecord ) )
+		{
+			prvFail( "trace_decode: %s ends part way through record %lu\n", argv[ 1 ], ulRecord );
+		}
+
+		/* The first record is the header, which gives the byte order and the
+		time stamp rate. */
+		if( ulRecord == 0UL )
+		{
+			if( ( xRecord.ucEvent != traceEVENT_HEADER ) || ( ( xRecord.ulObject != traceRECORDER_MAGIC ) && ( xRecord.ulObject != __builtin_bswap32( traceRECORDER_MAGIC ) ) ) )
+			{
+				prvFail( "trace_decode: %s does not start with a trace recorder header\n", argv[ 1 ] );
+			}
+
+			xSwapBytes = ( xRecord.ulObject != traceRECORDER_MAGIC ) ? pdTRUE : pdFALSE;
+		}
+
+		if( xSwapBytes != pdFALSE )
+		{
+			prvSwapRecord( &xRecord );
+		}
+
+		if( xRecord.ucEvent == traceEVENT_HEADER )
+		{
+			if( ( xRecord.ucParameter != traceRECORDER_VERSION ) || ( xRecord.usTask != sizeof( TraceRecord_t ) ) || ( xRecord.ulValue == 0UL ) )
+			{
+				prvFail( "trace_decode: record %lu is a header for an unsupported version\n", ulRecord );
+			}
+
+			ulTimestampHz = xRecord.ulValue;
+			ulRecord++;
+			continue;
+		}
+		else if( xRecord.ucEvent == traceEVENT_NAME )
+		{
+			/* Names are written when they are read out, not when the object
+			was created, so their time stamps are ignored. */
+			prvAddName( &xRecord );
+			ulRecord++;
+			continue;
+		}
+
+		pxEvent = prvFindEvent( xRecord.ucEvent );
+		if( pxEvent == NULL )
+		{
+			prvFail( "trace_decode: record %lu has the unknown event code 0x%02x\n", ulRecord, ( unsigned int ) xRecord.ucEvent );
+		}
+
+		/* Extend the time stamp, counting from the first event. */
+		if( xHaveTime == pdFALSE )
+		{
+			xHaveTime = pdTRUE;
+			usRunningTask = xRecord.usTask;
+		}
+		else
+		{
+			ullTime += ( uint32_t ) ( xRecord.ulTimestamp - ulLastTimestamp );
+		}
+		ulLastTimestamp = xRecord.ulTimestamp;
+
+		/* End the slice of the task that was running if another task was
+		running when this event was recorded. */
+		if( xRecord.usTask != usRunningTask )
+		{
+			prvWriteSlice( pxOutput, usRunningTask, ullSliceStart, ullTime );
+			ullSliceStart = ullTime;
+			usRunningTask = xRecord.usTask;
+		}
+
+		ucTaskSeen[ xRecord.usTask ] = pdTRUE;
+
+		prvStartEvent( pxOutput, "i", pxEvent->pcCategory, xRecord.usTask, ullTime );
+		fprintf( pxOutput, ",\"s\":\"t\",\"name\":" );
+		prvWriteString( pxOutput, pxEvent->pcName );
+		fprintf( pxOutput, ",\"args\":{" );
+
+		if( pxEvent->ucObjectKind == decodeOBJECT_TASK )
+		{
+			pcName = prvFindName( traceOBJECT_TASK, xRecord.ulObject );
+			fprintf( pxOutput, "\"task\":" );
+
+			if( pcName != NULL )
+			{
+				prvWriteString( pxOutput, pcName );
+			}
+			else
+			{
+				fprintf( pxOutput, "%lu", ( unsigned long ) xRecord.ulObject );
+			}
+		}
+		else if( pxEvent->ucObjectKind == decodeOBJECT_ADDRESS )
+		{
+			pcName = prvFindName( traceOBJECT_QUEUE, xRecord.ulObject );
+
+			if( pcName == NULL )
+			{
+				pcName = prvFindName( traceOBJECT_TIMER, xRecord.ulObject );
+			}
+
+			fprintf( pxOutput, "\"object\":" );
+
+			if( pcName != NULL )
+			{
+				prvWriteString( pxOutput, pcName );
+			}
+			else
+			{
+				fprintf( pxOutput, "\"0x%08lx\"", ( unsigned long ) xRecord.ulObject );
+			}
+		}
+		else if( xRecord.ucEvent == traceEVENT_USER )
+		{
+			fprintf( pxOutput, "\"id\":%lu", ( unsigned long ) xRecord.ulObject );
+		}
+
+		if( pxEvent->pcValueName != NULL )
+		{
+			if( ( pxEvent->ucObjectKind != decodeOBJECT_NONE ) || ( xRecord.ucEvent == traceEVENT_USER ) )
+			{
+				fprintf( pxOutput, "," );
+			}
+
+			prvWriteString( pxOutput, pxEvent->pcValueName );
+			fprintf( pxOutput, ":%lu", ( unsigned long ) xRecord.ulValue );
+		}
+
+		fprintf( pxOutput, "}}" );
+
+		if( xRecord.ucEvent == traceEVENT_DROPPED )
+		{
+			ulDropped += xRecord.ulValue;
+		}
+
+		ulRecord++;
+	}
+
+	if( ulRecord == 0UL )
+	{
+		prvFail( "trace_decode: %s is empty\n", argv[ 1 ] );
+	}
+
+	/* End the slice of the task running at the end of the trace. */
+	if( xHaveTime != pdFALSE )
+	{
+		prvWriteSlice( pxOutput, usRunningTask, ullSliceStart, ullTime );
+	}
+
+	/* Name the track of each task. */
+	for( ulTask = 0UL; ulTask < decodeMAX_TASKS; ulTask++ )
+	{
+		if( ucTaskSeen[ ulTask ] != pdFALSE )
+		{
+			pcName = prvFindName( traceOBJECT_TASK, ( uint32_t ) ulTask );
+			prvStartEvent( pxOutput, "M", "task", ( uint16_t ) ulTask, 0ULL );
+			fprintf( pxOutput, ",\"name\":\"thread_name\",\"args\":{\"name\":" );
+
+			if( ulTask == 0UL )
+			{
+				/* Records made before the scheduler started. */
+				prvWriteString( pxOutput, "(no task)" );
+			}
+			else if( pcName != NULL )
+			{
+				prvWriteString( pxOutput, pcName );
+			}
+			else
+			{
+				fprintf( pxOutput, "\"task %lu\"", ulTask );
+			}
+
+			fprintf( pxOutput, "}}" );
+		}
+	}
+
+	fprintf( pxOutput, "\n]}\n" );
+
+	if( ferror( pxInput ) || ( fclose( pxOutput ) != 0 ) )
+	{
+		prvFail( "trace_decode: error reading %s or writing %s\n", argv[ 1 ], argv[ 2 ] );
+	}
+
+	fclose( pxInput );
+
+	printf( "trace_decode: %lu records, %lu events, %lu records dropped, %.3f seconds, written to %s\n", ulRecord, ulEventsWritten, ulDropped, ( double ) ullTime / ( double ) ulTimestampHz, argv[ 2 ] );
+
+	return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char *pcFormat, ... )
+{
+va_list xArgs;
+
+	va_start( xArgs, pcFormat );
+	vfprintf( stderr, pcFormat, xArgs );
+	va_end( xArgs );
+	exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwapRecord( TraceRecord_t *pxRecord )
+{
+	pxRecord->ulTimestamp = __builtin_bswap32( pxRecord->ulTimestamp );
+	pxRecord->usTask = __builtin_bswap16( pxRecord->usTask );
+	pxRecord->ulObject = __builtin_bswap32( pxRecord->ulObject );
+	pxRecord->ulValue = __builtin_bswap32( pxRecord->ulValue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddName( const TraceRecord_t *pxRecord )
+{
+uint8_t ucObjectType = ( uint8_t ) ( pxRecord->ucParameter >> 4 );
+size_t xOffset = ( size_t ) ( pxRecord->ucParameter & 0x0fU ) * 4U, x;
+DecodeName_t *pxName = NULL;
+
+	for( x = 0; x < xNumberOfNames; x++ )
+	{
+		if( ( xNames[ x ].ucObjectType == ucObjectType ) && ( xNames[ x ].ulObject == pxRecord->ulObject ) )
+		{
+			pxName = &( xNames[ x ] );
+			break;
+		}
+	}
+
+	if( pxName == NULL )
+	{
+		if( xNumberOfNames == decodeMAX_NAMES )
+		{
+			prvFail( "trace_decode: more than %d names\n", decodeMAX_NAMES );
+		}
+
+		pxName = &( xNames[ xNumberOfNames ] );
+		xNumberOfNames++;
+		pxName->ucObjectType = ucObjectType;
+		pxName->ulObject = pxRecord->ulObject;
+	}
+
+	/* The first four characters start the name again, as the object might
+	have been renamed, or its address reused. */
+	if( xOffset == 0U )
+	{
+		memset( pxName->cName, 0x00, sizeof( pxName->cName ) );
+	}
+
+	for( x = 0; x < 4U; x++ )
+	{
+		pxName->cName[ xOffset + x ] = ( char ) ( ( pxRecord->ulValue >> ( x * 8U ) ) & 0xffUL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static const char *prvFindName( uint8_t ucObjectType, uint32_t ulObject )
+{
+size_t x;
+
+	for( x = 0; x < xNumberOfNames; x++ )
+	{
+		if( ( xNames[ x ].ucObjectType == ucObjectType ) && ( xNames[ x ].ulObject == ulObject ) )
+		{
+			return xNames[ x ].cName;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static const DecodeEvent_t *prvFindEvent( uint8_t ucEvent )
+{
+size_t x;
+
+	for( x = 0; x < sizeof( xEvents ) / sizeof( xEvents[ 0 ] ); x++ )
+	{
+		if( xEvents[ x ].ucEvent == ucEvent )
+		{
+			return &( xEvents[ x ] );
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteString( FILE *pxFile, const char *pcString )
+{
+	fputc( '"', pxFile );
+
+	while( *pcString != 0x00 )
+	{
+		if( ( *pcString == '"' ) || ( *pcString == '\\' ) )
+		{
+			fprintf( pxFile, "\\%c", *pcString );
+		}
+		else if( ( unsigned char ) *pcString < 0x20U )
+		{
+			fprintf( pxFile, "\\u%04x", ( unsigned int ) ( unsigned char ) *pcString );
+		}
+		else
+		{
+			fputc( *pcString, pxFile );
+		}
+
+		pcString++;
+	}
+
+	fputc( '"', pxFile );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartEvent( FILE *pxFile, const char *pcPhase, const char *pcCategory, uint16_t usTask, uint64_t ullTime )
+{
+	if( ulEventsWritten != 0UL )
+	{
+		fprintf( pxFile, ",\n" );
+	}
+
+	fprintf( pxFile, "{\"ph\":\"%s\",\"cat\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", pcPhase, pcCategory, ( unsigned int ) usTask, prvMicroseconds( ullTime ) );
+	ulEventsWritten++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSlice( FILE *pxFile, uint16_t usTask, uint64_t ullStartTime, uint64_t ullEndTime )
+{
+	prvStartEvent( pxFile, "X", "task", usTask, ullStartTime );
+	fprintf( pxFile, ",\"name\":\"running\",\"dur\":%.3f}", prvMicroseconds( ullEndTime - ullStartTime ) );
+}
+/*-----------------------------------------------------------*/
+
+static double prvMicroseconds( uint64_t ullTime )
+{
+	return ( ( double ) ullTime * 1000000.0 ) / ( double ) ulTimestampHz;
+}
+/*-----------------------------------------------------------*/
+
@@ -31,6 +31,34 @@ void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName );
 void vApplicationIdleHook( void );
 void vApplicationTickHook( void );
 void vAssertCalled( void );
+void vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName, uint32_t ulWatermark );
+
+/*
+ * Provide the memory of the idle and timer service tasks when
+ * configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
+	void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+#endif
+
+/*
+ * The run time stats counter, set up and read through the
+ * portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and portGET_RUN_TIME_COUNTER_VALUE()
+ * macros defined in FreeRTOSConfig.h.
+ */
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	void vApplicationSetupRunTimeCounter( void );
+	uint64_t ullApplicationGetRunTimeCounter( void );
+#endif
+
+/*
+ * The trace recorder time stamp, read through the
+ * configTRACE_RECORDER_TIMESTAMP() macro defined in FreeRTOSConfig.h.
+ */
+#if( configUSE_TRACE_RECORDER == 1 )
+	uint32_t ulApplicationGetTraceTimestamp( void );
+#endif
 
 /*
  * Only the comprehensive demo uses application hook (callback) functions.  See
@@ -96,11 +124,26 @@ const uint32_t ulEnableRegisterWrite = 0xA50BUL, ulDisableRegisterWrite = 0xA500
 	/* Interrupt on compare match. */
 	CMT0.CMCR.BIT.CMIE = 1;
 
-	/* Set the compare match value. */
-	CMT0.CMCOR = ( unsigned short ) ( ( ( configPERIPHERAL_CLOCK_HZ / configTICK_RATE_HZ ) -1 ) / 8 );
+	#if( configUSE_TICKLESS_IDLE == 1 )
+	{
+		/* The RX600v2 port suppresses ticks by moving this compare match out
+		by whole tick periods, which the 16-bit counter limits to 8 ticks at
+		PCLK/8.  PCLK/32 still gives an exact 1ms period at 60MHz, and allows
+		up to 34 ticks to be suppressed. */
+		CMT0.CMCOR = ( unsigned short ) ( ( ( configPERIPHERAL_CLOCK_HZ / configTICK_RATE_HZ ) / 32 ) - 1 );
+
+		/* Divide the PCLK by 32. */
+		CMT0.CMCR.BIT.CKS = 1;
+	}
+	#else
+	{
+		/* Set the compare match value. */
+		CMT0.CMCOR = ( unsigned short ) ( ( ( configPERIPHERAL_CLOCK_HZ / configTICK_RATE_HZ ) -1 ) / 8 );
 
-	/* Divide the PCLK by 8. */
-	CMT0.CMCR.BIT.CKS = 0;
+		/* Divide the PCLK by 8. */
+		CMT0.CMCR.BIT.CKS = 0;
+	}
+	#endif
 
 	/* Enable the interrupt... */
 	_IEN( _CMT0_CMI0 ) = 1;
@@ -116,6 +159,94 @@ const uint32_t ulEnableRegisterWrite = 0xA50BUL, ulDisableRegisterWrite = 0xA500
 }
 /*-----------------------------------------------------------*/
 
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/* The kernel uses this callback, through
+	portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(), to start the run time counter.
+	The 32-bit compare match timer CMTW1 is left free running at PCLK/8, which
+	gives the run time stats and CPU load a resolution of 133ns. */
+	void vApplicationSetupRunTimeCounter( void )
+	{
+	const uint32_t ulEnableRegisterWrite = 0xA50BUL, ulDisableRegisterWrite = 0xA500UL;
+
+		/* Disable register write protection. */
+		SYSTEM.PRCR.WORD = ulEnableRegisterWrite;
+
+		/* Enable compare match timer W1. */
+		MSTP( CMTW1 ) = 0;
+
+		/* Stop the timer while it is configured. */
+		CMTW1.CMWSTR.BIT.STR = 0;
+
+		/* Count PCLK/8 with no interrupts, and do not clear the counter on a
+		compare match, so it wraps from 0xffffffff to 0. */
+		CMTW1.CMWCR.BIT.CKS = 0;
+		CMTW1.CMWCR.BIT.CMS = 0;
+		CMTW1.CMWCR.BIT.CMWIE = 0;
+		CMTW1.CMWCR.BIT.CCLR = 1;
+		CMTW1.CMWCOR = 0xFFFFFFFFUL;
+		CMTW1.CMWCNT = 0UL;
+
+		/* Start the timer. */
+		CMTW1.CMWSTR.BIT.STR = 1;
+
+		/* Reneable register protection. */
+		SYSTEM.PRCR.WORD = ulDisableRegisterWrite;
+	}
+	/*-----------------------------------------------------------*/
+
+	/* The kernel uses this callback, through portGET_RUN_TIME_COUNTER_VALUE(),
+	to read the run time counter.  CMTW1 wraps every 572 seconds, so the count
+	is extended to 64 bits by counting the wraps.  The kernel reads the counter
+	at least ten times a second when configGENERATE_CPU_LOAD_STATS is 1, so no
+	wrap can be missed. */
+	uint64_t ullApplicationGetRunTimeCounter( void )
+	{
+	static uint32_t ulLastCount = 0UL, ulWraps = 0UL;
+	uint32_t ulCount;
+	uint64_t ullCount;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Called from tasks and from interrupts, which must not see the count
+		and the number of wraps change part way through. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			ulCount = CMTW1.CMWCNT;
+
+			if( ulCount < ulLastCount )
+			{
+				ulWraps++;
+			}
+
+			ulLastCount = ulCount;
+			ullCount = ( ( uint64_t ) ulWraps << 32 ) | ( uint64_t ) ulCount;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return ullCount;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	#if( configGENERATE_RUN_TIME_STATS != 1 )
+		#error The trace recorder time stamps are read from the run time stats counter, CMTW1.
+	#endif
+
+	/* The trace recorder uses this callback, through
+	configTRACE_RECORDER_TIMESTAMP(), to time stamp each record.  The recorder
+	only needs 32 bits, so CMTW1 is read directly.  The count is zero until the
+	scheduler starts the timer. */
+	uint32_t ulApplicationGetTraceTimestamp( void )
+	{
+		return CMTW1.CMWCNT;
+	}
+
+#endif /* configUSE_TRACE_RECORDER */
+/*-----------------------------------------------------------*/
+
 void vApplicationMallocFailedHook( void )
 {
 	/* Called if a call to pvPortMalloc() fails because there is insufficient
@@ -163,6 +294,35 @@ void vApplicationIdleHook( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+	{
+	/* The buffers are static so they remain in scope after this function
+	returns. */
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+		*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+		*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+	{
+	/* As vApplicationGetIdleTaskMemory(). */
+	static StaticTask_t xTimerTaskTCB;
+	static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+		*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+		*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+		*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 void vApplicationTickHook( void )
 {
 	/* This function will be called by each tick interrupt if
@@ -179,6 +339,25 @@ void vApplicationTickHook( void )
 }
 /*-----------------------------------------------------------*/
 
+void vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName, uint32_t ulWatermark )
+{
+/* The last task found to be close to overflowing its stack, for inspection in
+the debugger. */
+static volatile TaskHandle_t xLastStackWarningTask = NULL;
+static volatile uint32_t ulLastStackWarningWatermark = 0UL;
+
+	( void ) pcTaskName;
+
+	/* Called by the idle task, within a critical section, once for each task
+	that has used configSTACK_WATERMARK_WARNING_PERCENT of its stack.  Unlike
+	vApplicationStackOverflowHook() the task can carry on, so the warning is
+	only recorded.  uxTaskGetAllStackWatermarks() gives the watermarks of all
+	the tasks. */
+	xLastStackWarningTask = xTask;
+	ulLastStackWarningWatermark = ulWatermark;
+}
+/*-----------------------------------------------------------*/
+
 void vAssertCalled( void )
 {
 volatile unsigned long ul = 0;
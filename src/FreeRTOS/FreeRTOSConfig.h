@@ -70,6 +70,106 @@
 #define configMAX_PRIORITIES					( 7 )			// Micom is NOT involved in this value
 #define configMAX_CO_ROUTINE_PRIORITIES 		( 2 )
 
+/* The kernel options below are left at their FreeRTOS.h defaults here, and are
+listed so they can be found.  The Posix_GCC demo builds and tests them.  Turn
+one on for this board only once it has been measured on it. */
+
+/* Set to 1 to select the next task to run from a bitmap of the ready priorities
+(see portGET_HIGHEST_PRIORITY() in portmacro.h), rather than by walking the
+ready lists down from the highest priority that was last used.  The time taken
+then does not grow with configMAX_PRIORITIES, which must be 32 or less. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
+
+/* Set to 1 to index the delayed task lists so a task that blocks with a timeout
+is added in O(log n) time rather than by walking the list.  Worth enabling when
+many tasks are blocked with timeouts at once. */
+#define configUSE_INDEXED_DELAY_LISTS			0
+
+/* Set to 1 to time slice each priority after configTIME_SLICE_TICKS() ticks
+rather than on every tick.  vTaskSetTimeSlice() changes a time slice while the
+application runs, and portMAX_DELAY leaves a priority to run to completion. */
+#define configUSE_TIME_SLICE_QUANTA				0
+
+/* Set to 1 to include xQueueSendMultiple(), xQueueReceiveMultiple() and their
+FromISR() versions, which move a burst of items with one critical section and
+one pass over the waiting tasks rather than one of each per item. */
+#define configUSE_QUEUE_BATCH					0
+
+/* Set to 1 to include xStreamBufferSendV(), which sends data gathered from
+several blocks, and xStreamBufferReceiveAcquire()/xStreamBufferReceiveConsume(),
+which let data be parsed in place in the buffer.  Message buffers get the same. */
+#define configUSE_STREAM_BUFFER_SCATTER_GATHER	0
+
+/* Set to 1 to serve small allocations from pools of fixed size blocks set aside
+at the start of the heap (heap_4.c only), rather than from the free list.  The
+pool memory is never returned to the rest of the heap, and is not counted by
+xPortGetFreeHeapSize() or xPortGetMinimumEverFreeHeapSize().  Off here, as pools
+large enough for the whole demo would take about 60K bytes of the heap.  To use
+them, also define configHEAP_POOL_COUNT, configHEAP_POOL_BLOCK_SIZES (in
+ascending order) and configHEAP_POOL_BLOCK_COUNTS, sized from the allocations
+vPortGetPoolStats() reports on the target. */
+#define configUSE_HEAP_POOLS					0
+
+/* Set to 1 to record the task that allocated each heap block (heap_4.c and
+heap_5.c only), so uxTaskGetHeapUsage() can report the memory each task holds
+and vPortHeapDump() can list every allocated block.  Each block then grows by a
+24 byte record, which heap pool block sizes must allow for if pools are used.
+configHEAP_CALL_SITE() can be defined to record the caller of pvPortMalloc()
+too.  Off by default as it is a debug aid. */
+#define configUSE_HEAP_ACCOUNTING				0
+
+/* When configGENERATE_RUN_TIME_STATS is set to 1 above, the run time stats are
+counted by CMTW1, which main.c then leaves free running at PCLK/8.  The count is
+extended to 64 bits as 32 bits would wrap after 572 seconds.
+vTaskGetRunTimeStats() also needs configUSE_TRACE_FACILITY. */
+void vApplicationSetupRunTimeCounter( void );
+uint64_t ullApplicationGetRunTimeCounter( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vApplicationSetupRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()			ullApplicationGetRunTimeCounter()
+#define configRUN_TIME_COUNTER_TYPE				uint64_t
+
+/* Set to 1 to have the kernel sample the run time of every task ten times a
+second, so uxTaskGetCpuLoad() can report each task's share of the CPU over the
+last 1, 10 and 60 seconds.  Interrupts that use taskCPU_LOAD_ENTER_ISR() and
+taskCPU_LOAD_EXIT_ISR() (the tick and the IntQueue timers) are reported by
+uxTaskGetISRCpuLoad() for each nesting level instead.  Needs
+configGENERATE_RUN_TIME_STATS. */
+#define configGENERATE_CPU_LOAD_STATS			0
+
+/* Set to 1 to keep log2 histograms, in CMTW1 counts, of how long the tick, the
+yield and the IntQueue timer interrupts run for, and of how long critical
+sections and portSET_INTERRUPT_MASK_FROM_ISR() mask interrupts.
+vTaskGetISRLatencyReport() prints them.  Off by default as it is a debug aid,
+which reads the run time counter on each interrupt and masked period. */
+#define configGENERATE_ISR_LATENCY_STATS		0
+#define configISR_LATENCY_BUCKETS				16
+
+/* Set to 1 to have the idle task scan the stack of each task in turn, at most
+configSTACK_WATERMARK_SCAN_WORDS words on each pass of its loop, so
+uxTaskGetAllStackWatermarks() returns the high water marks of all the tasks
+without reading their stacks.  vApplicationStackWatermarkHook() in main.c is
+called once for each task found to have used configSTACK_WATERMARK_WARNING_PERCENT
+of its stack. */
+#define configUSE_STACK_WATERMARK_SCANNER		0
+
+/* Set to 1 to build in the binary trace recorder (trace_recorder.h), which
+records kernel events to a ring of configTRACE_RECORDER_BUFFER_RECORDS 16 byte
+records once vTraceRecorderStart() is called.  The records are time stamped with
+the CMTW1 count used by the run time stats, so are 133ns apart at best.  Off by
+default as it is a debug aid, which costs a test of ulTraceRecorderMask at each
+kernel event while stopped. */
+#define configUSE_TRACE_RECORDER				0
+uint32_t ulApplicationGetTraceTimestamp( void );
+#define configTRACE_RECORDER_TIMESTAMP()		ulApplicationGetTraceTimestamp()
+#define configTRACE_RECORDER_TIMESTAMP_HZ		( configPERIPHERAL_CLOCK_HZ / 8UL )
+#define configTRACE_RECORDER_BUFFER_RECORDS		512
+#define configTRACE_RECORDER_NAMES				96
+
+/* Set to 1 to stop the tick interrupt while the idle task runs.  The port then
+reprograms the CMT0 compare match set up by vApplicationSetupTimerInterrupt()
+in main.c to wake at the next task timeout. */
+#define configUSE_TICKLESS_IDLE					0
+
 /* This demo makes use of one or more example stats formatting functions.  These
 format the raw data provided by the uxTaskGetSystemState() function in to human
 readable ASCII form.  See the notes in the implementation of vTaskList() within
@@ -82,6 +182,57 @@ FreeRTOS/Source/tasks.c for limitations. */
 #define configTIMER_QUEUE_LENGTH				5
 #define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE )
 
+/* The kernel options below are also left at their defaults, as above. */
+
+/* Set to 1 to have timer commands issued by the timer service task itself, in
+practice from timer callbacks, carried out straight away rather than posted to
+the timer queue - which holds only configTIMER_QUEUE_LENGTH commands, and on
+which the task would wait forever were it full. */
+#define configUSE_TIMER_DIRECT_COMMANDS			0
+
+/* Set to 1 to hold active timers in a hierarchical timing wheel rather than in
+two lists sorted by expiry time, so starting, resetting and expiring a timer
+takes the same time however many timers are active.  The wheel takes 129 lists
+(about 2.6K bytes of RAM) against 2, so only pays when hundreds of timers are
+active at once. */
+#define configUSE_TIMER_WHEEL					0
+
+/* Set to 1 to create a deferred work task that runs functions posted from
+interrupts with xDeferredFunctionCallFromISR() and xDeferredWorkPostFromISR()
+(see deferred_work.h).  Unlike xTimerPendFunctionCallFromISR() the requests do
+not share the timer queue, and a work item posted again before it has run is
+not queued twice.  The queue length must be a power of 2, and each entry takes
+20 bytes. */
+#define configUSE_DEFERRED_WORK					0
+
+/* Set to 1 to have xEventGroupSetBitsFromISR() and xEventGroupClearBitsFromISR()
+act on the event group directly, rather than sending a command to the timer
+task, at the cost of the task level event group functions using critical
+sections.  Set configUSE_EVENT_GROUP_BIT_INDEX to 1 to hold tasks waiting for
+one bit, or for all of several bits, in a list per bit, so setting bits only
+looks at the tasks that can be unblocked by them.  The index adds 24 lists
+(480 bytes) to each event group. */
+#define configUSE_EVENT_GROUP_DIRECT_ISR		0
+#define configUSE_EVENT_GROUP_BIT_INDEX			0
+
+/* The number of notifications each task has, each with its own 32-bit value
+and state (see xTaskNotifyIndexed()).  Index 0 is used by the stream and message
+buffers and the deferred work task, so the others are left to the application.
+Each entry adds 5 bytes to every task. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	1
+
+/* The memory of a task that deletes itself is freed by the idle task, which
+does not get to run while the system is busy.  Once this many such tasks are
+waiting the next task to create or delete a task frees them all instead (see
+vTaskGetCleanupStats()).  0 leaves them all to the idle task. */
+#define configTASK_CLEANUP_THRESHOLD			0
+
+/* Pass inherited priorities on along chains of tasks waiting for mutexes held
+by each other, at most this many holders deep, and drop a task that gives back
+one of several mutexes only to the priority the others still require.  Adds a
+list and a pointer to every task and a list item to every queue. */
+#define configUSE_PRIORITY_INHERITANCE_CHAINS	0
+
 /* The interrupt priority used by the kernel itself for the tick interrupt and
 the pended interrupt.  This would normally be the lowest priority. */
 #define configKERNEL_INTERRUPT_PRIORITY         1
@@ -0,0 +1,412 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred_work.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred work.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_DEFERRED_WORK == 1 )
+
+#if( ( configDEFERRED_WORK_QUEUE_LENGTH & ( configDEFERRED_WORK_QUEUE_LENGTH - 1 ) ) != 0 )
+	#error configDEFERRED_WORK_QUEUE_LENGTH must be a power of 2.
+#endif
+
+/* The name assigned to the deferred work task.  This can be overridden by
+defining configDEFERRED_WORK_TASK_NAME in FreeRTOSConfig.h. */
+#ifndef configDEFERRED_WORK_TASK_NAME
+	#define configDEFERRED_WORK_TASK_NAME "DefWork"
+#endif
+
+#define dwRING_INDEX_MASK			( ( uint32_t ) configDEFERRED_WORK_QUEUE_LENGTH - 1UL )
+
+/* An entry in the ring.  ulSequence is set to one more than the number of the
+request held once the rest of the entry has been written, which is how the
+deferred work task knows the entry is complete. */
+typedef struct xDEFERRED_WORK_ENTRY
+{
+	DeferredFunction_t pxFunction;
+	void *pvParameter1;
+	uint32_t ulParameter2;
+	DeferredWork_t *pxWork;			/* NULL for a one-off call. */
+	volatile uint32_t ulSequence;
+} DeferredWorkEntry_t;
+
+/*-----------------------------------------------------------*/
+
+/* The ring of requests.  ulDeferredWorkHead counts the entries claimed and
+ulDeferredWorkTail the entries run since the scheduler started, so the number
+in use is their difference and the ring position is given by the bottom bits.
+The head is only changed with interrupts masked, and the tail only by the
+deferred work task.
+
+Masking interrupts to claim an entry stands in for a lock free compare and swap
+on the head.  The RX has no compare and swap instruction (only XCHG), and this
+version of the kernel has no atomic API to build one on, so a compare and swap
+would itself need interrupts masked.  The test of xPending that coalesces a work
+item, and the stats, are made in the same short masked section. */
+PRIVILEGED_DATA static DeferredWorkEntry_t xDeferredWorkRing[ configDEFERRED_WORK_QUEUE_LENGTH ];
+PRIVILEGED_DATA static volatile uint32_t ulDeferredWorkHead = 0UL;
+PRIVILEGED_DATA static volatile uint32_t ulDeferredWorkTail = 0UL;
+
+/* Only changed with interrupts masked. */
+PRIVILEGED_DATA static DeferredWorkStats_t xDeferredWorkStats = { 0UL, 0UL, 0UL, 0U };
+
+PRIVILEGED_DATA static TaskHandle_t xDeferredWorkTaskHandle = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The deferred work task, which runs the requests in the ring in the order
+ * they were claimed, and waits on its notification when it reaches an entry
+ * that has not been published.
+ */
+static void prvDeferredWorkTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Claim an entry, fill it in and publish it, or count pxWork as coalesced if
+ * it is already pending.  *pxNotify is set to pdTRUE if the deferred work task
+ * has run every earlier request, so may be waiting for this one.  Interrupts
+ * must not be masked by the caller, but a task must call it from a critical
+ * section so it cannot be preempted between claiming and publishing the entry
+ * - which would hold up every later request until it ran again.
+ */
+static BaseType_t prvPostRequest( DeferredFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2, DeferredWork_t *pxWork, BaseType_t *pxNotify ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredWorkCreateTask( void )
+{
+BaseType_t xReturn;
+
+	xReturn = xTaskCreate(	prvDeferredWorkTask,
+							configDEFERRED_WORK_TASK_NAME,
+							configDEFERRED_WORK_TASK_STACK_DEPTH,
+							NULL,
+							( ( UBaseType_t ) configDEFERRED_WORK_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+							&xDeferredWorkTaskHandle );
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredWorkTask( void *pvParameters )
+{
+DeferredWorkEntry_t *pxEntry;
+DeferredFunction_t pxFunction;
+void *pvParameter1;
+uint32_t ulParameter2, ulTail;
+
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Requests can be posted before the scheduler starts, so look at the
+		ring before waiting. */
+		ulTail = ulDeferredWorkTail;
+		pxEntry = &( xDeferredWorkRing[ ulTail & dwRING_INDEX_MASK ] );
+
+		while( pxEntry->ulSequence == ( ulTail + 1UL ) )
+		{
+			if( pxEntry->pxWork != NULL )
+			{
+				pxFunction = pxEntry->pxWork->pxFunction;
+				pvParameter1 = pxEntry->pxWork->pvParameter1;
+				ulParameter2 = pxEntry->pxWork->ulParameter2;
+
+				/* Posts made from here on are not covered by this run, so
+				must queue the item again. */
+				pxEntry->pxWork->xPending = pdFALSE;
+			}
+			else
+			{
+				pxFunction = pxEntry->pxFunction;
+				pvParameter1 = pxEntry->pvParameter1;
+				ulParameter2 = pxEntry->ulParameter2;
+			}
+
+			/* Free the entry before running the function, so the function can
+			post again even if the ring was full. */
+			ulTail++;
+			ulDeferredWorkTail = ulTail;
+
+			/* On a multi-core build the new tail must be seen by a poster on
+			another core before the next entry is looked at, or both could
+			decide the other will see the request and the task would not be
+			notified. */
+			portMEMORY_BARRIER();
+
+			pxFunction( pvParameter1, ulParameter2 );
+
+			pxEntry = &( xDeferredWorkRing[ ulTail & dwRING_INDEX_MASK ] );
+		}
+
+		/* Wait for the request that will be held by the entry just looked at.
+		If it was published after the entry was looked at the notification is
+		already pending, so this returns straight away. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPostRequest( DeferredFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2, DeferredWork_t *pxWork, BaseType_t *pxNotify )
+{
+UBaseType_t uxSavedInterruptStatus;
+DeferredWorkEntry_t *pxEntry = NULL;
+uint32_t ulRequest = 0UL, ulUsed;
+BaseType_t xReturn = pdPASS;
+
+	*pxNotify = pdFALSE;
+
+	/* Only claiming the entry needs interrupts masked (see the comment above
+	xDeferredWorkRing).  An interrupt that nests while the entry is being filled
+	in finishes before the deferred work task can run again. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( ( pxWork != NULL ) && ( pxWork->xPending != pdFALSE ) )
+		{
+			/* Still waiting to run, and will run after this post. */
+			xDeferredWorkStats.ulCoalesced++;
+		}
+		else
+		{
+			ulUsed = ulDeferredWorkHead - ulDeferredWorkTail;
+
+			if( ulUsed < ( uint32_t ) configDEFERRED_WORK_QUEUE_LENGTH )
+			{
+				ulRequest = ulDeferredWorkHead;
+				ulDeferredWorkHead = ulRequest + 1UL;
+				pxEntry = &( xDeferredWorkRing[ ulRequest & dwRING_INDEX_MASK ] );
+
+				if( pxWork != NULL )
+				{
+					pxWork->xPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xDeferredWorkStats.ulPosted++;
+
+				if( ( UBaseType_t ) ( ulUsed + 1UL ) > xDeferredWorkStats.uxMostUsed )
+				{
+					xDeferredWorkStats.uxMostUsed = ( UBaseType_t ) ( ulUsed + 1UL );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xDeferredWorkStats.ulDropped++;
+				xReturn = pdFAIL;
+			}
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( pxEntry != NULL )
+	{
+		pxEntry->pxFunction = pxFunction;
+		pxEntry->pvParameter1 = pvParameter1;
+		pxEntry->ulParameter2 = ulParameter2;
+		pxEntry->pxWork = pxWork;
+
+		/* The barriers publish the entry before its sequence number, and the
+		sequence number before the tail is read, on a multi-core build. */
+		portMEMORY_BARRIER();
+		pxEntry->ulSequence = ulRequest + 1UL;
+		portMEMORY_BARRIER();
+
+		/* If the task has not yet reached this entry it will find it without
+		being notified, so only a burst's first request costs a notification. */
+		if( ( ulDeferredWorkTail == ulRequest ) && ( xDeferredWorkTaskHandle != NULL ) )
+		{
+			*pxNotify = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredWorkInit( DeferredWork_t *pxWork, DeferredFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 )
+{
+	configASSERT( pxWork );
+	configASSERT( pxFunction );
+
+	pxWork->pxFunction = pxFunction;
+	pxWork->pvParameter1 = pvParameter1;
+	pxWork->ulParameter2 = ulParameter2;
+	pxWork->xPending = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredWorkPostFromISR( DeferredWork_t *pxWork, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn, xNotify;
+
+	configASSERT( pxWork );
+
+	xReturn = prvPostRequest( NULL, NULL, 0UL, pxWork, &xNotify );
+
+	if( xNotify != pdFALSE )
+	{
+		vTaskNotifyGiveFromISR( xDeferredWorkTaskHandle, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredWorkPost( DeferredWork_t *pxWork )
+{
+BaseType_t xReturn, xNotify;
+
+	configASSERT( pxWork );
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvPostRequest( NULL, NULL, 0UL, pxWork, &xNotify );
+	}
+	taskEXIT_CRITICAL();
+
+	if( xNotify != pdFALSE )
+	{
+		( void ) xTaskNotifyGive( xDeferredWorkTaskHandle );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredFunctionCallFromISR( DeferredFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn, xNotify;
+
+	configASSERT( xFunctionToPend );
+
+	xReturn = prvPostRequest( xFunctionToPend, pvParameter1, ulParameter2, NULL, &xNotify );
+
+	if( xNotify != pdFALSE )
+	{
+		vTaskNotifyGiveFromISR( xDeferredWorkTaskHandle, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredFunctionCall( DeferredFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2 )
+{
+BaseType_t xReturn, xNotify;
+
+	configASSERT( xFunctionToPend );
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvPostRequest( xFunctionToPend, pvParameter1, ulParameter2, NULL, &xNotify );
+	}
+	taskEXIT_CRITICAL();
+
+	if( xNotify != pdFALSE )
+	{
+		( void ) xTaskNotifyGive( xDeferredWorkTaskHandle );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xDeferredWorkGetTaskHandle( void )
+{
+	/* If xDeferredWorkGetTaskHandle() is called before the scheduler has been
+	started, then xDeferredWorkTaskHandle will be NULL. */
+	configASSERT( ( xDeferredWorkTaskHandle != NULL ) );
+	return xDeferredWorkTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredWorkGetStats( DeferredWorkStats_t *pxStats )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxStats );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		*pxStats = xDeferredWorkStats;
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include deferred work.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_DEFERRED_WORK == 1 */
@@ -60,10 +60,36 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* The number of bits in an event group that are available to the application,
+and so can have tasks waiting for them. */
+#if configUSE_16_BIT_TICKS == 1
+	#define eventNUM_BITS					( 8U )
+#else
+	#define eventNUM_BITS					( 24U )
+#endif
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+	/* Interrupts set and clear bits, and unblock tasks, directly, so the task
+	level functions access the bits and the lists of waiting tasks from critical
+	sections - entered with the scheduler suspended, as the task event list
+	functions require. */
+	#define eventENTER_CRITICAL()	taskENTER_CRITICAL()
+	#define eventEXIT_CRITICAL()	taskEXIT_CRITICAL()
+#else
+	/* Interrupts pend their calls to the timer task, so suspending the
+	scheduler is enough. */
+	#define eventENTER_CRITICAL()
+	#define eventEXIT_CRITICAL()
+#endif
+
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set - with configUSE_EVENT_GROUP_BIT_INDEX, only those waiting for any one of several bits. */
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+		List_t xTasksWaitingForBit[ eventNUM_BITS ];	/*< Tasks waiting for one bit, and tasks waiting for all their bits held against one of them that was clear when the task was last looked at. */
+	#endif
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
@@ -86,6 +112,46 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the lists of waiting tasks of a new event group.
+ */
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set uxBitsToSet, unblock the tasks whose wait condition is then met, and
+ * clear the bits those tasks asked to be cleared on exit.  Called with the
+ * scheduler suspended, from a critical section if
+ * configUSE_EVENT_GROUP_DIRECT_ISR is 1, or with interrupts masked from an
+ * interrupt if xFromISR is pdTRUE.  Returns pdTRUE if a task with a priority
+ * above the calling (or interrupted) task was unblocked.
+ */
+static BaseType_t prvSetBitsAndUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Test the wait condition of every task in pxList against the bits now set,
+ * unblocking the tasks whose condition is met and adding the bits they clear
+ * on exit to *puxBitsToClear.  Part of prvSetBitsAndUnblockTasks().
+ */
+static BaseType_t prvTestWaitingTasks( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t *puxBitsToClear, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+
+	/*
+	 * Return the list a task waiting for uxBitsWaitedFor, with control bits
+	 * uxControlBits, is held in.  A task waiting for all its bits is held
+	 * against the highest of them that is clear, as it cannot be unblocked
+	 * until that bit is set.  A task waiting for any one of several bits is
+	 * held in xTasksWaitingForBits, which is looked at whatever bits are set.
+	 */
+	static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor, const EventBits_t uxControlBits ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/* Every waiting task is held in the one list. */
+	#define prvGetWaitList( pxEventBits, uxBitsWaitedFor, uxControlBits ) ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+
+#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +179,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -164,7 +230,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitLists( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -204,10 +270,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
-		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+		( void ) prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, pdFALSE );
 
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
@@ -229,7 +297,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor, eventWAIT_FOR_ALL_BITS ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -246,6 +314,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventEXIT_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +396,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -384,7 +454,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor, uxControlBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +464,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventEXIT_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,7 +556,27 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
@@ -506,11 +597,11 @@ UBaseType_t uxSavedInterruptStatus;
 EventGroup_t const * const pxEventBits = xEventGroup;
 EventBits_t uxReturn;
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		uxReturn = pxEventBits->uxEventBits;
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -518,95 +609,251 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
+EventBits_t uxReturn;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
+		( void ) prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, pdFALSE );
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	eventEXIT_CRITICAL();
+	( void ) xTaskResumeAll();
 
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetBitsAndUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+{
+EventBits_t uxBitsToClear = 0;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
 
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
+	/* See if the new bit value should unblock any tasks.  With the bit index
+	only the tasks held against the bits being set, and those waiting for any
+	one of several bits, can have had their wait condition met. */
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+	{
+	UBaseType_t uxBit;
+
+		for( uxBit = 0U; uxBit < eventNUM_BITS; uxBit++ )
 		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
+			if( ( uxBitsToSet & ( ( EventBits_t ) 1 << uxBit ) ) != ( EventBits_t ) 0 )
+			{
+				if( prvTestWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), &uxBitsToClear, xFromISR ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+
+	if( prvTestWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear, xFromISR ) != pdFALSE )
+	{
+		xHigherPriorityTaskWoken = pdTRUE;
+	}
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
 
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestWaitingTasks( EventGroup_t *pxEventBits, List_t *pxList, EventBits_t *puxBitsToClear, const BaseType_t xFromISR )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+EventBits_t uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound, xHigherPriorityTaskWoken = pdFALSE;
+
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	while( pxListItem != pxListEnd )
+	{
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			{
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set.  With
+			the bit index the task is moved to the list of another bit it is
+			still waiting for, so it is not looked at again until that bit is
+			set. */
+			#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
 			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			List_t *pxNewList = prvGetWaitList( pxEventBits, uxBitsWaitedFor, uxControlBits );
+
+				if( pxNewList != pxList )
 				{
-					xMatchFound = pdTRUE;
+					( void ) uxListRemove( pxListItem );
+					vListInsertEnd( pxNewList, pxListItem );
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+			#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
 			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
+				*puxBitsToClear |= uxBitsWaitedFor;
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
+				mtCOVERAGE_TEST_MARKER();
 			}
 
-			if( xMatchFound != pdFALSE )
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
 			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+				if( xFromISR != pdFALSE )
 				{
-					uxBitsToClear |= uxBitsWaitedFor;
+					if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+					{
+						xHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
 				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
+			}
+			#else
+			{
+				/* Only the task level calls this function. */
+				( void ) xFromISR;
 				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
 			}
+			#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+		}
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list, or moved to the list
+		of another bit. */
+		pxListItem = pxNext;
+	}
 
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+
+	static List_t *prvGetWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsWaitedFor, const EventBits_t uxControlBits )
+	{
+	EventBits_t uxCandidateBits;
+	List_t *pxList;
+	UBaseType_t uxBit;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+		{
+			/* Only called when the wait condition is not met, so at least one
+			bit is clear. */
+			uxCandidateBits = uxBitsWaitedFor & ~( pxEventBits->uxEventBits );
+		}
+		else if( ( uxBitsWaitedFor & ( uxBitsWaitedFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 )
+		{
+			/* Waiting for any one bit of one - the same as waiting for all. */
+			uxCandidateBits = uxBitsWaitedFor;
+		}
+		else
+		{
+			uxCandidateBits = 0;
 		}
 
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		if( uxCandidateBits != ( EventBits_t ) 0 )
+		{
+			/* The highest bit is used so that tasks that wait for the same bits
+			in a rendezvous, where the bits tend to be set in order, are only
+			looked at again when the last of the bits is set. */
+			uxBit = eventNUM_BITS - 1U;
+			while( ( uxCandidateBits & ( ( EventBits_t ) 1 << uxBit ) ) == ( EventBits_t ) 0 )
+			{
+				uxBit--;
+			}
+
+			pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+		}
+		else
+		{
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+		}
+
+		return pxList;
 	}
-	( void ) xTaskResumeAll();
 
-	return pxEventBits->uxEventBits;
+#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseWaitLists( EventGroup_t *pxEventBits )
+{
+	vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+	{
+	UBaseType_t uxBit;
+
+		for( uxBit = 0U; uxBit < eventNUM_BITS; uxBit++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+		}
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
 }
 /*-----------------------------------------------------------*/
 
@@ -616,6 +863,7 @@ EventGroup_t *pxEventBits = xEventGroup;
 const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 
 	vTaskSuspendAll();
+	eventENTER_CRITICAL();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
@@ -627,6 +875,24 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
 		}
 
+		#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+		{
+		UBaseType_t uxBit;
+
+			for( uxBit = 0U; uxBit < eventNUM_BITS; uxBit++ )
+			{
+				pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+				while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+				{
+					vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_BIT_INDEX */
+	}
+	eventEXIT_CRITICAL();
+	{
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -703,7 +969,47 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* The task level functions access the event group from critical
+		sections, so the bits can be set, and the tasks waiting for them
+		unblocked, here rather than in the timer task.  Only the tasks held
+		against the bits being set are looked at if configUSE_EVENT_GROUP_BIT_INDEX
+		is 1. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+			if( prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, pdTRUE ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
@@ -218,6 +218,30 @@ extern "C" {
 	#define portCRITICAL_NESTING_IN_TCB 0
 #endif
 
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES 1
+#endif
+
+#if configNUMBER_OF_CORES < 1
+	#error configNUMBER_OF_CORES must be set to a minimum of 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+	#define configUSE_CORE_AFFINITY 0
+#endif
+
+#ifndef configRUN_MULTIPLE_PRIORITIES
+	#define configRUN_MULTIPLE_PRIORITIES 0
+#endif
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+	#define configUSE_PASSIVE_IDLE_HOOK 0
+#endif
+
+#ifndef configTASK_DEFAULT_CORE_AFFINITY
+	#define configTASK_DEFAULT_CORE_AFFINITY tskNO_AFFINITY
+#endif
+
 #ifndef configMAX_TASK_NAME_LEN
 	#define configMAX_TASK_NAME_LEN 16
 #endif
@@ -254,6 +278,64 @@ extern "C" {
 
 #endif /* configUSE_TIMERS */
 
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	#define configUSE_TIMER_DIRECT_COMMANDS 0
+#endif
+
+#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+	/* The timer API asks the scheduler whether the timer service task is the
+	caller. */
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+		#error INCLUDE_xTaskGetCurrentTaskHandle or configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h when configUSE_TIMER_DIRECT_COMMANDS is set to 1.
+	#endif
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configUSE_DEFERRED_WORK
+	#define configUSE_DEFERRED_WORK 0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+	#define configUSE_EVENT_GROUP_DIRECT_ISR 0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_BIT_INDEX
+	#define configUSE_EVENT_GROUP_BIT_INDEX 0
+#endif
+
+#if( configUSE_DEFERRED_WORK == 1 )
+
+	/* By default the deferred work task runs one below the highest priority,
+	so it preempts the application's ordinary tasks but a task that must not be
+	delayed by interrupt work can still be given the highest priority.  Needs
+	configMAX_PRIORITIES to be 2 or more. */
+	#ifndef configDEFERRED_WORK_TASK_PRIORITY
+		#define configDEFERRED_WORK_TASK_PRIORITY ( configMAX_PRIORITIES - 2 )
+	#endif /* configDEFERRED_WORK_TASK_PRIORITY */
+
+	#ifndef configDEFERRED_WORK_QUEUE_LENGTH
+		#error If configUSE_DEFERRED_WORK is set to 1 then configDEFERRED_WORK_QUEUE_LENGTH must also be defined.
+	#endif /* configDEFERRED_WORK_QUEUE_LENGTH */
+
+	#ifndef configDEFERRED_WORK_TASK_STACK_DEPTH
+		#error If configUSE_DEFERRED_WORK is set to 1 then configDEFERRED_WORK_TASK_STACK_DEPTH must also be defined.
+	#endif /* configDEFERRED_WORK_TASK_STACK_DEPTH */
+
+	/* The deferred work task waits on its task notification, and is created
+	with xTaskCreate(). */
+	#if( configUSE_TASK_NOTIFICATIONS != 1 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h when configUSE_DEFERRED_WORK is set to 1.
+	#endif
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+		#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h when configUSE_DEFERRED_WORK is set to 1.
+	#endif
+
+#endif /* configUSE_DEFERRED_WORK */
+
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
 	#define portSET_INTERRUPT_MASK_FROM_ISR() 0
 #endif
@@ -262,6 +344,17 @@ extern "C" {
 	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue ) ( void ) uxSavedStatusValue
 #endif
 
+/* Ports that time the periods for which portSET_INTERRUPT_MASK_FROM_ISR() masks
+interrupts, when configGENERATE_ISR_LATENCY_STATS is 1, also provide untimed
+versions for use by the timing code itself. */
+#ifndef portRAW_SET_INTERRUPT_MASK_FROM_ISR
+	#define portRAW_SET_INTERRUPT_MASK_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#endif
+
+#ifndef portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR
+	#define portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue ) portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )
+#endif
+
 #ifndef portCLEAN_UP_TCB
 	#define portCLEAN_UP_TCB( pxTCB ) ( void ) pxTCB
 #endif
@@ -288,6 +381,16 @@ extern "C" {
 	#define portPOINTER_SIZE_TYPE uint32_t
 #endif
 
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	/* The binary trace recorder defines the trace macros, so must be included
+	before the unused macros are removed below. */
+	#include "trace_recorder.h"
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 	/* Used to perform any necessary initialisation - for example, open a file
@@ -609,31 +712,31 @@ extern "C" {
 #endif
 
 #ifndef traceTASK_NOTIFY_TAKE_BLOCK
-	#define traceTASK_NOTIFY_TAKE_BLOCK()
+	#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_TAKE
-	#define traceTASK_NOTIFY_TAKE()
+	#define traceTASK_NOTIFY_TAKE( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_WAIT_BLOCK
-	#define traceTASK_NOTIFY_WAIT_BLOCK()
+	#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_WAIT
-	#define traceTASK_NOTIFY_WAIT()
+	#define traceTASK_NOTIFY_WAIT( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY
-	#define traceTASK_NOTIFY()
+	#define traceTASK_NOTIFY( uxIndexToNotify )
 #endif
 
 #ifndef traceTASK_NOTIFY_FROM_ISR
-	#define traceTASK_NOTIFY_FROM_ISR()
+	#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )
 #endif
 
 #ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
-	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )
 #endif
 
 #ifndef traceSTREAM_BUFFER_CREATE_FAILED
@@ -710,6 +813,76 @@ extern "C" {
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Can be set to uint64_t when the run time counter is clocked fast enough
+	for 32 bits to overflow within the life of the application. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+#ifndef configGENERATE_CPU_LOAD_STATS
+	#define configGENERATE_CPU_LOAD_STATS 0
+#endif
+
+#if( configGENERATE_CPU_LOAD_STATS == 1 )
+	#if( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configGENERATE_RUN_TIME_STATS must be set to 1 in FreeRTOSConfig.h when configGENERATE_CPU_LOAD_STATS is set to 1.
+	#endif
+#endif /* configGENERATE_CPU_LOAD_STATS */
+
+#ifndef configCPU_LOAD_ISR_LEVELS
+	#define configCPU_LOAD_ISR_LEVELS 4
+#endif
+
+#ifndef configGENERATE_ISR_LATENCY_STATS
+	#define configGENERATE_ISR_LATENCY_STATS 0
+#endif
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+	#if( configGENERATE_RUN_TIME_STATS != 1 )
+		#error configGENERATE_RUN_TIME_STATS must be set to 1 in FreeRTOSConfig.h when configGENERATE_ISR_LATENCY_STATS is set to 1.
+	#endif
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+
+#ifndef configISR_LATENCY_VECTORS
+	/* Vectors 0 and 1 are used by the port for the tick and yield interrupts,
+	the rest are numbered by the application. */
+	#define configISR_LATENCY_VECTORS 8
+#endif
+
+#if( configISR_LATENCY_VECTORS < 2 )
+	#error configISR_LATENCY_VECTORS must be at least 2, as the tick and yield interrupts use vectors 0 and 1.
+#endif
+
+#ifndef configISR_LATENCY_BUCKETS
+	#define configISR_LATENCY_BUCKETS 16
+#endif
+
+#ifndef configISR_LATENCY_NESTING_LEVELS
+	#define configISR_LATENCY_NESTING_LEVELS 4
+#endif
+
+/* 1 to have the idle task keep the stack high water mark of every task up to
+date a few words at a time, for uxTaskGetAllStackWatermarks(). */
+#ifndef configUSE_STACK_WATERMARK_SCANNER
+	#define configUSE_STACK_WATERMARK_SCANNER 0
+#endif
+
+/* The most stack words the idle task checks on each iteration of its loop. */
+#ifndef configSTACK_WATERMARK_SCAN_WORDS
+	#define configSTACK_WATERMARK_SCAN_WORDS 16
+#endif
+
+/* The share of its stack, in percent, a task has to have used for
+vApplicationStackWatermarkHook() to be called.  0 if the application does not
+provide the hook. */
+#ifndef configSTACK_WATERMARK_WARNING_PERCENT
+	#define configSTACK_WATERMARK_WARNING_PERCENT 0
+#endif
+
+#if( configSTACK_WATERMARK_WARNING_PERCENT > 100 )
+	#error configSTACK_WATERMARK_WARNING_PERCENT must be a percentage.
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -719,7 +892,14 @@ extern "C" {
 #endif
 
 #ifndef portYIELD_WITHIN_API
-	#define portYIELD_WITHIN_API portYIELD
+	#if( configNUMBER_OF_CORES > 1 )
+		/* A yield requested from within a critical section is held pending
+		until the critical section is left, as the core must not be switched
+		while it holds the kernel locks. */
+		#define portYIELD_WITHIN_API vTaskYieldWithinAPI
+	#else
+		#define portYIELD_WITHIN_API portYIELD
+	#endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
@@ -738,6 +918,10 @@ extern "C" {
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_INDEXED_DELAY_LISTS
+	#define configUSE_INDEXED_DELAY_LISTS 0
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -754,10 +938,61 @@ extern "C" {
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_QUEUE_BATCH
+	#define configUSE_QUEUE_BATCH 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_SCATTER_GATHER
+	#define configUSE_STREAM_BUFFER_SCATTER_GATHER 0
+#endif
+
+#ifndef configUSE_HEAP_POOLS
+	#define configUSE_HEAP_POOLS 0
+#endif
+
+#if( configUSE_HEAP_POOLS == 1 )
+	#ifndef configHEAP_POOL_COUNT
+		#error configHEAP_POOL_COUNT must be defined in FreeRTOSConfig.h when configUSE_HEAP_POOLS is set to 1.
+	#endif
+
+	#ifndef configHEAP_POOL_BLOCK_SIZES
+		#error configHEAP_POOL_BLOCK_SIZES must be defined in FreeRTOSConfig.h when configUSE_HEAP_POOLS is set to 1.
+	#endif
+
+	#ifndef configHEAP_POOL_BLOCK_COUNTS
+		#error configHEAP_POOL_BLOCK_COUNTS must be defined in FreeRTOSConfig.h when configUSE_HEAP_POOLS is set to 1.
+	#endif
+#endif /* configUSE_HEAP_POOLS */
+
+#ifndef configUSE_HEAP_ACCOUNTING
+	#define configUSE_HEAP_ACCOUNTING 0
+#endif
+
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+	/* The heap asks the scheduler which task is making each allocation. */
+	#if( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+		#error INCLUDE_xTaskGetSchedulerState or configUSE_TIMERS must be set to 1 in FreeRTOSConfig.h when configUSE_HEAP_ACCOUNTING is set to 1.
+	#endif
+
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+		#error INCLUDE_xTaskGetCurrentTaskHandle or configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h when configUSE_HEAP_ACCOUNTING is set to 1.
+	#endif
+#endif /* configUSE_HEAP_ACCOUNTING */
+
+#ifndef configHEAP_CALL_SITE
+	/* Set to an expression that identifies the code calling pvPortMalloc(), for
+	example the return address, to have it recorded with each block. */
+	#define configHEAP_CALL_SITE() ( NULL )
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
 
+#ifndef portTASK_USES_ACCUMULATOR
+	#define portTASK_USES_ACCUMULATOR()
+#endif
+
 #ifndef portTASK_CALLS_SECURE_FUNCTIONS
 	#define portTASK_CALLS_SECURE_FUNCTIONS()
 #endif
@@ -766,6 +1001,24 @@ extern "C" {
 	#define configUSE_TIME_SLICING 1
 #endif
 
+/* 1 to time slice tasks of each priority after the number of ticks given by
+configTIME_SLICE_TICKS(), or set by vTaskSetTimeSlice(), rather than on every
+tick. */
+#ifndef configUSE_TIME_SLICE_QUANTA
+	#define configUSE_TIME_SLICE_QUANTA 0
+#endif
+
+/* The ticks a task of priority uxPriority runs before the next ready task of
+the same priority is switched in, or portMAX_DELAY if it runs until it blocks,
+yields or is preempted. */
+#ifndef configTIME_SLICE_TICKS
+	#define configTIME_SLICE_TICKS( uxPriority ) ( ( TickType_t ) 1 )
+#endif
+
+#if( ( configUSE_TIME_SLICE_QUANTA == 1 ) && ( ( configUSE_PREEMPTION == 0 ) || ( configUSE_TIME_SLICING == 0 ) ) )
+	#error configUSE_TIME_SLICE_QUANTA requires configUSE_PREEMPTION and configUSE_TIME_SLICING to be set to 1.
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
 	#define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS 0
 #endif
@@ -806,6 +1059,36 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+/* 0 to have only the idle task free the memory of tasks that delete
+themselves.  Otherwise the number of such tasks that can wait before the next
+task to create or delete a task frees them all. */
+#ifndef configTASK_CLEANUP_THRESHOLD
+	#define configTASK_CLEANUP_THRESHOLD 0
+#endif
+
+/* 1 to pass an inherited priority on along a chain of tasks that wait for
+mutexes held by each other, and to have each task keep a list of the mutexes it
+holds so a task that gives back one of several mutexes drops only to the
+priority the others still require.  0 for the original single level scheme. */
+#ifndef configUSE_PRIORITY_INHERITANCE_CHAINS
+	#define configUSE_PRIORITY_INHERITANCE_CHAINS 0
+#endif
+
+/* The number of mutex holders a priority is passed on to after the holder of
+the mutex being waited for.  Bounds the time spent in the critical section, and
+breaks the walk around a deadlock. */
+#ifndef configPRIORITY_INHERITANCE_CHAIN_DEPTH
+	#define configPRIORITY_INHERITANCE_CHAIN_DEPTH 4
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -848,6 +1131,75 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use priority inheritance chains
+#endif
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* The port must say which core is executing, request a yield on another
+	core, and provide the two recursive spinlocks the kernel takes in place of
+	masking interrupts on a single core.  The task lock is held while a core is
+	in a critical section or has the scheduler suspended, and the ISR lock while
+	a core is in a critical section entered from a task or an interrupt.  The
+	critical nesting count is kept per core by the port. */
+	#ifndef portGET_CORE_ID
+		#error portGET_CORE_ID() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#ifndef portYIELD_CORE
+		#error portYIELD_CORE() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+		#error portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() must be defined by the port when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portSET_CRITICAL_NESTING_COUNT ) || !defined( portINCREMENT_CRITICAL_NESTING_COUNT ) || !defined( portDECREMENT_CRITICAL_NESTING_COUNT )
+		#error The port must keep the critical nesting count of each core when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be set to 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if( portCRITICAL_NESTING_IN_TCB != 0 )
+		#error portCRITICAL_NESTING_IN_TCB cannot be used when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be set to 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	/* Both measure a single stream of execution. */
+	#if( configGENERATE_CPU_LOAD_STATS != 0 )
+		#error configGENERATE_CPU_LOAD_STATS must be set to 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if( configGENERATE_ISR_LATENCY_STATS != 0 )
+		#error configGENERATE_ISR_LATENCY_STATS must be set to 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_TRACE_RECORDER != 0 )
+		#error configUSE_TRACE_RECORDER must be set to 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+#else
+
+	#ifndef portGET_CORE_ID
+		#define portGET_CORE_ID() ( ( BaseType_t ) 0 )
+	#endif
+
+#endif /* configNUMBER_OF_CORES */
+
+#ifndef portMEMORY_BARRIER
+	/* Orders memory accesses between cores, and between the two ends of a
+	stream buffer created with sbFLAGS_LOCKFREE_SPSC.  Ports that define
+	nothing must not let the compiler move memory accesses across a function
+	call that publishes shared data. */
+	#define portMEMORY_BARRIER()
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -956,6 +1308,10 @@ struct xSTATIC_LIST_ITEM
 {
 	TickType_t xDummy1;
 	void *pvDummy2[ 4 ];
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+		void *pvDummy3[ 3 ];
+		BaseType_t xDummy4;
+	#endif
 };
 typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
 
@@ -973,6 +1329,10 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy1;
 	void *pvDummy2;
 	StaticMiniListItem_t xDummy3;
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+		void *pvDummy4;
+		BaseType_t xDummy5;
+	#endif
 } StaticList_t;
 
 /*
@@ -1004,12 +1364,23 @@ typedef struct xSTATIC_TCB
 	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 		UBaseType_t		uxDummy9;
 	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		BaseType_t		xDummy9a;
+		UBaseType_t		uxDummy9b;
+	#endif
+	#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+		UBaseType_t		uxDummy9c;
+	#endif
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy10[ 2 ];
 	#endif
 	#if ( configUSE_MUTEXES == 1 )
 		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		StaticList_t	xDummy12a;
+		void			*pvDummy12b;
+	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
@@ -1017,14 +1388,23 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16;
+	#endif
+	#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulDummy16a;
+		uint32_t		ulDummy16b[ 3 ];
+	#endif
+	#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		StaticListItem_t	xDummy16c;
+		uint32_t		ulDummy16d[ 3 ];
+		uint8_t			ucDummy16e;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t			uxDummy20;
@@ -1064,6 +1444,10 @@ typedef struct xSTATIC_QUEUE
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
 
+	#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		StaticListItem_t xDummy2a;
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucDummy6;
 	#endif
@@ -1099,6 +1483,10 @@ typedef struct xSTATIC_EVENT_GROUP
 	TickType_t xDummy1;
 	StaticList_t xDummy2;
 
+	#if( configUSE_EVENT_GROUP_BIT_INDEX == 1 )
+		StaticList_t xDummy5[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
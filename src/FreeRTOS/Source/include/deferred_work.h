@@ -0,0 +1,157 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Deferred work.  When configUSE_DEFERRED_WORK is set to 1 in FreeRTOSConfig.h
+ * the scheduler creates a deferred work task, at
+ * configDEFERRED_WORK_TASK_PRIORITY (by default configMAX_PRIORITIES - 2, one
+ * below the highest priority), that runs functions posted to it by
+ * interrupts (and tasks), so an interrupt can do the minimum itself and leave
+ * the rest to a task.  This does the same job as
+ * xTimerPendFunctionCallFromISR(), but does not share the timer command queue,
+ * so a burst of timer commands cannot delay the deferred work, or fill the
+ * queue and cause the interrupt's request to be lost.
+ *
+ * Requests are held in a ring of configDEFERRED_WORK_QUEUE_LENGTH entries,
+ * which must be a power of 2.  An interrupt claims an entry with interrupts
+ * masked up to configMAX_SYSCALL_INTERRUPT_PRIORITY for a few instructions,
+ * rather than with a compare and swap on the head, as the RX has no compare
+ * and swap instruction and this kernel has no atomic API.  It then fills the
+ * entry in and publishes it with interrupts enabled, so interrupts of any
+ * priority that can use the FreeRTOS API can post at the same time.  The
+ * task is only notified when it has caught up with the entries published
+ * before, so a burst of requests costs one notification.
+ *
+ * A request is either a one-off function call, made with
+ * xDeferredFunctionCallFromISR(), or a DeferredWork_t work item, posted with
+ * xDeferredWorkPostFromISR().  A work item that is posted again before the
+ * task has started running it is not queued twice, so an interrupt that fires
+ * faster than its work can be done costs one ring entry, not one per
+ * interrupt.  The function runs once for all the posts made before it
+ * started.
+ */
+
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include deferred_work.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The prototype of the functions run by the deferred work task - the same as
+PendedFunction_t in timers.h. */
+typedef void (*DeferredFunction_t)( void *, uint32_t );
+
+/*
+ * A work item.  The structure is allocated by the application, normally
+ * statically, and set up with vDeferredWorkInit().  Its members are private to
+ * deferred_work.c.
+ */
+typedef struct xDEFERRED_WORK
+{
+	DeferredFunction_t pxFunction;
+	void *pvParameter1;
+	uint32_t ulParameter2;
+	volatile BaseType_t xPending;
+} DeferredWork_t;
+
+/* Returned by vDeferredWorkGetStats(). */
+typedef struct xDEFERRED_WORK_STATS
+{
+	uint32_t ulPosted;			/* Requests added to the ring. */
+	uint32_t ulCoalesced;		/* Work item posts that found the item already pending. */
+	uint32_t ulDropped;			/* Requests that failed because the ring was full. */
+	UBaseType_t uxMostUsed;		/* The most ring entries in use at once. */
+} DeferredWorkStats_t;
+
+/*
+ * Set up a work item so that posting it has the deferred work task call
+ * pxFunction( pvParameter1, ulParameter2 ).  Must not be called while the item
+ * is pending.
+ */
+void vDeferredWorkInit( DeferredWork_t *pxWork, DeferredFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * Have the deferred work task run pxWork's function, unless pxWork is already
+ * waiting to be run.  Returns pdPASS if the item was queued or was already
+ * pending, or pdFAIL if the ring was full.  *pxHigherPriorityTaskWoken is set
+ * to pdTRUE if the deferred work task was woken and has a priority above the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt exits.
+ */
+BaseType_t xDeferredWorkPostFromISR( DeferredWork_t *pxWork, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * As xDeferredWorkPostFromISR(), for use from tasks.  Never blocks.
+ */
+BaseType_t xDeferredWorkPost( DeferredWork_t *pxWork ) PRIVILEGED_FUNCTION;
+
+/*
+ * Have the deferred work task call xFunctionToPend( pvParameter1,
+ * ulParameter2 ) once.  One-off calls are made in the order they were posted,
+ * and are not coalesced.  Returns pdPASS, or pdFAIL if the ring was full.
+ * *pxHigherPriorityTaskWoken is used as by xDeferredWorkPostFromISR().
+ */
+BaseType_t xDeferredFunctionCallFromISR( DeferredFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * As xDeferredFunctionCallFromISR(), for use from tasks.  Never blocks.
+ */
+BaseType_t xDeferredFunctionCall( DeferredFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the handle of the deferred work task.  Must not be called before the
+ * scheduler has been started.
+ */
+TaskHandle_t xDeferredWorkGetTaskHandle( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the counts of requests posted, coalesced and dropped since the
+ * scheduler started, and the most entries used, to *pxStats.
+ */
+void vDeferredWorkGetStats( DeferredWorkStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Create the ring and the deferred work task.  Called by vTaskStartScheduler(),
+ * not by application code.
+ */
+BaseType_t xDeferredWorkCreateTask( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEFERRED_WORK_H */
@@ -145,6 +145,12 @@ struct xLIST_ITEM
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;	/*< Pointer to the previous ListItem_t in the list. */
 	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
 	struct xLIST * configLIST_VOLATILE pxContainer;		/*< Pointer to the list in which this list item is placed (if any). */
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+		struct xLIST_ITEM * pxTreeParent;				/*< The links used to place the item in the red-black tree of an indexed list.  Unused when the item is in a list that is not indexed. */
+		struct xLIST_ITEM * pxTreeLeft;
+		struct xLIST_ITEM * pxTreeRight;
+		BaseType_t xTreeRed;
+	#endif
 	listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as two separate definitions. */
@@ -167,6 +173,10 @@ typedef struct xLIST
 	volatile UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+		ListItem_t * pxTreeRoot;						/*< Root of the red-black tree that indexes the items of an indexed list by item value. */
+		BaseType_t xIndexed;							/*< pdTRUE if the list was initialised with vListInitialiseIndexed(). */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -344,6 +354,30 @@ List_t * const pxConstList = ( pxList );													\
  */
 void vListInitialise( List_t * const pxList ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configUSE_INDEXED_DELAY_LISTS is set to 1.
+ *
+ * Initialise a list that is only ever written using vListInsert().  As well as
+ * being kept in a sorted linked list, the items of an indexed list are kept in
+ * a red-black tree ordered by item value, so vListInsert() finds the insertion
+ * point in O(log n) time, rather than by walking the list, and uxListRemove()
+ * also completes in O(log n) time.  The linked list is maintained exactly as
+ * for any other list, so the head of the list is still the item with the lowest
+ * value and all the other list macros can be used unchanged.
+ *
+ * The kernel uses indexed lists for the delayed task lists, the insertion cost
+ * of which otherwise grows with the number of tasks that are blocked with a
+ * timeout.
+ *
+ * @param pxList Pointer to the list being initialised.
+ *
+ * \page vListInitialiseIndexed vListInitialiseIndexed
+ * \ingroup LinkedList
+ */
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	void vListInitialiseIndexed( List_t * const pxList ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Must be called before a list item is used.  This sets the list container to
  * null so the item does not think that it is already contained in a list.
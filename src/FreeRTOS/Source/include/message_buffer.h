@@ -203,6 +203,25 @@ MessageBufferHandle_t xMessageBuffer;
  */
 #define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, pdTRUE, pucMessageBufferStorageArea, pxStaticMessageBuffer )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateWithFlags( size_t xBufferSizeBytes, BaseType_t xFlags );
+MessageBufferHandle_t xMessageBufferCreateStaticWithFlags( size_t xBufferSizeBytes, BaseType_t xFlags, uint8_t *pucMessageBufferStorageArea, StaticMessageBuffer_t *pxStaticMessageBuffer );
+</pre>
+ *
+ * Versions of xMessageBufferCreate() and xMessageBufferCreateStatic() that
+ * accept the creation flags defined in stream_buffer.h, for example
+ * sbFLAGS_LOCKFREE_SPSC.  Passing 0 as xFlags is the same as calling the
+ * versions without flags.
+ *
+ * \defgroup xMessageBufferCreateWithFlags xMessageBufferCreateWithFlags
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateWithFlags( xBufferSizeBytes, xFlags ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, ( pdTRUE | ( xFlags ) ) )
+#define xMessageBufferCreateStaticWithFlags( xBufferSizeBytes, xFlags, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, ( pdTRUE | ( xFlags ) ), pucMessageBufferStorageArea, pxStaticMessageBuffer )
+
 /**
  * message_buffer.h
  *
@@ -791,6 +810,59 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer, const StreamBufferIOVec_t * const pxVectors, UBaseType_t uxVectorCount, TickType_t xTicksToWait );
+size_t xMessageBufferSendVFromISR( MessageBufferHandle_t xMessageBuffer, const StreamBufferIOVec_t * const pxVectors, UBaseType_t uxVectorCount, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Send one message made up of the uxVectorCount blocks described by
+ * pxVectors, for example a frame header and its payload, without first copying
+ * them into one buffer.  The message is written completely or not at all.  See
+ * xStreamBufferSendV() in stream_buffer.h.
+ *
+ * configUSE_STREAM_BUFFER_SCATTER_GATHER must be set to 1 in FreeRTOSConfig.h
+ * for these macros to be available.
+ *
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) xStreamBufferSendV( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait )
+#define xMessageBufferSendVFromISR( xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken ) xStreamBufferSendVFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer, StreamBufferIOVec_t pxSpans[ 2 ], TickType_t xTicksToWait );
+size_t xMessageBufferReceiveAcquireFromISR( MessageBufferHandle_t xMessageBuffer, StreamBufferIOVec_t pxSpans[ 2 ] );
+BaseType_t xMessageBufferReceiveConsume( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength );
+BaseType_t xMessageBufferReceiveConsumeFromISR( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Parse the next message in place.  xMessageBufferReceiveAcquire() returns the
+ * length of the next message (0 if there is none) and describes it as two spans
+ * of the message buffer's storage area, the second of which is only used if
+ * the message wraps around the end of the storage area.  The message stays in
+ * the message buffer until xMessageBufferReceiveConsume() is called with the
+ * same length, which removes it.  Calling xMessageBufferReceiveConsume() with
+ * a length of 0 leaves the message where it is.  See
+ * xStreamBufferReceiveAcquire() and xStreamBufferReceiveConsume() in
+ * stream_buffer.h.
+ *
+ * configUSE_STREAM_BUFFER_SCATTER_GATHER must be set to 1 in FreeRTOSConfig.h
+ * for these macros to be available.
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveAcquire( xMessageBuffer, pxSpans, xTicksToWait ) xStreamBufferReceiveAcquire( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans, xTicksToWait )
+#define xMessageBufferReceiveAcquireFromISR( xMessageBuffer, pxSpans ) xStreamBufferReceiveAcquireFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans )
+#define xMessageBufferReceiveConsume( xMessageBuffer, xMessageLength ) xStreamBufferReceiveConsume( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength )
+#define xMessageBufferReceiveConsumeFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) xStreamBufferReceiveConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken )
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
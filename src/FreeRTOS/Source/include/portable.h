@@ -102,7 +102,7 @@ extern "C" {
 	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
-/* Used by heap_5.c. */
+/* Used by heap_5.c and heap_6.c. */
 typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
@@ -119,9 +119,59 @@ typedef struct HeapRegion
  * defines a region of memory that can be used as the heap.  The array is
  * terminated by a HeapRegions_t structure that has a size of 0.  The region
  * with the lowest start address must appear first in the array.
+ *
+ * heap_6.c adds the regions to its own heap instead, so the function can be
+ * called at any time, and the regions can be in any order.
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Used by heap_4.c when configUSE_HEAP_POOLS is 1. */
+typedef struct xHEAP_POOL_STATS
+{
+	size_t xBlockSize;				/* The largest request the pool serves. */
+	size_t xNumberOfBlocks;			/* The number of blocks in the pool. */
+	size_t xBlocksInUse;			/* The number of blocks currently allocated. */
+	size_t xMaximumBlocksInUse;		/* The most blocks that have been allocated at once. */
+	uint32_t ulHits;				/* The number of requests served by the pool. */
+	uint32_t ulMisses;				/* The number of requests for which this was the best fitting pool, but which were served by the heap because the pool was empty. */
+} HeapPoolStats_t;
+
+/*
+ * Copy the statistics of each of the heap_4.c pools into pxPoolStats, which
+ * must point to an array of configHEAP_POOL_COUNT structures.  The pools are
+ * not counted by xPortGetFreeHeapSize() or xPortGetMinimumEverFreeHeapSize(),
+ * so this is the only record of how much pool memory is free.
+ */
+void vPortGetPoolStats( HeapPoolStats_t *pxPoolStats ) PRIVILEGED_FUNCTION;
+
+/* Used by heap_4.c and heap_5.c when configUSE_HEAP_ACCOUNTING is 1. */
+typedef void (*HeapDumpFunction_t)( void *pvBlock, size_t xRequestedSize, void *pvOwner, const void *pvCallSite, void *pvParameter );
+
+/*
+ * Return the number of bytes requested by the blocks that are currently
+ * allocated and that were allocated by the task whose handle is pvOwner.  Set
+ * pvOwner to NULL for the blocks allocated before the scheduler was started,
+ * or by tasks that have since been deleted.
+ */
+size_t xPortGetHeapUsage( void *pvOwner ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the owner of every allocated block owned by the task whose handle is
+ * pvOwner to NULL.  Called by the kernel when the task is deleted, before its
+ * handle can be reused by a new task.
+ */
+void vPortHeapClearOwner( void *pvOwner ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call pxFunction() once for each allocated block, oldest first, passing the
+ * memory returned by pvPortMalloc(), the number of bytes requested, the handle
+ * of the task that allocated the block (NULL if the scheduler had not been
+ * started or the task has been deleted), the value of configHEAP_CALL_SITE()
+ * at the time, and pvParameter.  The scheduler is suspended while the blocks
+ * are reported, so pxFunction() must not block, or allocate or free memory.
+ */
+void vPortHeapDump( HeapDumpFunction_t pxFunction, void *pvParameter ) PRIVILEGED_FUNCTION;
+
 
 /*
  * Map to the memory management routines required for the port.
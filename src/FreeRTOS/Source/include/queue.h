@@ -61,6 +61,21 @@ typedef struct QueueDef_t * QueueSetHandle_t;
  */
 typedef struct QueueDef_t * QueueSetMemberHandle_t;
 
+/**
+ * One entry of the table of statically allocated queues created by
+ * xQueueCreateStaticSet().  The members are the parameters of
+ * xQueueCreateStatic(), and pxCreatedQueue is where the handle of the created
+ * queue is written.
+ */
+typedef struct xSTATIC_QUEUE_DEFINITION
+{
+	UBaseType_t uxQueueLength;
+	UBaseType_t uxItemSize;
+	uint8_t *pucQueueStorage;
+	StaticQueue_t *pxQueueBuffer;
+	QueueHandle_t *pxCreatedQueue;
+} StaticQueueDefinition_t;
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
@@ -232,6 +247,33 @@ typedef struct QueueDef_t * QueueSetMemberHandle_t;
 	#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueCreateStaticSet( const StaticQueueDefinition_t * const pxQueueDefinitions, const UBaseType_t uxNumberOfQueues );
+ * </pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1.
+ *
+ * Creates every queue described by a table of StaticQueueDefinition_t
+ * structures, as if by calling xQueueCreateStatic() for each entry.  The table
+ * is normally a const table laid out at compile time along with the storage
+ * areas and StaticQueue_t structures it references.  See
+ * xTaskCreateStaticSet() and xTimerCreateStaticSet().
+ *
+ * @param pxQueueDefinitions The table of queues to create.
+ *
+ * @param uxNumberOfQueues The number of entries in pxQueueDefinitions.
+ *
+ * @return pdPASS if every queue was created, otherwise pdFAIL.
+ *
+ * \defgroup xQueueCreateStaticSet xQueueCreateStaticSet
+ * \ingroup QueueManagement
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	BaseType_t xQueueCreateStaticSet( const StaticQueueDefinition_t * const pxQueueDefinitions, const UBaseType_t uxNumberOfQueues ) PRIVILEGED_FUNCTION;
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * queue. h
  * <pre>
@@ -1384,6 +1426,217 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_QUEUE_BATCH == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+								QueueHandle_t xQueue,
+								const void *pvItems,
+								UBaseType_t uxItemCount,
+								TickType_t xTicksToWait
+							   );
+ * </pre>
+ *
+ * Post uxItemCount items to the back of a queue, in order.  The items are held
+ * contiguously in the array pointed to by pvItems, and are copied into the
+ * queue with one entry to a critical section per pass rather than one per item.
+ * Tasks waiting to receive are unblocked with one pass over the event list -
+ * one task per item posted.
+ *
+ * If the queue does not have space for all the items the ones that fit are
+ * posted, then the calling task blocks until there is space for more, up to
+ * xTicksToWait ticks in total.  Items posted by other tasks and interrupts
+ * while the calling task is blocked can be interleaved with the batch, but the
+ * items of the batch remain in order.
+ *
+ * If the queue is a member of a queue set the set is notified once per item,
+ * exactly as if each item had been sent using xQueueSend().
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  It cannot be used on semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items to be placed on the
+ * queue.  The size of each item was defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available, should the queue fill before every item has
+ * been posted.  The call will return once the queue is full if this is set to
+ * 0.
+ *
+ * @return The number of items posted, which is uxItemCount unless the block
+ * time expired first.
+ *
+ * Example usage:
+   <pre>
+ #define BURST_LENGTH	32
+
+ void vASensorTask( void *pvParameters )
+ {
+ QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+ SensorRecord_t xRecords[ BURST_LENGTH ];
+ UBaseType_t uxRecords;
+
+	for( ;; )
+	{
+		uxRecords = uxReadSensorFIFO( xRecords, BURST_LENGTH );
+
+		// Post the whole burst, waiting up to 10 ticks for space.
+		if( xQueueSendMultiple( xQueue, xRecords, uxRecords, ( TickType_t ) 10 ) != uxRecords )
+		{
+			// Some of the records were dropped.
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultipleFromISR(
+										QueueHandle_t xQueue,
+										const void *pvItems,
+										UBaseType_t uxItemCount,
+										BaseType_t *pxHigherPriorityTaskWoken
+									  );
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine, for example to post the records a DMA transfer has just
+ * completed.  As many of the items as there is space for are posted, in order,
+ * and the rest are not.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the first of the items to be placed on the
+ * queue.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items unblocked
+ * a task with a priority higher than the currently running task, in which case
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxMaxItems,
+									TickType_t xTicksToWait
+								  );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue, in order, with one entry to a
+ * critical section.  Tasks waiting to send are unblocked with one pass over the
+ * event list - one task per item removed.
+ *
+ * The call blocks only while the queue is empty.  Once at least one item is
+ * available every available item, up to uxMaxItems, is received and the call
+ * returns - it does not wait for uxMaxItems items to arrive.
+ *
+ * A queue that is a member of a queue set must only be read once per handle
+ * returned by xQueueSelectFromSet(), so this function must not be used to
+ * receive more than one item from such a queue.
+ *
+ * configUSE_QUEUE_BATCH must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.  It cannot be used on semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  It must be large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.  Must be at least
+ * 1.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * before any item was available.
+ *
+ * Example usage:
+   <pre>
+ void vALoggingTask( void *pvParameters )
+ {
+ QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+ SensorRecord_t xRecords[ 16 ];
+ UBaseType_t uxRecord, uxRecords;
+
+	for( ;; )
+	{
+		// Wait for at least one record, then take all that are queued (up to
+		// 16) in one go.
+		uxRecords = xQueueReceiveMultiple( xQueue, xRecords, 16, portMAX_DELAY );
+
+		for( uxRecord = 0; uxRecord < uxRecords; uxRecord++ )
+		{
+			vLogRecord( &( xRecords[ uxRecord ] ) );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultipleFromISR(
+											QueueHandle_t xQueue,
+											void *pvBuffer,
+											UBaseType_t uxMaxItems,
+											BaseType_t *pxHigherPriorityTaskWoken
+										 );
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine, for example to fill a DMA transmit buffer from a queue.
+ * It never blocks, so returns 0 if the queue is empty.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if removing the items
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_BATCH */
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -64,6 +64,18 @@ extern "C" {
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/**
+ * Describes one contiguous block of data.  An array of them passed to
+ * xStreamBufferSendV() lists the blocks that make up the data to send, and
+ * xStreamBufferReceiveAcquire() describes the data that can be read with two
+ * of them.
+ */
+typedef struct xSTREAM_BUFFER_IOVEC
+{
+	const void *pvData;	/* The start of the block. */
+	size_t xLength;		/* The number of bytes in the block. */
+} StreamBufferIOVec_t;
+
 
 /**
  * message_buffer.h
@@ -213,6 +225,54 @@ const size_t xTriggerLevel = 1;
  */
 #define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE, pucStreamBufferStorageArea, pxStaticStreamBuffer )
 
+/*
+ * Flag that can be passed to xStreamBufferCreateWithFlags(),
+ * xStreamBufferCreateStaticWithFlags(), xMessageBufferCreateWithFlags() and
+ * xMessageBufferCreateStaticWithFlags().
+ *
+ * sbFLAGS_LOCKFREE_SPSC promises that the buffer only ever has one writer and
+ * one reader, which is how stream and message buffers are meant to be used
+ * anyway.  Sends and receives then only enter a critical section or suspend the
+ * scheduler when they have to block, or when the task at the other end of the
+ * buffer is actually blocked on it.  The data itself is always copied without
+ * a critical section.
+ *
+ * The single writer and single reader can each be either a task or an
+ * interrupt, but must not change for the lifetime of the buffer.  Use the
+ * buffer without the flag if that cannot be guaranteed.
+ */
+#define sbFLAGS_LOCKFREE_SPSC ( ( BaseType_t ) 4 )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateWithFlags( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xFlags );
+StreamBufferHandle_t xStreamBufferCreateStaticWithFlags( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xFlags, uint8_t *pucStreamBufferStorageArea, StaticStreamBuffer_t *pxStaticStreamBuffer );
+</pre>
+ *
+ * Versions of xStreamBufferCreate() and xStreamBufferCreateStatic() that
+ * accept the creation flags above, for example sbFLAGS_LOCKFREE_SPSC.  Passing
+ * 0 as xFlags is the same as calling the versions without flags.
+ *
+ * Example use:
+<pre>
+
+void vAFunction( void )
+{
+StreamBufferHandle_t xStreamBuffer;
+
+    // Create a stream buffer that is only ever written to by one task and
+    // read by one other task.
+    xStreamBuffer = xStreamBufferCreateWithFlags( 100, 1, sbFLAGS_LOCKFREE_SPSC );
+}
+</pre>
+ * \defgroup xStreamBufferCreateWithFlags xStreamBufferCreateWithFlags
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateWithFlags( xBufferSizeBytes, xTriggerLevelBytes, xFlags ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, ( pdFALSE | ( xFlags ) ) )
+#define xStreamBufferCreateStaticWithFlags( xBufferSizeBytes, xTriggerLevelBytes, xFlags, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, ( pdFALSE | ( xFlags ) ), pucStreamBufferStorageArea, pxStaticStreamBuffer )
+
 /**
  * stream_buffer.h
  *
@@ -829,6 +889,227 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferIOVec_t * const pxVectors,
+                           UBaseType_t uxVectorCount,
+                           TickType_t xTicksToWait );
+</pre>
+ *
+ * A version of xStreamBufferSend() that gathers the data to send from
+ * uxVectorCount separate blocks, for example a protocol header held in one
+ * structure and the payload held in another, so the caller does not have to
+ * copy them into one contiguous buffer first.  The blocks are sent in the order
+ * they appear in pxVectors.
+ *
+ * The total length of the blocks is treated exactly as xDataLengthBytes is
+ * treated by xStreamBufferSend().  When used through xMessageBufferSendV() the
+ * blocks together form one message, which is either written completely or not
+ * at all.
+ *
+ * configUSE_STREAM_BUFFER_SCATTER_GATHER must be set to 1 in FreeRTOSConfig.h
+ * for xStreamBufferSendV() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which data is being
+ * sent.
+ *
+ * @param pxVectors An array of uxVectorCount structures that each give the
+ * start and length of one block of data.  Blocks of zero length are allowed.
+ *
+ * @param uxVectorCount The number of structures in pxVectors.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space to become available in the stream
+ * buffer, as for xStreamBufferSend().
+ *
+ * @return The number of bytes written to the stream buffer.
+ *
+ * Example use:
+<pre>
+void vSendFrame( StreamBufferHandle_t xStreamBuffer, const FrameHeader_t *pxHeader, const uint8_t *pucPayload, size_t xPayloadLength )
+{
+StreamBufferIOVec_t xVectors[ 2 ];
+
+    xVectors[ 0 ].pvData = pxHeader;
+    xVectors[ 0 ].xLength = sizeof( FrameHeader_t );
+    xVectors[ 1 ].pvData = pucPayload;
+    xVectors[ 1 ].xLength = xPayloadLength;
+
+    xStreamBufferSendV( xStreamBuffer, xVectors, 2, pdMS_TO_TICKS( 100 ) );
+}
+</pre>
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+						   const StreamBufferIOVec_t * const pxVectors,
+						   UBaseType_t uxVectorCount,
+						   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+                                  const StreamBufferIOVec_t * const pxVectors,
+                                  UBaseType_t uxVectorCount,
+                                  BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferSendV(), which behaves as
+ * xStreamBufferSendFromISR() does.
+ *
+ * \defgroup xStreamBufferSendVFromISR xStreamBufferSendVFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferIOVec_t * const pxVectors,
+								  UBaseType_t uxVectorCount,
+								  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferIOVec_t pxSpans[ 2 ],
+                                    TickType_t xTicksToWait );
+</pre>
+ *
+ * Look at the data in a stream buffer where it is, rather than copying it out
+ * as xStreamBufferReceive() does.  The data in a stream buffer can wrap around
+ * the end of its storage area, so is described by two spans - pxSpans[ 0 ]
+ * then pxSpans[ 1 ], the second of which has zero length if the data did not
+ * wrap.
+ *
+ * Nothing is removed from the stream buffer until
+ * xStreamBufferReceiveConsume() is called, so the spans can be parsed at
+ * leisure and calling xStreamBufferReceiveAcquire() again describes the same
+ * data (plus anything written since).  The data must not be modified, and the
+ * spans must not be used after xStreamBufferReceiveConsume() or
+ * xStreamBufferReset() is called.
+ *
+ * When used through xMessageBufferReceiveAcquire() the spans describe exactly
+ * the next message.
+ *
+ * configUSE_STREAM_BUFFER_SCATTER_GATHER must be set to 1 in FreeRTOSConfig.h
+ * for xStreamBufferReceiveAcquire() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which data is
+ * being received.
+ *
+ * @param pxSpans An array of two structures that are set to describe the data.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, should the stream buffer be empty, as for
+ * xStreamBufferReceive().
+ *
+ * @return The total length of the two spans, which is 0 if there was no data.
+ *
+ * Example use:
+<pre>
+void vProcessStream( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferIOVec_t xSpans[ 2 ];
+size_t xBytes, xUsed;
+
+    xBytes = xStreamBufferReceiveAcquire( xStreamBuffer, xSpans, portMAX_DELAY );
+
+    // Parse as many complete records as there are, straight from the stream
+    // buffer's storage area.
+    xUsed = xParseRecords( xSpans, xBytes );
+
+    // Remove the parsed records from the stream buffer, leaving any partial
+    // record to be completed by the next write.
+    xStreamBufferReceiveConsume( xStreamBuffer, xUsed );
+}
+</pre>
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+									StreamBufferIOVec_t pxSpans[ 2 ],
+									TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferIOVec_t pxSpans[ 2 ] );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferReceiveAcquire(), which never
+ * blocks.
+ *
+ * \defgroup xStreamBufferReceiveAcquireFromISR xStreamBufferReceiveAcquireFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+										   StreamBufferIOVec_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer, size_t xConsumedBytes );
+</pre>
+ *
+ * Remove data described by xStreamBufferReceiveAcquire() from the stream
+ * buffer, which returns the space it occupied to the writer and unblocks the
+ * writer if it was waiting for space.
+ *
+ * Any number of bytes up to the total length of the spans can be removed from
+ * a stream buffer.  A message buffer message can only be removed whole, so
+ * xConsumedBytes must then be the length returned by
+ * xMessageBufferReceiveAcquire().  Passing 0 removes nothing.
+ *
+ * configUSE_STREAM_BUFFER_SCATTER_GATHER must be set to 1 in FreeRTOSConfig.h
+ * for xStreamBufferReceiveConsume() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer the data was acquired
+ * from.
+ *
+ * @param xConsumedBytes The number of bytes to remove from the front of the
+ * stream buffer.
+ *
+ * @return pdPASS if the bytes were removed, or pdFAIL if xConsumedBytes was
+ * more than the bytes in the stream buffer, or not the length of the next
+ * message in a message buffer - in which case nothing is removed.
+ *
+ * \defgroup xStreamBufferReceiveConsume xStreamBufferReceiveConsume
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer, size_t xConsumedBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               size_t xConsumedBytes,
+                                               BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * An interrupt safe version of xStreamBufferReceiveConsume().
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if removing the data unblocked
+ * a task that has a priority above the task that was interrupted, as for
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReceiveConsumeFromISR xStreamBufferReceiveConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+											   size_t xConsumedBytes,
+											   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
@@ -78,6 +78,11 @@ typedef enum
 	eInvalid		/* Used as an 'invalid state' value. */
 } eTaskState;
 
+/* The index of the notification used by the task notification functions and
+macros that do not take an index, such as xTaskNotify() and ulTaskNotifyTake(),
+and by the kernel itself. */
+#define tskDEFAULT_INDEX_TO_NOTIFY		( 0 )
+
 /* Actions that can be performed when vTaskNotify() is called. */
 typedef enum
 {
@@ -124,6 +129,24 @@ typedef struct xTASK_PARAMETERS
 	#endif
 } TaskParameters_t;
 
+/*
+ * One entry of the table of statically allocated tasks created by
+ * xTaskCreateStaticSet().  The members are the parameters of
+ * xTaskCreateStatic(), and pxCreatedTask, which can be NULL, is where the
+ * handle of the created task is written.
+ */
+typedef struct xSTATIC_TASK_DEFINITION
+{
+	TaskFunction_t pxTaskCode;
+	const char *pcName;		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	uint32_t ulStackDepth;
+	void *pvParameters;
+	UBaseType_t uxPriority;
+	StackType_t *puxStackBuffer;
+	StaticTask_t *pxTaskBuffer;
+	TaskHandle_t *pxCreatedTask;
+} StaticTaskDefinition_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
 in the system. */
 typedef struct xTASK_STATUS
@@ -134,11 +157,57 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetCpuLoad() and uxTaskGetISRCpuLoad() functions to return
+the share of the CPU time used over three periods.  Each value is in hundredths
+of a percent, so 10000 means all of the CPU time. */
+typedef struct xCPU_LOAD
+{
+	uint16_t usLoad1s;				/* The load averaged over the last second. */
+	uint16_t usLoad10s;				/* The load averaged over the last 10 seconds. */
+	uint16_t usLoad60s;				/* The load averaged over the last minute. */
+} CpuLoad_t;
+
+/* Used with the uxTaskGetISRLatency() function to return the times recorded
+for an interrupt vector, or for the periods interrupts were masked.  Times are
+in run time counter counts.  ulBuckets[ 0 ] counts times of 0, and
+ulBuckets[ n ] times from 2^(n-1) to 2^n - 1, except that the last bucket also
+counts all the longer times. */
+typedef struct xISR_LATENCY
+{
+	const char *pcName;								/* The name of the vector, or of the type of masked period. */
+	uint32_t ulSamples;								/* The number of times recorded. */
+	configRUN_TIME_COUNTER_TYPE ulMaxTime;			/* The longest time recorded.  For a vector this excludes the time spent in nested interrupts. */
+	configRUN_TIME_COUNTER_TYPE ulMaxNestedTime;	/* For a vector, the longest time a single run of the interrupt was itself interrupted.  Always 0 for a masked period. */
+	uint32_t ulBuckets[ configISR_LATENCY_BUCKETS ];
+} ISRLatency_t;
+
+/* Returned by vTaskGetCleanupStats().  Only tasks that delete themselves wait
+to have their memory freed, as the memory of a task deleted by another task is
+freed straight away. */
+typedef struct xTASK_CLEANUP_STATS
+{
+	uint32_t ulTasksFreed;			/* The number of deleted tasks whose memory has been freed after waiting. */
+	uint32_t ulBulkReclaims;		/* The number of times configTASK_CLEANUP_THRESHOLD waiting tasks were freed by a task other than the idle task. */
+	UBaseType_t uxMostWaiting;		/* The most deleted tasks waiting to have their memory freed at once. */
+	TickType_t xLongestWait;		/* The most ticks a deleted task waited to have its memory freed. */
+	uint32_t ulTotalWaitTicks;		/* The ticks waited by all the freed tasks, so the average wait can be calculated. */
+} TaskCleanupStats_t;
+
+/* Used with uxTaskGetAllStackWatermarks() to return the stack high water mark
+of each task in the system. */
+typedef struct xTASK_STACK_WATERMARK
+{
+	TaskHandle_t xHandle;			/* The handle of the task. */
+	const char *pcTaskName;			/* A pointer to the task's name. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	uint32_t ulStackDepth;			/* The size of the task's stack, in words. */
+	uint32_t ulWatermark;			/* The least free stack space the task has had, in words, as far as the idle task has scanned. */
+} TaskStackWatermark_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -154,6 +223,19 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/* The core affinity mask of a task that can run on any core. */
+#define tskNO_AFFINITY				( ( UBaseType_t ) -1 )
+
+/* The histograms reported by uxTaskGetISRLatency().  Vectors from
+tskISR_LATENCY_FIRST_APPLICATION_VECTOR to configISR_LATENCY_VECTORS - 1 are
+free for the application's own interrupts. */
+#define tskISR_LATENCY_TICK_VECTOR					( ( UBaseType_t ) 0U )
+#define tskISR_LATENCY_YIELD_VECTOR					( ( UBaseType_t ) 1U )
+#define tskISR_LATENCY_FIRST_APPLICATION_VECTOR		( ( UBaseType_t ) 2U )
+#define tskISR_LATENCY_CRITICAL_SECTION				( ( UBaseType_t ) configISR_LATENCY_VECTORS )
+#define tskISR_LATENCY_MASK_FROM_ISR				( ( UBaseType_t ) configISR_LATENCY_VECTORS + ( UBaseType_t ) 1U )
+#define tskISR_LATENCY_HISTOGRAMS					( ( UBaseType_t ) configISR_LATENCY_VECTORS + ( UBaseType_t ) 2U )
+
 /**
  * task. h
  *
@@ -177,7 +259,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskENTER_CRITICAL()		portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#if( configNUMBER_OF_CORES == 1 )
+	#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+	#define taskENTER_CRITICAL_FROM_ISR() vTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -192,7 +278,11 @@ typedef enum
  * \ingroup SchedulerControl
  */
 #define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if( configNUMBER_OF_CORES == 1 )
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) vTaskExitCriticalFromISR( x )
+#endif
 /**
  * task. h
  *
@@ -220,6 +310,50 @@ is used in assert() statements. */
 #define taskSCHEDULER_NOT_STARTED	( ( BaseType_t ) 1 )
 #define taskSCHEDULER_RUNNING		( ( BaseType_t ) 2 )
 
+/**
+ * task. h
+ *
+ * Macros to mark the start and end of an interrupt service routine, so the
+ * time spent in the interrupt is counted against the interrupt rather than
+ * against the task it interrupted.  See uxTaskGetISRCpuLoad().  They compile
+ * away unless configGENERATE_CPU_LOAD_STATS is set to 1 in FreeRTOSConfig.h.
+ * They can only be used in interrupts that run at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, and taskCPU_LOAD_EXIT_ISR() must be
+ * called before the interrupt requests a context switch.
+ *
+ * \defgroup taskCPU_LOAD_ENTER_ISR taskCPU_LOAD_ENTER_ISR
+ * \ingroup SchedulerControl
+ */
+#if( configGENERATE_CPU_LOAD_STATS == 1 )
+	#define taskCPU_LOAD_ENTER_ISR()	vTaskCpuLoadEnterISR()
+	#define taskCPU_LOAD_EXIT_ISR()		vTaskCpuLoadExitISR()
+#else
+	#define taskCPU_LOAD_ENTER_ISR()
+	#define taskCPU_LOAD_EXIT_ISR()
+#endif
+
+/**
+ * task. h
+ *
+ * Macros to mark the start and end of an interrupt service routine, so the
+ * time the interrupt runs for is recorded in the histogram of its vector.  See
+ * uxTaskGetISRLatency().  They compile away unless
+ * configGENERATE_ISR_LATENCY_STATS is set to 1 in FreeRTOSConfig.h.  The same
+ * restrictions apply as to taskCPU_LOAD_ENTER_ISR().  uxVector is the
+ * interrupt's number in the histograms, from
+ * tskISR_LATENCY_FIRST_APPLICATION_VECTOR to configISR_LATENCY_VECTORS - 1.
+ *
+ * \defgroup taskISR_LATENCY_ENTER taskISR_LATENCY_ENTER
+ * \ingroup SchedulerControl
+ */
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+	#define taskISR_LATENCY_ENTER( uxVector )	vTaskISRLatencyEnter( uxVector )
+	#define taskISR_LATENCY_EXIT()				vTaskISRLatencyExit()
+#else
+	#define taskISR_LATENCY_ENTER( uxVector )
+	#define taskISR_LATENCY_EXIT()
+#endif
+
 
 /*-----------------------------------------------------------
  * TASK CREATION API
@@ -327,6 +461,61 @@ is used in assert() statements. */
 							TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ *<pre>
+ BaseType_t xTaskCreateAffinitySet(	TaskFunction_t pvTaskCode,
+									const char * const pcName,
+									configSTACK_DEPTH_TYPE usStackDepth,
+									void *pvParameters,
+									UBaseType_t uxPriority,
+									UBaseType_t uxCoreAffinityMask,
+									TaskHandle_t *pvCreatedTask
+								);</pre>
+ *
+ * Only available when configNUMBER_OF_CORES is greater than 1 and
+ * configUSE_CORE_AFFINITY is set to 1 in FreeRTOSConfig.h.
+ *
+ * As xTaskCreate(), but the created task only ever runs on the cores that
+ * have their bit set in uxCoreAffinityMask - bit 0 for core 0, and so on.
+ * Tasks created with xTaskCreate() are given configTASK_DEFAULT_CORE_AFFINITY,
+ * which defaults to tskNO_AFFINITY so they can run on any core.
+ *
+ * \defgroup xTaskCreateAffinitySet xTaskCreateAffinitySet
+ * \ingroup Tasks
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+	BaseType_t xTaskCreateAffinitySet(	TaskFunction_t pxTaskCode,
+										const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const configSTACK_DEPTH_TYPE usStackDepth,
+										void * const pvParameters,
+										UBaseType_t uxPriority,
+										UBaseType_t uxCoreAffinityMask,
+										TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ *<pre>
+ void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask );</pre>
+ *
+ * Only available when configNUMBER_OF_CORES is greater than 1 and
+ * configUSE_CORE_AFFINITY is set to 1 in FreeRTOSConfig.h.
+ *
+ * Set or get the cores on which xTask can run, see xTaskCreateAffinitySet().
+ * Passing NULL as xTask sets or gets the affinity of the calling task.  If
+ * xTask is running on a core that is removed from its mask then that core is
+ * made to yield.
+ *
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup Tasks
+ */
+#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -444,6 +633,54 @@ is used in assert() statements. */
 									StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ *<pre>
+ BaseType_t xTaskCreateStaticSet( const StaticTaskDefinition_t * const pxTaskDefinitions, const UBaseType_t uxNumberOfTasks );</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1, and can
+ * only be called before the scheduler is started.
+ *
+ * Creates every task described by a table of StaticTaskDefinition_t
+ * structures, normally a const table laid out at compile time along with the
+ * stacks and StaticTask_t structures it references.  All the TCBs are
+ * initialised first, then all the tasks are added to the ready lists within a
+ * single critical section, so a static system is built without using the heap
+ * and without one critical section per task.
+ *
+ * @param pxTaskDefinitions The table of tasks to create.
+ *
+ * @param uxNumberOfTasks The number of entries in pxTaskDefinitions.
+ *
+ * @return pdPASS if every task was created.  If an entry does not provide a
+ * stack or a StaticTask_t structure then no task is created and pdFAIL is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+    static StackType_t xStack1[ 200 ], xStack2[ 200 ];
+    static StaticTask_t xTCB1, xTCB2;
+    static TaskHandle_t xTask2;
+
+    static const StaticTaskDefinition_t xTasks[] =
+    {
+        { vTask1, "T1", 200, NULL, 1, xStack1, &xTCB1, NULL },
+        { vTask2, "T2", 200, NULL, 2, xStack2, &xTCB2, &xTask2 }
+    };
+
+    void main( void )
+    {
+        xTaskCreateStaticSet( xTasks, sizeof( xTasks ) / sizeof( xTasks[ 0 ] ) );
+        vTaskStartScheduler();
+    }
+   </pre>
+ * \defgroup xTaskCreateStaticSet xTaskCreateStaticSet
+ * \ingroup Tasks
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	BaseType_t xTaskCreateStaticSet( const StaticTaskDefinition_t * const pxTaskDefinitions, const UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * task. h
  *<pre>
@@ -1004,6 +1241,60 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetTimeSlice( UBaseType_t uxPriority, TickType_t xTicks );</pre>
+ *
+ * configUSE_TIME_SLICE_QUANTA must be defined as 1 for this function to be
+ * available.
+ *
+ * Set the number of ticks a task of priority uxPriority runs before the tick
+ * interrupt switches in the next ready task of the same priority.  The tick
+ * only switches tasks if another task of the same priority is ready, and a
+ * task switched in for any other reason starts a new time slice.
+ *
+ * @param uxPriority The priority the time slice applies to.
+ *
+ * @param xTicks The length of the time slice in ticks.  portMAX_DELAY to have
+ * tasks of this priority run until they block, yield or are preempted by a
+ * higher priority task, or 0 to revert to configTIME_SLICE_TICKS( uxPriority ).
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( void )
+ {
+	 // The worker tasks share tskIDLE_PRIORITY + 1, and switching between them
+	 // every tick costs more than it gains.
+	 vTaskSetTimeSlice( tskIDLE_PRIORITY + 1, pdMS_TO_TICKS( 20 ) );
+
+	 // Each task of priority tskIDLE_PRIORITY + 2 completes its work before
+	 // the next is run.
+	 vTaskSetTimeSlice( tskIDLE_PRIORITY + 2, portMAX_DELAY );
+ }
+   </pre>
+ * \defgroup vTaskSetTimeSlice vTaskSetTimeSlice
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeSlice( UBaseType_t uxPriority, TickType_t xTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>TickType_t xTaskGetTimeSlice( UBaseType_t uxPriority );</pre>
+ *
+ * configUSE_TIME_SLICE_QUANTA must be defined as 1 for this function to be
+ * available.
+ *
+ * @param uxPriority The priority to query.
+ *
+ * @return The time slice of tasks of priority uxPriority in ticks, as set by
+ * vTaskSetTimeSlice() or configTIME_SLICE_TICKS(), or portMAX_DELAY if they
+ * are not time sliced.
+ *
+ * \defgroup xTaskGetTimeSlice xTaskGetTimeSlice
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskGetTimeSlice( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -1422,6 +1713,168 @@ TaskHandle_t xTaskGetHandle( const char *pcNameToQuery ) PRIVILEGED_FUNCTION; /*
  */
 UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetAllStackWatermarks( TaskStackWatermark_t * const pxWatermarks, const UBaseType_t uxArraySize );</PRE>
+ *
+ * configUSE_STACK_WATERMARK_SCANNER must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Fills a TaskStackWatermark_t structure for each task in the system.  The
+ * idle task scans the stacks in turn, at most configSTACK_WATERMARK_SCAN_WORDS
+ * words on each iteration of its loop, and each scan only checks the part of
+ * the stack that was still unused the last time the task was scanned.  The
+ * watermarks returned are the results of the latest scans, so this function
+ * does not read the stacks itself and takes the same time however large they
+ * are.  Use uxTaskGetStackHighWaterMark() for an up to date value for one
+ * task.
+ *
+ * If configSTACK_WATERMARK_WARNING_PERCENT is not 0 then a scan that finds a
+ * task has used at least that percentage of its stack calls
+ * vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName,
+ * uint32_t ulWatermark ), once for each task.  The hook is called from the idle
+ * task within a critical section, so must not block or use the kernel API.
+ *
+ * @param pxWatermarks An array of TaskStackWatermark_t structures.
+ *
+ * @param uxArraySize The number of structures in pxWatermarks.  Tasks are left
+ * out if there are more tasks than structures.
+ *
+ * @return The number of structures filled.
+ */
+UBaseType_t uxTaskGetAllStackWatermarks( TaskStackWatermark_t * const pxWatermarks, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetHeapUsage( TaskHandle_t xTask );</PRE>
+ *
+ * configUSE_HEAP_ACCOUNTING must be set to 1 in FreeRTOSConfig.h, and a heap
+ * implementation that supports it (heap_4.c or heap_5.c) used, for this
+ * function to be available.
+ *
+ * Returns the number of bytes currently allocated from the heap by xTask.
+ * Memory is counted against the task that called pvPortMalloc(), so memory a
+ * task allocates and passes to another task is still counted against the task
+ * that allocated it.  The stack and TCB of a task are counted against the task
+ * that created it.  When a task is deleted the blocks it still holds are no
+ * longer counted against any task.
+ *
+ * @param xTask Handle of the task whose heap usage is returned.  Set xTask to
+ * NULL to return the heap usage of the calling task.
+ *
+ * @return The total size requested by the blocks allocated by xTask that have
+ * not yet been freed.
+ */
+UBaseType_t uxTaskGetHeapUsage( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetCpuLoad( TaskHandle_t xTask, CpuLoad_t *pxLoad );</PRE>
+ *
+ * configGENERATE_CPU_LOAD_STATS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * The kernel samples the run time counter of every task ten times a second,
+ * from the tick interrupt, and keeps a rolling average of the share of the CPU
+ * time each task used over the last 1, 10 and 60 seconds.  Unlike the totals
+ * returned by uxTaskGetSystemState() the averages show the current load, and
+ * are not affected by the run time counter wrapping.  Time spent in interrupts
+ * that use taskCPU_LOAD_ENTER_ISR() and taskCPU_LOAD_EXIT_ISR() is not counted
+ * against the task that was interrupted.
+ *
+ * @param xTask Handle of the task whose load is returned.  Set xTask to NULL to
+ * return the load of the calling task.
+ *
+ * @param pxLoad If pxLoad is not NULL then the three averages are written to
+ * the CpuLoad_t structure it points to.
+ *
+ * @return The load averaged over the last second, in hundredths of a percent.
+ */
+UBaseType_t uxTaskGetCpuLoad( TaskHandle_t xTask, CpuLoad_t * const pxLoad ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetISRCpuLoad( UBaseType_t uxNestingLevel, CpuLoad_t *pxLoad );</PRE>
+ *
+ * As uxTaskGetCpuLoad(), but returns the share of the CPU time spent in
+ * interrupts that use taskCPU_LOAD_ENTER_ISR() and taskCPU_LOAD_EXIT_ISR().
+ * The time is recorded against the interrupt nesting level rather than the
+ * interrupt, so level 0 holds the interrupts that interrupted a task, level 1
+ * the interrupts that interrupted those, and so on.  The time an interrupt
+ * spends interrupted is counted at the deeper level only.  Interrupts nested
+ * more than configCPU_LOAD_ISR_LEVELS deep are counted against the deepest
+ * level.
+ *
+ * @param uxNestingLevel The nesting level, from 0 to
+ * configCPU_LOAD_ISR_LEVELS - 1, whose load is returned.
+ *
+ * @param pxLoad If pxLoad is not NULL then the three averages are written to
+ * the CpuLoad_t structure it points to.
+ *
+ * @return The load averaged over the last second, in hundredths of a percent.
+ */
+UBaseType_t uxTaskGetISRCpuLoad( UBaseType_t uxNestingLevel, CpuLoad_t * const pxLoad ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>UBaseType_t uxTaskGetISRLatency( UBaseType_t uxHistogram, ISRLatency_t *pxLatency );</PRE>
+ *
+ * configGENERATE_ISR_LATENCY_STATS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * The kernel keeps a log2 histogram of the time each interrupt vector that
+ * uses taskISR_LATENCY_ENTER() and taskISR_LATENCY_EXIT() runs for, excluding
+ * the time it spends interrupted by other instrumented interrupts, and of the
+ * periods interrupts are masked by critical sections and by
+ * portSET_INTERRUPT_MASK_FROM_ISR().  The worst case latency of an interrupt is
+ * then bounded by the longest masked period plus the longest run of each
+ * vector that can delay it.
+ *
+ * @param uxHistogram A vector number, from 0 to configISR_LATENCY_VECTORS - 1,
+ * or tskISR_LATENCY_CRITICAL_SECTION or tskISR_LATENCY_MASK_FROM_ISR.
+ *
+ * @param pxLatency If pxLatency is not NULL then the histogram is written to
+ * the ISRLatency_t structure it points to.
+ *
+ * @return The number of times recorded in the histogram.
+ */
+UBaseType_t uxTaskGetISRLatency( UBaseType_t uxHistogram, ISRLatency_t * const pxLatency ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>void vTaskSetISRLatencyName( UBaseType_t uxVector, const char *pcName );</PRE>
+ *
+ * Names an application interrupt vector in the output of uxTaskGetISRLatency()
+ * and vTaskGetISRLatencyReport().  The string is not copied.
+ */
+void vTaskSetISRLatencyName( UBaseType_t uxVector, const char *pcName ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>void vTaskClearISRLatency( void );</PRE>
+ *
+ * Empties all the histograms, for example once the application has started
+ * up, so only the latencies seen in normal operation are reported.
+ */
+void vTaskClearISRLatency( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>void vTaskGetCleanupStats( TaskCleanupStats_t *pxStats );</PRE>
+ *
+ * INCLUDE_vTaskDelete must be defined as 1 for this function to be available.
+ *
+ * The memory of a task that deletes itself cannot be freed until the task has
+ * been switched out, so the task is placed on a list to be freed later - by the
+ * idle task, or, when configTASK_CLEANUP_THRESHOLD is set, by the next task to
+ * create or delete a task once that many are waiting.  The statistics show how
+ * long the memory stays allocated.
+ *
+ * @param pxStats The counts and times since the scheduler was started are
+ * written to the TaskCleanupStats_t structure pxStats points to.
+ */
+void vTaskGetCleanupStats( TaskCleanupStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include task.h before
 FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
 so the following two prototypes will cause a compilation error.  This can be
@@ -1484,6 +1937,19 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTaskGetIdleTaskHandleForCore() and xTaskGetCurrentTaskHandleForCore() are
+ * only available when configNUMBER_OF_CORES is greater than 1.
+ *
+ * Return the handle of the idle task created for core xCoreID, or of the task
+ * in the Running state on core xCoreID.  xTaskGetIdleTaskHandle() returns the
+ * idle task of core 0.
+ */
+#if( configNUMBER_OF_CORES > 1 )
+	TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1512,6 +1978,8 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
  * total run time (as defined by the run time stats clock, see
  * http://www.freertos.org/rtos-run-time-stats.html) since the target booted.
  * pulTotalRunTime can be set to NULL to omit the total run time information.
+ * The run time is held in a configRUN_TIME_COUNTER_TYPE, which is uint32_t
+ * unless set otherwise in FreeRTOSConfig.h.
  *
  * @return The number of TaskStatus_t structures that were populated by
  * uxTaskGetSystemState().  This should equal the number returned by the
@@ -1527,7 +1995,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalRunTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulStatsAsPercentage;
 
 		// Make sure the write buffer does not contain a string.
 		*pcWriteBuffer = 0x00;
@@ -1562,13 +2030,13 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
 					if( ulStatsAsPercentage > 0UL )
 					{
-						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 					}
 					else
 					{
 						// If the percentage is zero here then the task has
 						// consumed less than 1% of the total run time.
-						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, pxTaskStatusArray[ x ].ulRunTimeCounter );
+						sprintf( pcWriteBuffer, "%s\t\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].pcTaskName, ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 					}
 
 					pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
@@ -1581,7 +2049,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -1595,7 +2063,8 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const
  * not intended for normal application runtime use but as a debug aid.
  *
  * Lists all the current tasks, along with their current state and stack
- * usage high water mark.
+ * usage high water mark.  If configUSE_HEAP_ACCOUNTING is set to 1 the bytes
+ * each task has allocated from the heap are listed too.
  *
  * Tasks are reported as blocked ('B'), ready ('R'), deleted ('D') or
  * suspended ('S').
@@ -1686,7 +2155,36 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
+ * <PRE>void vTaskGetISRLatencyReport( char *pcWriteBuffer );</PRE>
+ *
+ * configGENERATE_ISR_LATENCY_STATS, configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must all be defined as 1 for this
+ * function to be available.
+ *
+ * Writes the histograms returned by uxTaskGetISRLatency() into a buffer as a
+ * table, one line for each vector that has a name or has recorded a time, and
+ * one each for critical sections and for portSET_INTERRUPT_MASK_FROM_ISR().
+ * Each line holds the name, the number of times recorded, the longest time,
+ * the longest time spent interrupted, and then a "bucket:count" pair for each
+ * bucket that is not empty, where the times counted by bucket n are below 2^n.
+ *
+ * Like vTaskGetRunTimeStats() this function is provided for convenience only,
+ * has a dependency on sprintf(), and is not considered part of the scheduler.
+ *
+ * @param pcWriteBuffer A buffer into which the table will be written, in ASCII
+ * form.  This buffer is assumed to be large enough to contain the generated
+ * report.  Approximately 60 bytes per line, plus 10 bytes per bucket that is
+ * not empty, should be sufficient.
+ *
+ * \defgroup vTaskGetISRLatencyReport vTaskGetISRLatencyReport
+ * \ingroup TaskUtils
+ */
+void vTaskGetISRLatencyReport( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction );
+ * BaseType_t xTaskNotifyIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1694,6 +2192,17 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
+ * Each task has an array of configTASK_NOTIFICATION_ARRAY_ENTRIES notifications,
+ * each with its own value and state, which defaults to one.  The "Indexed"
+ * versions of the notification functions act on the notification given by
+ * their index parameter, and leave the task's other notifications unchanged.
+ * The versions without an index act on index tskDEFAULT_INDEX_TO_NOTIFY (0), so
+ * xTaskNotify() is equivalent to calling xTaskNotifyIndexed() with
+ * uxIndexToNotify set to 0.  Stream and message buffers, and the deferred work
+ * task, use index 0 - so an application should use the other indexes alongside
+ * them.  A task blocked on one index is not unblocked by a notification sent
+ * to another.
+ *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
  * are a method of sending an event directly to a task without the need for such
@@ -1722,6 +2231,10 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification to send, which must be
+ * less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions without this
+ * parameter always send to index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1763,13 +2276,16 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );
+ * BaseType_t xTaskNotifyIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1778,7 +2294,8 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
  * A version of xTaskNotify() that can be used from an interrupt service routine
- * (ISR).
+ * (ISR).  xTaskNotifyIndexedFromISR() is the version of xTaskNotifyIndexed(),
+ * and sends notification uxIndexToNotify - see xTaskNotifyIndexed().
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -1808,6 +2325,10 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify The index of the notification to send, which must be
+ * less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  The versions without this
+ * parameter always send to index 0.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1854,13 +2375,16 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
+ * <PRE>BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );
+ * BaseType_t xTaskNotifyWaitIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -1891,6 +2415,11 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification to wait for, which must
+ * be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.  Only a notification sent
+ * to this index unblocks the task.  xTaskNotifyWait() does not have this
+ * parameter and always waits on index 0.
+ *
  * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry value
  * will be cleared in the calling task's notification value before the task
  * checks to see if any notifications are pending, and optionally blocks if no
@@ -1931,11 +2460,14 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );</PRE>
+ * <PRE>BaseType_t xTaskNotifyGive( TaskHandle_t xTaskToNotify );
+ * BaseType_t xTaskNotifyGiveIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1977,11 +2509,13 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
  * <PRE>void vTaskNotifyGiveFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+ * void vTaskNotifyGiveIndexedFromISR( TaskHandle_t xTaskHandle, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this macro
  * to be available.
@@ -1990,7 +2524,8 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * "notification value", which is a 32-bit unsigned integer (uint32_t).
  *
  * A version of xTaskNotifyGive() that can be called from an interrupt service
- * routine (ISR).
+ * routine (ISR).  vTaskNotifyGiveIndexedFromISR() is the version of
+ * xTaskNotifyGiveIndexed(), and increments notification uxIndexToNotify.
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -2032,11 +2567,14 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
- * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
+ * <PRE>uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait );
+ * uint32_t ulTaskNotifyTakeIndexed( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait );</pre>
  *
  * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
  * function to be available.
@@ -2080,6 +2618,10 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  *
  * See http://www.FreeRTOS.org/RTOS-task-notifications.html for details.
  *
+ * @param uxIndexToWaitOn The index of the notification value to take, which
+ * must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ * ulTaskNotifyTake() does not have this parameter and always takes index 0.
+ *
  * @param xClearCountOnExit if xClearCountOnExit is pdFALSE then the task's
  * notification value is decremented when the function exits.  In this way the
  * notification value acts like a counting semaphore.  If xClearCountOnExit is
@@ -2101,23 +2643,30 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWaitOn ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
- * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );</pre>
+ * <PRE>BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+ * BaseType_t xTaskNotifyStateClearIndexed( TaskHandle_t xTask, UBaseType_t uxIndexToClear );</pre>
  *
  * If the notification state of the task referenced by the handle xTask is
  * eNotified, then set the task's notification state to eNotWaitingNotification.
  * The task's notification value is not altered.  Set xTask to NULL to clear the
- * notification state of the calling task.
+ * notification state of the calling task.  xTaskNotifyStateClearIndexed() clears
+ * the state of notification uxIndexToClear only, and xTaskNotifyStateClear()
+ * the state of index 0.
  *
  * @return pdTRUE if the task's notification state was set to
  * eNotWaitingNotification, otherwise pdFALSE.
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2214,15 +2763,36 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * As vTaskRemoveFromUnorderedEventList(), but can be called from an interrupt,
+ * and so whether or not the scheduler is suspended.  Used by the event groups
+ * implementation when configUSE_EVENT_GROUP_DIRECT_ISR is set to 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was interrupted, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
  * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
  *
  * Sets the pointer to the current TCB to the TCB of the highest priority task
- * that is ready to run.
- */
-void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+ * that is ready to run.  When configNUMBER_OF_CORES is greater than 1 it is
+ * called by core xCoreID to select its own next task, and must not be called
+ * from within a critical section.
+ */
+#if( configNUMBER_OF_CORES == 1 )
+	void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#else
+	void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -2252,6 +2822,31 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const
  */
 void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * portYIELD_WITHIN_API() when configNUMBER_OF_CORES is greater than 1.
+	 * Yields straight away if the calling core is not in a critical section,
+	 * otherwise holds the yield pending until the critical section is left.
+	 */
+	void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The critical section implementation used when configNUMBER_OF_CORES is
+	 * greater than 1.  The port maps portENTER_CRITICAL() and
+	 * portEXIT_CRITICAL() to vTaskEnterCritical() and vTaskExitCritical(), and
+	 * taskENTER_CRITICAL_FROM_ISR() and taskEXIT_CRITICAL_FROM_ISR() map to the
+	 * FromISR versions.  Each masks interrupts on the calling core, then takes
+	 * the port's spinlocks so no other core can enter a critical section, or
+	 * suspend the scheduler, until the outermost critical section is left.
+	 */
+	void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+	UBaseType_t vTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * Returns the scheduler state as taskSCHEDULER_RUNNING,
  * taskSCHEDULER_NOT_STARTED or taskSCHEDULER_SUSPENDED.
@@ -2291,6 +2886,35 @@ UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
  */
 void vTaskSetTaskNumber( TaskHandle_t xTask, const UBaseType_t uxHandle ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configGENERATE_CPU_LOAD_STATS is set to 1.  Called by
+ * the taskCPU_LOAD_ENTER_ISR() and taskCPU_LOAD_EXIT_ISR() macros on entry to
+ * and exit from an interrupt, so the time between is counted against the
+ * interrupt nesting level rather than against the task that was running.
+ */
+void vTaskCpuLoadEnterISR( void ) PRIVILEGED_FUNCTION;
+void vTaskCpuLoadExitISR( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configGENERATE_ISR_LATENCY_STATS is set to 1.  Called by
+ * the taskISR_LATENCY_ENTER() and taskISR_LATENCY_EXIT() macros on entry to and
+ * exit from an interrupt, so the time between, less the time spent in nested
+ * interrupts, is recorded in the histogram of the vector.
+ */
+void vTaskISRLatencyEnter( UBaseType_t uxVector ) PRIVILEGED_FUNCTION;
+void vTaskISRLatencyExit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configGENERATE_ISR_LATENCY_STATS is set to 1.  Called by
+ * the port with interrupts masked, just after it masks interrupts and just
+ * before it unmasks them again, to time the periods interrupts are masked.
+ * xFromISR is pdTRUE if interrupts were masked by
+ * portSET_INTERRUPT_MASK_FROM_ISR(), or pdFALSE if by a critical section.
+ * Nested calls are allowed, and only the outermost period is timed.
+ */
+void vTaskISRLatencyMask( BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+void vTaskISRLatencyUnmask( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Only available when configUSE_TICKLESS_IDLE is set to 1.
  * If tickless mode is being used, or a low power mode is implemented, then
@@ -2323,6 +2947,21 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  As pvTaskIncrementMutexHeldCount(), but also adds
+ * pxHeldMutexListItem, the list item of the mutex that has been taken, to the
+ * list of mutexes held by the calling task.  The owner of the list item is the
+ * list of tasks waiting for the mutex.
+ */
+TaskHandle_t pvTaskAddHeldMutex( ListItem_t * const pxHeldMutexListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Record the mutex the calling task is about to wait
+ * for, or NULL when it stops waiting, so an inherited priority can be passed on
+ * to the holder of that mutex.
+ */
+void vTaskSetMutexWaitedFor( void *pvMutex ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
@@ -87,6 +87,25 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/*
+ * One entry of the table of statically allocated timers created by
+ * xTimerCreateStaticSet().  The members up to pxTimerBuffer are the parameters
+ * of xTimerCreateStatic().  The timer is also started if xAutoStart is pdTRUE,
+ * and pxCreatedTimer, which can be NULL, is where the handle of the created
+ * timer is written.
+ */
+typedef struct xSTATIC_TIMER_DEFINITION
+{
+	const char *pcTimerName;		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	TickType_t xTimerPeriodInTicks;
+	UBaseType_t uxAutoReload;
+	void *pvTimerID;
+	TimerCallbackFunction_t pxCallbackFunction;
+	StaticTimer_t *pxTimerBuffer;
+	BaseType_t xAutoStart;
+	TimerHandle_t *pxCreatedTimer;
+} StaticTimerDefinition_t;
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -363,6 +382,34 @@ typedef void (*PendedFunction_t)( void *, uint32_t );
 										StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * BaseType_t xTimerCreateStaticSet( const StaticTimerDefinition_t * const pxTimerDefinitions,
+ *									const UBaseType_t uxNumberOfTimers );
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1, and can
+ * only be called before the scheduler is started.
+ *
+ * Creates every timer described by a table of StaticTimerDefinition_t
+ * structures, normally a const table laid out at compile time along with the
+ * StaticTimer_t structures it references.  Timers with xAutoStart set to
+ * pdTRUE are placed straight into the list of active timers, as the timer
+ * service task is not running yet, rather than by sending a start command
+ * for each one.  The table can therefore hold more timers to start than the
+ * timer command queue can hold commands, and starting them leaves the queue
+ * empty.  As with xTimerStart() called before the scheduler is started, the
+ * period of each started timer is measured from the tick count at the time
+ * xTimerCreateStaticSet() is called.
+ *
+ * @param pxTimerDefinitions The table of timers to create.
+ *
+ * @param uxNumberOfTimers The number of entries in pxTimerDefinitions.
+ *
+ * @return pdPASS if every timer was created, otherwise pdFAIL.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	BaseType_t xTimerCreateStaticSet( const StaticTimerDefinition_t * const pxTimerDefinitions, const UBaseType_t uxNumberOfTimers ) PRIVILEGED_FUNCTION;
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -0,0 +1,374 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The binary trace recorder.  When configUSE_TRACE_RECORDER is set to 1 in
+ * FreeRTOSConfig.h this header is included by FreeRTOS.h, and defines the
+ * kernel trace macros so each traced event is written to a RAM ring buffer as
+ * a 16 byte record.  Recording is started with vTraceRecorderStart(), in one
+ * of two modes:
+ *
+ * Snapshot - the ring always holds the most recent records, older records
+ * being overwritten.  Stop the recorder, then call vTraceRecorderDump() to
+ * write the records out, for example when an error is detected.
+ *
+ * Streaming - no record is overwritten until it has been read by
+ * xTraceRecorderRead(), which a task calls periodically to pass the records to
+ * the host.  Records written while the ring is full are dropped and counted.
+ *
+ * A record is claimed and filled in with interrupts masked up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, which takes a few instructions, so
+ * writing a record never blocks and can be done from any interrupt that can
+ * use the FreeRTOS API.  The context switch, tick, queue and notification
+ * events are recorded where the kernel has already masked interrupts, so they
+ * do not mask them again.  No event does more than read the timestamp and
+ * store the 16 bytes - the timestamp is converted by the decoder, not here.
+ *
+ * Either way the output is a sequence of TraceRecord_t structures, which
+ * Demo/Posix_GCC/trace_decode.c converts to the JSON format used by the Chrome
+ * and Perfetto trace viewers.
+ *
+ * The events are grouped into classes, and only the classes set in the mask
+ * passed to vTraceRecorderStart() or vTraceRecorderSetMask() are recorded.  A
+ * trace macro whose class is not enabled costs one load and one test.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+#if( configUSE_TRACE_FACILITY != 1 )
+	#error configUSE_TRACE_FACILITY must be set to 1 in FreeRTOSConfig.h when configUSE_TRACE_RECORDER is set to 1, as tasks are identified by their TCB number.
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP
+	#error configTRACE_RECORDER_TIMESTAMP() must be defined in FreeRTOSConfig.h when configUSE_TRACE_RECORDER is set to 1.  It returns a free running 32-bit count.
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP_HZ
+	#error configTRACE_RECORDER_TIMESTAMP_HZ must be defined in FreeRTOSConfig.h when configUSE_TRACE_RECORDER is set to 1.  It is the rate at which configTRACE_RECORDER_TIMESTAMP() counts.
+#endif
+
+#ifndef configTRACE_RECORDER_BUFFER_RECORDS
+	/* The number of records the ring holds, which must be a power of 2. */
+	#define configTRACE_RECORDER_BUFFER_RECORDS 512
+#endif
+
+#ifndef configTRACE_RECORDER_NAMES
+	/* The number of task, queue and timer names that are remembered, so they
+	can be written out with a snapshot even after the records that named them
+	have been overwritten. */
+	#define configTRACE_RECORDER_NAMES 32
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Event classes, for use in the mask passed to vTraceRecorderStart() and
+vTraceRecorderSetMask(). */
+#define traceCLASS_TASK				( 1UL << 0 )	/* Task switches, creation, deletion, delays, suspension and priority changes. */
+#define traceCLASS_TICK				( 1UL << 1 )	/* Each tick. */
+#define traceCLASS_QUEUE			( 1UL << 2 )	/* Queue, semaphore and mutex calls made by tasks. */
+#define traceCLASS_ISR				( 1UL << 3 )	/* Queue, semaphore, notification, event group and stream buffer calls made by interrupts. */
+#define traceCLASS_NOTIFY			( 1UL << 4 )	/* Task notifications sent and received by tasks. */
+#define traceCLASS_EVENT_GROUP		( 1UL << 5 )	/* Event group calls made by tasks. */
+#define traceCLASS_TIMER			( 1UL << 6 )	/* Software timer commands and expiries. */
+#define traceCLASS_STREAM_BUFFER	( 1UL << 7 )	/* Stream and message buffer calls made by tasks. */
+#define traceCLASS_HEAP				( 1UL << 8 )	/* pvPortMalloc() and vPortFree(). */
+#define traceCLASS_USER				( 1UL << 9 )	/* Events written by vTraceRecorderUserEvent(). */
+#define traceCLASS_ALL				( 0x3ffUL )
+
+/* Event codes.  The meaning of the object and value held by each record is
+given in brackets. */
+#define traceEVENT_TASK_SWITCHED_IN			( 0x01U )	/* (task, priority) */
+#define traceEVENT_TASK_READY				( 0x02U )	/* (task, priority) */
+#define traceEVENT_TASK_CREATE				( 0x03U )	/* (task, priority) */
+#define traceEVENT_TASK_DELETE				( 0x04U )	/* (task, 0) */
+#define traceEVENT_TASK_DELAY				( 0x05U )	/* (task, ticks to delay) */
+#define traceEVENT_TASK_DELAY_UNTIL			( 0x06U )	/* (task, tick to wake) */
+#define traceEVENT_TASK_SUSPEND				( 0x07U )	/* (task, 0) */
+#define traceEVENT_TASK_RESUME				( 0x08U )	/* (task, 0) */
+#define traceEVENT_TASK_RESUME_FROM_ISR		( 0x09U )	/* (task, 0) */
+#define traceEVENT_TASK_PRIORITY_SET		( 0x0aU )	/* (task, new priority) */
+#define traceEVENT_TASK_PRIORITY_INHERIT	( 0x0bU )	/* (mutex holder, inherited priority) */
+#define traceEVENT_TASK_PRIORITY_DISINHERIT	( 0x0cU )	/* (mutex holder, restored priority) */
+#define traceEVENT_TICK						( 0x10U )	/* (0, tick count) */
+#define traceEVENT_QUEUE_CREATE				( 0x20U )	/* (queue, queue type) */
+#define traceEVENT_QUEUE_DELETE				( 0x21U )	/* (queue, 0) */
+#define traceEVENT_QUEUE_SEND				( 0x22U )	/* (queue, items before the send) */
+#define traceEVENT_QUEUE_SEND_FAILED		( 0x23U )	/* (queue, items) */
+#define traceEVENT_QUEUE_RECEIVE			( 0x24U )	/* (queue, items before the receive) */
+#define traceEVENT_QUEUE_RECEIVE_FAILED		( 0x25U )	/* (queue, items) */
+#define traceEVENT_QUEUE_PEEK				( 0x26U )	/* (queue, items) */
+#define traceEVENT_QUEUE_BLOCK_ON_SEND		( 0x27U )	/* (queue, items) */
+#define traceEVENT_QUEUE_BLOCK_ON_RECEIVE	( 0x28U )	/* (queue, items) */
+#define traceEVENT_QUEUE_SEND_FROM_ISR		( 0x30U )	/* (queue, items before the send) */
+#define traceEVENT_QUEUE_SEND_FROM_ISR_FAILED		( 0x31U )	/* (queue, items) */
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR	( 0x32U )	/* (queue, items before the receive) */
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED	( 0x33U )	/* (queue, items) */
+#define traceEVENT_NOTIFY_FROM_ISR			( 0x34U )	/* (task notified, notification value) */
+#define traceEVENT_NOTIFY_GIVE_FROM_ISR		( 0x35U )	/* (task notified, notification value) */
+#define traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR	( 0x36U )	/* (event group, bits to set) */
+#define traceEVENT_STREAM_BUFFER_SEND_FROM_ISR		( 0x37U )	/* (stream buffer, bytes sent) */
+#define traceEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR	( 0x38U )	/* (stream buffer, bytes received) */
+#define traceEVENT_NOTIFY					( 0x40U )	/* (task notified, notification value) */
+#define traceEVENT_NOTIFY_TAKE				( 0x41U )	/* (task, notification value) */
+#define traceEVENT_NOTIFY_TAKE_BLOCK		( 0x42U )	/* (task, notification value) */
+#define traceEVENT_NOTIFY_WAIT				( 0x43U )	/* (task, notification value) */
+#define traceEVENT_NOTIFY_WAIT_BLOCK		( 0x44U )	/* (task, notification value) */
+#define traceEVENT_EVENT_GROUP_CREATE		( 0x50U )	/* (event group, 0) */
+#define traceEVENT_EVENT_GROUP_DELETE		( 0x51U )	/* (event group, 0) */
+#define traceEVENT_EVENT_GROUP_SET_BITS		( 0x52U )	/* (event group, bits to set) */
+#define traceEVENT_EVENT_GROUP_CLEAR_BITS	( 0x53U )	/* (event group, bits to clear) */
+#define traceEVENT_EVENT_GROUP_WAIT_BLOCK	( 0x54U )	/* (event group, bits to wait for) */
+#define traceEVENT_EVENT_GROUP_WAIT_END		( 0x55U )	/* (event group, pdTRUE if timed out) */
+#define traceEVENT_EVENT_GROUP_SYNC_BLOCK	( 0x56U )	/* (event group, bits to wait for) */
+#define traceEVENT_EVENT_GROUP_SYNC_END		( 0x57U )	/* (event group, pdTRUE if timed out) */
+#define traceEVENT_TIMER_CREATE				( 0x60U )	/* (timer, period) */
+#define traceEVENT_TIMER_COMMAND_SEND		( 0x61U )	/* (timer, command) */
+#define traceEVENT_TIMER_COMMAND_RECEIVED	( 0x62U )	/* (timer, command) */
+#define traceEVENT_TIMER_EXPIRED			( 0x63U )	/* (timer, 0) */
+#define traceEVENT_STREAM_BUFFER_CREATE		( 0x70U )	/* (stream buffer, pdTRUE if a message buffer) */
+#define traceEVENT_STREAM_BUFFER_DELETE		( 0x71U )	/* (stream buffer, 0) */
+#define traceEVENT_STREAM_BUFFER_SEND		( 0x72U )	/* (stream buffer, bytes sent) */
+#define traceEVENT_STREAM_BUFFER_RECEIVE	( 0x73U )	/* (stream buffer, bytes received) */
+#define traceEVENT_STREAM_BUFFER_BLOCK_ON_SEND		( 0x74U )	/* (stream buffer, 0) */
+#define traceEVENT_STREAM_BUFFER_BLOCK_ON_RECEIVE	( 0x75U )	/* (stream buffer, 0) */
+#define traceEVENT_MALLOC					( 0x80U )	/* (block, bytes requested) */
+#define traceEVENT_FREE						( 0x81U )	/* (block, bytes freed) */
+#define traceEVENT_USER						( 0x90U )	/* (user event ID, value) */
+
+/* Records that describe the trace rather than an event, which are written
+whatever the mask. */
+#define traceEVENT_HEADER					( 0xf0U )	/* (traceRECORDER_MAGIC, timestamp rate in Hz) */
+#define traceEVENT_NAME						( 0xf1U )	/* (object, four characters of its name) */
+#define traceEVENT_DROPPED					( 0xf2U )	/* (0, records dropped since the last read) */
+
+/* Written to the header record so a decoder can tell the byte order of the
+target. */
+#define traceRECORDER_MAGIC					( 0x52544652UL )
+#define traceRECORDER_VERSION				( 1U )
+
+/* The types of object that are named by traceEVENT_NAME records.  The type is
+held in the top four bits of ucParameter, and the offset of the four
+characters within the name, in units of four, in the bottom four bits. */
+#define traceOBJECT_TASK					( 0U )
+#define traceOBJECT_QUEUE					( 1U )
+#define traceOBJECT_TIMER					( 2U )
+
+/* One trace record. */
+typedef struct xTRACE_RECORD
+{
+	uint32_t ulTimestamp;		/* The value of configTRACE_RECORDER_TIMESTAMP() when the event occurred. */
+	uint8_t ucEvent;			/* One of the traceEVENT_ codes above. */
+	uint8_t ucParameter;		/* Used by traceEVENT_HEADER and traceEVENT_NAME records only. */
+	uint16_t usTask;			/* The TCB number of the task that was running, which is the task interrupted if the event was recorded by an interrupt. */
+	uint32_t ulObject;			/* The object the event relates to, as listed against the event code. */
+	uint32_t ulValue;			/* The value listed against the event code. */
+} TraceRecord_t;
+
+typedef enum
+{
+	eTraceSnapshot = 0,			/* Overwrite the oldest records when the ring is full. */
+	eTraceStreaming				/* Drop new records when the ring is full. */
+} eTraceRecorderMode;
+
+/* The type of the function vTraceRecorderDump() calls to output the records. */
+typedef void (*TraceRecorderWriteFunction_t)( const TraceRecord_t *pxRecords, size_t xNumberOfRecords, void *pvParameter );
+
+/*
+ * Discard any records already held, and start recording the events of the
+ * classes set in ulClassMask (traceCLASS_ALL for everything) in the given
+ * mode.
+ */
+void vTraceRecorderStart( eTraceRecorderMode eMode, uint32_t ulClassMask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stop recording.  The records are kept until the recorder is started again.
+ */
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Change the classes of events that are recorded without discarding any
+ * records.  Has no effect if the recorder is stopped.
+ */
+void vTraceRecorderSetMask( uint32_t ulClassMask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Snapshot mode only.  Call pxWrite(), one or more times, with a header record,
+ * a record for each part of each name remembered, then every record in the
+ * ring from the oldest to the newest.  The recorder must be stopped first.
+ */
+void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWrite, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Streaming mode only.  Copy up to xMaxRecords of the oldest records not yet
+ * read into pxRecords, and return the number copied.  The first read after
+ * vTraceRecorderStart() returns the header and name records first, and a
+ * traceEVENT_DROPPED record is returned wherever records had to be dropped.
+ * Only one task can read the records.
+ */
+size_t xTraceRecorderRead( TraceRecord_t *pxRecords, size_t xMaxRecords ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record an application defined event, in the traceCLASS_USER class.  Can be
+ * called from tasks and from interrupts that run at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+void vTraceRecorderUserEvent( uint32_t ulEventID, uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the trace macros below.  Not for use by application code.
+ */
+void vTraceRecorderWrite( uint8_t ucEvent, uint32_t ulObject, uint32_t ulValue ) PRIVILEGED_FUNCTION;
+void vTraceRecorderWriteMasked( uint8_t ucEvent, uint32_t ulObject, uint32_t ulValue ) PRIVILEGED_FUNCTION;
+void vTraceRecorderName( uint8_t ucObjectType, uint32_t ulObject, const char *pcName ) PRIVILEGED_FUNCTION;
+extern volatile uint32_t ulTraceRecorderMask;
+extern volatile uint16_t usTraceRecorderTask;
+
+/* Record an event if its class is enabled. */
+#define traceRECORD( ulClass, ucEvent, ulObject, ulValue )											\
+	do																								\
+	{																								\
+		if( ( ulTraceRecorderMask & ( ulClass ) ) != 0UL )											\
+		{																							\
+			vTraceRecorderWrite( ( ucEvent ), ( uint32_t ) ( ulObject ), ( uint32_t ) ( ulValue ) );	\
+		}																							\
+	} while( 0 )
+
+/* As traceRECORD(), but for the trace macros that are only expanded where
+interrupts are already masked up to configMAX_SYSCALL_INTERRUPT_PRIORITY - within
+a critical section, an interrupt that has masked interrupts to use the FreeRTOS
+API, or the context switch - so the record is written without masking them
+again.  That leaves the timestamp read and the stores to the ring as the cost of
+the events recorded most often. */
+#define traceRECORD_MASKED( ulClass, ucEvent, ulObject, ulValue )									\
+	do																								\
+	{																								\
+		if( ( ulTraceRecorderMask & ( ulClass ) ) != 0UL )											\
+		{																							\
+			vTraceRecorderWriteMasked( ( ucEvent ), ( uint32_t ) ( ulObject ), ( uint32_t ) ( ulValue ) );	\
+		}																							\
+	} while( 0 )
+
+/* Objects are identified by their address, and tasks by their TCB number. */
+#define traceOBJECT_ID( pvObject )	( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) ( pvObject ) )
+#define traceTASK_ID( pxTCB )		( ( uint32_t ) ( pxTCB )->uxTCBNumber )
+
+/* The kernel trace macros.  These are expanded within the kernel source files,
+so can use the variables in scope where they are called. */
+#define traceTASK_SWITCHED_IN()																		\
+	do																								\
+	{																								\
+		usTraceRecorderTask = ( uint16_t ) traceTASK_ID( pxCurrentTCB );							\
+		traceRECORD_MASKED( traceCLASS_TASK, traceEVENT_TASK_SWITCHED_IN, traceTASK_ID( pxCurrentTCB ), pxCurrentTCB->uxPriority );	\
+	} while( 0 )
+
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )				traceRECORD( traceCLASS_TASK, traceEVENT_TASK_READY, traceTASK_ID( pxTCB ), ( pxTCB )->uxPriority )
+#define traceTASK_CREATE( pxNewTCB )																\
+	do																								\
+	{																								\
+		vTraceRecorderName( traceOBJECT_TASK, traceTASK_ID( pxNewTCB ), ( pxNewTCB )->pcTaskName );	\
+		traceRECORD( traceCLASS_TASK, traceEVENT_TASK_CREATE, traceTASK_ID( pxNewTCB ), ( pxNewTCB )->uxPriority );	\
+	} while( 0 )
+#define traceTASK_DELETE( pxTaskToDelete )					traceRECORD( traceCLASS_TASK, traceEVENT_TASK_DELETE, traceTASK_ID( pxTaskToDelete ), 0 )
+#define traceTASK_DELAY()									traceRECORD( traceCLASS_TASK, traceEVENT_TASK_DELAY, traceTASK_ID( pxCurrentTCB ), xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )				traceRECORD( traceCLASS_TASK, traceEVENT_TASK_DELAY_UNTIL, traceTASK_ID( pxCurrentTCB ), ( xTimeToWake ) )
+#define traceTASK_SUSPEND( pxTaskToSuspend )				traceRECORD( traceCLASS_TASK, traceEVENT_TASK_SUSPEND, traceTASK_ID( pxTaskToSuspend ), 0 )
+#define traceTASK_RESUME( pxTaskToResume )					traceRECORD( traceCLASS_TASK, traceEVENT_TASK_RESUME, traceTASK_ID( pxTaskToResume ), 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )			traceRECORD( traceCLASS_TASK, traceEVENT_TASK_RESUME_FROM_ISR, traceTASK_ID( pxTaskToResume ), 0 )
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )		traceRECORD( traceCLASS_TASK, traceEVENT_TASK_PRIORITY_SET, traceTASK_ID( pxTask ), ( uxNewPriority ) )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )		traceRECORD( traceCLASS_TASK, traceEVENT_TASK_PRIORITY_INHERIT, traceTASK_ID( pxTCBOfMutexHolder ), ( uxInheritedPriority ) )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )		traceRECORD( traceCLASS_TASK, traceEVENT_TASK_PRIORITY_DISINHERIT, traceTASK_ID( pxTCBOfMutexHolder ), ( uxOriginalPriority ) )
+
+#define traceTASK_INCREMENT_TICK( xTickCount )				traceRECORD_MASKED( traceCLASS_TICK, traceEVENT_TICK, 0, ( xTickCount ) + 1 )
+
+#define traceQUEUE_CREATE( pxNewQueue )						traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_CREATE, traceOBJECT_ID( pxNewQueue ), ( pxNewQueue )->ucQueueType )
+#define traceQUEUE_DELETE( pxQueue )						traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_DELETE, traceOBJECT_ID( pxQueue ), 0 )
+#define traceQUEUE_SEND( pxQueue )							traceRECORD_MASKED( traceCLASS_QUEUE, traceEVENT_QUEUE_SEND, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )					traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_SEND_FAILED, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )						traceRECORD_MASKED( traceCLASS_QUEUE, traceEVENT_QUEUE_RECEIVE, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )				traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_RECEIVE_FAILED, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_PEEK( pxQueue )							traceRECORD_MASKED( traceCLASS_QUEUE, traceEVENT_QUEUE_PEEK, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )				traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_BLOCK_ON_SEND, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )			traceRECORD( traceCLASS_QUEUE, traceEVENT_QUEUE_BLOCK_ON_RECEIVE, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )		vTraceRecorderName( traceOBJECT_QUEUE, traceOBJECT_ID( xQueue ), ( pcQueueName ) )
+
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )					traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_QUEUE_SEND_FROM_ISR, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )			traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_QUEUE_SEND_FROM_ISR_FAILED, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )				traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_QUEUE_RECEIVE_FROM_ISR, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )		traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, traceOBJECT_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )		traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_NOTIFY_FROM_ISR, traceTASK_ID( pxTCB ), pxTCB->ulNotifiedValue[ uxIndexToNotify ] )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )	traceRECORD_MASKED( traceCLASS_ISR, traceEVENT_NOTIFY_GIVE_FROM_ISR, traceTASK_ID( pxTCB ), pxTCB->ulNotifiedValue[ uxIndexToNotify ] )
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )				traceRECORD( traceCLASS_ISR, traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR, traceOBJECT_ID( xEventGroup ), ( uxBitsToSet ) )
+#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )				traceRECORD( traceCLASS_ISR, traceEVENT_STREAM_BUFFER_SEND_FROM_ISR, traceOBJECT_ID( xStreamBuffer ), ( xBytesSent ) )
+#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )		traceRECORD( traceCLASS_ISR, traceEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR, traceOBJECT_ID( xStreamBuffer ), ( xReceivedLength ) )
+
+#define traceTASK_NOTIFY( uxIndexToNotify )					traceRECORD_MASKED( traceCLASS_NOTIFY, traceEVENT_NOTIFY, traceTASK_ID( pxTCB ), pxTCB->ulNotifiedValue[ uxIndexToNotify ] )
+#define traceTASK_NOTIFY_TAKE( uxIndexToWait )				traceRECORD_MASKED( traceCLASS_NOTIFY, traceEVENT_NOTIFY_TAKE, traceTASK_ID( pxCurrentTCB ), pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] )
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )		traceRECORD_MASKED( traceCLASS_NOTIFY, traceEVENT_NOTIFY_TAKE_BLOCK, traceTASK_ID( pxCurrentTCB ), pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] )
+#define traceTASK_NOTIFY_WAIT( uxIndexToWait )				traceRECORD_MASKED( traceCLASS_NOTIFY, traceEVENT_NOTIFY_WAIT, traceTASK_ID( pxCurrentTCB ), pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] )
+#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )		traceRECORD_MASKED( traceCLASS_NOTIFY, traceEVENT_NOTIFY_WAIT_BLOCK, traceTASK_ID( pxCurrentTCB ), pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] )
+
+#define traceEVENT_GROUP_CREATE( xEventGroup )				traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_CREATE, traceOBJECT_ID( xEventGroup ), 0 )
+#define traceEVENT_GROUP_DELETE( xEventGroup )				traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_DELETE, traceOBJECT_ID( xEventGroup ), 0 )
+#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )						traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_SET_BITS, traceOBJECT_ID( xEventGroup ), ( uxBitsToSet ) )
+#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )					traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_CLEAR_BITS, traceOBJECT_ID( xEventGroup ), ( uxBitsToClear ) )
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )			traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_WAIT_BLOCK, traceOBJECT_ID( xEventGroup ), ( uxBitsToWaitFor ) )
+#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred )	traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_WAIT_END, traceOBJECT_ID( xEventGroup ), ( xTimeoutOccurred ) )
+#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )	traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_SYNC_BLOCK, traceOBJECT_ID( xEventGroup ), ( uxBitsToWaitFor ) )
+#define traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred )	traceRECORD( traceCLASS_EVENT_GROUP, traceEVENT_EVENT_GROUP_SYNC_END, traceOBJECT_ID( xEventGroup ), ( xTimeoutOccurred ) )
+
+#define traceTIMER_CREATE( pxNewTimer )																\
+	do																								\
+	{																								\
+		vTraceRecorderName( traceOBJECT_TIMER, traceOBJECT_ID( pxNewTimer ), ( pxNewTimer )->pcTimerName );	\
+		traceRECORD( traceCLASS_TIMER, traceEVENT_TIMER_CREATE, traceOBJECT_ID( pxNewTimer ), ( pxNewTimer )->xTimerPeriodInTicks );	\
+	} while( 0 )
+#define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn )	traceRECORD( traceCLASS_TIMER, traceEVENT_TIMER_COMMAND_SEND, traceOBJECT_ID( xTimer ), ( xMessageID ) )
+#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )			traceRECORD( traceCLASS_TIMER, traceEVENT_TIMER_COMMAND_RECEIVED, traceOBJECT_ID( pxTimer ), ( xMessageID ) )
+#define traceTIMER_EXPIRED( pxTimer )						traceRECORD( traceCLASS_TIMER, traceEVENT_TIMER_EXPIRED, traceOBJECT_ID( pxTimer ), 0 )
+
+#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )				traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_CREATE, traceOBJECT_ID( pxStreamBuffer ), ( xIsMessageBuffer ) )
+#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )			traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_DELETE, traceOBJECT_ID( xStreamBuffer ), 0 )
+#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )						traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_SEND, traceOBJECT_ID( xStreamBuffer ), ( xBytesSent ) )
+#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )				traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_RECEIVE, traceOBJECT_ID( xStreamBuffer ), ( xReceivedLength ) )
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )						traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_BLOCK_ON_SEND, traceOBJECT_ID( xStreamBuffer ), 0 )
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )						traceRECORD( traceCLASS_STREAM_BUFFER, traceEVENT_STREAM_BUFFER_BLOCK_ON_RECEIVE, traceOBJECT_ID( xStreamBuffer ), 0 )
+
+#define traceMALLOC( pvAddress, uiSize )					traceRECORD( traceCLASS_HEAP, traceEVENT_MALLOC, traceOBJECT_ID( pvAddress ), ( uiSize ) )
+#define traceFREE( pvAddress, uiSize )						traceRECORD( traceCLASS_HEAP, traceEVENT_FREE, traceOBJECT_ID( pvAddress ), ( uiSize ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
@@ -30,6 +30,35 @@
 #include "FreeRTOS.h"
 #include "list.h"
 
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	/*
+	 * Red-black tree primitives used to index the items of lists initialised
+	 * with vListInitialiseIndexed().  The tree holds the same items as the
+	 * linked list, in the same order, so an in-order walk of the tree visits the
+	 * items in the order they appear in the list.  Items with equal values are
+	 * placed to the right of the existing items, matching the ordering used by
+	 * vListInsert() when it walks the list.  The height of the tree is at most
+	 * 2log2(n + 1), which bounds the time taken to insert and remove items.
+	 */
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+	static void prvTreeReplace( List_t * const pxList, ListItem_t * const pxOldItem, ListItem_t * const pxNewItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Insert pxNewListItem into the tree of pxList, and return the item after
+	 * which it must be placed in the linked list - or NULL if it must be placed
+	 * at the head of the list.
+	 */
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove pxItemToRemove from the tree of the list that contains it.
+	 */
+	static void prvTreeRemove( List_t * const pxList, ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -52,6 +81,13 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+		pxList->pxTreeRoot = NULL;
+		pxList->xIndexed = pdFALSE;
+	}
+	#endif
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -59,6 +95,17 @@ void vListInitialise( List_t * const pxList )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	void vListInitialiseIndexed( List_t * const pxList )
+	{
+		vListInitialise( pxList );
+		pxList->xIndexed = pdTRUE;
+	}
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+/*-----------------------------------------------------------*/
+
 void vListInitialiseItem( ListItem_t * const pxItem )
 {
 	/* Make sure the list item is not recorded as being on a list. */
@@ -81,6 +128,14 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 	listTEST_LIST_INTEGRITY( pxList );
 	listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
+	/* The order of an indexed list must match the order of its tree, so items
+	can only be added to an indexed list using vListInsert(). */
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+		configASSERT( pxList->xIndexed == pdFALSE );
+	}
+	#endif
+
 	/* Insert a new list item into pxList, but rather than sort the list,
 	makes the new list item the last item to be removed by a call to
 	listGET_OWNER_OF_NEXT_ENTRY(). */
@@ -118,7 +173,23 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	stored in ready lists (all of which have the same xItemValue value) get a
 	share of the CPU.  However, if the xItemValue is the same as the back marker
 	the iteration loop below will not end.  Therefore the value is checked
-	first, and the algorithm slightly modified if necessary. */
+	first, and the algorithm slightly modified if necessary.
+
+	The items of an indexed list are also held in a tree, from which the
+	insertion point is found without walking the list. */
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	if( pxList->xIndexed != pdFALSE )
+	{
+		pxIterator = prvTreeInsert( pxList, pxNewListItem );
+
+		if( pxIterator == NULL )
+		{
+			/* No item has a lower or equal value, so insert at the head. */
+			pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		}
+	}
+	else
+	#endif /* configUSE_INDEXED_DELAY_LISTS */
 	if( xValueOfInsertion == portMAX_DELAY )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
@@ -173,6 +244,15 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 item. */
 List_t * const pxList = pxItemToRemove->pxContainer;
 
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+		if( pxList->xIndexed != pdFALSE )
+		{
+			prvTreeRemove( pxList, pxItemToRemove );
+		}
+	}
+	#endif
+
 	pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
 	pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -196,3 +276,319 @@ List_t * const pxList = pxItemToRemove->pxContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxRight = pxItem->pxTreeRight;
+
+		pxItem->pxTreeRight = pxRight->pxTreeLeft;
+
+		if( pxRight->pxTreeLeft != NULL )
+		{
+			pxRight->pxTreeLeft->pxTreeParent = pxItem;
+		}
+
+		prvTreeReplace( pxList, pxItem, pxRight );
+		pxRight->pxTreeLeft = pxItem;
+		pxItem->pxTreeParent = pxRight;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxLeft = pxItem->pxTreeLeft;
+
+		pxItem->pxTreeLeft = pxLeft->pxTreeRight;
+
+		if( pxLeft->pxTreeRight != NULL )
+		{
+			pxLeft->pxTreeRight->pxTreeParent = pxItem;
+		}
+
+		prvTreeReplace( pxList, pxItem, pxLeft );
+		pxLeft->pxTreeRight = pxItem;
+		pxItem->pxTreeParent = pxLeft;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeReplace( List_t * const pxList, ListItem_t * const pxOldItem, ListItem_t * const pxNewItem )
+	{
+	ListItem_t * const pxParent = pxOldItem->pxTreeParent;
+
+		/* Make pxNewItem (which may be NULL) take the place pxOldItem has
+		under its parent.  The children of neither item are changed. */
+		if( pxParent == NULL )
+		{
+			pxList->pxTreeRoot = pxNewItem;
+		}
+		else if( pxParent->pxTreeLeft == pxOldItem )
+		{
+			pxParent->pxTreeLeft = pxNewItem;
+		}
+		else
+		{
+			pxParent->pxTreeRight = pxNewItem;
+		}
+
+		if( pxNewItem != NULL )
+		{
+			pxNewItem->pxTreeParent = pxParent;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	ListItem_t *pxParent = NULL, *pxItem = pxList->pxTreeRoot, *pxPredecessor = NULL;
+	ListItem_t *pxGrandparent, *pxUncle;
+	const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+		/* Descend to the leaf position of the new item.  The last item passed
+		on the left is the item with the highest value that is not greater than
+		the new value - which is the item the new item follows in the list. */
+		while( pxItem != NULL )
+		{
+			pxParent = pxItem;
+
+			if( pxItem->xItemValue <= xValueOfInsertion )
+			{
+				pxPredecessor = pxItem;
+				pxItem = pxItem->pxTreeRight;
+			}
+			else
+			{
+				pxItem = pxItem->pxTreeLeft;
+			}
+		}
+
+		pxNewListItem->pxTreeParent = pxParent;
+		pxNewListItem->pxTreeLeft = NULL;
+		pxNewListItem->pxTreeRight = NULL;
+		pxNewListItem->xTreeRed = pdTRUE;
+
+		if( pxParent == NULL )
+		{
+			pxList->pxTreeRoot = pxNewListItem;
+		}
+		else if( pxParent == pxPredecessor )
+		{
+			pxParent->pxTreeRight = pxNewListItem;
+		}
+		else
+		{
+			pxParent->pxTreeLeft = pxNewListItem;
+		}
+
+		/* Restore the red-black properties.  Each iteration either ends the
+		loop or moves two levels up the tree. */
+		pxItem = pxNewListItem;
+
+		while( ( pxItem->pxTreeParent != NULL ) && ( pxItem->pxTreeParent->xTreeRed != pdFALSE ) )
+		{
+			pxParent = pxItem->pxTreeParent;
+
+			/* The parent is red so cannot be the root. */
+			pxGrandparent = pxParent->pxTreeParent;
+
+			if( pxParent == pxGrandparent->pxTreeLeft )
+			{
+				pxUncle = pxGrandparent->pxTreeRight;
+
+				if( ( pxUncle != NULL ) && ( pxUncle->xTreeRed != pdFALSE ) )
+				{
+					pxParent->xTreeRed = pdFALSE;
+					pxUncle->xTreeRed = pdFALSE;
+					pxGrandparent->xTreeRed = pdTRUE;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeRight )
+					{
+						pxItem = pxParent;
+						prvTreeRotateLeft( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->xTreeRed = pdFALSE;
+					pxGrandparent->xTreeRed = pdTRUE;
+					prvTreeRotateRight( pxList, pxGrandparent );
+				}
+			}
+			else
+			{
+				pxUncle = pxGrandparent->pxTreeLeft;
+
+				if( ( pxUncle != NULL ) && ( pxUncle->xTreeRed != pdFALSE ) )
+				{
+					pxParent->xTreeRed = pdFALSE;
+					pxUncle->xTreeRed = pdFALSE;
+					pxGrandparent->xTreeRed = pdTRUE;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeLeft )
+					{
+						pxItem = pxParent;
+						prvTreeRotateRight( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->xTreeRed = pdFALSE;
+					pxGrandparent->xTreeRed = pdTRUE;
+					prvTreeRotateLeft( pxList, pxGrandparent );
+				}
+			}
+		}
+
+		pxList->pxTreeRoot->xTreeRed = pdFALSE;
+
+		return pxPredecessor;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRemove( List_t * const pxList, ListItem_t * const pxItemToRemove )
+	{
+	ListItem_t *pxChild, *pxParent, *pxSibling, *pxSuccessor;
+	BaseType_t xRemovedRed;
+
+		/* pxChild is the item (possibly NULL) that moves into the position
+		vacated in the tree, and pxParent is its new parent. */
+		if( pxItemToRemove->pxTreeLeft == NULL )
+		{
+			xRemovedRed = pxItemToRemove->xTreeRed;
+			pxChild = pxItemToRemove->pxTreeRight;
+			pxParent = pxItemToRemove->pxTreeParent;
+			prvTreeReplace( pxList, pxItemToRemove, pxChild );
+		}
+		else if( pxItemToRemove->pxTreeRight == NULL )
+		{
+			xRemovedRed = pxItemToRemove->xTreeRed;
+			pxChild = pxItemToRemove->pxTreeLeft;
+			pxParent = pxItemToRemove->pxTreeParent;
+			prvTreeReplace( pxList, pxItemToRemove, pxChild );
+		}
+		else
+		{
+			/* The item has two children, so is replaced by its successor,
+			which is also the next item in the linked list. */
+			pxSuccessor = pxItemToRemove->pxNext;
+			xRemovedRed = pxSuccessor->xTreeRed;
+			pxChild = pxSuccessor->pxTreeRight;
+
+			if( pxSuccessor->pxTreeParent == pxItemToRemove )
+			{
+				pxParent = pxSuccessor;
+			}
+			else
+			{
+				pxParent = pxSuccessor->pxTreeParent;
+				prvTreeReplace( pxList, pxSuccessor, pxChild );
+				pxSuccessor->pxTreeRight = pxItemToRemove->pxTreeRight;
+				pxSuccessor->pxTreeRight->pxTreeParent = pxSuccessor;
+			}
+
+			prvTreeReplace( pxList, pxItemToRemove, pxSuccessor );
+			pxSuccessor->pxTreeLeft = pxItemToRemove->pxTreeLeft;
+			pxSuccessor->pxTreeLeft->pxTreeParent = pxSuccessor;
+			pxSuccessor->xTreeRed = pxItemToRemove->xTreeRed;
+		}
+
+		/* Removing a black item leaves one path short of a black item.
+		Restore the red-black properties.  Each iteration either ends the loop
+		or moves one level up the tree. */
+		if( xRemovedRed == pdFALSE )
+		{
+			while( ( pxChild != pxList->pxTreeRoot ) && ( ( pxChild == NULL ) || ( pxChild->xTreeRed == pdFALSE ) ) )
+			{
+				if( pxChild == pxParent->pxTreeLeft )
+				{
+					/* The sibling cannot be NULL as the path through it has at
+					least one more black item than the path through pxChild. */
+					pxSibling = pxParent->pxTreeRight;
+
+					if( pxSibling->xTreeRed != pdFALSE )
+					{
+						pxSibling->xTreeRed = pdFALSE;
+						pxParent->xTreeRed = pdTRUE;
+						prvTreeRotateLeft( pxList, pxParent );
+						pxSibling = pxParent->pxTreeRight;
+					}
+
+					if( ( ( pxSibling->pxTreeLeft == NULL ) || ( pxSibling->pxTreeLeft->xTreeRed == pdFALSE ) ) &&
+						( ( pxSibling->pxTreeRight == NULL ) || ( pxSibling->pxTreeRight->xTreeRed == pdFALSE ) ) )
+					{
+						pxSibling->xTreeRed = pdTRUE;
+						pxChild = pxParent;
+						pxParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( ( pxSibling->pxTreeRight == NULL ) || ( pxSibling->pxTreeRight->xTreeRed == pdFALSE ) )
+						{
+							pxSibling->pxTreeLeft->xTreeRed = pdFALSE;
+							pxSibling->xTreeRed = pdTRUE;
+							prvTreeRotateRight( pxList, pxSibling );
+							pxSibling = pxParent->pxTreeRight;
+						}
+
+						pxSibling->xTreeRed = pxParent->xTreeRed;
+						pxParent->xTreeRed = pdFALSE;
+						pxSibling->pxTreeRight->xTreeRed = pdFALSE;
+						prvTreeRotateLeft( pxList, pxParent );
+						pxChild = pxList->pxTreeRoot;
+					}
+				}
+				else
+				{
+					pxSibling = pxParent->pxTreeLeft;
+
+					if( pxSibling->xTreeRed != pdFALSE )
+					{
+						pxSibling->xTreeRed = pdFALSE;
+						pxParent->xTreeRed = pdTRUE;
+						prvTreeRotateRight( pxList, pxParent );
+						pxSibling = pxParent->pxTreeLeft;
+					}
+
+					if( ( ( pxSibling->pxTreeLeft == NULL ) || ( pxSibling->pxTreeLeft->xTreeRed == pdFALSE ) ) &&
+						( ( pxSibling->pxTreeRight == NULL ) || ( pxSibling->pxTreeRight->xTreeRed == pdFALSE ) ) )
+					{
+						pxSibling->xTreeRed = pdTRUE;
+						pxChild = pxParent;
+						pxParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( ( pxSibling->pxTreeLeft == NULL ) || ( pxSibling->pxTreeLeft->xTreeRed == pdFALSE ) )
+						{
+							pxSibling->pxTreeRight->xTreeRed = pdFALSE;
+							pxSibling->xTreeRed = pdTRUE;
+							prvTreeRotateLeft( pxList, pxSibling );
+							pxSibling = pxParent->pxTreeLeft;
+						}
+
+						pxSibling->xTreeRed = pxParent->xTreeRed;
+						pxParent->xTreeRed = pdFALSE;
+						pxSibling->pxTreeLeft->xTreeRed = pdFALSE;
+						prvTreeRotateRight( pxList, pxParent );
+						pxChild = pxList->pxTreeRoot;
+					}
+				}
+			}
+
+			if( pxChild != NULL )
+			{
+				pxChild->xTreeRed = pdFALSE;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_INDEXED_DELAY_LISTS */
+/*-----------------------------------------------------------*/
@@ -30,6 +30,28 @@
  * (coalescences) adjacent memory blocks as they are freed, and in so doing
  * limits memory fragmentation.
  *
+ * If configUSE_HEAP_POOLS is 1 then the start of the heap is set aside as
+ * configHEAP_POOL_COUNT pools of fixed size blocks, one pool for each of the
+ * block sizes in configHEAP_POOL_BLOCK_SIZES, holding the number of blocks
+ * given in configHEAP_POOL_BLOCK_COUNTS.  A request is served from the pool of
+ * the smallest blocks that are large enough by popping a block off the pool's
+ * free stack, so the objects the kernel allocates most often (task control
+ * blocks, stacks, queues, timers) neither walk nor fragment the free list.
+ * Requests that are larger than the largest pool block, or that find their
+ * pool empty, are served from the free list as normal.  The sizes must be in
+ * ascending order.  Memory set aside for the pools is never returned to the
+ * rest of the heap.  xPortGetFreeHeapSize() and
+ * xPortGetMinimumEverFreeHeapSize() only count the free list, so they neither
+ * include the free pool blocks nor change when a pool block is allocated or
+ * freed - use vPortGetPoolStats() for the pools.
+ * vPortGetPoolStats() reports how well each pool is used.
+ *
+ * If configUSE_HEAP_ACCOUNTING is 1 then each allocated block also records the
+ * task that allocated it, the call site given by configHEAP_CALL_SITE() and
+ * the number of bytes requested, and is kept in a list of allocated blocks.
+ * xPortGetHeapUsage() sums the blocks that belong to one task, and
+ * vPortHeapDump() reports every allocated block.
+ *
  * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
  * memory management pages of http://www.FreeRTOS.org for more information.
  */
@@ -90,6 +112,28 @@ static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+#if( configUSE_HEAP_POOLS == 1 )
+
+	/*
+	 * Set aside the pools at pucStart, and return the number of bytes used.
+	 */
+	static size_t prvPoolInit( uint8_t *pucStart );
+
+	/*
+	 * Return a block from the pool of the smallest blocks that can hold
+	 * xWantedSize bytes, or NULL if xWantedSize is larger than every pool
+	 * block or that pool is empty.
+	 */
+	static void *prvPoolMalloc( size_t xWantedSize );
+
+	/*
+	 * Return pv to its pool and return pdTRUE if it came from a pool, otherwise
+	 * return pdFALSE.
+	 */
+	static BaseType_t prvPoolFree( void *pv );
+
+#endif /* configUSE_HEAP_POOLS */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -110,12 +154,54 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_POOLS == 1 )
+
+	/* A free pool block holds a link to the next free block in the same pool.
+	Allocated pool blocks have no header at all - the pool a block belongs to is
+	found from its address. */
+	typedef struct A_POOL_BLOCK
+	{
+		struct A_POOL_BLOCK *pxNextFreeBlock;
+	} PoolBlock_t;
+
+	typedef struct A_POOL
+	{
+		uint8_t *pucStart;				/*<< The first block in the pool. */
+		uint8_t *pucEnd;				/*<< The first byte after the last block in the pool. */
+		size_t xStride;					/*<< The distance between blocks, which is the block size rounded up to the byte alignment. */
+		PoolBlock_t *pxFreeBlocks;		/*<< The stack of free blocks. */
+		HeapPoolStats_t xStats;
+	} Pool_t;
+
+	static Pool_t xPools[ configHEAP_POOL_COUNT ];
+
+#endif /* configUSE_HEAP_POOLS */
+
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* The accounting record at the start of each allocated block, and the
+	functions that maintain and report the records, are shared with heap_5.c. */
+	#include "heap_accounting.c"
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+	const void * const pvCallSite = configHEAP_CALL_SITE();
+	const size_t xRequestedSize = xWantedSize;
+#endif
+
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		/* Make room for the accounting record. */
+		xWantedSize = prvAddAccountSize( xWantedSize );
+	}
+	#endif /* configUSE_HEAP_ACCOUNTING */
 
 	vTaskSuspendAll();
 	{
@@ -130,11 +216,18 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_POOLS == 1 )
+		{
+			/* Small requests are served by the pools where possible. */
+			pvReturn = prvPoolMalloc( xWantedSize );
+		}
+		#endif /* configUSE_HEAP_POOLS */
+
 		/* Check the requested block size is not so large that the top bit is
 		set.  The top bit of the block size member of the BlockLink_t structure
 		is used to determine who owns the block - the application or the
 		kernel, so it must be free. */
-		if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+		if( ( pvReturn == NULL ) && ( ( xWantedSize & xBlockAllocatedBit ) == 0 ) )
 		{
 			/* The wanted size is increased so it can contain a BlockLink_t
 			structure in addition to the requested amount of bytes. */
@@ -239,6 +332,19 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_ACCOUNTING == 1 )
+		{
+			if( pvReturn != NULL )
+			{
+				pvReturn = prvAccountBlock( pvReturn, xRequestedSize, pvCallSite );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_HEAP_ACCOUNTING */
+
 		traceMALLOC( pvReturn, xWantedSize );
 	}
 	( void ) xTaskResumeAll();
@@ -267,6 +373,32 @@ void vPortFree( void *pv )
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
 
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		/* The block is freed from the start of its accounting record. */
+		if( pv != NULL )
+		{
+			pv = prvUnaccountBlock( pv );
+			puc = ( uint8_t * ) pv;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_HEAP_ACCOUNTING */
+
+	#if( configUSE_HEAP_POOLS == 1 )
+	{
+		/* A block that came from a pool goes back to the pool, and is not
+		known to the rest of the heap. */
+		if( prvPoolFree( pv ) != pdFALSE )
+		{
+			pv = NULL;
+		}
+	}
+	#endif /* configUSE_HEAP_POOLS */
+
 	if( pv != NULL )
 	{
 		/* The memory being freed will have an BlockLink_t structure immediately
@@ -312,6 +444,7 @@ BlockLink_t *pxLink;
 
 size_t xPortGetFreeHeapSize( void )
 {
+	/* The pools are not included, see the comment at the top of this file. */
 	return xFreeBytesRemaining;
 }
 /*-----------------------------------------------------------*/
@@ -347,6 +480,18 @@ size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
 
 	pucAlignedHeap = ( uint8_t * ) uxAddress;
 
+	#if( configUSE_HEAP_POOLS == 1 )
+	{
+	size_t xPoolBytes;
+
+		/* The pools take the start of the heap, and the free list the rest. */
+		xPoolBytes = prvPoolInit( pucAlignedHeap );
+		configASSERT( xPoolBytes < xTotalHeapSize );
+		pucAlignedHeap += xPoolBytes;
+		xTotalHeapSize -= xPoolBytes;
+	}
+	#endif /* configUSE_HEAP_POOLS */
+
 	/* xStart is used to hold a pointer to the first item in the list of free
 	blocks.  The void cast is used to prevent compiler warnings. */
 	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
@@ -435,4 +580,226 @@ uint8_t *puc;
 		mtCOVERAGE_TEST_MARKER();
 	}
 }
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_POOLS == 1 )
+
+	static size_t prvPoolInit( uint8_t *pucStart )
+	{
+	static const size_t xBlockSizes[] = configHEAP_POOL_BLOCK_SIZES;
+	static const size_t xBlockCounts[] = configHEAP_POOL_BLOCK_COUNTS;
+	Pool_t *pxPool;
+	PoolBlock_t *pxBlock;
+	size_t xPool, xBlock, xUsed = 0;
+
+		/* Every pool must have a size and a count, and the sizes must be in
+		ascending order so the first pool that is large enough is the best
+		fit. */
+		configASSERT( ( sizeof( xBlockSizes ) / sizeof( xBlockSizes[ 0 ] ) ) == configHEAP_POOL_COUNT );
+		configASSERT( ( sizeof( xBlockCounts ) / sizeof( xBlockCounts[ 0 ] ) ) == configHEAP_POOL_COUNT );
+
+		for( xPool = 0; xPool < configHEAP_POOL_COUNT; xPool++ )
+		{
+			configASSERT( ( xPool == 0 ) || ( xBlockSizes[ xPool ] > xBlockSizes[ xPool - 1 ] ) );
+
+			pxPool = &( xPools[ xPool ] );
+			pxPool->xStride = xBlockSizes[ xPool ];
+
+			/* Free blocks must be able to hold their link, and every block
+			must be aligned. */
+			if( pxPool->xStride < sizeof( PoolBlock_t ) )
+			{
+				pxPool->xStride = sizeof( PoolBlock_t );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( pxPool->xStride & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				pxPool->xStride += ( portBYTE_ALIGNMENT - ( pxPool->xStride & portBYTE_ALIGNMENT_MASK ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxPool->pucStart = pucStart + xUsed;
+			pxPool->pucEnd = pxPool->pucStart + ( pxPool->xStride * xBlockCounts[ xPool ] );
+			xUsed += pxPool->xStride * xBlockCounts[ xPool ];
+
+			/* Push the blocks in reverse order so they are handed out in
+			address order. */
+			pxPool->pxFreeBlocks = NULL;
+
+			for( xBlock = xBlockCounts[ xPool ]; xBlock > 0; xBlock-- )
+			{
+				pxBlock = ( void * ) ( pxPool->pucStart + ( ( xBlock - 1 ) * pxPool->xStride ) );
+				pxBlock->pxNextFreeBlock = pxPool->pxFreeBlocks;
+				pxPool->pxFreeBlocks = pxBlock;
+			}
+
+			pxPool->xStats.xBlockSize = xBlockSizes[ xPool ];
+			pxPool->xStats.xNumberOfBlocks = xBlockCounts[ xPool ];
+			pxPool->xStats.xBlocksInUse = 0;
+			pxPool->xStats.xMaximumBlocksInUse = 0;
+			pxPool->xStats.ulHits = 0;
+			pxPool->xStats.ulMisses = 0;
+		}
+
+		return xUsed;
+	}
+
+#endif /* configUSE_HEAP_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_POOLS == 1 )
+
+	static void *prvPoolMalloc( size_t xWantedSize )
+	{
+	Pool_t *pxPool = NULL;
+	PoolBlock_t *pxBlock = NULL;
+	size_t xPool;
+
+		/* Called with the scheduler suspended.  Find the pool of the smallest
+		blocks that are large enough. */
+		if( xWantedSize > 0 )
+		{
+			for( xPool = 0; xPool < configHEAP_POOL_COUNT; xPool++ )
+			{
+				if( xWantedSize <= xPools[ xPool ].xStats.xBlockSize )
+				{
+					pxPool = &( xPools[ xPool ] );
+					break;
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxPool != NULL )
+		{
+			pxBlock = pxPool->pxFreeBlocks;
+
+			if( pxBlock != NULL )
+			{
+				pxPool->pxFreeBlocks = pxBlock->pxNextFreeBlock;
+				( pxPool->xStats.ulHits )++;
+				( pxPool->xStats.xBlocksInUse )++;
+
+				if( pxPool->xStats.xBlocksInUse > pxPool->xStats.xMaximumBlocksInUse )
+				{
+					pxPool->xStats.xMaximumBlocksInUse = pxPool->xStats.xBlocksInUse;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The pool is empty, so the request falls through to the free
+				list. */
+				( pxPool->xStats.ulMisses )++;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( void * ) pxBlock;
+	}
+
+#endif /* configUSE_HEAP_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_POOLS == 1 )
+
+	static BaseType_t prvPoolFree( void *pv )
+	{
+	uint8_t *puc = ( uint8_t * ) pv;
+	PoolBlock_t *pxBlock;
+	Pool_t *pxPool;
+	size_t xPool;
+	BaseType_t xReturn = pdFALSE;
+
+		/* The pools are contiguous, so a block that is outside all of them can
+		be rejected without checking each one. */
+		if( ( pxEnd != NULL ) && ( puc >= xPools[ 0 ].pucStart ) && ( puc < xPools[ configHEAP_POOL_COUNT - 1 ].pucEnd ) )
+		{
+			for( xPool = 0; xPool < configHEAP_POOL_COUNT; xPool++ )
+			{
+				pxPool = &( xPools[ xPool ] );
+
+				if( puc < pxPool->pucEnd )
+				{
+					/* Check pv really is the start of a block. */
+					configASSERT( ( ( size_t ) ( puc - pxPool->pucStart ) % pxPool->xStride ) == 0 );
+
+					vTaskSuspendAll();
+					{
+						configASSERT( pxPool->xStats.xBlocksInUse > 0 );
+
+						pxBlock = ( void * ) puc;
+						pxBlock->pxNextFreeBlock = pxPool->pxFreeBlocks;
+						pxPool->pxFreeBlocks = pxBlock;
+						( pxPool->xStats.xBlocksInUse )--;
+						traceFREE( pv, pxPool->xStride );
+					}
+					( void ) xTaskResumeAll();
+
+					xReturn = pdTRUE;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_HEAP_POOLS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_POOLS == 1 )
+
+	void vPortGetPoolStats( HeapPoolStats_t *pxPoolStats )
+	{
+	size_t xPool;
+
+		/* pxPoolStats must point to an array of configHEAP_POOL_COUNT
+		structures. */
+		configASSERT( pxPoolStats );
+
+		vTaskSuspendAll();
+		{
+			if( pxEnd == NULL )
+			{
+				prvHeapInit();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			for( xPool = 0; xPool < configHEAP_POOL_COUNT; xPool++ )
+			{
+				pxPoolStats[ xPool ] = xPools[ xPool ].xStats;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_HEAP_POOLS */
 
@@ -30,6 +30,12 @@
  * across multiple non-contigous blocks and combines (coalescences) adjacent
  * memory blocks as they are freed.
  *
+ * If configUSE_HEAP_ACCOUNTING is 1 then each allocated block also records the
+ * task that allocated it, the call site given by configHEAP_CALL_SITE() and
+ * the number of bytes requested, and is kept in a list of allocated blocks.
+ * xPortGetHeapUsage() sums the blocks that belong to one task, and
+ * vPortHeapDump() reports every allocated block.
+ *
  * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
  * implementations, and the memory management pages of http://www.FreeRTOS.org
  * for more information.
@@ -127,12 +133,31 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* The accounting record at the start of each allocated block, and the
+	functions that maintain and report the records, are shared with heap_4.c. */
+	#include "heap_accounting.c"
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+	const void * const pvCallSite = configHEAP_CALL_SITE();
+	const size_t xRequestedSize = xWantedSize;
+#endif
+
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		/* Make room for the accounting record. */
+		xWantedSize = prvAddAccountSize( xWantedSize );
+	}
+	#endif /* configUSE_HEAP_ACCOUNTING */
 
 	/* The heap must be initialised before the first call to
 	prvPortMalloc(). */
@@ -247,6 +272,19 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_ACCOUNTING == 1 )
+		{
+			if( pvReturn != NULL )
+			{
+				pvReturn = prvAccountBlock( pvReturn, xRequestedSize, pvCallSite );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_HEAP_ACCOUNTING */
+
 		traceMALLOC( pvReturn, xWantedSize );
 	}
 	( void ) xTaskResumeAll();
@@ -274,6 +312,21 @@ void vPortFree( void *pv )
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
 
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		/* The block is freed from the start of its accounting record. */
+		if( pv != NULL )
+		{
+			pv = prvUnaccountBlock( pv );
+			puc = ( uint8_t * ) pv;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_HEAP_ACCOUNTING */
+
 	if( pv != NULL )
 	{
 		/* The memory being freed will have an BlockLink_t structure immediately
@@ -0,0 +1,761 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that finds and
+ * releases blocks in constant time, using a two level segregated fit (TLSF)
+ * scheme, and combines (coalescences) adjacent memory blocks as they are
+ * freed.
+ *
+ * heap_4.c and heap_5.c search a single list of free blocks for the first
+ * block that is large enough, and free blocks are inserted into that list in
+ * address order, so the time taken by both pvPortMalloc() and vPortFree()
+ * grows with the number of free blocks.  heap_6.c instead keeps a separate
+ * list of free blocks for each range of block sizes.  The ranges are powers of
+ * two (the first level), each split into heapSL_INDEX_COUNT equal parts (the
+ * second level), and a bitmap records which lists are not empty, so finding a
+ * large enough block is a couple of bit scans however many blocks are free.
+ * Each block records the block immediately before it in memory, so a freed
+ * block can be merged with its neighbours without searching for them.
+ *
+ * The cost is a doubly linked free list, so the smallest block is four
+ * pointers long rather than two, and a table of list heads (about 1.5K bytes
+ * on the RX).  A request is met by the block at the front of the list its size
+ * maps to if that block is large enough, otherwise by the first non-empty list
+ * whose blocks are all large enough - which is not necessarily the smallest
+ * block that would fit.  Only if both fail is the rest of the first list
+ * searched, so pvPortMalloc() only takes longer when it is about to fail, or
+ * when the heap is nearly exhausted.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * Like heap_4.c, the heap is the ucHeap array of configTOTAL_HEAP_SIZE bytes,
+ * and is initialised automatically the first time pvPortMalloc() is called.
+ *
+ * Like heap_5.c, vPortDefineHeapRegions() can be used to add further, non
+ * contiguous, blocks of memory to the heap.  vPortDefineHeapRegions() takes an
+ * array of HeapRegion_t structures, terminated by a NULL zero sized region,
+ * exactly as described in heap_5.c.  The regions can be given in any order,
+ * and vPortDefineHeapRegions() can be called before or after the first call to
+ * pvPortMalloc().  Memory added to the heap in this way is never removed.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE			( ( size_t ) 8 )
+
+/* Each power of two range of block sizes is split into this many lists. */
+#define heapSL_INDEX_COUNT_LOG2		( 4 )
+#define heapSL_INDEX_COUNT			( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in first level list 0,
+split into heapSL_INDEX_COUNT lists of equal width.  Larger blocks are held in
+first level list 1 for sizes from heapSMALL_BLOCK_SIZE to twice
+heapSMALL_BLOCK_SIZE, list 2 for the next power of two, and so on. */
+#define heapSMALL_BLOCK_SIZE_LOG2	( 8 )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapSMALL_BLOCK_SIZE_LOG2 )
+#define heapSMALL_BLOCK_STEP		( heapSMALL_BLOCK_SIZE / ( size_t ) heapSL_INDEX_COUNT )
+
+/* Blocks, and therefore heap regions, must be smaller than
+heapMAXIMUM_BLOCK_SIZE, which keeps the first level bitmap within 32 bits and
+leaves the top bit of a 32-bit xBlockSize free to mark allocated blocks. */
+#define heapMAXIMUM_BLOCK_SIZE_LOG2	( 30 )
+#define heapMAXIMUM_BLOCK_SIZE		( ( size_t ) 1 << heapMAXIMUM_BLOCK_SIZE_LOG2 )
+#define heapFL_INDEX_COUNT			( heapMAXIMUM_BLOCK_SIZE_LOG2 - heapSMALL_BLOCK_SIZE_LOG2 + 1 )
+
+/* Block sizes must not get too small - a free block must be able to hold the
+whole of its BlockLink_t structure. */
+#define heapMINIMUM_BLOCK_SIZE		( ( size_t ) ( ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) )
+
+#pragma section OSW
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#pragma section
+
+/* Define the block header.  Only the first two members are present while a
+block is allocated - the free list links are held in what would otherwise be
+the start of the application's memory, so are only valid while the block is
+free. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPreviousPhysicalBlock;	/*<< The block immediately before this block in memory, or NULL if this is the first block in its region. */
+	size_t xBlockSize;								/*<< The size of the block, including this header.  The top bit is set while the block is allocated. */
+	struct A_BLOCK_LINK *pxNextFreeBlock;			/*<< The next block in the same free list. */
+	struct A_BLOCK_LINK *pxPreviousFreeBlock;		/*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() or vPortDefineHeapRegions() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Make the xSizeInBytes bytes starting at pucStartAddress a single free block
+ * that is part of the heap.
+ */
+static void prvAddRegionToHeap( uint8_t *pucStartAddress, size_t xSizeInBytes );
+
+/*
+ * Return the first and second level indexes of the free list that holds blocks
+ * of xBlockSize bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Remove, and return, a free block of at least xWantedSize bytes, or return
+ * NULL if there is no such block.
+ */
+static BlockLink_t *prvRemoveSuitableBlock( size_t xWantedSize );
+
+/*
+ * Add a free block to, or remove a free block from, the free list for its
+ * size.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+static void prvRemoveBlockFromFreeList( BlockLink_t *pxBlockToRemove );
+
+/*
+ * Return the index of the lowest or highest bit that is set in ulValue, which
+ * must not be zero.  Written in portable C so they take the same time whatever
+ * the value.
+ */
+static UBaseType_t prvLowestSetBit( uint32_t ulValue );
+static UBaseType_t prvHighestSetBit( uint32_t ulValue );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of the structure that remains at the beginning of each
+allocated memory block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( ( sizeof( BlockLink_t * ) + sizeof( size_t ) ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The head of each free list, and the bitmaps that record which lists are not
+empty.  Bit n of uxFirstLevelBitmap is set if any bit of ulSecondLevelBitmap[ n ]
+is set, and bit m of ulSecondLevelBitmap[ n ] is set if pxFreeLists[ n ][ m ] is
+not empty. */
+static BlockLink_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmap[ heapFL_INDEX_COUNT ];
+
+/* Set once ucHeap has been added to the heap. */
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockLink_t *pxBlock, *pxNewBlockLink, *pxNextBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Check the requested block size is not so large that it could not be
+		held in any free list, which also ensures the top bit, which is used to
+		determine who owns the block, is free. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAXIMUM_BLOCK_SIZE ) )
+		{
+			/* The wanted size is increased so it can contain the start of a
+			BlockLink_t structure in addition to the requested amount of bytes,
+			and so the block can hold the whole BlockLink_t structure when it
+			is freed. */
+			xWantedSize += xHeapStructSize;
+
+			/* Ensure that blocks are always aligned to the required number of
+			bytes. */
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+			{
+				xWantedSize = heapMINIMUM_BLOCK_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize <= xFreeBytesRemaining )
+			{
+				pxBlock = prvRemoveSuitableBlock( xWantedSize );
+
+				if( pxBlock != NULL )
+				{
+					/* Return the memory space pointed to - jumping over the
+					start of the BlockLink_t structure. */
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested. The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+						pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+
+						/* Calculate the sizes of two blocks split from the
+						single block, and link the new block in between the
+						block and the block that used to follow it. */
+						pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+						pxNextBlock->pxPreviousPhysicalBlock = pxNewBlockLink;
+						pxBlock->xBlockSize = xWantedSize;
+
+						/* Insert the new block into the list of free blocks. */
+						prvInsertBlockIntoFreeList( pxNewBlockLink );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have the start of a BlockLink_t
+		structure immediately before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			/* The block is being returned to the heap - it is no longer
+			allocated. */
+			pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxLink->xBlockSize;
+				traceFREE( pv, pxLink->xBlockSize );
+
+				/* Merge the block with the block before it in memory if that
+				block is also free.  The first block in a region has no block
+				before it. */
+				pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+				{
+					prvRemoveBlockFromFreeList( pxNeighbour );
+					pxNeighbour->xBlockSize += pxLink->xBlockSize;
+					pxLink = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge the block with the block after it in memory if that
+				block is also free.  The last block in a region is followed by
+				the region's end marker, which is always marked as allocated. */
+				pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+				if( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 )
+				{
+					prvRemoveBlockFromFreeList( pxNeighbour );
+					pxLink->xBlockSize += pxNeighbour->xBlockSize;
+					pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxNeighbour->pxPreviousPhysicalBlock = pxLink;
+
+				/* Add this block to the list of free blocks. */
+				prvInsertBlockIntoFreeList( pxLink );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+const HeapRegion_t *pxHeapRegion;
+
+	vTaskSuspendAll();
+	{
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+		{
+			prvAddRegionToHeap( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	/* The free lists and bitmaps are in zero initialised memory, so all the
+	lists start empty, and only ucHeap needs adding. */
+	xHeapHasBeenInitialised = pdTRUE;
+	prvAddRegionToHeap( ucHeap, configTOTAL_HEAP_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegionToHeap( uint8_t *pucStartAddress, size_t xSizeInBytes )
+{
+BlockLink_t *pxFirstFreeBlock, *pxEnd;
+size_t uxAddress, xAlignedStart;
+
+	/* Ensure the region starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) pucStartAddress;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		/* Adjust the size for the bytes lost to alignment. */
+		xSizeInBytes -= uxAddress - ( size_t ) pucStartAddress;
+	}
+
+	xAlignedStart = uxAddress;
+
+	/* pxEnd marks the end of the region.  It is the start of a BlockLink_t
+	structure that is always marked as allocated, so the last free block in the
+	region is never merged past the end of the region. */
+	uxAddress = xAlignedStart + xSizeInBytes;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* To start with there is a single free block in the region that is sized to
+	take up the entire region, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) xAlignedStart;
+	pxFirstFreeBlock->xBlockSize = uxAddress - xAlignedStart;
+	pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+	pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+
+	/* Check the region is large enough to be useful, and small enough to fit in
+	a free list. */
+	configASSERT( pxFirstFreeBlock->xBlockSize >= heapMINIMUM_BLOCK_SIZE );
+	configASSERT( pxFirstFreeBlock->xBlockSize < heapMAXIMUM_BLOCK_SIZE );
+
+	prvInsertBlockIntoFreeList( pxFirstFreeBlock );
+
+	/* Memory added to the heap is never removed, so counts towards the minimum
+	ever free as well as the current free space. */
+	xFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+	xMinimumEverFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxHighestBit;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are split into lists of equal width. */
+		*puxFirstLevel = 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize / heapSMALL_BLOCK_STEP );
+	}
+	else
+	{
+		/* Larger blocks are listed by their highest set bit, then by the
+		heapSL_INDEX_COUNT_LOG2 bits below it. */
+		uxHighestBit = prvHighestSetBit( ( uint32_t ) xBlockSize );
+		*puxFirstLevel = uxHighestBit - ( heapSMALL_BLOCK_SIZE_LOG2 - 1 );
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxHighestBit - heapSL_INDEX_COUNT_LOG2 ) ) & ( heapSL_INDEX_COUNT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvRemoveSuitableBlock( size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+BlockLink_t *pxBlock;
+size_t xRoundedSize;
+
+	/* A block at the front of the list that xWantedSize maps to is the closest
+	fit that can be found in constant time, and is often exactly the right
+	size, as blocks of the same size tend to be allocated and freed in turn. */
+	prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+	pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+	if( ( pxBlock == NULL ) || ( pxBlock->xBlockSize < xWantedSize ) )
+	{
+		pxBlock = NULL;
+
+		/* Round the size up to the start of the next list, so every block in
+		that list, and every list after it, is large enough. */
+		if( xWantedSize < heapSMALL_BLOCK_SIZE )
+		{
+			xRoundedSize = xWantedSize + ( heapSMALL_BLOCK_STEP - 1 );
+		}
+		else
+		{
+			xRoundedSize = xWantedSize + ( ( ( size_t ) 1 << ( prvHighestSetBit( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1 );
+		}
+
+		prvMapBlockSize( xRoundedSize, &uxFirstLevel, &uxSecondLevel );
+
+		if( uxFirstLevel < heapFL_INDEX_COUNT )
+		{
+			/* Look for a non-empty list at or after the second level index in
+			the same first level list, then in the smallest first level list
+			after it that has any free blocks. */
+			ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ] & ( ~( uint32_t ) 0 << uxSecondLevel );
+
+			if( ulBitmap == 0U )
+			{
+				ulBitmap = ulFirstLevelBitmap & ( ~( uint32_t ) 0 << ( uxFirstLevel + 1 ) );
+
+				if( ulBitmap != 0U )
+				{
+					uxFirstLevel = prvLowestSetBit( ulBitmap );
+					ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ];
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ulBitmap != 0U )
+			{
+				uxSecondLevel = prvLowestSetBit( ulBitmap );
+				pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxBlock == NULL )
+		{
+			/* There is no list in which every block is large enough, but blocks
+			after the first in the list that xWantedSize maps to might be.  This
+			is the only search that is not constant time, and only happens when
+			the allocation would otherwise fail - including when the heap is a
+			single free block, which is otherwise never large enough for a
+			request of more than the start of its own list. */
+			prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+			for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( pxBlock->xBlockSize >= xWantedSize )
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock != NULL )
+	{
+		prvRemoveBlockFromFreeList( pxBlock );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+BlockLink_t *pxHead;
+
+	prvMapBlockSize( pxBlockToInsert->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	/* Blocks are added to the front of their list. */
+	pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlockToInsert->pxNextFreeBlock = pxHead;
+	pxBlockToInsert->pxPreviousFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPreviousFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToInsert;
+	ulFirstLevelBitmap |= ( uint32_t ) 1 << uxFirstLevel;
+	ulSecondLevelBitmap[ uxFirstLevel ] |= ( uint32_t ) 1 << uxSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockLink_t *pxBlockToRemove )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapBlockSize( pxBlockToRemove->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlockToRemove->pxNextFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToRemove->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlockToRemove->pxPreviousFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxPreviousFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the front of its list. */
+		configASSERT( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == pxBlockToRemove );
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToRemove->pxNextFreeBlock;
+
+		/* Clear the bitmaps if the list is now empty. */
+		if( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == NULL )
+		{
+			ulSecondLevelBitmap[ uxFirstLevel ] &= ~( ( uint32_t ) 1 << uxSecondLevel );
+
+			if( ulSecondLevelBitmap[ uxFirstLevel ] == 0U )
+			{
+				ulFirstLevelBitmap &= ~( ( uint32_t ) 1 << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLowestSetBit( uint32_t ulValue )
+{
+/* Indexed by the top five bits of the lowest set bit multiplied by a de
+Bruijn sequence, which are different for each bit position. */
+static const uint8_t ucDeBruijnBitPosition[ 32 ] =
+{
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+	configASSERT( ulValue != 0U );
+	ulValue &= ( ( uint32_t ) 0U - ulValue );
+	return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ulValue * 0x077CB531UL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHighestSetBit( uint32_t ulValue )
+{
+	configASSERT( ulValue != 0U );
+
+	/* Set every bit below the highest set bit, then clear all but the highest
+	set bit, so it is also the lowest set bit. */
+	ulValue |= ulValue >> 1;
+	ulValue |= ulValue >> 2;
+	ulValue |= ulValue >> 4;
+	ulValue |= ulValue >> 8;
+	ulValue |= ulValue >> 16;
+	ulValue ^= ulValue >> 1;
+
+	return prvLowestSetBit( ulValue );
+}
+
@@ -0,0 +1,213 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * The heap accounting shared by heap_4.c and heap_5.c, which each include this
+ * file when configUSE_HEAP_ACCOUNTING is 1.  It is not a header - it defines
+ * the file scope variables and functions of the heap that includes it, and must
+ * be included after portBYTE_ALIGNMENT_MASK is known.
+ *
+ * Each allocated block starts with a BlockAccount_t record that holds the task
+ * that allocated it, the call site given by configHEAP_CALL_SITE() and the
+ * number of bytes requested, and links the block into a list of allocated
+ * blocks.  The memory returned by pvPortMalloc() follows the record.
+ */
+
+#ifndef HEAP_ACCOUNTING_C
+#define HEAP_ACCOUNTING_C
+
+/* Each allocated block starts with a record of the task and call site that
+allocated it, and the record is held in a list of all allocated blocks.  The
+memory returned to the application follows the record. */
+typedef struct A_BLOCK_ACCOUNT
+{
+	struct A_BLOCK_ACCOUNT *pxNext;			/*<< The next allocated block. */
+	struct A_BLOCK_ACCOUNT *pxPrevious;		/*<< The previous allocated block. */
+	void *pvOwner;							/*<< The task that allocated the block, or NULL if the block was allocated before the scheduler was started or the task has since been deleted. */
+	const void *pvCallSite;					/*<< The value of configHEAP_CALL_SITE() when the block was allocated. */
+	size_t xRequestedSize;					/*<< The number of bytes the application asked for. */
+} BlockAccount_t;
+
+/* The size of the record must also be correctly byte aligned. */
+static const size_t xAccountStructSize = ( sizeof( BlockAccount_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The list of allocated blocks.  xAllocatedBlocks marks the start and end of
+the list, so the list is never empty. */
+static BlockAccount_t xAllocatedBlocks = { &xAllocatedBlocks, &xAllocatedBlocks, NULL, NULL, 0 };
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Return xWantedSize plus the room needed for the accounting record.  A size
+ * that would wrap is returned as it is, so the heap rejects it as too large.
+ */
+static size_t prvAddAccountSize( size_t xWantedSize )
+{
+	if( ( xWantedSize > 0 ) && ( ( xWantedSize + xAccountStructSize ) > xWantedSize ) )
+	{
+		xWantedSize += xAccountStructSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Fill in the accounting record at the start of the block pv, add the block to
+ * the list of allocated blocks, and return the memory that follows the record.
+ * Called with the scheduler suspended.
+ */
+static void *prvAccountBlock( void *pv, size_t xRequestedSize, const void *pvCallSite )
+{
+BlockAccount_t *pxAccount = ( BlockAccount_t * ) pv;
+
+	if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+	{
+		pxAccount->pvOwner = ( void * ) xTaskGetCurrentTaskHandle();
+	}
+	else
+	{
+		pxAccount->pvOwner = NULL;
+	}
+
+	pxAccount->pvCallSite = pvCallSite;
+	pxAccount->xRequestedSize = xRequestedSize;
+
+	/* Add the block to the end of the list, so vPortHeapDump() reports the
+	oldest blocks first. */
+	pxAccount->pxNext = &xAllocatedBlocks;
+	pxAccount->pxPrevious = xAllocatedBlocks.pxPrevious;
+	xAllocatedBlocks.pxPrevious->pxNext = pxAccount;
+	xAllocatedBlocks.pxPrevious = pxAccount;
+
+	return ( void * ) ( ( ( uint8_t * ) pv ) + xAccountStructSize );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove the block whose memory starts at pv from the list of allocated blocks,
+ * and return the start of its accounting record, which is where the heap's own
+ * block starts.
+ */
+static void *prvUnaccountBlock( void *pv )
+{
+BlockAccount_t *pxAccount = ( void * ) ( ( ( uint8_t * ) pv ) - xAccountStructSize );
+
+	vTaskSuspendAll();
+	{
+		/* Catch blocks that are freed twice, and records that have been
+		overwritten by the application. */
+		configASSERT( pxAccount->pxNext != NULL );
+		configASSERT( pxAccount->pxNext->pxPrevious == pxAccount );
+		configASSERT( pxAccount->pxPrevious->pxNext == pxAccount );
+
+		pxAccount->pxPrevious->pxNext = pxAccount->pxNext;
+		pxAccount->pxNext->pxPrevious = pxAccount->pxPrevious;
+		pxAccount->pxNext = NULL;
+		pxAccount->pxPrevious = NULL;
+	}
+	( void ) xTaskResumeAll();
+
+	return ( void * ) pxAccount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetHeapUsage( void *pvOwner )
+{
+BlockAccount_t *pxAccount;
+size_t xUsage = 0;
+
+	vTaskSuspendAll();
+	{
+		for( pxAccount = xAllocatedBlocks.pxNext; pxAccount != &xAllocatedBlocks; pxAccount = pxAccount->pxNext )
+		{
+			if( pxAccount->pvOwner == pvOwner )
+			{
+				xUsage += pxAccount->xRequestedSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xUsage;
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapClearOwner( void *pvOwner )
+{
+BlockAccount_t *pxAccount;
+
+	/* The owner is only a record of a task's address, so once the task has
+	been deleted a new task created at the same address would be charged for
+	its blocks.  Its remaining blocks are reported as having no owner. */
+	vTaskSuspendAll();
+	{
+		for( pxAccount = xAllocatedBlocks.pxNext; pxAccount != &xAllocatedBlocks; pxAccount = pxAccount->pxNext )
+		{
+			if( pxAccount->pvOwner == pvOwner )
+			{
+				pxAccount->pvOwner = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapDump( HeapDumpFunction_t pxFunction, void *pvParameter )
+{
+BlockAccount_t *pxAccount;
+
+	configASSERT( pxFunction );
+
+	/* The scheduler stays suspended while the list is walked, so pxFunction()
+	must not allocate or free memory, or block. */
+	vTaskSuspendAll();
+	{
+		for( pxAccount = xAllocatedBlocks.pxNext; pxAccount != &xAllocatedBlocks; pxAccount = pxAccount->pxNext )
+		{
+			pxFunction( ( void * ) ( ( ( uint8_t * ) pxAccount ) + xAccountStructSize ), pxAccount->xRequestedSize, pxAccount->pvOwner, pxAccount->pvCallSite, pvParameter );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* HEAP_ACCOUNTING_C */
+
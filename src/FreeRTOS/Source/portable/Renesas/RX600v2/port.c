@@ -46,6 +46,22 @@ PSW is set with U and I set, and PM and IPL clear. */
 #define portINITIAL_PSW     ( ( StackType_t ) 0x00030000 )
 #define portINITIAL_FPSW    ( ( StackType_t ) 0x00000100 )
 
+/* CMT0.CMCNT is a 16-bit up counter that is cleared on compare match, so the
+longest time that can be timed in one go is 0x10000 counts. */
+#define portCMT_COUNTER_RANGE			( 0x10000UL )
+
+/* The approximate number of CPU cycles for which CMT0 is stopped each time
+vPortSuppressTicksAndSleep() reprograms it.  The counts missed while the timer
+is stopped are added back when it is restarted.  This is an estimate from the
+instruction sequence and has not been measured on hardware. */
+#define portSTOPPED_TIMER_CPU_CYCLES	( 60UL )
+
+/* The stopped time is usually less than one CMT0 count (one count is 64 CPU
+cycles at PCLK/32 with this board's clocks), so it is kept in 1/256ths of a
+count and the fraction is carried from one restart to the next. */
+#define portCOMPENSATION_FRACTION_BITS	( 8UL )
+#define portCOMPENSATION_FRACTION_MASK	( ( 1UL << portCOMPENSATION_FRACTION_BITS ) - 1UL )
+
 /*-----------------------------------------------------------*/
 
 /* The following lines are to ensure vSoftwareInterruptEntry can be referenced,
@@ -77,6 +93,16 @@ static void prvYieldHandler( void );
  */
 void vSoftwareInterruptISR( void );
 
+/*
+ * Stop and restart the CMT0 count while its compare match value is changed.
+ * Starting the timer adds the counts missed while it was stopped to the count,
+ * unless doing so would take the count to the compare match value.
+ */
+#if( configUSE_TICKLESS_IDLE == 1 )
+	static void prvStopTickTimer( void );
+	static void prvStartTickTimer( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* This is accessed by the inline assembler functions so is file scope for
@@ -84,6 +110,69 @@ convenience. */
 extern void *pxCurrentTCB;
 extern void vTaskSwitchContext( void );
 
+#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+
+	/* Set to pdTRUE by portTASK_USES_ACCUMULATOR() for the task that is
+	running.  Saved to and restored from the task's stack on each context
+	switch, and only when it is not 0 are the accumulators saved and restored
+	with it.  The FPSW is saved and restored for every task. */
+	uint32_t ulPortTaskHasAccumulatorContext = pdFALSE;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	/* The position of the most significant set bit in each byte value, used by
+	portGET_HIGHEST_PRIORITY().  Entry 0 is never used, as the idle priority is
+	always ready. */
+	const uint8_t ucPortHighestSetBitInByte[ 256 ] =
+	{
+		0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+	};
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	/* The number of CMT0 counts in one tick period, read back from the compare
+	match value set by vApplicationSetupTimerInterrupt(). */
+	static uint32_t ulCountsPerTick = 0;
+
+	/* The maximum number of tick periods that can be suppressed is limited by
+	the 16-bit range of the CMT0 counter. */
+	static TickType_t xMaximumPossibleSuppressedTicks = 0;
+
+	/* The number of CMT0 counts missed each time the timer is stopped and
+	restarted, in 1/256ths of a count, and the fraction of a count missed but
+	not yet added back. */
+	static uint32_t ulStoppedTimerCompensation = 0;
+	static uint32_t ulStoppedTimerFraction = 0;
+
+	/* Set by the tick interrupt so vPortSuppressTicksAndSleep() knows whether
+	it was the tick interrupt that ended the sleep. */
+	static volatile BaseType_t xTickInterruptOccurred = pdFALSE;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -143,18 +232,31 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 	*pxTopOfStack = ( StackType_t ) pvParameters; /* R1 */
 	pxTopOfStack--;
 	*pxTopOfStack = portINITIAL_FPSW;
-	pxTopOfStack--;
-	*pxTopOfStack = 0x11111111; /* Accumulator 0. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x22222222; /* Accumulator 0. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x33333333; /* Accumulator 0. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x44444444; /* Accumulator 1. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x55555555; /* Accumulator 1. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x66666666; /* Accumulator 1. */
+
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+	{
+		/* A task has no accumulator context until it calls
+		portTASK_USES_ACCUMULATOR(), so only the flag that says so is
+		stacked. */
+		pxTopOfStack--;
+		*pxTopOfStack = pdFALSE;
+	}
+	#else
+	{
+		pxTopOfStack--;
+		*pxTopOfStack = 0x11111111; /* Accumulator 0. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x22222222; /* Accumulator 0. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x33333333; /* Accumulator 0. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x44444444; /* Accumulator 1. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x55555555; /* Accumulator 1. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x66666666; /* Accumulator 1. */
+	}
+	#endif /* configUSE_TASK_ACCUMULATOR_SUPPORT */
 
 	return pxTopOfStack;
 }
@@ -172,6 +274,21 @@ extern void vApplicationSetupTimerInterrupt( void );
 		use.  A demo application is provided to show a suitable example. */
 		vApplicationSetupTimerInterrupt();
 
+		#if( configUSE_TICKLESS_IDLE == 1 )
+		{
+		uint32_t ulCyclesPerCount;
+
+			/* Tick suppression reprograms the CMT0 compare match set up by the
+			application, so the tick must be generated by CMT0.  Read back the
+			tick period and the PCLK divisor the application chose rather than
+			assume them.  CKS selects PCLK/8, /32, /128 or /512. */
+			ulCountsPerTick = ( uint32_t ) CMT0.CMCOR + 1UL;
+			xMaximumPossibleSuppressedTicks = ( TickType_t ) ( portCMT_COUNTER_RANGE / ulCountsPerTick );
+			ulCyclesPerCount = ( configCPU_CLOCK_HZ / configPERIPHERAL_CLOCK_HZ ) * ( 8UL << ( 2UL * ( uint32_t ) CMT0.CMCR.BIT.CKS ) );
+			ulStoppedTimerCompensation = ( portSTOPPED_TIMER_CPU_CYCLES << portCOMPENSATION_FRACTION_BITS ) / ulCyclesPerCount;
+		}
+		#endif
+
 		/* Enable the software interrupt. */
 		_IEN( _ICU_SWINT ) = 1;
 
@@ -209,6 +326,18 @@ static void prvStartFirstTask( void )
 
 	/* Restore the registers from the stack of the task pointed to by
 	pxCurrentTCB. */
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+
+		/* Is there an accumulator context to restore?  If the restored
+		ulPortTaskHasAccumulatorContext is 0 then no. */
+		POP		R14
+		MOV.L	#_ulPortTaskHasAccumulatorContext, R15
+		MOV.L	R14, [ R15 ]
+		CMP		#0, R14
+		BEQ.B	?+
+
+	#endif
+
     POP		R15
     MVTACLO	R15, A0		/* Accumulator low 32 bits. */
     POP		R15
@@ -221,6 +350,10 @@ static void prvStartFirstTask( void )
     MVTACHI	R15, A1		/* Accumulator high 32 bits. */
     POP		R15
     MVTACGU	R15, A1		/* Accumulator guard. */
+
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+		?:
+	#endif
     POP		R15
     MVTC	R15,FPSW 	/* Floating point status word. */
     POPM	R1-R15 		/* R1 to R15 - R0 is not included as it is the SP. */
@@ -237,10 +370,29 @@ void vTickISR( void )
 	necessitates. */
 	set_ipl( configMAX_SYSCALL_INTERRUPT_PRIORITY );
 	{
+		/* Count the time spent here against the interrupt rather than the
+		task that was running, when configGENERATE_CPU_LOAD_STATS is 1. */
+		taskCPU_LOAD_ENTER_ISR();
+		taskISR_LATENCY_ENTER( tskISR_LATENCY_TICK_VECTOR );
+
+		#if( configUSE_TICKLESS_IDLE == 1 )
+		{
+			/* Let vPortSuppressTicksAndSleep() know the sleep, if any, was
+			ended by the tick.  The compare match value may have been set to
+			span several tick periods, and the count has just been cleared, so
+			put it back to one tick period. */
+			xTickInterruptOccurred = pdTRUE;
+			CMT0.CMCOR = ( uint16_t ) ( ulCountsPerTick - 1UL );
+		}
+		#endif
+
 		if( xTaskIncrementTick() != pdFALSE )
 		{
 			taskYIELD();
 		}
+
+		taskISR_LATENCY_EXIT();
+		taskCPU_LOAD_EXIT_ISR();
 	}
 	set_ipl( configKERNEL_INTERRUPT_PRIORITY );
 }
@@ -285,9 +437,23 @@ static void prvYieldHandler( void )
 	/* Save the rest of the general registers (R15 has been saved already). */
 	PUSHM	R1-R14
 
-	/* Save the FPSW and accumulators. */
+	/* Save the FPSW. */
 	MVFC	FPSW, R15
 	PUSH.L	R15
+
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+
+		/* Does the task have an accumulator context that needs saving?  If
+		ulPortTaskHasAccumulatorContext is 0 then no.  R14 has been saved
+		already so can hold the flag while R15 is used below. */
+		MOV.L	#_ulPortTaskHasAccumulatorContext, R14
+		MOV.L	[ R14 ], R14
+		CMP		#0, R14
+		BEQ.B	?+
+
+	#endif
+
+	/* Save the accumulators. */
 	MVFACGU	#0, A1, R15
 	PUSH.L	R15
 	MVFACHI	#0, A1, R15
@@ -301,6 +467,13 @@ static void prvYieldHandler( void )
 	MVFACLO	#0, A0, R15	; Low order word.
 	PUSH.L	R15
 
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+		?:
+
+		/* Save ulPortTaskHasAccumulatorContext itself. */
+		PUSH.L	R14
+	#endif
+
 	/* Save the stack pointer to the TCB. */
 	MOV.L	#_pxCurrentTCB, R15
 	MOV.L	[ R15 ], R15
@@ -310,9 +483,23 @@ static void prvYieldHandler( void )
 	structures are being accessed. */
 	MVTIPL	#configMAX_SYSCALL_INTERRUPT_PRIORITY
 
+	#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+		/* Time the switch against tskISR_LATENCY_YIELD_VECTOR, which is 1.
+		The context has been saved, so the registers the calls use are
+		free. */
+		MOV.L	#1, R1
+		BSR.A	_vTaskISRLatencyEnter
+
+	#endif
+
 	/* Select the next task to run. */
 	BSR.A	_vTaskSwitchContext
 
+	#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+		BSR.A	_vTaskISRLatencyExit
+	#endif
+
 	/* Reset the interrupt mask as no more data structure access is required. */
 	MVTIPL	#configKERNEL_INTERRUPT_PRIORITY
 
@@ -324,6 +511,18 @@ static void prvYieldHandler( void )
 
 	/* Restore the context of the new task.  The PSW (Program Status Word) and
 	PC will be popped by the RTE instruction. */
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+
+		/* Is there an accumulator context to restore?  If the restored
+		ulPortTaskHasAccumulatorContext is 0 then no. */
+		POP		R14
+		MOV.L	#_ulPortTaskHasAccumulatorContext, R15
+		MOV.L	R14, [ R15 ]
+		CMP		#0, R14
+		BEQ.B	?+
+
+	#endif
+
     POP		R15
     MVTACLO	R15, A0		/* Accumulator low 32 bits. */
     POP		R15
@@ -336,6 +535,10 @@ static void prvYieldHandler( void )
     MVTACHI	R15, A1		/* Accumulator high 32 bits. */
     POP		R15
     MVTACGU	R15, A1		/* Accumulator guard. */
+
+	#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+		?:
+	#endif
 	POP		R15
 	MVTC	R15,FPSW
 	POPM	R1-R15
@@ -345,6 +548,57 @@ static void prvYieldHandler( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+
+	void vPortTaskUsesAccumulator( void )
+	{
+		/* A task is registered as needing its accumulators saved by setting
+		ulPortTaskHasAccumulatorContext, which is saved as part of the task
+		context on the next switch. */
+		ulPortTaskHasAccumulatorContext = pdTRUE;
+	}
+
+#endif /* configUSE_TASK_ACCUMULATOR_SUPPORT */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	UBaseType_t uxPortSetInterruptMaskFromISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portRAW_SET_INTERRUPT_MASK_FROM_ISR();
+
+		/* Only time the period if the mask was raised by this call, rather
+		than already being at configMAX_SYSCALL_INTERRUPT_PRIORITY because of a
+		critical section, an outer mask, or an interrupt such as the tick that
+		runs at that priority. */
+		if( uxSavedInterruptStatus < ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
+		{
+			vTaskISRLatencyMask( pdTRUE );
+		}
+
+		return uxSavedInterruptStatus;
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vPortClearInterruptMaskFromISR( UBaseType_t uxSavedInterruptStatus )
+	{
+		if( uxSavedInterruptStatus < ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
+		{
+			vTaskISRLatencyUnmask();
+		}
+
+		portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
 void vPortEndScheduler( void )
 {
 	/* Not implemented in ports where there is nothing to return to.
@@ -356,5 +610,153 @@ void vPortEndScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE == 1 )
 
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulCurrentCount, ulCompleteTickPeriods;
+	TickType_t xModifiableIdleTime;
+	eSleepModeStatus eSleepAction;
+
+		/* Make sure the compare match value does not overflow the counter. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
+
+		/* Interrupts are disabled using the I bit, rather than the IPL, because
+		the WAIT instruction sets the I bit so the processor wakes on the next
+		interrupt of any priority. */
+		clrpsw_i();
+
+		/* If a context switch is pending, or a task is waiting for the scheduler
+		to be unsuspended, then abandon the low power entry. */
+		eSleepAction = eTaskConfirmSleepModeStatus();
+
+		if( eSleepAction == eAbortSleep )
+		{
+			setpsw_i();
+		}
+		else
+		{
+			prvStopTickTimer();
+
+			if( _IR( _CMT0_CMI0 ) != 0 )
+			{
+				/* The current tick period ended before the timer was stopped,
+				so the count now belongs to the next period.  Let the pending
+				tick interrupt execute instead of sleeping. */
+				prvStartTickTimer();
+				setpsw_i();
+			}
+			else
+			{
+				/* Move the compare match to the end of the tick period in which
+				the idle time ends.  The count is not cleared, so the time
+				already spent in the current tick period is included, and the
+				tick keeps its phase. */
+				CMT0.CMCOR = ( uint16_t ) ( ( ulCountsPerTick * ( uint32_t ) xExpectedIdleTime ) - 1UL );
+				xTickInterruptOccurred = pdFALSE;
+				prvStartTickTimer();
+
+				/* Allow the application to define some pre-sleep processing.
+				If the application sets xModifiableIdleTime to 0 then it has
+				performed its own sleep, so WAIT is not executed. */
+				xModifiableIdleTime = xExpectedIdleTime;
+				configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+				if( xModifiableIdleTime > 0 )
+				{
+					/* Sleep until an interrupt occurs.  WAIT sets the I bit,
+					so the interrupt that ends the sleep is serviced before
+					execution continues. */
+					wait();
+				}
+				else
+				{
+					setpsw_i();
+				}
+
+				configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+				/* Disable interrupts again while the tick count is
+				corrected. */
+				clrpsw_i();
+				prvStopTickTimer();
+				ulCurrentCount = ( uint32_t ) CMT0.CMCNT;
+
+				if( ( xTickInterruptOccurred != pdFALSE ) || ( _IR( _CMT0_CMI0 ) != 0 ) )
+				{
+					/* The compare match at the end of the idle time has
+					occurred, so the count is already in the next tick period.
+					The tick interrupt either executed while the processor was
+					awake or is pending, and either way its tick is held pending
+					by the kernel, so the tick count is stepped forward by one
+					less than the idle time. */
+					CMT0.CMCOR = ( uint16_t ) ( ulCountsPerTick - 1UL );
+					ulCompleteTickPeriods = ( uint32_t ) xExpectedIdleTime - 1UL;
+				}
+				else
+				{
+					/* Something other than the tick interrupt ended the sleep.
+					Count the tick periods that completed while the processor
+					slept, and generate the next tick interrupt at the end of
+					the tick period that is in progress.  The interrupt puts
+					the compare match value back to one tick period. */
+					ulCompleteTickPeriods = ulCurrentCount / ulCountsPerTick;
+					CMT0.CMCOR = ( uint16_t ) ( ( ( ulCompleteTickPeriods + 1UL ) * ulCountsPerTick ) - 1UL );
+				}
+
+				prvStartTickTimer();
+
+				/* Wind the tick forward by the number of tick periods that the
+				processor remained in a low power state. */
+				vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+
+				setpsw_i();
+			}
+		}
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	static void prvStopTickTimer( void )
+	{
+		CMT.CMSTR0.BIT.STR0 = 0;
+
+		/* Wait for the count to stop before reading it. */
+		while( CMT.CMSTR0.BIT.STR0 != 0 )
+		{
+			portNOP();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvStartTickTimer( void )
+	{
+	uint32_t ulCount;
+
+		/* Compensate for the time the timer was stopped in whole counts, and
+		keep the fraction for the next restart. */
+		ulStoppedTimerFraction += ulStoppedTimerCompensation;
+		ulCount = ( uint32_t ) CMT0.CMCNT + ( ulStoppedTimerFraction >> portCOMPENSATION_FRACTION_BITS );
+
+		/* Only as far as possible without skipping the compare match.  If the
+		counts cannot be added they are dropped rather than carried, as the
+		count is about to restart from 0. */
+		if( ulCount < ( uint32_t ) CMT0.CMCOR )
+		{
+			CMT0.CMCNT = ( uint16_t ) ulCount;
+		}
+
+		ulStoppedTimerFraction &= portCOMPENSATION_FRACTION_MASK;
+
+		CMT.CMSTR0.BIT.STR0 = 1;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
 
@@ -79,6 +79,43 @@ typedef unsigned long UBaseType_t;
 #define portTICK_PERIOD_MS				( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portNOP()						nop()
 
+/* Architecture specific optimisations. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* The RX has no count leading zeros instruction, so the most significant
+	non-zero byte of the ready priorities is found with at most two compares,
+	then looked up in a 256 entry table.  The time taken to select the next task
+	then does not depend on configMAX_PRIORITIES, or on how far apart the ready
+	priorities are. */
+	extern const uint8_t ucPortHighestSetBitInByte[ 256 ];
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#if( configMAX_PRIORITIES <= 8 )
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( UBaseType_t ) ucPortHighestSetBitInByte[ ( uxReadyPriorities ) ]
+	#else
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )																			\
+			uxTopPriority = ( ( uxReadyPriorities ) > 0xffffUL ) ?																						\
+				( ( ( uxReadyPriorities ) > 0xffffffUL ) ? ( 24UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 24 ] ) : ( 16UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 16 ] ) ) :	\
+				( ( ( uxReadyPriorities ) > 0xffUL ) ? ( 8UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 8 ] ) : ( UBaseType_t ) ucPortHighestSetBitInByte[ ( uxReadyPriorities ) ] )
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
 
 #pragma inline_asm vPortYield
 static void vPortYield( void )
@@ -98,6 +135,12 @@ static void vPortYield( void )
 #define portYIELD()	vPortYield()
 #define portYIELD_FROM_ISR( x )	if( x != pdFALSE ) portYIELD()
 
+/* The RX600 is a single core that executes in order, so a memory barrier only
+has to stop the compiler moving memory accesses across it.  The function is in
+port_asm.src so the compiler cannot inline it or see that it does nothing. */
+extern void vPortMemoryBarrier( void );
+#define portMEMORY_BARRIER() vPortMemoryBarrier()
+
 /* These macros should not be called directly, but through the
 taskENTER_CRITICAL() and taskEXIT_CRITICAL() macros.  An extra check is
 performed if configASSERT() is defined to ensure an assertion handler does not
@@ -125,8 +168,51 @@ extern void vTaskExitCritical( void );
 #define portEXIT_CRITICAL()		vTaskExitCritical()
 
 /* As this port allows interrupt nesting... */
-#define portSET_INTERRUPT_MASK_FROM_ISR() ( UBaseType_t ) get_ipl(); set_ipl( ( long ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
-#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus ) set_ipl( ( long ) uxSavedInterruptStatus )
+#define portRAW_SET_INTERRUPT_MASK_FROM_ISR() ( UBaseType_t ) get_ipl(); set_ipl( ( long ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
+#define portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus ) set_ipl( ( long ) uxSavedInterruptStatus )
+
+#if( defined( configGENERATE_ISR_LATENCY_STATS ) && ( configGENERATE_ISR_LATENCY_STATS == 1 ) )
+
+	/* The periods the FromISR macros raise the interrupt mask for are timed,
+	see uxTaskGetISRLatency(). */
+	extern UBaseType_t uxPortSetInterruptMaskFromISR( void );
+	extern void vPortClearInterruptMaskFromISR( UBaseType_t uxSavedInterruptStatus );
+	#define portSET_INTERRUPT_MASK_FROM_ISR() uxPortSetInterruptMaskFromISR()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus ) vPortClearInterruptMaskFromISR( uxSavedInterruptStatus )
+
+#else
+
+	#define portSET_INTERRUPT_MASK_FROM_ISR() portRAW_SET_INTERRUPT_MASK_FROM_ISR()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus ) portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus )
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#if configUSE_TICKLESS_IDLE == 1
+	#ifndef portSUPPRESS_TICKS_AND_SLEEP
+		extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+		#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+	#endif
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Only the tasks that use the MAC instructions need the two accumulators saved
+and restored on a context switch.  When configUSE_TASK_ACCUMULATOR_SUPPORT is 1
+a task says it does by calling portTASK_USES_ACCUMULATOR() before it uses them,
+and the switch to and from other tasks skips those six words.  The FPSW is
+saved and restored for every task, as the compiler uses it for any floating
+point operation.  When it is 2 the accumulators are saved for every task. */
+#ifndef configUSE_TASK_ACCUMULATOR_SUPPORT
+	#define configUSE_TASK_ACCUMULATOR_SUPPORT 2
+#endif
+
+#if( configUSE_TASK_ACCUMULATOR_SUPPORT == 1 )
+	void vPortTaskUsesAccumulator( void );
+	#define portTASK_USES_ACCUMULATOR() vPortTaskUsesAccumulator()
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -0,0 +1,1281 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix port.
+ *
+ * Each task is given its own host thread, but only the thread of the task in
+ * the Running state is ever allowed to execute - every other task thread is
+ * blocked on its own event.  A context switch signals the event of the task
+ * being switched in, then blocks the thread of the task being switched out.
+ *
+ * The tick interrupt is simulated by the SIGALRM signal generated by a host
+ * timer that expires once every tick period.  A tick is only processed once
+ * the simulator has been given a tick period of host CPU time since the last
+ * one, so a loaded host slows the simulated time down instead of leaving the
+ * tasks less time to run in each tick period - the demo tasks then see the
+ * same timing however many other processes share the host.  Builds with
+ * configUSE_TICKLESS_IDLE set to 1 sleep in the host while ticks are
+ * suppressed, so their tick follows the host clock instead.  Other peripheral interrupts are simulated by
+ * SIGUSR1, see vPortGenerateSimulatedInterrupt().  Simulated interrupts are
+ * disabled by blocking signals in the running thread, so interrupt handlers
+ * only ever execute on the thread of the Running state task, and never while
+ * that task is in a critical section.
+ *
+ * Note that the Running state task can be switched out by the tick handler at
+ * any point where signals are not blocked, so tasks must not call host library
+ * functions that take internal locks (printf(), malloc(), etc.) other than from
+ * within a critical section.
+ *
+ * If configNUMBER_OF_CORES is greater than 1 the thread of the task running on
+ * each simulated core executes, so that many threads run at once.  The core a
+ * thread is running on is handed to it, in its Thread_t structure, when it is
+ * switched in.  Cores ask each other to yield with the SIGUSR2 signal, sent to
+ * the thread of the task to be switched out, and the kernel locks are spinlocks
+ * owned by a core.  The tick and other simulated interrupts are taken by
+ * whichever core has interrupts enabled when the signal is generated.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+	#include <x86intrin.h>
+#endif
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Simulator utilities. */
+#include "utils/wait_for_event.h"
+
+/*-----------------------------------------------------------*/
+
+/* The size of the host stack allocated to each task thread.  The stack
+allocated by the kernel is not used by the thread, other than to hold the
+Thread_t structure below, as the host ABI needs far more stack than the
+target. */
+#ifndef portSIM_THREAD_STACK_SIZE
+	#define portSIM_THREAD_STACK_SIZE	( 256 * 1024 )
+#endif
+
+/* The signals used to generate the simulated tick interrupt, and all the
+other simulated interrupts. */
+#define portTICK_SIGNAL				SIGALRM
+#define portINTERRUPT_SIGNAL		SIGUSR1
+
+/* The signal used to make another core yield. */
+#define portYIELD_SIGNAL			SIGUSR2
+
+/* The number of simulated interrupts, other than the tick, that can be
+installed with vPortSetInterruptHandler(). */
+#define portMAX_INTERRUPTS			( 32UL )
+
+/* The length of a tick period in host nanoseconds. */
+#define portTICK_PERIOD_NS			( 1000000000ULL / ( uint64_t ) configTICK_RATE_HZ )
+
+/* The maximum number of ticks vPortSuppressTicksAndSleep() suppresses in one
+go.  Defaults to the limit the 16-bit CMT0 counter imposes on the RX65N target
+when the CMT is clocked at PCLK/32, so the simulator sleeps in the same sized
+steps as the board. */
+#ifndef portMAX_SUPPRESSED_TICKS
+	#define portMAX_SUPPRESSED_TICKS	( ( TickType_t ) 34 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct THREAD
+{
+	pthread_t pthread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	struct event *ev;
+	#if( configNUMBER_OF_CORES > 1 )
+		volatile BaseType_t xCore;	/* Set before the thread is switched in. */
+	#endif
+} Thread_t;
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* A recursive spinlock, owned by a core. */
+	typedef struct PORT_LOCK
+	{
+		volatile BaseType_t xOwner;
+		UBaseType_t uxCount;
+	} PortLock_t;
+
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * The Thread_t structure of each task is stored at the top of the stack
+ * allocated to the task by the kernel.  The kernel never updates
+ * pxTopOfStack in this port, so the structure can always be located from the
+ * first member of the TCB.
+ */
+static Thread_t *prvGetThreadFromTask( void *pvTask );
+
+/*
+ * Entry point of every task thread.  The thread blocks until it is first
+ * selected to run by the scheduler, then calls the task function.
+ */
+static void *prvWaitForStart( void *pvParams );
+
+/*
+ * Switch from the thread of pxThreadToSuspend to the thread of
+ * pxThreadToResume.  Must be called with simulated interrupts disabled.
+ */
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+
+/*
+ * Simulated tick interrupt handler.
+ */
+static void prvTickHandler( int iSignal );
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Handler for the signal another core sends to make this core yield.
+	 */
+	static void prvYieldHandler( int iSignal );
+
+	/*
+	 * Take and release a PortLock_t on behalf of the calling core, spinning
+	 * until it is free.  Must be called with simulated interrupts disabled.
+	 */
+	static void prvGetLock( PortLock_t *pxLock );
+	static void prvReleaseLock( PortLock_t *pxLock );
+
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Handler for all the other simulated interrupts.  Calls the handler installed
+ * for each interrupt that is pending.
+ */
+static void prvInterruptHandler( int iSignal );
+
+/*
+ * Called at the end of each simulated interrupt handler to switch to the task
+ * selected by vTaskSwitchContext() if xSwitchRequired is pdTRUE, or a switch
+ * was requested by a FromISR function within the handler.
+ */
+static void prvEndInterrupt( Thread_t *pxThreadToSuspend, BaseType_t xSwitchRequired );
+
+/*
+ * Call vTaskSwitchContext(), recording the host cycles it takes in the
+ * statistics returned by vPortGetTickStats().  Must be called with simulated
+ * interrupts disabled.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Create the host timer that generates the tick interrupt, and start it.
+ */
+static void prvSetupTimerInterrupt( void );
+
+/*
+ * Program the tick timer to first expire at the absolute host time
+ * ullFirstTickTime, then once every tick period.
+ */
+static void prvSetTickTimer( uint64_t ullFirstTickTime );
+
+/*
+ * The host monotonic clock, in nanoseconds.
+ */
+static uint64_t prvGetHostTime( void );
+
+/*
+ * The clock the tick follows, in nanoseconds - the host CPU time used by the
+ * simulator per simulated core, or the host clock if configUSE_TICKLESS_IDLE
+ * is 1.
+ */
+static uint64_t prvGetTickTime( void );
+
+/*
+ * Called once before the first task thread is created to initialise the
+ * signal set used to mask simulated interrupts.
+ */
+static void prvSetupSignals( void );
+
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES == 1 )
+
+	/* This is accessed by the tick handler and yield functions, so is file
+	scope for convenience - in the same way the RX ports access it from asm
+	code. */
+	extern void *pxCurrentTCB;
+
+	/* The critical nesting count of the Running state task.  The value is
+	saved on the stack of a thread that is switched out, and restored when the
+	thread is switched back in. */
+	static volatile UBaseType_t uxCriticalNesting = 0;
+
+	/* Set while the tick handler is executing so a yield requested from within
+	the handler (from a tick hook for example) is deferred until the handler
+	exits, as happens on real hardware. */
+	static volatile BaseType_t xInsideInterrupt = pdFALSE;
+	static volatile BaseType_t xPendingSwitchFromISR = pdFALSE;
+
+#else
+
+	/* The task running on each core, and so the thread executing for each
+	core.  pxCurrentTCB refers to the core of the calling thread. */
+	extern void * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+	#define pxCurrentTCB pxCurrentTCBs[ xPortCoreID ]
+
+	/* The core the calling thread is running on, and the critical nesting
+	count of that core.  A thread is only switched out when its nesting count
+	is zero, so the count does not need to be saved with the thread. */
+	__thread BaseType_t xPortCoreID = 0;
+	__thread UBaseType_t uxPortCriticalNesting = 0;
+	#define uxCriticalNesting uxPortCriticalNesting
+
+	/* As the single core variables, but for the interrupt executing on the
+	core of the calling thread. */
+	static __thread BaseType_t xInsideInterrupt = pdFALSE;
+	static __thread BaseType_t xPendingSwitchFromISR = pdFALSE;
+
+	/* The locks taken by the kernel, see portGET_TASK_LOCK() and
+	portGET_ISR_LOCK(). */
+	static PortLock_t xTaskLock = { -1, 0 };
+	static PortLock_t xISRLock = { -1, 0 };
+
+#endif /* configNUMBER_OF_CORES */
+
+/* The signals that are blocked to disable simulated interrupts. */
+static sigset_t xAllSignals;
+static pthread_once_t xSignalsSetUp = PTHREAD_ONCE_INIT;
+
+/* Signalled by vPortEndScheduler() to return the thread that called
+xPortStartScheduler(). */
+static struct event *pxSchedulerEndEvent = NULL;
+
+/* The host timer that generates the tick, and the prvGetTickTime() time of the
+next tick boundary that has not been processed or counted as lost.  Tick
+boundaries fall at fixed intervals, equivalent to the compare match of a free
+running hardware timer. */
+static timer_t xTickTimer;
+static uint64_t ullNextTickTime = 0;
+
+/* Set while vPortSuppressTicksAndSleep() is sleeping.  The tick handler then
+processes only one tick, as the tick interrupt would on the target, and leaves
+the tick periods that elapsed while asleep to be stepped over. */
+static volatile BaseType_t xSuppressingTicks = pdFALSE;
+
+/* The handlers installed for the simulated interrupts, and a bit for each
+interrupt that has been generated but not yet handled. */
+static uint32_t ( *pvInterruptHandlers[ portMAX_INTERRUPTS ] )( void ) = { NULL };
+static volatile uint32_t ulPendingInterrupts = 0;
+
+/* Tick processing and task selection statistics collected for the benchmark
+harness.  Only written with simulated interrupts disabled. */
+static PortTickStats_t xTickStats = { 0 };
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	/* The position of the most significant set bit in each byte value, used by
+	portGET_HIGHEST_PRIORITY() as in the RX600v2 port. */
+	const uint8_t ucPortHighestSetBitInByte[ 256 ] =
+	{
+		0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+		7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+	};
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xThreadAttributes;
+UBaseType_t uxSavedInterruptStatus;
+int iRet;
+
+	( void ) pthread_once( &xSignalsSetUp, prvSetupSignals );
+
+	/* Store the thread structure at the top of the stack, and return the
+	address below it as the top of stack so the structure is never
+	overwritten. */
+	pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->ev = event_create();
+	configASSERT( pxThread->ev != NULL );
+
+	pthread_attr_init( &xThreadAttributes );
+	pthread_attr_setstacksize( &xThreadAttributes, portSIM_THREAD_STACK_SIZE );
+
+	/* The thread inherits the signal mask of its creator, so create it with
+	simulated interrupts disabled - prvWaitForStart() enables them when the
+	task first runs.  This also prevents the creating task being switched out
+	while it holds host library locks inside pthread_create(). */
+	uxSavedInterruptStatus = uxPortSetInterruptMask();
+	{
+		iRet = pthread_create( &pxThread->pthread, &xThreadAttributes, prvWaitForStart, pxThread );
+	}
+	vPortClearInterruptMask( uxSavedInterruptStatus );
+
+	pthread_attr_destroy( &xThreadAttributes );
+
+	if( iRet != 0 )
+	{
+		fprintf( stderr, "pthread_create() failed: %s\n", strerror( iRet ) );
+		configASSERT( iRet == 0 );
+	}
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	/* The calling thread never runs a task, so keeps simulated interrupts
+	masked for good - the tick must only ever be taken by a task thread. */
+	( void ) pthread_once( &xSignalsSetUp, prvSetupSignals );
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+
+	pxSchedulerEndEvent = event_create();
+	configASSERT( pxSchedulerEndEvent != NULL );
+
+	/* Start the timer that generates the tick interrupt. */
+	prvSetupTimerInterrupt();
+
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		/* Start the first task. */
+		event_signal( prvGetThreadFromTask( pxCurrentTCB )->ev );
+	}
+	#else
+	{
+	BaseType_t xCoreID;
+	Thread_t *pxThread;
+
+		/* Start the idle task the kernel gave each core. */
+		for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+		{
+			pxThread = prvGetThreadFromTask( pxCurrentTCBs[ xCoreID ] );
+			pxThread->xCore = xCoreID;
+			event_signal( pxThread->ev );
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	/* Wait until vPortEndScheduler() is called. */
+	event_wait( pxSchedulerEndEvent );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* Stop the tick. */
+	( void ) timer_delete( xTickTimer );
+
+	/* Return the thread that started the scheduler from xPortStartScheduler(),
+	then block this task thread for good. */
+	vPortDisableInterrupts();
+	event_signal( pxSchedulerEndEvent );
+	event_wait( prvGetThreadFromTask( pxCurrentTCB )->ev );
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES == 1 )
+
+	void vPortYield( void )
+	{
+	Thread_t *pxThreadToSuspend, *pxThreadToResume;
+
+		vPortEnterCritical();
+		{
+			pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+			prvSwitchContext();
+			pxThreadToResume = prvGetThreadFromTask( pxCurrentTCB );
+
+			#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+			{
+				/* A task can yield from within a critical section, which on
+				the target only switches once the critical section is left.
+				The time the task spends switched out is therefore not counted
+				as masked, and the masked period of the task switched in carries
+				on from here. */
+				if( pxThreadToResume != pxThreadToSuspend )
+				{
+					vTaskISRLatencyUnmask();
+				}
+			}
+			#endif
+
+			prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+
+			#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+			{
+				if( pxThreadToResume != pxThreadToSuspend )
+				{
+					vTaskISRLatencyMask( pdFALSE );
+				}
+			}
+			#endif
+		}
+		vPortExitCritical();
+	}
+
+#else
+
+	void vPortYield( void )
+	{
+	Thread_t *pxThreadToSuspend, *pxThreadToResume;
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( uxCriticalNesting != 0 )
+		{
+			/* The kernel switches when the critical section is left. */
+			vTaskYieldWithinAPI();
+		}
+		else
+		{
+			/* vTaskSwitchContext() takes the kernel locks itself, and must be
+			called outside of a critical section. */
+			uxSavedInterruptStatus = uxPortSetInterruptMask();
+			{
+				pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+				prvSwitchContext();
+				pxThreadToResume = prvGetThreadFromTask( pxCurrentTCB );
+
+				prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+			}
+			vPortClearInterruptMask( uxSavedInterruptStatus );
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* Called by the kernel with the locks held, so the task running on the
+		core cannot change.  The signal is taken as soon as the thread has
+		interrupts enabled - possibly after it has been switched out and in
+		again, in which case it causes one unnecessary yield. */
+		( void ) pthread_kill( prvGetThreadFromTask( pxCurrentTCBs[ xCoreID ] )->pthread, portYIELD_SIGNAL );
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vPortWaitForInterrupt( void )
+	{
+	sigset_t xWaitMask;
+
+		/* The equivalent of the WAIT instruction, for the idle task of a core
+		that has nothing to do.  The host has fewer processors than there are
+		simulated cores, so a thread that spins delays the threads that have
+		work to do.  Returns once a simulated interrupt, the tick or a yield
+		request from another core, has been taken - straight away if one is
+		already pending. */
+		vPortDisableInterrupts();
+		sigemptyset( &xWaitMask );
+		( void ) sigsuspend( &xWaitMask );
+		vPortEnableInterrupts();
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		/* The switch is performed when the tick handler exits. */
+		xPendingSwitchFromISR = pdTRUE;
+	}
+	else
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES == 1 )
+
+	void vPortEnterCritical( void )
+	{
+		if( uxCriticalNesting == 0 )
+		{
+			vPortDisableInterrupts();
+
+			#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+			{
+				vTaskISRLatencyMask( pdFALSE );
+			}
+			#endif
+		}
+
+		uxCriticalNesting++;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES == 1 )
+
+	void vPortExitCritical( void )
+	{
+		configASSERT( uxCriticalNesting > 0 );
+		uxCriticalNesting--;
+
+		/* Only re-enable simulated interrupts when the outermost critical
+		section is left. */
+		if( uxCriticalNesting == 0 )
+		{
+			#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+			{
+				vTaskISRLatencyUnmask();
+			}
+			#endif
+
+			vPortEnableInterrupts();
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vPortGetTaskLock( void )
+	{
+		prvGetLock( &xTaskLock );
+	}
+
+	void vPortReleaseTaskLock( void )
+	{
+		prvReleaseLock( &xTaskLock );
+	}
+
+	void vPortGetISRLock( void )
+	{
+		prvGetLock( &xISRLock );
+	}
+
+	void vPortReleaseISRLock( void )
+	{
+		prvReleaseLock( &xISRLock );
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+sigset_t xPrevious;
+
+	/* Return pdTRUE if simulated interrupts were already masked, which is
+	always the case when called from the tick handler. */
+	( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPrevious );
+	return ( UBaseType_t ) ( sigismember( &xPrevious, portTICK_SIGNAL ) == 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus )
+{
+	if( uxSavedInterruptStatus == ( UBaseType_t ) pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	UBaseType_t uxPortSetInterruptMaskFromISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Only the outermost mask, which blocks the simulated interrupts, is
+		timed. */
+		uxSavedInterruptStatus = uxPortSetInterruptMask();
+
+		if( uxSavedInterruptStatus == ( UBaseType_t ) pdFALSE )
+		{
+			vTaskISRLatencyMask( pdTRUE );
+		}
+
+		return uxSavedInterruptStatus;
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vPortClearInterruptMaskFromISR( UBaseType_t uxSavedInterruptStatus )
+	{
+		if( uxSavedInterruptStatus == ( UBaseType_t ) pdFALSE )
+		{
+			vTaskISRLatencyUnmask();
+		}
+
+		vPortClearInterruptMask( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	sigset_t xWaitMask;
+	uint64_t ullSleepStartTickTime, ullNow, ullElapsedTicks, ullProcessedTicks;
+	TickType_t xModifiableIdleTime;
+
+		if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+		{
+			xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+		}
+
+		vPortDisableInterrupts();
+
+		/* If a context switch is pending, or a task is waiting for the
+		scheduler to be unsuspended, then abandon the low power entry. */
+		if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+		{
+			vPortEnableInterrupts();
+		}
+		else
+		{
+			/* Move the next tick interrupt to the end of the tick period in
+			which the idle time ends.  The timer is programmed in absolute time,
+			so the time already spent in the current tick period is included
+			and the tick keeps its phase - as the RX600v2 port moves the CMT0
+			compare match without clearing the count. */
+			ullSleepStartTickTime = ullNextTickTime;
+			prvSetTickTimer( ullSleepStartTickTime + ( ( uint64_t ) ( xExpectedIdleTime - 1 ) * portTICK_PERIOD_NS ) );
+			xSuppressingTicks = pdTRUE;
+
+			xModifiableIdleTime = xExpectedIdleTime;
+			configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+			if( xModifiableIdleTime > 0 )
+			{
+				/* Wait for any simulated interrupt.  sigsuspend() returns
+				after the handler has executed, with interrupts disabled
+				again, as the WAIT instruction would on the target. */
+				sigemptyset( &xWaitMask );
+				( void ) sigsuspend( &xWaitMask );
+			}
+
+			configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+			xSuppressingTicks = pdFALSE;
+
+			/* Count the tick periods that have elapsed since the sleep
+			started, less the one (if any) already processed by the tick
+			handler - the kernel holds that tick pending until the scheduler
+			is unsuspended. */
+			ullNow = prvGetHostTime();
+			ullElapsedTicks = 0;
+			if( ullNow >= ullSleepStartTickTime )
+			{
+				ullElapsedTicks = ( ( ullNow - ullSleepStartTickTime ) / portTICK_PERIOD_NS ) + 1ULL;
+			}
+			ullProcessedTicks = ( ullNextTickTime - ullSleepStartTickTime ) / portTICK_PERIOD_NS;
+			ullElapsedTicks -= ullProcessedTicks;
+
+			/* Step over the elapsed periods, but never past the tick at which
+			a task unblocks.  Any periods beyond that are left for the tick
+			handler to process as normal ticks. */
+			if( ( ullElapsedTicks + ullProcessedTicks ) > ( uint64_t ) ( xExpectedIdleTime - 1 ) )
+			{
+				if( ullProcessedTicks < ( uint64_t ) ( xExpectedIdleTime - 1 ) )
+				{
+					ullElapsedTicks = ( uint64_t ) ( xExpectedIdleTime - 1 ) - ullProcessedTicks;
+				}
+				else
+				{
+					ullElapsedTicks = 0;
+				}
+			}
+
+			ullNextTickTime += ullElapsedTicks * portTICK_PERIOD_NS;
+
+			/* Generate the next tick interrupt at the end of the tick period
+			in progress, or straight away if periods were left unprocessed. */
+			prvSetTickTimer( ullNextTickTime );
+
+			xTickStats.ullSleepCount++;
+			xTickStats.ullSuppressedTickCount += ullElapsedTicks;
+
+			/* Wind the tick forward by the number of tick periods that were
+			spent asleep. */
+			vTaskStepTick( ( TickType_t ) ullElapsedTicks );
+			vPortEnableInterrupts();
+		}
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	portENTER_CRITICAL();
+	{
+		pvInterruptHandlers[ ulInterruptNumber ] = pvHandler;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( ulInterruptNumber < portMAX_INTERRUPTS );
+
+	/* Latch the interrupt, then raise the signal.  The signal is delivered to
+	whichever task thread next has interrupts enabled, so this can be called
+	from host threads that are not known to the kernel, as a peripheral would
+	assert an interrupt line. */
+	( void ) __atomic_fetch_or( &ulPendingInterrupts, 1UL << ulInterruptNumber, __ATOMIC_SEQ_CST );
+	( void ) kill( getpid(), portINTERRUPT_SIGNAL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+	/* The task is not the Running state task, so its thread is blocked on its
+	event and can be cancelled safely.  The thread must be joined before the
+	kernel frees the stack that holds its Thread_t structure. */
+	configASSERT( pxThread->pthread != pthread_self() );
+	( void ) pthread_cancel( pxThread->pthread );
+	( void ) pthread_join( pxThread->pthread, NULL );
+	event_delete( pxThread->ev );
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetHostCycles( void )
+{
+	#if defined( __x86_64__ ) || defined( __i386__ )
+	{
+		return ( uint64_t ) __rdtsc();
+	}
+	#else
+	{
+	struct timespec xNow;
+
+		( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+		return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTickStats( PortTickStats_t *pxStats )
+{
+	portENTER_CRITICAL();
+	{
+		*pxStats = xTickStats;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortResetTickStats( void )
+{
+	portENTER_CRITICAL();
+	{
+		memset( &xTickStats, 0, sizeof( xTickStats ) );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( void *pvTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) pvTask;
+
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	event_wait( pxThread->ev );
+
+	/* Selected to run for the first time.  Tasks start with interrupts
+	enabled and no critical nesting. */
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		xPortCoreID = pxThread->xCore;
+	}
+	#endif
+	uxCriticalNesting = 0;
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* Tasks must not return. */
+	configASSERT( pxThread == NULL );
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+
+	if( pxThreadToSuspend != pxThreadToResume )
+	{
+		/* The critical nesting count belongs to the task being switched
+		out, so save it on this thread's stack until the task runs again. */
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			/* The task being switched out might already have been selected by
+			another core, in which case its event is already signalled and the
+			thread carries on running as that core. */
+			pxThreadToResume->xCore = xPortCoreID;
+			event_signal( pxThreadToResume->ev );
+			event_wait( pxThreadToSuspend->ev );
+			xPortCoreID = pxThreadToSuspend->xCore;
+		}
+		#else
+		{
+			event_signal( pxThreadToResume->ev );
+			event_wait( pxThreadToSuspend->ev );
+		}
+		#endif /* configNUMBER_OF_CORES */
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+BaseType_t xSwitchRequired = pdFALSE;
+uint64_t ullNow, ullLate, ullStart, ullCycles;
+UBaseType_t uxSavedInterruptStatus;
+
+	( void ) iSignal;
+
+	/* Signals are blocked while the handler executes, which is equivalent to
+	the tick running at configMAX_SYSCALL_INTERRUPT_PRIORITY on the target.
+	On a multi-core build the handler also holds the ISR lock, as the tick is
+	processed for all the cores. */
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		uxCriticalNesting++;
+	}
+	#endif
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xInsideInterrupt = pdTRUE;
+	taskCPU_LOAD_ENTER_ISR();
+	taskISR_LATENCY_ENTER( tskISR_LATENCY_TICK_VECTOR );
+
+	pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+	xTickStats.ullTickInterruptCount++;
+
+	/* One tick is processed per interrupt, as on the target, where a compare
+	match that occurs while the tick interrupt is still pending is lost.  Tick
+	boundaries the host delayed the signal beyond are counted rather than
+	processed, so the demo tasks never see a burst of ticks they had no chance
+	to run between.  While ticks are suppressed the tick periods that elapsed
+	are stepped over by vPortSuppressTicksAndSleep() instead. */
+	ullNow = prvGetTickTime();
+
+	if( ullNow >= ullNextTickTime )
+	{
+		ullLate = ( ullNow - ullNextTickTime ) / portTICK_PERIOD_NS;
+
+		if( xSuppressingTicks != pdFALSE )
+		{
+			ullLate = 0;
+		}
+
+		ullNextTickTime += ( ullLate + 1ULL ) * portTICK_PERIOD_NS;
+		xTickStats.ullLostTickCount += ullLate;
+
+		ullStart = ullPortGetHostCycles();
+		xSwitchRequired = xTaskIncrementTick();
+		ullCycles = ullPortGetHostCycles() - ullStart;
+
+		xTickStats.ullTickCount++;
+		xTickStats.ullTickCycles += ullCycles;
+		if( ullCycles > xTickStats.ullMaxTickCycles )
+		{
+			xTickStats.ullMaxTickCycles = ullCycles;
+		}
+	}
+
+	xInsideInterrupt = pdFALSE;
+
+	if( ( xSwitchRequired != pdFALSE ) || ( xPendingSwitchFromISR != pdFALSE ) )
+	{
+		xTickStats.ullTickSwitchCount++;
+	}
+
+	/* The time spent switching to the next task is counted against the task,
+	and against the yield vector. */
+	taskISR_LATENCY_EXIT();
+	taskCPU_LOAD_EXIT_ISR();
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	prvEndInterrupt( pxThreadToSuspend, xSwitchRequired );
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		uxCriticalNesting--;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+BaseType_t xSwitchRequired = pdFALSE;
+uint32_t ulPending, ulInterruptNumber;
+UBaseType_t uxSavedInterruptStatus;
+
+	( void ) iSignal;
+
+	/* On a multi-core build the handlers installed for the simulated
+	interrupts are serialised by the ISR lock, as they would be by a single
+	interrupt controller. */
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		uxCriticalNesting++;
+	}
+	#endif
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	xInsideInterrupt = pdTRUE;
+	taskCPU_LOAD_ENTER_ISR();
+
+	pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+
+	/* Several interrupts can be latched by a single signal. */
+	ulPending = __atomic_exchange_n( &ulPendingInterrupts, 0UL, __ATOMIC_SEQ_CST );
+
+	for( ulInterruptNumber = 0; ulInterruptNumber < portMAX_INTERRUPTS; ulInterruptNumber++ )
+	{
+		if( ( ( ulPending & ( 1UL << ulInterruptNumber ) ) != 0UL ) && ( pvInterruptHandlers[ ulInterruptNumber ] != NULL ) )
+		{
+			if( pvInterruptHandlers[ ulInterruptNumber ]() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+		}
+	}
+
+	xInsideInterrupt = pdFALSE;
+
+	taskCPU_LOAD_EXIT_ISR();
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	prvEndInterrupt( pxThreadToSuspend, xSwitchRequired );
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		uxCriticalNesting--;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvYieldHandler( int iSignal )
+	{
+		( void ) iSignal;
+
+		/* The core that sent the signal has already marked the running task
+		as scheduled to yield. */
+		prvEndInterrupt( prvGetThreadFromTask( pxCurrentTCB ), pdTRUE );
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+uint64_t ullStart, ullCycles;
+
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		/* Switching context is the work of the yield interrupt on the
+		target. */
+		taskISR_LATENCY_ENTER( tskISR_LATENCY_YIELD_VECTOR );
+		ullStart = ullPortGetHostCycles();
+		vTaskSwitchContext();
+		ullCycles = ullPortGetHostCycles() - ullStart;
+		taskISR_LATENCY_EXIT();
+
+		xTickStats.ullSwitchCount++;
+		xTickStats.ullSwitchCycles += ullCycles;
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		ullStart = ullPortGetHostCycles();
+		vTaskSwitchContext( xPortCoreID );
+		ullCycles = ullPortGetHostCycles() - ullStart;
+
+		/* The statistics are shared by all the cores. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			xTickStats.ullSwitchCount++;
+			xTickStats.ullSwitchCycles += ullCycles;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndInterrupt( Thread_t *pxThreadToSuspend, BaseType_t xSwitchRequired )
+{
+Thread_t *pxThreadToResume;
+
+	if( ( xSwitchRequired != pdFALSE ) || ( xPendingSwitchFromISR != pdFALSE ) )
+	{
+		xPendingSwitchFromISR = pdFALSE;
+
+		prvSwitchContext();
+		pxThreadToResume = prvGetThreadFromTask( pxCurrentTCB );
+		prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct sigevent xEvent;
+
+	memset( &xEvent, 0, sizeof( xEvent ) );
+	xEvent.sigev_notify = SIGEV_SIGNAL;
+	xEvent.sigev_signo = portTICK_SIGNAL;
+
+	if( timer_create( CLOCK_MONOTONIC, &xEvent, &xTickTimer ) != 0 )
+	{
+		fprintf( stderr, "timer_create() failed: %s\n", strerror( errno ) );
+		configASSERT( pdFALSE );
+	}
+
+	ullNextTickTime = prvGetTickTime() + portTICK_PERIOD_NS;
+	prvSetTickTimer( prvGetHostTime() + portTICK_PERIOD_NS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetTickTimer( uint64_t ullFirstTickTime )
+{
+struct itimerspec xTimer;
+
+	xTimer.it_value.tv_sec = ( time_t ) ( ullFirstTickTime / 1000000000ULL );
+	xTimer.it_value.tv_nsec = ( long ) ( ullFirstTickTime % 1000000000ULL );
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_nsec = ( long ) portTICK_PERIOD_NS;
+
+	/* A time that has already passed makes the timer expire immediately. */
+	if( timer_settime( xTickTimer, TIMER_ABSTIME, &xTimer, NULL ) != 0 )
+	{
+		fprintf( stderr, "timer_settime() failed: %s\n", strerror( errno ) );
+		configASSERT( pdFALSE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetHostTime( void )
+{
+struct timespec xNow;
+
+	( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTickTime( void )
+{
+	#if( configUSE_TICKLESS_IDLE == 0 )
+	{
+	struct timespec xNow;
+
+		/* The idle tasks never sleep in the host, so each simulated core uses
+		host CPU time at the rate of the host clock when the host is not
+		loaded, and more slowly when it is.  The time the tasks wait for the
+		host to switch their threads is not counted either. */
+		( void ) clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xNow );
+		return ( ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec ) / ( uint64_t ) configNUMBER_OF_CORES;
+	}
+	#else
+	{
+		return prvGetHostTime();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignals( void )
+{
+struct sigaction xTick, xInterrupt;
+#if( configNUMBER_OF_CORES > 1 )
+	struct sigaction xYield;
+#endif
+
+	sigfillset( &xAllSignals );
+
+	/* Leave SIGINT unblocked so the simulator can always be stopped, and
+	broken into by a debugger. */
+	sigdelset( &xAllSignals, SIGINT );
+
+	memset( &xTick, 0, sizeof( xTick ) );
+	xTick.sa_handler = prvTickHandler;
+	sigfillset( &xTick.sa_mask );
+
+	memset( &xInterrupt, 0, sizeof( xInterrupt ) );
+	xInterrupt.sa_handler = prvInterruptHandler;
+	sigfillset( &xInterrupt.sa_mask );
+
+	if( ( sigaction( portTICK_SIGNAL, &xTick, NULL ) != 0 ) || ( sigaction( portINTERRUPT_SIGNAL, &xInterrupt, NULL ) != 0 ) )
+	{
+		fprintf( stderr, "sigaction() failed: %s\n", strerror( errno ) );
+		configASSERT( pdFALSE );
+	}
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		memset( &xYield, 0, sizeof( xYield ) );
+		xYield.sa_handler = prvYieldHandler;
+		sigfillset( &xYield.sa_mask );
+
+		if( sigaction( portYIELD_SIGNAL, &xYield, NULL ) != 0 )
+		{
+			fprintf( stderr, "sigaction() failed: %s\n", strerror( errno ) );
+			configASSERT( pdFALSE );
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvGetLock( PortLock_t *pxLock )
+	{
+	BaseType_t xFree;
+
+		if( pxLock->xOwner == xPortCoreID )
+		{
+			/* Already held by this core. */
+			pxLock->uxCount++;
+		}
+		else
+		{
+			for( ;; )
+			{
+				xFree = -1;
+
+				if( __atomic_compare_exchange_n( &( pxLock->xOwner ), &xFree, xPortCoreID, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+				{
+					break;
+				}
+
+				/* The host might have fewer CPUs than there are simulated
+				cores, in which case the owner has to be given the chance to
+				run. */
+				( void ) sched_yield();
+			}
+
+			pxLock->uxCount = 1;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseLock( PortLock_t *pxLock )
+	{
+		configASSERT( ( pxLock->xOwner == xPortCoreID ) && ( pxLock->uxCount > 0 ) );
+		pxLock->uxCount--;
+
+		if( pxLock->uxCount == 0 )
+		{
+			__atomic_store_n( &( pxLock->xOwner ), -1, __ATOMIC_RELEASE );
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,262 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE size_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+/* The tick type is kept at the width used by the RX600v2 port so wrap around
+behaves the same way in the simulator as it does on the target. */
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32 or 64-bit host, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portNOP()					__asm volatile( "nop" )
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations.  The multi-core scheduler always
+uses the generic task selection. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#if( defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 ) )
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+	#else
+		#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+	#endif
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Uses the same sequence as the RX600v2 port, so the simulator selects
+	tasks, and measures the cost of doing so, the way the target does.  The most
+	significant non-zero byte of the ready priorities is found with at most two
+	compares, then looked up in a 256 entry table. */
+	extern const uint8_t ucPortHighestSetBitInByte[ 256 ];
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#if( configMAX_PRIORITIES <= 8 )
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( UBaseType_t ) ucPortHighestSetBitInByte[ ( uxReadyPriorities ) ]
+	#else
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )																			\
+			uxTopPriority = ( ( uxReadyPriorities ) > 0xffffUL ) ?																						\
+				( ( ( uxReadyPriorities ) > 0xffffffUL ) ? ( 24UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 24 ] ) : ( 16UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 16 ] ) ) :	\
+				( ( ( uxReadyPriorities ) > 0xffUL ) ? ( 8UL + ucPortHighestSetBitInByte[ ( uxReadyPriorities ) >> 8 ] ) : ( UBaseType_t ) ucPortHighestSetBitInByte[ ( uxReadyPriorities ) ] )
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portYIELD()									vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( ( xSwitchRequired ) != pdFALSE ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Simulated interrupts are host signals, so
+masking interrupts is implemented by blocking the tick signal in the running
+thread.  The simulator has a single interrupt priority, so the FromISR mask
+macros simply enter and leave a nested critical section. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus );
+
+#define portDISABLE_INTERRUPTS()							vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()								vPortEnableInterrupts()
+#define portRAW_SET_INTERRUPT_MASK_FROM_ISR()				uxPortSetInterruptMask()
+#define portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatus )	vPortClearInterruptMask( uxSavedStatus )
+
+#if( defined( configGENERATE_ISR_LATENCY_STATS ) && ( configGENERATE_ISR_LATENCY_STATS == 1 ) )
+
+	/* The periods the FromISR macros mask interrupts for are timed. */
+	extern UBaseType_t uxPortSetInterruptMaskFromISR( void );
+	extern void vPortClearInterruptMaskFromISR( UBaseType_t uxSavedInterruptStatus );
+
+	#define portSET_INTERRUPT_MASK_FROM_ISR()					uxPortSetInterruptMaskFromISR()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatus )	vPortClearInterruptMaskFromISR( uxSavedStatus )
+
+#else
+
+	#define portSET_INTERRUPT_MASK_FROM_ISR()					uxPortSetInterruptMask()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatus )	vPortClearInterruptMask( uxSavedStatus )
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+
+#if( defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 ) )
+
+	/* Multi-core simulation.  Each simulated core runs the thread of the task
+	selected for it, so configNUMBER_OF_CORES task threads execute at once.
+	The core number and the critical nesting count are held in thread local
+	storage, and are handed over to a task thread as it is switched in.  The
+	kernel takes the locks, and keeps the nesting count, from its own critical
+	section functions. */
+	extern __thread BaseType_t xPortCoreID;
+	extern __thread UBaseType_t uxPortCriticalNesting;
+	extern void vPortYieldCore( BaseType_t xCoreID );
+	extern void vPortGetTaskLock( void );
+	extern void vPortReleaseTaskLock( void );
+	extern void vPortGetISRLock( void );
+	extern void vPortReleaseISRLock( void );
+	extern void vPortWaitForInterrupt( void );
+
+	#define portGET_CORE_ID()								xPortCoreID
+	#define portYIELD_CORE( xCoreID )						vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()								vPortGetTaskLock()
+	#define portRELEASE_TASK_LOCK()							vPortReleaseTaskLock()
+	#define portGET_ISR_LOCK()								vPortGetISRLock()
+	#define portRELEASE_ISR_LOCK()							vPortReleaseISRLock()
+	#define portGET_CRITICAL_NESTING_COUNT()				uxPortCriticalNesting
+	#define portSET_CRITICAL_NESTING_COUNT( x )				uxPortCriticalNesting = ( x )
+	#define portINCREMENT_CRITICAL_NESTING_COUNT()			uxPortCriticalNesting++
+	#define portDECREMENT_CRITICAL_NESTING_COUNT()			uxPortCriticalNesting--
+	#define portMEMORY_BARRIER()							__sync_synchronize()
+
+	#define portENTER_CRITICAL()							vTaskEnterCritical()
+	#define portEXIT_CRITICAL()								vTaskExitCritical()
+
+#else
+
+	#define portENTER_CRITICAL()							vPortEnterCritical()
+	#define portEXIT_CRITICAL()								vPortExitCritical()
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#if configUSE_TICKLESS_IDLE == 1
+	#ifndef portSUPPRESS_TICKS_AND_SLEEP
+		extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+		#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+/* Simulated peripheral interrupts.  vPortSetInterruptHandler() installs the
+handler for interrupt number ulInterruptNumber (0 to 31), which returns pdTRUE
+if a context switch is required when it exits.  vPortGenerateSimulatedInterrupt()
+can be called from a task, or from a host thread that stands in for a
+peripheral, and the handler executes in interrupt context the next time
+interrupts are enabled. */
+extern void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t ( *pvHandler )( void ) );
+extern void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber );
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Each task runs in its own host thread.  The thread must be cancelled when
+the kernel frees the TCB, and the thread of a task that deletes itself must not
+be allowed to run again once the switch away from it has been made. */
+extern void vPortCancelThread( void *pxTaskToDelete );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Host side instrumentation used by the simulator benchmark harness.
+ullPortGetHostCycles() returns the host time stamp counter where one is
+available, or a nanosecond count otherwise. */
+typedef struct xPORT_TICK_STATS
+{
+	uint64_t ullTickCount;			/* Number of ticks processed by the tick interrupt. */
+	uint64_t ullTickCycles;			/* Host cycles spent in xTaskIncrementTick(), hooks included. */
+	uint64_t ullMaxTickCycles;		/* Longest single call to xTaskIncrementTick(). */
+	uint64_t ullTickSwitchCount;	/* Number of tick interrupts that resulted in a context switch. */
+	uint64_t ullTickInterruptCount;	/* Number of tick interrupts taken. */
+	uint64_t ullLostTickCount;		/* Number of ticks lost because the host delayed the tick signal. */
+	uint64_t ullSleepCount;			/* Number of times vPortSuppressTicksAndSleep() slept. */
+	uint64_t ullSuppressedTickCount;/* Number of ticks stepped over by vPortSuppressTicksAndSleep(). */
+	uint64_t ullSwitchCount;		/* Number of calls to vTaskSwitchContext(). */
+	uint64_t ullSwitchCycles;		/* Host cycles spent in vTaskSwitchContext(). */
+} PortTickStats_t;
+
+extern uint64_t ullPortGetHostCycles( void );
+extern void vPortGetTickStats( PortTickStats_t *pxStats );
+extern void vPortResetTickStats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
@@ -89,6 +89,10 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+/* The lock counts are int8_t, so saturate rather than wrap when a batch adds
+more than one to them. */
+#define queueMAX_LOCK_COUNT				( ( int8_t ) 127 )
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -115,6 +119,10 @@ typedef struct QueueDef_t
 	volatile int8_t cRxLock;		/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	volatile int8_t cTxLock;		/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+	#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		ListItem_t xHeldMutexListItem;	/*< Links a mutex into the list of mutexes held by its holder.  Owned by xTasksWaitingToReceive so the holder can find the priority of the tasks waiting for the mutex. */
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -206,6 +214,49 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+#if( configUSE_QUEUE_BATCH == 1 )
+	/*
+	 * Copies up to uxItemCount items to the back of the queue, limited by the
+	 * space available, using at most two memcpy() calls.
+	 *
+	 * @return The number of items copied.
+	 */
+	static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copies up to uxMaxItems items out of the queue, limited by the number of
+	 * items available, using at most two memcpy() calls.
+	 *
+	 * @return The number of items copied.
+	 */
+	static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called after uxItemCount items have been added to an unlocked queue.
+	 * Notifies the queue set once per item if the queue is a member of a set,
+	 * otherwise unblocks up to uxItemCount tasks waiting to receive.
+	 *
+	 * @return pdTRUE if a task that has a higher priority than the calling
+	 * task was unblocked, otherwise pdFALSE.
+	 */
+	static BaseType_t prvUnblockReceivers( const Queue_t * const pxQueue, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called after uxItemCount items have been removed from an unlocked queue.
+	 * Unblocks up to uxItemCount tasks waiting to send.
+	 *
+	 * @return pdTRUE if a task that has a higher priority than the calling
+	 * task was unblocked, otherwise pdFALSE.
+	 */
+	static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Adds uxItemCount to the lock count cLock, saturating at
+	 * queueMAX_LOCK_COUNT.
+	 */
+	static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -363,6 +414,49 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	BaseType_t xQueueCreateStaticSet( const StaticQueueDefinition_t * const pxQueueDefinitions, const UBaseType_t uxNumberOfQueues )
+	{
+	const StaticQueueDefinition_t *pxDefinition;
+	QueueHandle_t xCreatedQueue;
+	UBaseType_t uxQueue;
+	BaseType_t xReturn = pdPASS;
+
+		configASSERT( pxQueueDefinitions != NULL );
+
+		/* A queue is not linked into any kernel list until it is used, so
+		creating a queue only initialises its own structure. */
+		for( uxQueue = 0U; uxQueue < uxNumberOfQueues; uxQueue++ )
+		{
+			pxDefinition = &( pxQueueDefinitions[ uxQueue ] );
+			xCreatedQueue = xQueueGenericCreateStatic( pxDefinition->uxQueueLength, pxDefinition->uxItemSize, pxDefinition->pucQueueStorage, pxDefinition->pxQueueBuffer, queueQUEUE_TYPE_BASE );
+
+			if( xCreatedQueue == NULL )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxDefinition->pxCreatedQueue != NULL )
+			{
+				*( pxDefinition->pxCreatedQueue ) = xCreatedQueue;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
 	QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, const uint8_t ucQueueType )
@@ -484,6 +578,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+			{
+				vListInitialiseItem( &( pxNewQueue->xHeldMutexListItem ) );
+				listSET_LIST_ITEM_OWNER( &( pxNewQueue->xHeldMutexListItem ), &( pxNewQueue->xTasksWaitingToReceive ) );
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -565,7 +666,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+#if ( ( configUSE_MUTEXES == 1 ) && ( ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) || ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 ) ) )
 
 	TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
 	{
@@ -985,7 +1086,7 @@ Queue_t * const pxQueue = xQueue;
 	read, instead return a flag to say whether a context switch is required or
 	not (i.e. has a task with a higher priority than us been woken by this
 	post). */
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
@@ -1099,7 +1200,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1144,7 +1245,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1264,7 +1365,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1463,7 +1564,15 @@ Queue_t * const pxQueue = xQueue;
 					{
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
-						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+						{
+							pxQueue->u.xSemaphore.xMutexHolder = pvTaskAddHeldMutex( &( pxQueue->xHeldMutexListItem ) );
+						}
+						#else
+						{
+							pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						}
+						#endif
 					}
 					else
 					{
@@ -1552,6 +1661,14 @@ Queue_t * const pxQueue = xQueue;
 						taskENTER_CRITICAL();
 						{
 							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+							#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+							{
+								/* A priority later inherited by this task is
+								passed on to the holder of this mutex. */
+								vTaskSetMutexWaitedFor( pxQueue );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1593,6 +1710,19 @@ Queue_t * const pxQueue = xQueue;
 			queue being empty is equivalent to the semaphore count being 0. */
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+				{
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						vTaskSetMutexWaitedFor( NULL );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+
 				#if ( configUSE_MUTEXES == 1 )
 				{
 					/* xInheritanceOccurred could only have be set if
@@ -1803,7 +1933,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1863,7 +1993,7 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1896,7 +2026,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		/* Cannot block in an ISR, so check there is data available. */
 		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
@@ -1917,12 +2047,375 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	const int8_t *pcNextItem = ( const int8_t * ) pvItems;
+	UBaseType_t uxItemsSent = 0, uxItemsCopied;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+
+		/* Semaphores and mutexes do not hold data, so cannot be sent to in
+		batches. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Copy as many of the outstanding items as there is space for
+				with one entry to the critical section, then unblock the tasks
+				waiting for them with one pass over the event list. */
+				uxItemsCopied = prvCopyItemsToQueue( pxQueue, pcNextItem, uxItemCount - uxItemsSent );
+
+				if( uxItemsCopied > ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_SEND( pxQueue );
+					uxItemsSent += uxItemsCopied;
+					pcNextItem += uxItemsCopied * pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+					if( prvUnblockReceivers( pxQueue, uxItemsCopied ) != pdFALSE )
+					{
+						/* The yield is held pending until the critical section
+						is exited. */
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( uxItemsSent == uxItemCount )
+				{
+					taskEXIT_CRITICAL();
+					return uxItemsSent;
+				}
+				else if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue filled before all the items were sent and no
+					block time is specified (or the block time has expired) so
+					leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return uxItemsSent;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The block time covers the whole batch, so is only
+					configured the first time the queue is found to be full. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired.  Loop back once more to send
+				whatever the queue now has space for. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+				xTicksToWait = ( TickType_t ) 0;
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxItemsSent, uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			uxItemsSent = prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxItemCount );
+
+			if( uxItemsSent > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+				/* The event lists are not updated if the queue is locked. */
+				if( cTxLock == queueUNLOCKED )
+				{
+					if( ( prvUnblockReceivers( pxQueue, uxItemsSent ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Add the number of items to the lock count so the task
+					that unlocks the queue knows how many were posted while it
+					was locked. */
+					pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxItemsSent );
+				}
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return uxItemsSent;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	UBaseType_t uxItemsReceived;
+
+		configASSERT( pxQueue );
+		configASSERT( pvBuffer );
+		configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Remove everything that is available, up to uxMaxItems,
+				then unblock the tasks waiting for the space with one pass over
+				the event list. */
+				uxItemsReceived = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+
+				if( uxItemsReceived > ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+
+					if( prvUnblockSenders( pxQueue, uxItemsReceived ) != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return uxItemsReceived;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified
+						(or the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return ( UBaseType_t ) 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was empty and a block time was specified
+						so configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* The queue contains data again.  Loop back to try and read
+					the data. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If there is no data in the queue exit, otherwise
+				loop back and attempt to read the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxItemsReceived, uxSavedInterruptStatus;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pvBuffer );
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0 );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			uxItemsReceived = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+
+			if( uxItemsReceived > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+				/* If the queue is locked the event list will not be modified.
+				Instead update the lock count so the task that unlocks the queue
+				will know that items were removed while it was locked. */
+				if( cRxLock == queueUNLOCKED )
+				{
+					if( ( prvUnblockSenders( pxQueue, uxItemsReceived ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxItemsReceived );
+				}
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return uxItemsReceived;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 {
 UBaseType_t uxReturn;
@@ -1981,6 +2474,32 @@ Queue_t * const pxQueue = xQueue;
 	}
 	#endif
 
+	#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+	{
+		/* A mutex deleted while it is held must not be left in the list of
+		mutexes held by the task that holds it. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxQueue->xHeldMutexListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxQueue->xHeldMutexListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 	{
 		/* The queue can only have been allocated dynamically - free it
@@ -2082,7 +2601,21 @@ UBaseType_t uxMessagesWaiting;
 		{
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
-				/* The mutex is no longer being held. */
+				/* The mutex is no longer being held.  Take it out of the
+				holder's list first so it no longer counts towards the
+				priority the holder keeps. */
+				#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+				{
+					if( listLIST_ITEM_CONTAINER( &( pxQueue->xHeldMutexListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxQueue->xHeldMutexListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
 				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
 				pxQueue->u.xSemaphore.xMutexHolder = NULL;
 			}
@@ -2164,6 +2697,233 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxItemCount )
+	{
+	const UBaseType_t uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	UBaseType_t uxItemsToCopy, uxItemsInRun;
+	size_t xBytesInRun;
+
+		/* This function is called from a critical section. */
+		if( uxItemCount > uxSpaces )
+		{
+			uxItemCount = uxSpaces;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Copy the items that fit before the end of the storage area, then
+		wrap back to the start for the rest. */
+		uxItemsToCopy = uxItemCount;
+		while( uxItemsToCopy > ( UBaseType_t ) 0 )
+		{
+			uxItemsInRun = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) / pxQueue->uxItemSize; /*lint !e946 !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( uxItemsInRun > uxItemsToCopy )
+			{
+				uxItemsInRun = uxItemsToCopy;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xBytesInRun = ( size_t ) uxItemsInRun * ( size_t ) pxQueue->uxItemSize;
+			( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesInRun ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+			pcItems += xBytesInRun; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			pxQueue->pcWriteTo += xBytesInRun; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxItemsToCopy -= uxItemsInRun;
+		}
+
+		pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + uxItemCount;
+
+		return uxItemCount;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxMaxItems )
+	{
+	UBaseType_t uxItemsToCopy, uxItemsInRun;
+	size_t xBytesInRun;
+	int8_t *pcReadFrom;
+
+		/* This function is called from a critical section. */
+		if( uxMaxItems > pxQueue->uxMessagesWaiting )
+		{
+			uxMaxItems = pxQueue->uxMessagesWaiting;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* pcReadFrom points to the last item read, so the first item to copy
+		is the one after it. */
+		uxItemsToCopy = uxMaxItems;
+		while( uxItemsToCopy > ( UBaseType_t ) 0 )
+		{
+			pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+			{
+				pcReadFrom = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxItemsInRun = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ) / pxQueue->uxItemSize; /*lint !e946 !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			if( uxItemsInRun > uxItemsToCopy )
+			{
+				uxItemsInRun = uxItemsToCopy;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xBytesInRun = ( size_t ) uxItemsInRun * ( size_t ) pxQueue->uxItemSize;
+			( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xBytesInRun ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+			pcBuffer += xBytesInRun; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+			/* Leave pcReadFrom pointing to the last item copied, as
+			prvCopyDataFromQueue() does. */
+			pxQueue->u.xQueue.pcReadFrom = pcReadFrom + ( xBytesInRun - ( size_t ) pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+			uxItemsToCopy -= uxItemsInRun;
+		}
+
+		pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - uxMaxItems;
+
+		return uxMaxItems;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	static BaseType_t prvUnblockReceivers( const Queue_t * const pxQueue, const UBaseType_t uxItemCount )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+	UBaseType_t uxItem;
+
+		/* This function is called from a critical section, or from an ISR,
+		with the queue unlocked. */
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			if( pxQueue->pxQueueSetContainer != NULL )
+			{
+				/* The queue set holds one handle per item, so is notified once
+				per item - otherwise the set would report fewer items than the
+				queue holds. */
+				for( uxItem = ( UBaseType_t ) 0; uxItem < uxItemCount; uxItem++ )
+				{
+					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				return xYieldRequired;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_QUEUE_SETS */
+
+		/* Each item can satisfy one waiting task, so stop at whichever runs
+		out first. */
+		for( uxItem = ( UBaseType_t ) 0; ( uxItem < uxItemCount ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); uxItem++ )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xYieldRequired;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, const UBaseType_t uxItemCount )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+	UBaseType_t uxItem;
+
+		/* This function is called from a critical section, or from an ISR,
+		with the queue unlocked.  Each free space can satisfy one waiting task,
+		which might itself be sending a batch. */
+		for( uxItem = ( UBaseType_t ) 0; ( uxItem < uxItemCount ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ); uxItem++ )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xYieldRequired;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCH == 1 )
+
+	static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxItemCount )
+	{
+	int8_t cReturn;
+
+		/* The lock count of a locked queue is never negative.  Only a queue
+		longer than queueMAX_LOCK_COUNT items can reach the limit, which the
+		single item functions cannot count past either. */
+		if( uxItemCount >= ( UBaseType_t ) ( queueMAX_LOCK_COUNT - cLock ) )
+		{
+			cReturn = queueMAX_LOCK_COUNT;
+		}
+		else
+		{
+			cReturn = ( int8_t ) ( cLock + ( int8_t ) uxItemCount );
+		}
+
+		return cReturn;
+	}
+
+#endif /* configUSE_QUEUE_BATCH */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
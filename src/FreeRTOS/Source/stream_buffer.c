@@ -53,6 +53,26 @@ correct privileged Vs unprivileged linkage and placement. */
 or #defined the notification macros away, them provide default implementations
 that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overidden. */
+
+/* A stream buffer created with sbFLAGS_LOCKFREE_SPSC only calls the macros
+below when a task is blocked on it, as the default implementations do nothing
+otherwise.  Application provided implementations might, so are always called. */
+#if defined( sbRECEIVE_COMPLETED ) || defined( sbRECEIVE_COMPLETED_FROM_ISR )
+	#define sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer ) ( pdTRUE )
+#else
+	#define sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer )														\
+		( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_LOCKFREE_SPSC ) == ( uint8_t ) 0 ) ||						\
+		  ( ( pxStreamBuffer )->xTaskWaitingToSend != NULL ) )
+#endif
+
+#if defined( sbSEND_COMPLETED ) || defined( sbSEND_COMPLETE_FROM_ISR )
+	#define sbSEND_COMPLETED_REQUIRED( pxStreamBuffer ) ( pdTRUE )
+#else
+	#define sbSEND_COMPLETED_REQUIRED( pxStreamBuffer )															\
+		( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_LOCKFREE_SPSC ) == ( uint8_t ) 0 ) ||						\
+		  ( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL ) )
+#endif
+
 #ifndef sbRECEIVE_COMPLETED
 	#define sbRECEIVE_COMPLETED( pxStreamBuffer )										\
 		vTaskSuspendAll();																\
@@ -74,7 +94,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();			\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
 			{																			\
@@ -85,7 +105,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );							\
 	}
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -112,7 +132,7 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();			\
 		{																				\
 			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
 			{																			\
@@ -123,7 +143,7 @@ that uses task notifications. */
 				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
 			}																			\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );							\
 	}
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
@@ -134,6 +154,7 @@ that uses task notifications. */
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+/* sbFLAGS_LOCKFREE_SPSC ( 4 ) is defined in stream_buffer.h as it is passed in by the application. */
 
 /*-----------------------------------------------------------*/
 
@@ -160,12 +181,12 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
 /*
- * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
- * Returns the number of bytes written, which will either equal xCount in the
- * success case, or 0 if there was not enough space in the buffer (in which case
- * no data is written into the buffer).
+ * Copy xCount bytes from pucData into the pxStreamBuffer buffer, starting at
+ * index xHead.  The caller must have checked there is space.  Returns the index
+ * following the last byte written.  The buffer's own xHead is not updated, so
+ * the caller can make everything it writes visible to the reader at once.
  */
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
 
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
@@ -188,19 +209,60 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
  * data storage area.
  */
 static size_t prvWriteMessageToBuffer(  StreamBuffer_t * const pxStreamBuffer,
-										const void * pvTxData,
+										const StreamBufferIOVec_t * const pxVectors,
+										UBaseType_t uxVectorCount,
 										size_t xDataLengthBytes,
 										size_t xSpace,
 										size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
 
 /*
- * Read xMaxCount bytes from the pxStreamBuffer message buffer and write them
- * to pucData.
+ * Gather xCount bytes from the uxVectorCount buffers described by pxVectors
+ * into the pxStreamBuffer buffer, starting at index xHead.  Returns the index
+ * following the last byte written, as prvWriteBytesToBuffer() does.
+ */
+static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+									   const StreamBufferIOVec_t * const pxVectors,
+									   UBaseType_t uxVectorCount,
+									   size_t xCount,
+									   size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementations of xStreamBufferSend() and xStreamBufferSendFromISR(),
+ * which are also used by xStreamBufferSendV() and xStreamBufferSendVFromISR().
+ * xDataLengthBytes is the total length of the buffers described by pxVectors.
+ */
+static size_t prvSendVectors( StreamBuffer_t * const pxStreamBuffer,
+							  const StreamBufferIOVec_t * const pxVectors,
+							  UBaseType_t uxVectorCount,
+							  size_t xDataLengthBytes,
+							  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+static size_t prvSendVectorsFromISR( StreamBuffer_t * const pxStreamBuffer,
+									 const StreamBufferIOVec_t * const pxVectors,
+									 UBaseType_t uxVectorCount,
+									 size_t xDataLengthBytes,
+									 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block for up to xTicksToWait ticks until there is more than
+ * xBytesToStoreMessageLength bytes in the buffer, then return the number of
+ * bytes in the buffer.  Used by both xStreamBufferReceive() and
+ * xStreamBufferReceiveAcquire().
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+							  size_t xBytesToStoreMessageLength,
+							  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes, starting at index xTail, from the pxStreamBuffer buffer
+ * to pucData.  The caller must have checked the bytes are available.  Returns
+ * the index following the last byte read.  The buffer's own xTail is not
+ * updated, so the caller decides when the space is returned to the writer.
  */
 static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  uint8_t *pucData,
-									  size_t xMaxCount,
-									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+									  size_t xCount,
+									  size_t xTail ) PRIVILEGED_FUNCTION;
 
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
@@ -210,7 +272,35 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
 										  size_t xTriggerLevelBytes,
-										  BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+										  uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Converts the xIsMessageBuffer parameter of the create functions, which can
+ * have sbFLAGS_LOCKFREE_SPSC ORed into it, to ucFlags bits.
+ */
+static uint8_t prvCreateFlags( BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	/*
+	 * Describe the next message (or, for a stream buffer, all the bytes) in
+	 * the buffer as up to two spans of the buffer's data storage area, without
+	 * removing anything from the buffer.  Returns the total length of the
+	 * spans.
+	 */
+	static size_t prvGetReadSpans( const StreamBuffer_t * const pxStreamBuffer,
+								   StreamBufferIOVec_t pxSpans[ 2 ],
+								   size_t xBytesAvailable,
+								   size_t xBytesToStoreMessageLength ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove xConsumedBytes bytes (or, for a message buffer, the whole next
+	 * message, which must be xConsumedBytes long) from the buffer.  Returns
+	 * pdFAIL, and removes nothing, if that many bytes are not in the buffer.
+	 */
+	static BaseType_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xConsumedBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
 
 /*-----------------------------------------------------------*/
 
@@ -219,6 +309,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
 	{
 	uint8_t *pucAllocatedMemory;
+	const uint8_t ucFlags = prvCreateFlags( xIsMessageBuffer );
 
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
@@ -251,13 +342,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										   pucAllocatedMemory + sizeof( StreamBuffer_t ),  /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer, also storage area has no alignment requirement. */
 										   xBufferSizeBytes,
 										   xTriggerLevelBytes,
-										   xIsMessageBuffer );
+										   ucFlags );
 
-			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), ( BaseType_t ) ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) );
 		}
 		else
 		{
-			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE_FAILED( ( BaseType_t ) ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) );
 		}
 
 		return ( StreamBufferHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
@@ -276,6 +367,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	{
 	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 !e9087 Safe cast as StaticStreamBuffer_t is opaque Streambuffer_t. */
 	StreamBufferHandle_t xReturn;
+	const uint8_t ucFlags = prvCreateFlags( xIsMessageBuffer );
 
 		configASSERT( pucStreamBufferStorageArea );
 		configASSERT( pxStaticStreamBuffer );
@@ -310,20 +402,16 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  pucStreamBufferStorageArea,
 										  xBufferSizeBytes,
 										  xTriggerLevelBytes,
-										  xIsMessageBuffer );
-
-			/* Remember this was statically allocated in case it is ever deleted
-			again. */
-			pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
+										  ucFlags | sbFLAGS_IS_STATICALLY_ALLOCATED ); /* Remember this was statically allocated in case it is ever deleted again. */
 
-			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, ( BaseType_t ) ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) );
 
 			xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
 		}
 		else
 		{
 			xReturn = NULL;
-			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, ( BaseType_t ) ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) );
 		}
 
 		return xReturn;
@@ -368,7 +456,7 @@ StreamBuffer_t * pxStreamBuffer = xStreamBuffer;
 BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
 {
 StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
+BaseType_t xReturn = pdFAIL;
 
 #if( configUSE_TRACE_FACILITY == 1 )
 	UBaseType_t uxStreamBufferNumber;
@@ -391,20 +479,13 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 		{
 			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
 			{
-				if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
-				{
-					xIsMessageBuffer = pdTRUE;
-				}
-				else
-				{
-					xIsMessageBuffer = pdFALSE;
-				}
-
+				/* All the flags are kept - the buffer is still the same type,
+				allocated in the same way. */
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
 											  pxStreamBuffer->pucBuffer,
 											  pxStreamBuffer->xLength,
 											  pxStreamBuffer->xTriggerLevelBytes,
-											  xIsMessageBuffer );
+											  pxStreamBuffer->ucFlags );
 				xReturn = pdPASS;
 
 				#if( configUSE_TRACE_FACILITY == 1 )
@@ -493,14 +574,28 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
 						  size_t xDataLengthBytes,
 						  TickType_t xTicksToWait )
 {
-StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+StreamBufferIOVec_t xVector;
+
+	configASSERT( pvTxData );
+	configASSERT( xStreamBuffer );
+
+	xVector.pvData = pvTxData;
+	xVector.xLength = xDataLengthBytes;
+
+	return prvSendVectors( xStreamBuffer, &xVector, ( UBaseType_t ) 1, xDataLengthBytes, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSendVectors( StreamBuffer_t * const pxStreamBuffer,
+							  const StreamBufferIOVec_t * const pxVectors,
+							  UBaseType_t uxVectorCount,
+							  size_t xDataLengthBytes,
+							  TickType_t xTicksToWait )
+{
 size_t xReturn, xSpace = 0;
 size_t xRequiredSpace = xDataLengthBytes;
 TimeOut_t xTimeOut;
 
-	configASSERT( pvTxData );
-	configASSERT( pxStreamBuffer );
-
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
@@ -517,7 +612,19 @@ TimeOut_t xTimeOut;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_LOCKFREE_SPSC ) != ( uint8_t ) 0 )
+	{
+		/* This is the only task writing to the buffer, so the space can only
+		grow until this task writes to it again.  If there is enough space now
+		there is no need to enter the critical section below. */
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xSpace < xRequiredSpace ) )
 	{
 		vTaskSetTimeOutState( &xTimeOut );
 
@@ -537,6 +644,29 @@ TimeOut_t xTimeOut;
 					/* Should only be one writer. */
 					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
 					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+
+					#if( configNUMBER_OF_CORES > 1 )
+					{
+						/* A lock-free reader on another core does not take the
+						critical section, so the space is checked again after
+						the handle is published.  The reader moves the tail
+						before it reads the handle, so one of the two sees the
+						other. */
+						portMEMORY_BARRIER();
+						xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+						if( xSpace >= xRequiredSpace )
+						{
+							pxStreamBuffer->xTaskWaitingToSend = NULL;
+							taskEXIT_CRITICAL();
+							break;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configNUMBER_OF_CORES */
 				}
 				else
 				{
@@ -546,7 +676,7 @@ TimeOut_t xTimeOut;
 			}
 			taskEXIT_CRITICAL();
 
-			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
 			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
 			pxStreamBuffer->xTaskWaitingToSend = NULL;
 
@@ -566,14 +696,14 @@ TimeOut_t xTimeOut;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
 
 	if( xReturn > ( size_t ) 0 )
 	{
-		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+		traceSTREAM_BUFFER_SEND( pxStreamBuffer, xReturn );
 
 		/* Was a task waiting for the data? */
-		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		if( ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) && ( sbSEND_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE ) )
 		{
 			sbSEND_COMPLETED( pxStreamBuffer );
 		}
@@ -585,7 +715,7 @@ TimeOut_t xTimeOut;
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
-		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+		traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
 	}
 
 	return xReturn;
@@ -597,12 +727,26 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 								 size_t xDataLengthBytes,
 								 BaseType_t * const pxHigherPriorityTaskWoken )
 {
-StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-size_t xReturn, xSpace;
-size_t xRequiredSpace = xDataLengthBytes;
+StreamBufferIOVec_t xVector;
 
 	configASSERT( pvTxData );
-	configASSERT( pxStreamBuffer );
+	configASSERT( xStreamBuffer );
+
+	xVector.pvData = pvTxData;
+	xVector.xLength = xDataLengthBytes;
+
+	return prvSendVectorsFromISR( xStreamBuffer, &xVector, ( UBaseType_t ) 1, xDataLengthBytes, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSendVectorsFromISR( StreamBuffer_t * const pxStreamBuffer,
+									 const StreamBufferIOVec_t * const pxVectors,
+									 UBaseType_t uxVectorCount,
+									 size_t xDataLengthBytes,
+									 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+size_t xReturn, xSpace;
+size_t xRequiredSpace = xDataLengthBytes;
 
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
@@ -618,12 +762,12 @@ size_t xRequiredSpace = xDataLengthBytes;
 	}
 
 	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
 
 	if( xReturn > ( size_t ) 0 )
 	{
 		/* Was a task waiting for the data? */
-		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		if( ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) && ( sbSEND_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE ) )
 		{
 			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
 		}
@@ -637,20 +781,76 @@ size_t xRequiredSpace = xDataLengthBytes;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+	traceSTREAM_BUFFER_SEND_FROM_ISR( pxStreamBuffer, xReturn );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+							   const StreamBufferIOVec_t * const pxVectors,
+							   UBaseType_t uxVectorCount,
+							   TickType_t xTicksToWait )
+	{
+	size_t xDataLengthBytes = 0;
+	UBaseType_t ux;
+
+		configASSERT( xStreamBuffer );
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+
+		for( ux = 0; ux < uxVectorCount; ux++ )
+		{
+			configASSERT( ( pxVectors[ ux ].pvData != NULL ) || ( pxVectors[ ux ].xLength == ( size_t ) 0 ) );
+			xDataLengthBytes += pxVectors[ ux ].xLength;
+		}
+
+		return prvSendVectors( xStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xTicksToWait );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+									  const StreamBufferIOVec_t * const pxVectors,
+									  UBaseType_t uxVectorCount,
+									  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	size_t xDataLengthBytes = 0;
+	UBaseType_t ux;
+
+		configASSERT( xStreamBuffer );
+		configASSERT( ( pxVectors != NULL ) || ( uxVectorCount == ( UBaseType_t ) 0 ) );
+
+		for( ux = 0; ux < uxVectorCount; ux++ )
+		{
+			configASSERT( ( pxVectors[ ux ].pvData != NULL ) || ( pxVectors[ ux ].xLength == ( size_t ) 0 ) );
+			xDataLengthBytes += pxVectors[ ux ].xLength;
+		}
+
+		return prvSendVectorsFromISR( xStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-									   const void * pvTxData,
+									   const StreamBufferIOVec_t * const pxVectors,
+									   UBaseType_t uxVectorCount,
 									   size_t xDataLengthBytes,
 									   size_t xSpace,
 									   size_t xRequiredSpace )
 {
 	BaseType_t xShouldWrite;
 	size_t xReturn;
+	size_t xNextHead = pxStreamBuffer->xHead;
+
+	/* xSpace was calculated from the tail, which must be read before the
+	bytes it frees are written over. */
+	portMEMORY_BARRIER();
 
 	if( xSpace == ( size_t ) 0 )
 	{
@@ -673,7 +873,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 		into the buffer.  Start by writing the length of the data, the data
 		itself will be written later in this function. */
 		xShouldWrite = pdTRUE;
-		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
 	}
 	else
 	{
@@ -684,7 +884,17 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 	if( xShouldWrite != pdFALSE )
 	{
 		/* Writes the data itself. */
-		xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		xNextHead = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xNextHead );
+
+		/* Only now move the head, so a reader never sees the length of a
+		message before the message itself.  The first barrier keeps the data
+		before the head, and the second keeps the head before the caller reads
+		xTaskWaitingToReceive, as with sbFLAGS_LOCKFREE_SPSC the reader does
+		not take the critical section to check the head is unchanged. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = xNextHead;
+		portMEMORY_BARRIER();
+		xReturn = xDataLengthBytes;
 	}
 	else
 	{
@@ -720,7 +930,65 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesToStoreMessageLength = 0;
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
+	xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
+	holds the number of bytes used to store the message length) or a stream of
+	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+	available must be greater than xBytesToStoreMessageLength to be able to
+	read bytes from the buffer. */
+	if( xBytesAvailable > xBytesToStoreMessageLength )
+	{
+		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReceivedLength != ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+
+			if( sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE )
+			{
+				sbRECEIVE_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+							  size_t xBytesToStoreMessageLength,
+							  TickType_t xTicksToWait )
+{
+size_t xBytesAvailable;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_LOCKFREE_SPSC ) != ( uint8_t ) 0 )
+	{
+		/* This is the only task reading from the buffer, so the data can only
+		grow until this task reads it.  If there is data now there is no need to
+		enter the critical section below. */
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+	else
+	{
+		xBytesAvailable = 0;
+	}
+
+	if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xBytesAvailable <= xBytesToStoreMessageLength ) )
 	{
 		/* Checking if there is data and clearing the notification state must be
 		performed atomically. */
@@ -741,6 +1009,25 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 				/* Should only be one reader. */
 				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
 				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+
+				#if( configNUMBER_OF_CORES > 1 )
+				{
+					/* As prvSendVectors(), a lock-free writer on another core
+					moves the head before it reads the handle, so the data is
+					checked again after the handle is published. */
+					portMEMORY_BARRIER();
+					xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+					if( xBytesAvailable > xBytesToStoreMessageLength )
+					{
+						pxStreamBuffer->xTaskWaitingToReceive = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
 			}
 			else
 			{
@@ -752,7 +1039,7 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		if( xBytesAvailable <= xBytesToStoreMessageLength )
 		{
 			/* Wait for data to be available. */
-			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
 			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
 			pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
@@ -769,40 +1056,14 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 	}
 
-	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
-	holds the number of bytes used to store the message length) or a stream of
-	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-	available must be greater than xBytesToStoreMessageLength to be able to
-	read bytes from the buffer. */
-	if( xBytesAvailable > xBytesToStoreMessageLength )
-	{
-		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
-
-		/* Was a task waiting for space in the buffer? */
-		if( xReceivedLength != ( size_t ) 0 )
-		{
-			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-			sbRECEIVE_COMPLETED( pxStreamBuffer );
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
-	else
-	{
-		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
-		mtCOVERAGE_TEST_MARKER();
-	}
-
-	return xReceivedLength;
+	return xBytesAvailable;
 }
 /*-----------------------------------------------------------*/
 
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
 {
 StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-size_t xReturn, xBytesAvailable, xOriginalTail;
+size_t xReturn, xBytesAvailable;
 configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 
 	configASSERT( pxStreamBuffer );
@@ -816,13 +1077,10 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 			/* The number of bytes available is greater than the number of bytes
 			required to hold the length of the next message, so another message
 			is available.  Return its length without removing the length bytes
-			from the buffer.  A copy of the tail is stored so the buffer can be
-			returned to its prior state as the message is not actually being
-			removed from the buffer. */
-			xOriginalTail = pxStreamBuffer->xTail;
-			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+			from the buffer - the tail is not moved. */
+			portMEMORY_BARRIER();
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
 			xReturn = ( size_t ) xTempReturn;
-			pxStreamBuffer->xTail = xOriginalTail;
 		}
 		else
 		{
@@ -880,7 +1138,7 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
 
 		/* Was a task waiting for space in the buffer? */
-		if( xReceivedLength != ( size_t ) 0 )
+		if( ( xReceivedLength != ( size_t ) 0 ) && ( sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE ) )
 		{
 			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
 		}
@@ -900,23 +1158,159 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+										StreamBufferIOVec_t pxSpans[ 2 ],
+										TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReceivedLength, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+		xReceivedLength = prvGetReadSpans( pxStreamBuffer, pxSpans, xBytesAvailable, xBytesToStoreMessageLength );
+
+		if( xReceivedLength == ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReceivedLength;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+											   StreamBufferIOVec_t pxSpans[ 2 ] )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xBytesToStoreMessageLength;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		return prvGetReadSpans( pxStreamBuffer, pxSpans, prvBytesInBuffer( pxStreamBuffer ), xBytesToStoreMessageLength );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	BaseType_t xStreamBufferReceiveConsume( StreamBufferHandle_t xStreamBuffer, size_t xConsumedBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	BaseType_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsume( pxStreamBuffer, xConsumedBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( ( xReturn != pdFAIL ) && ( xConsumedBytes != ( size_t ) 0 ) )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xConsumedBytes );
+
+			if( sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE )
+			{
+				sbRECEIVE_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	BaseType_t xStreamBufferReceiveConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+												   size_t xConsumedBytes,
+												   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	BaseType_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsume( pxStreamBuffer, xConsumedBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( ( xReturn != pdFAIL ) && ( xConsumedBytes != ( size_t ) 0 ) && ( sbRECEIVE_COMPLETED_REQUIRED( pxStreamBuffer ) != pdFALSE ) )
+		{
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xConsumedBytes );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
 static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
 										void *pvRxData,
 										size_t xBufferLengthBytes,
 										size_t xBytesAvailable,
 										size_t xBytesToStoreMessageLength )
 {
-size_t xOriginalTail, xReceivedLength, xNextMessageLength;
+size_t xCount, xNextMessageLength, xNextTail;
 configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 
+	/* Everything is read using a copy of the tail, so the space is returned to
+	the writer in one step once the whole message has been read.
+	xBytesAvailable was calculated from the head, which must be read before the
+	data it covers. */
+	portMEMORY_BARRIER();
+	xNextTail = pxStreamBuffer->xTail;
+
 	if( xBytesToStoreMessageLength != ( size_t ) 0 )
 	{
 		/* A discrete message is being received.  First receive the length
-		of the message.  A copy of the tail is stored so the buffer can be
-		returned to its prior state if the length of the message is too
-		large for the provided buffer. */
-		xOriginalTail = pxStreamBuffer->xTail;
-		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xBytesAvailable );
+		of the message. */
+		xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xNextTail );
 		xNextMessageLength = ( size_t ) xTempNextMessageLength;
 
 		/* Reduce the number of bytes available by the number of bytes just
@@ -928,9 +1322,8 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 		if( xNextMessageLength > xBufferLengthBytes )
 		{
 			/* The user has provided insufficient space to read the message
-			so return the buffer to its previous state (so the length of
-			the message is in the buffer again). */
-			pxStreamBuffer->xTail = xOriginalTail;
+			so leave the length of the message in the buffer. */
+			xNextTail = pxStreamBuffer->xTail;
 			xNextMessageLength = 0;
 		}
 		else
@@ -945,10 +1338,27 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 		xNextMessageLength = xBufferLengthBytes;
 	}
 
-	/* Read the actual data. */
-	xReceivedLength = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xNextMessageLength, xBytesAvailable ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+	/* Use the minimum of the wanted bytes and the available bytes. */
+	xCount = configMIN( xNextMessageLength, xBytesAvailable );
 
-	return xReceivedLength;
+	if( xCount != ( size_t ) 0 )
+	{
+		/* Read the actual data. */
+		xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Move the tail to effectively remove the data read from the buffer.  The
+	barriers keep the data read before the tail is moved, and the tail moved
+	before the caller reads xTaskWaitingToSend. */
+	portMEMORY_BARRIER();
+	pxStreamBuffer->xTail = xNextTail;
+	portMEMORY_BARRIER();
+
+	return xCount;
 }
 /*-----------------------------------------------------------*/
 
@@ -1018,7 +1428,7 @@ UBaseType_t uxSavedInterruptStatus;
 
 	configASSERT( pxStreamBuffer );
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
 		{
@@ -1034,7 +1444,7 @@ UBaseType_t uxSavedInterruptStatus;
 			xReturn = pdFALSE;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1048,7 +1458,7 @@ UBaseType_t uxSavedInterruptStatus;
 
 	configASSERT( pxStreamBuffer );
 
-	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
 		{
@@ -1064,28 +1474,26 @@ UBaseType_t uxSavedInterruptStatus;
 			xReturn = pdFALSE;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead )
 {
-size_t xNextHead, xFirstLength;
+size_t xFirstLength;
 
 	configASSERT( xCount > ( size_t ) 0 );
 
-	xNextHead = pxStreamBuffer->xHead;
-
 	/* Calculate the number of bytes that can be added in the first write -
 	which may be less than the total number of bytes that need to be added if
 	the buffer will wrap back to the beginning. */
-	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextHead, xCount );
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
 
 	/* Write as many bytes as can be written in the first write. */
-	configASSERT( ( xNextHead + xFirstLength ) <= pxStreamBuffer->xLength );
-	memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
+	memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
 	/* If the number of bytes written was less than the number that could be
 	written in the first write... */
@@ -1100,75 +1508,218 @@ size_t xNextHead, xFirstLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xNextHead += xCount;
-	if( xNextHead >= pxStreamBuffer->xLength )
+	xHead += xCount;
+	if( xHead >= pxStreamBuffer->xLength )
 	{
-		xNextHead -= pxStreamBuffer->xLength;
+		xHead -= pxStreamBuffer->xLength;
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	pxStreamBuffer->xHead = xNextHead;
+	return xHead;
+}
+/*-----------------------------------------------------------*/
 
-	return xCount;
+static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+									   const StreamBufferIOVec_t * const pxVectors,
+									   UBaseType_t uxVectorCount,
+									   size_t xCount,
+									   size_t xHead )
+{
+UBaseType_t ux;
+size_t xBytesToWrite;
+
+	for( ux = 0; ( ux < uxVectorCount ) && ( xCount > ( size_t ) 0 ); ux++ )
+	{
+		/* A stream buffer might only have space for part of the data. */
+		xBytesToWrite = configMIN( pxVectors[ ux ].xLength, xCount );
+
+		if( xBytesToWrite > ( size_t ) 0 )
+		{
+			xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxVectors[ ux ].pvData, xBytesToWrite, xHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+			xCount -= xBytesToWrite;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xHead;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xTail )
 {
-size_t xCount, xFirstLength, xNextTail;
+size_t xFirstLength;
 
-	/* Use the minimum of the wanted bytes and the available bytes. */
-	xCount = configMIN( xBytesAvailable, xMaxCount );
+	configASSERT( xCount > ( size_t ) 0 );
+
+	/* Calculate the number of bytes that can be read - which may be less than
+	the number wanted if the data wraps around to the start of the buffer. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
 
-	if( xCount > ( size_t ) 0 )
+	/* Obtain the number of bytes it is possible to obtain in the first read.
+	Asserts check bounds of read and write. */
+	configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the total number of wanted bytes is greater than the number that
+	could be read in the first read... */
+	if( xCount > xFirstLength )
+	{
+		/*...then read the remaining bytes from the start of the buffer. */
+		memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
 	{
-		xNextTail = pxStreamBuffer->xTail;
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
-		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+	xTail += xCount;
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	if( xTail >= pxStreamBuffer->xLength )
+	{
+		xTail -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xTail;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
+	static size_t prvGetReadSpans( const StreamBuffer_t * const pxStreamBuffer,
+								   StreamBufferIOVec_t pxSpans[ 2 ],
+								   size_t xBytesAvailable,
+								   size_t xBytesToStoreMessageLength )
+	{
+	size_t xCount, xFirstLength, xTail;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+		/* xBytesAvailable was calculated from the head, which must be read
+		before the message length and the data the spans describe. */
+		portMEMORY_BARRIER();
+		xTail = pxStreamBuffer->xTail;
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Nothing to read. */
+			xCount = 0;
+		}
+		else if( xBytesToStoreMessageLength != ( size_t ) 0 )
 		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			/* The spans describe the next message, but not its length, which
+			is skipped over. */
+			xTail = prvReadBytesFromBuffer( ( StreamBuffer_t * ) pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xTail ); /*lint !e9005 The buffer is only read. */
+			xCount = ( size_t ) xTempNextMessageLength;
+			configASSERT( xCount <= ( xBytesAvailable - xBytesToStoreMessageLength ) );
+		}
+		else
+		{
+			/* The spans describe every byte in the stream buffer. */
+			xCount = xBytesAvailable;
+		}
+
+		/* The first span runs to the end of the data or the end of the storage
+		area, whichever comes first, and the second holds anything that wrapped
+		around to the start of the storage area. */
+		xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+		pxSpans[ 0 ].pvData = ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+		pxSpans[ 0 ].xLength = xFirstLength;
+		pxSpans[ 1 ].pvData = ( const void * ) pxStreamBuffer->pucBuffer;
+		pxSpans[ 1 ].xLength = xCount - xFirstLength;
+
+		return xCount;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_SCATTER_GATHER == 1 )
+
+	static BaseType_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xConsumedBytes )
+	{
+	size_t xBytesAvailable, xTail;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+	BaseType_t xReturn = pdFAIL;
+
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		portMEMORY_BARRIER();
+		xTail = pxStreamBuffer->xTail;
+
+		if( xConsumedBytes == ( size_t ) 0 )
+		{
+			/* Nothing is removed, so the spans obtained by the last acquire
+			remain valid. */
+			xReturn = pdPASS;
+		}
+		else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* Messages can only be removed whole, along with their length. */
+			if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+			{
+				xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+
+				if( ( size_t ) xTempNextMessageLength == xConsumedBytes )
+				{
+					xReturn = pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( xConsumedBytes <= xBytesAvailable )
+		{
+			xReturn = pdPASS;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
+		if( ( xReturn != pdFAIL ) && ( xConsumedBytes != ( size_t ) 0 ) )
+		{
+			/* Move the tail to effectively remove the data from the buffer. */
+			xTail += xConsumedBytes;
+
+			if( xTail >= pxStreamBuffer->xLength )
+			{
+				xTail -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		if( xNextTail >= pxStreamBuffer->xLength )
+			/* As prvReadMessageFromBuffer(), the data is finished with before
+			the tail moves, and the tail moves before xTaskWaitingToSend is
+			read. */
+			portMEMORY_BARRIER();
+			pxStreamBuffer->xTail = xTail;
+			portMEMORY_BARRIER();
+		}
+		else
 		{
-			xNextTail -= pxStreamBuffer->xLength;
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		pxStreamBuffer->xTail = xNextTail;
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
+		return xReturn;
 	}
 
-	return xCount;
-}
+#endif /* configUSE_STREAM_BUFFER_SCATTER_GATHER */
 /*-----------------------------------------------------------*/
 
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
@@ -1195,7 +1746,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
 										  size_t xTriggerLevelBytes,
-										  BaseType_t xIsMessageBuffer )
+										  uint8_t ucFlags )
 {
 	/* Assert here is deliberately writing to the entire buffer to ensure it can
 	be written to without generating exceptions, and is setting the buffer to a
@@ -1214,11 +1765,34 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	pxStreamBuffer->pucBuffer = pucBuffer;
 	pxStreamBuffer->xLength = xBufferSizeBytes;
 	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	pxStreamBuffer->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvCreateFlags( BaseType_t xIsMessageBuffer )
+{
+uint8_t ucFlags = ( uint8_t ) 0;
+
+	if( ( xIsMessageBuffer & sbFLAGS_LOCKFREE_SPSC ) != 0 )
+	{
+		ucFlags |= ( uint8_t ) sbFLAGS_LOCKFREE_SPSC;
+		xIsMessageBuffer &= ~sbFLAGS_LOCKFREE_SPSC;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
 	if( xIsMessageBuffer != pdFALSE )
 	{
-		pxStreamBuffer->ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+		ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
 	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ucFlags;
 }
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -40,6 +40,14 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+	#include "queue.h"
+#endif
+
+#if( configUSE_DEFERRED_WORK == 1 )
+	#include "deferred_work.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -64,6 +72,67 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* Values that can be assigned to the xTaskRunState member of the TCB, other
+	than the number of the core the task is running on. */
+	#define taskTASK_NOT_RUNNING			( ( BaseType_t ) -1 )
+	#define taskTASK_SCHEDULED_TO_YIELD		( ( BaseType_t ) -2 )
+
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( ( pxTCB )->xTaskRunState >= ( BaseType_t ) 0 ) && ( ( pxTCB )->xTaskRunState < ( BaseType_t ) configNUMBER_OF_CORES ) )
+
+	/* A task that has been asked to yield is still using its core until the
+	core takes the yield. */
+	#define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* Bits that can be set in the uxTaskAttributes member of the TCB. */
+	#define taskATTRIBUTE_IS_IDLE			( ( UBaseType_t ) 1U )
+
+	/* Ask core xCoreID to select a new task.  A yield of the calling core is
+	held pending until the critical section the caller must be in is left.
+	Must be called with the ISR lock held. */
+	#define prvYieldCore( xCoreID )																		\
+	{																									\
+		if( ( xCoreID ) == ( BaseType_t ) portGET_CORE_ID() )											\
+		{																								\
+			xYieldPendings[ ( xCoreID ) ] = pdTRUE;														\
+		}																								\
+		else if( pxCurrentTCBs[ ( xCoreID ) ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )			\
+		{																								\
+			portYIELD_CORE( xCoreID );																	\
+			pxCurrentTCBs[ ( xCoreID ) ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;					\
+		}																								\
+		else																							\
+		{																								\
+			mtCOVERAGE_TEST_MARKER();																	\
+		}																								\
+	}
+
+	#if( configUSE_PREEMPTION == 0 )
+		#define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )
+		#define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )
+	#else
+		/* Yield the core pxTCB is running on, if any, so the core can select a
+		task of higher priority. */
+		#define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )										\
+		{																								\
+			if( taskTASK_IS_RUNNING( pxTCB ) )															\
+			{																							\
+				prvYieldCore( ( pxTCB )->xTaskRunState );												\
+			}																							\
+		}
+
+		/* Yield whichever core is running the task of lowest priority, if
+		pxTCB should be running in its place. */
+		#define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )	prvYieldForTask( pxTCB )
+	#endif
+
+#else
+
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( pxTCB ) == pxCurrentTCB )
+
+#endif /* configNUMBER_OF_CORES */
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
@@ -100,7 +169,7 @@ changed then the definition of StaticTask_t must also be updated. */
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
 set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( configUSE_STACK_WATERMARK_SCANNER == 1 ) )
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	1
 #else
 	#define tskSET_NEW_STACKS_TO_KNOWN_VALUE	0
@@ -129,7 +198,24 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* Each core selects its own task from the shared ready lists, see
+	prvSelectHighestPriorityTask(). */
+	#define taskRECORD_READY_PRIORITY( uxPriority )														\
+	{																									\
+		if( ( uxPriority ) > uxTopReadyPriority )														\
+		{																								\
+			uxTopReadyPriority = ( uxPriority );														\
+		}																								\
+	} /* taskRECORD_READY_PRIORITY */
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID )	prvSelectHighestPriorityTask( xCoreID )
+
+	#define taskRESET_READY_PRIORITY( uxPriority )
+	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
 	performed in a generic way that is not optimised to any particular
@@ -261,6 +347,47 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+#if( configGENERATE_CPU_LOAD_STATS == 1 )
+	/* The CPU load is sampled every taskCPU_LOAD_SAMPLE_TICKS, and held as a
+	fraction of taskCPU_LOAD_ONE in three rolling averages.  Each sample moves
+	an average towards the load seen since the previous sample by the weight
+	held in usCpuLoadWeights[]. */
+	#define taskCPU_LOAD_AVERAGES		3
+	#define taskCPU_LOAD_SAMPLE_TICKS	( ( TickType_t ) pdMS_TO_TICKS( 100 ) )
+	#define taskCPU_LOAD_ONE_SHIFT		24
+	#define taskCPU_LOAD_ONE			( 1UL << taskCPU_LOAD_ONE_SHIFT )
+
+	/* Time spent in interrupts is recorded against the interrupt nesting
+	level. */
+	typedef struct xISR_CPU_LOAD
+	{
+		configRUN_TIME_COUNTER_TYPE ulEnterTime;			/*< The run time counter when the interrupt at this level was entered. */
+		configRUN_TIME_COUNTER_TYPE ulNestedTime;			/*< The time the interrupt at this level has spent interrupted. */
+		configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;		/*< The total time spent in interrupts at this level, excluding the time spent interrupted. */
+		configRUN_TIME_COUNTER_TYPE ulLoadSampleRunTime;	/*< The value of ulRunTimeCounter when the CPU load was last sampled. */
+		uint32_t ulCpuLoad[ taskCPU_LOAD_AVERAGES ];		/*< As the TCB member of the same name. */
+	} ISRCpuLoad_t;
+#endif /* configGENERATE_CPU_LOAD_STATS */
+
+#if( ( configGENERATE_CPU_LOAD_STATS == 1 ) || ( configGENERATE_ISR_LATENCY_STATS == 1 ) )
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define taskREAD_RUN_TIME_COUNTER( ulValue )	portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulValue ) )
+	#else
+		#define taskREAD_RUN_TIME_COUNTER( ulValue )	( ulValue ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+	/* An instrumented interrupt that is running, or that has been interrupted
+	by another instrumented interrupt. */
+	typedef struct xISR_LATENCY_LEVEL
+	{
+		UBaseType_t uxVector;							/*< The vector of the interrupt at this level. */
+		configRUN_TIME_COUNTER_TYPE ulEnterTime;		/*< The run time counter when the interrupt at this level was entered. */
+		configRUN_TIME_COUNTER_TYPE ulNestedTime;		/*< The time the interrupt at this level has spent interrupted. */
+	} ISRLatencyLevel_t;
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -288,6 +415,15 @@ typedef struct TaskControlBlock_t
 		UBaseType_t		uxCriticalNesting;	/*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
 	#endif
 
+	#if ( configNUMBER_OF_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;	/*< The core the task is running on, or taskTASK_NOT_RUNNING or taskTASK_SCHEDULED_TO_YIELD. */
+		UBaseType_t		uxTaskAttributes;	/*< taskATTRIBUTE_IS_IDLE is set in the TCB of each idle task. */
+	#endif
+
+	#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+		UBaseType_t		uxCoreAffinityMask;	/*< Bit n is set if the task can run on core n. */
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxTCBNumber;		/*< Stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
 		UBaseType_t		uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
@@ -298,6 +434,11 @@ typedef struct TaskControlBlock_t
 		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+		List_t			xMutexesHeldList;	/*< The mutexes held by the task, so the priority it must keep when it gives one back can be found. */
+		void			*pvMutexWaitedFor;	/*< The mutex the task is blocked waiting for, if any. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
@@ -307,7 +448,20 @@ typedef struct TaskControlBlock_t
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+	#endif
+
+	#if( configGENERATE_CPU_LOAD_STATS == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulLoadSampleRunTime;	/*< The value of ulRunTimeCounter when the CPU load was last sampled. */
+		uint32_t		ulCpuLoad[ taskCPU_LOAD_AVERAGES ];	/*< The rolling averages of the share of the CPU time used, as fractions of taskCPU_LOAD_ONE. */
+	#endif
+
+	#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		ListItem_t		xWatermarkListItem;	/*< Links the task into xStackWatermarkList. */
+		uint32_t		ulStackDepth;		/*< The size of the stack, in words. */
+		uint32_t		ulWatermark;		/*< The least free stack space found by the scans completed so far, in words. */
+		uint32_t		ulWatermarkCursor;	/*< The number of words from the end of the stack the scan in progress has found unused. */
+		uint8_t			ucWatermarkWarned;	/*< Set to pdTRUE once vApplicationStackWatermarkHook() has been called for the task. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -322,8 +476,8 @@ typedef struct TaskControlBlock_t
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -344,7 +498,18 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if( configNUMBER_OF_CORES == 1 )
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+
+#else
+
+	/* The task running on each core.  Tasks only ever read the entry for the
+	core they are running on, see prvGetCurrentTCB(). */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+	#define pxCurrentTCB prvGetCurrentTCB()
+
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
@@ -356,6 +521,7 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
 	PRIVILEGED_DATA static volatile UBaseType_t uxDeletedTasksWaitingCleanUp = ( UBaseType_t ) 0U;
+	PRIVILEGED_DATA static TaskCleanupStats_t xTaskCleanupStats = { 0 };	/*< Returned by vTaskGetCleanupStats(). */
 
 #endif
 
@@ -365,17 +531,39 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 #endif
 
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	/* Every task that has not been deleted, in the order the idle task is to
+	scan their stacks.  The task at the head is the one being scanned. */
+	PRIVILEGED_DATA static List_t xStackWatermarkList;
+
+#endif
+
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+
+#if( configNUMBER_OF_CORES == 1 )
+
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+
+#else
+
+	/* A yield is held pending for each core in turn, and each core has its own
+	idle task.  xYieldPending refers to the entry of the calling core, so must
+	only be used with interrupts masked. */
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL };
+	#define xYieldPending	xYieldPendings[ portGET_CORE_ID() ]
+
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -387,6 +575,60 @@ when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	#if( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#else
+		/* Each core switches tasks independently, so keeps its own switch time. */
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUMBER_OF_CORES ] = { 0UL };
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTimes[ configNUMBER_OF_CORES ] = { 0UL };
+	#endif
+
+#endif
+
+#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+
+	/* The time slice of each priority set by vTaskSetTimeSlice(), or 0 where
+	configTIME_SLICE_TICKS() applies. */
+	PRIVILEGED_DATA static TickType_t xTimeSlices[ configMAX_PRIORITIES ] = { ( TickType_t ) 0U };
+
+	#if( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static TickType_t xTicksInTimeSlice = ( TickType_t ) 0U;	/*< Ticks since the running task was switched in. */
+	#else
+		PRIVILEGED_DATA static TickType_t xTicksInTimeSlices[ configNUMBER_OF_CORES ] = { ( TickType_t ) 0U };
+	#endif
+
+#endif
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	/* The weight given to each new sample by the 1, 10 and 60 second averages,
+	which is 1 - exp( -0.1s / T ) scaled by 2^16 for each time constant T. */
+	static const uint16_t usCpuLoadWeights[ taskCPU_LOAD_AVERAGES ] = { 6237U, 652U, 109U };
+
+	PRIVILEGED_DATA static TickType_t xLastCpuLoadSampleTick = ( TickType_t ) 0U;
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulLastCpuLoadSampleTime = 0UL;
+	PRIVILEGED_DATA static ISRCpuLoad_t xISRCpuLoad[ configCPU_LOAD_ISR_LEVELS ];
+	PRIVILEGED_DATA static UBaseType_t uxCpuLoadISRNesting = ( UBaseType_t ) 0U;
+
+#endif
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	PRIVILEGED_DATA static ISRLatency_t xISRLatency[ tskISR_LATENCY_HISTOGRAMS ];
+	PRIVILEGED_DATA static ISRLatencyLevel_t xISRLatencyLevels[ configISR_LATENCY_NESTING_LEVELS ];
+	PRIVILEGED_DATA static UBaseType_t uxISRLatencyNesting = ( UBaseType_t ) 0U;
+
+	/* Interrupts can only be masked by one context at a time, so one record of
+	the outermost masked period is enough. */
+	PRIVILEGED_DATA static UBaseType_t uxISRLatencyMaskNesting = ( UBaseType_t ) 0U;
+	PRIVILEGED_DATA static UBaseType_t uxISRLatencyMaskHistogram = ( UBaseType_t ) 0U;
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulISRLatencyMaskTime = 0UL;
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -410,6 +652,26 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+
+	/* Provides the memory for the idle task of each core other than core 0,
+	xPassiveIdleTaskIndex being 0 for core 1 and so on. */
+	extern void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if( ( configUSE_PASSIVE_IDLE_HOOK == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+
+	extern void vApplicationPassiveIdleHook( void ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if( ( configUSE_STACK_WATERMARK_SCANNER == 1 ) && ( configSTACK_WATERMARK_WARNING_PERCENT > 0 ) )
+
+	extern void vApplicationStackWatermarkHook( TaskHandle_t xTask, char *pcTaskName, uint32_t ulWatermark ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 /* File private functions. --------------------------------*/
 
 /**
@@ -423,6 +685,16 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif /* INCLUDE_vTaskSuspend */
 
+#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+
+	/*
+	 * Returns pdTRUE if a task of priority uxPriority that has run for
+	 * xTicksInSlice ticks has used up its time slice.
+	 */
+	static BaseType_t prvTimeSliceEnded( UBaseType_t uxPriority, TickType_t xTicksInSlice ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIME_SLICE_QUANTA */
+
 /*
  * Utility to ready all the lists used by the scheduler.  This is called
  * automatically upon the creation of the first task.
@@ -442,6 +714,88 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * The idle task of each core other than core 0.  Only the idle task of core
+	 * 0 frees deleted tasks and enters low power modes, the others just give way
+	 * to any other task that is ready to run.
+	 */
+	static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters );
+
+	/*
+	 * Return the task running on the calling core.  Used in place of
+	 * pxCurrentTCB, so interrupts are masked while the core number is read and
+	 * used unless the caller is already in a critical section.
+	 */
+	static TCB_t *prvGetCurrentTCB( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Select the next task to run on core xCoreID.  A task is only selected if
+	 * it is not already running on another core, and (if configUSE_CORE_AFFINITY
+	 * is 1) its affinity mask includes xCoreID.  Called from
+	 * vTaskSwitchContext() with both kernel locks held.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * pxTCB has just been made ready to run, or had its priority raised.  Ask
+	 * the core running the task of lowest priority to yield if pxTCB should be
+	 * running in its place.  Must be called from within a critical section.
+	 */
+	#if( configUSE_PREEMPTION == 1 )
+
+		static void prvYieldForTask( const TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+	/*
+	 * Called with the kernel locks held when a task enters a critical section or
+	 * suspends the scheduler.  If another core asked the calling task to yield
+	 * before the locks were taken then the locks are dropped so the yield can
+	 * be taken, then taken again.
+	 */
+	static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return uxSchedulerSuspended, read from within a critical section.
+	 */
+	static UBaseType_t prvGetSchedulerSuspended( void ) PRIVILEGED_FUNCTION;
+
+	#define taskGET_SCHEDULER_SUSPENDED()	prvGetSchedulerSuspended()
+
+#else
+
+	#define taskGET_SCHEDULER_SUSPENDED()	uxSchedulerSuspended
+
+#endif /* configNUMBER_OF_CORES */
+
+#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	/*
+	 * Return the priority pxTCB must run at to honour the mutexes it holds -
+	 * the greater of its base priority and the priority of the highest
+	 * priority task waiting for any of them.
+	 */
+	static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Change the priority of pxTCB to uxNewPriority, moving it to the matching
+	 * ready list if it is ready to run.
+	 */
+	static void prvSetInheritedPriority( TCB_t * const pxTCB, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The priority of pxTCB has changed.  If pxTCB is waiting for a mutex then
+	 * follow the chain of mutex holders from it, setting each to the priority
+	 * its held mutexes now require, until a holder's priority does not change
+	 * or configPRIORITY_INHERITANCE_CHAIN_DEPTH holders have been visited.
+	 * Must be called from a critical section.
+	 */
+	static void prvPassOnInheritedPriority( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -462,6 +816,28 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used only by the idle task.  Checks up to configSTACK_WATERMARK_SCAN_WORDS
+ * words of the stack of the task at the head of xStackWatermarkList, moving on
+ * to the next task once the scan of its stack is complete.
+ */
+#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+
+	static void prvScanStackWatermark( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Frees the memory of the tasks that deleted themselves from the calling task,
+ * rather than the idle task, once configTASK_CLEANUP_THRESHOLD of them are
+ * waiting.  Called by the task creation and deletion functions.
+ */
+#if( ( INCLUDE_vTaskDelete == 1 ) && ( configTASK_CLEANUP_THRESHOLD > 0 ) )
+
+	static void prvReclaimDeletedTasks( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
@@ -524,6 +900,45 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	/*
+	 * Called from the tick interrupt every taskCPU_LOAD_SAMPLE_TICKS to update
+	 * the rolling CPU load averages of every task and interrupt nesting level.
+	 */
+	static void prvSampleCpuLoad( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move each of the rolling averages in pulCpuLoad towards the share of
+	 * ulElapsedTime that ulRunTime represents.  ullReciprocal is 2^48 divided
+	 * by ulElapsedTime.
+	 */
+	static void prvUpdateCpuLoad( uint32_t *pulCpuLoad, configRUN_TIME_COUNTER_TYPE ulRunTime, configRUN_TIME_COUNTER_TYPE ulElapsedTime, uint64_t ullReciprocal ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Convert the rolling averages in pulCpuLoad to hundredths of a percent.
+	 */
+	static UBaseType_t prvReportCpuLoad( const uint32_t *pulCpuLoad, CpuLoad_t * const pxLoad ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	/*
+	 * Add ulTime to the histogram uxHistogram.  ulNestedTime is the time the
+	 * interrupt spent interrupted, or 0 for a masked period.  Must be called
+	 * with interrupts masked.
+	 */
+	static void prvRecordISRLatency( UBaseType_t uxHistogram, configRUN_TIME_COUNTER_TYPE ulTime, configRUN_TIME_COUNTER_TYPE ulNestedTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The name of histogram uxHistogram, or NULL for an application vector
+	 * that has not been named.
+	 */
+	static const char *prvGetISRLatencyName( UBaseType_t uxHistogram ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -553,6 +968,18 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Allocate and initialise the TCB and stack of a task created by
+ * xTaskCreate() or xTaskCreateAffinitySet(), without yet placing the task under
+ * the control of the scheduler.  Returns NULL if the memory could not be
+ * allocated.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static TCB_t *prvCreateTask( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -623,6 +1050,100 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	BaseType_t xTaskCreateStaticSet( const StaticTaskDefinition_t * const pxTaskDefinitions, const UBaseType_t uxNumberOfTasks )
+	{
+	const StaticTaskDefinition_t *pxDefinition;
+	TCB_t *pxNewTCB;
+	TaskHandle_t xCreatedTask;
+	UBaseType_t uxTask;
+	BaseType_t xReturn = pdPASS;
+
+		/* Tasks created after the scheduler has started might have to run
+		straight away, so have to be created one at a time. */
+		configASSERT( xSchedulerRunning == pdFALSE );
+		configASSERT( pxTaskDefinitions != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* See the same check in xTaskCreateStatic(). */
+			volatile size_t xSize = sizeof( StaticTask_t );
+			configASSERT( xSize == sizeof( TCB_t ) );
+			( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		/* Check the whole table before anything is created so a bad entry does
+		not leave the system half built. */
+		for( uxTask = 0U; uxTask < uxNumberOfTasks; uxTask++ )
+		{
+			pxDefinition = &( pxTaskDefinitions[ uxTask ] );
+			configASSERT( pxDefinition->puxStackBuffer != NULL );
+			configASSERT( pxDefinition->pxTaskBuffer != NULL );
+
+			if( ( pxDefinition->puxStackBuffer == NULL ) || ( pxDefinition->pxTaskBuffer == NULL ) )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( xReturn == pdPASS )
+		{
+			/* Initialising a TCB and its stack does not touch the kernel
+			lists, so is done outside of the critical section. */
+			for( uxTask = 0U; uxTask < uxNumberOfTasks; uxTask++ )
+			{
+				pxDefinition = &( pxTaskDefinitions[ uxTask ] );
+				pxNewTCB = ( TCB_t * ) pxDefinition->pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+				pxNewTCB->pxStack = pxDefinition->puxStackBuffer;
+
+				#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+				{
+					pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+				}
+				#endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+				prvInitialiseNewTask( pxDefinition->pxTaskCode, pxDefinition->pcName, pxDefinition->ulStackDepth, pxDefinition->pvParameters, pxDefinition->uxPriority, &xCreatedTask, pxNewTCB, NULL );
+
+				if( pxDefinition->pxCreatedTask != NULL )
+				{
+					*( pxDefinition->pxCreatedTask ) = xCreatedTask;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Then the whole table is linked into the ready lists in one
+			pass.  The critical sections entered by prvAddNewTaskToReadyList()
+			only nest within this one, and as the scheduler is not running
+			none of the tasks is yielded to. */
+			taskENTER_CRITICAL();
+			{
+				for( uxTask = 0U; uxTask < uxNumberOfTasks; uxTask++ )
+				{
+					prvAddNewTaskToReadyList( ( TCB_t * ) pxTaskDefinitions[ uxTask ].pxTaskBuffer ); /*lint !e740 !e9087 See above. */
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 #if( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
 	BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition, TaskHandle_t *pxCreatedTask )
@@ -720,15 +1241,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	BaseType_t xTaskCreate(	TaskFunction_t pxTaskCode,
-							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-							const configSTACK_DEPTH_TYPE usStackDepth,
-							void * const pvParameters,
-							UBaseType_t uxPriority,
-							TaskHandle_t * const pxCreatedTask )
+	static TCB_t *prvCreateTask(	TaskFunction_t pxTaskCode,
+									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const configSTACK_DEPTH_TYPE usStackDepth,
+									void * const pvParameters,
+									UBaseType_t uxPriority,
+									TaskHandle_t * const pxCreatedTask )
 	{
 	TCB_t *pxNewTCB;
-	BaseType_t xReturn;
+
+		#if( ( INCLUDE_vTaskDelete == 1 ) && ( configTASK_CLEANUP_THRESHOLD > 0 ) )
+		{
+			/* Make the memory of deleted tasks available to the new task. */
+			prvReclaimDeletedTasks();
+		}
+		#endif
 
 		/* If the stack grows down then allocate the stack then the TCB so the stack
 		does not grow into the TCB.  Likewise if the stack grows up then allocate
@@ -797,6 +1324,30 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewTCB;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskCreate(	TaskFunction_t pxTaskCode,
+							const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+							const configSTACK_DEPTH_TYPE usStackDepth,
+							void * const pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t * const pxCreatedTask )
+	{
+	TCB_t *pxNewTCB;
+	BaseType_t xReturn;
+
+		pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+		if( pxNewTCB != NULL )
+		{
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
 		}
@@ -807,6 +1358,39 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
+
+	#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+		BaseType_t xTaskCreateAffinitySet(	TaskFunction_t pxTaskCode,
+											const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const configSTACK_DEPTH_TYPE usStackDepth,
+											void * const pvParameters,
+											UBaseType_t uxPriority,
+											UBaseType_t uxCoreAffinityMask,
+											TaskHandle_t * const pxCreatedTask )
+		{
+		TCB_t *pxNewTCB;
+		BaseType_t xReturn;
+
+			pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+			if( pxNewTCB != NULL )
+			{
+				/* Set the affinity before the task can be selected to run. */
+				pxNewTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+				prvAddNewTaskToReadyList( pxNewTCB );
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+			}
+
+			return xReturn;
+		}
+
+	#endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) */
 
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
@@ -921,6 +1505,13 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+	{
+		vListInitialise( &( pxNewTCB->xMutexesHeldList ) );
+		pxNewTCB->pvMutexWaitedFor = NULL;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -938,6 +1529,28 @@ UBaseType_t x;
 	}
 	#endif /* portCRITICAL_NESTING_IN_TCB */
 
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+		/* The idle tasks are the only tasks a core can always select. */
+		if( ( pxTaskCode == prvIdleTask ) || ( pxTaskCode == prvPassiveIdleTask ) )
+		{
+			pxNewTCB->uxTaskAttributes = taskATTRIBUTE_IS_IDLE;
+		}
+		else
+		{
+			pxNewTCB->uxTaskAttributes = ( UBaseType_t ) 0U;
+		}
+
+		#if ( configUSE_CORE_AFFINITY == 1 )
+		{
+			pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+		}
+		#endif
+	}
+	#endif /* configNUMBER_OF_CORES */
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 	{
 		pxNewTCB->pxTaskTag = NULL;
@@ -950,6 +1563,25 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+	{
+		pxNewTCB->ulLoadSampleRunTime = 0UL;
+		( void ) memset( ( void * ) pxNewTCB->ulCpuLoad, 0x00, sizeof( pxNewTCB->ulCpuLoad ) );
+	}
+	#endif /* configGENERATE_CPU_LOAD_STATS */
+
+	#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
+	{
+		/* Until the first scan the whole stack is taken to be unused. */
+		vListInitialiseItem( &( pxNewTCB->xWatermarkListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxNewTCB->xWatermarkListItem ), pxNewTCB );
+		pxNewTCB->ulStackDepth = ulStackDepth;
+		pxNewTCB->ulWatermark = ulStackDepth;
+		pxNewTCB->ulWatermarkCursor = 0UL;
+		pxNewTCB->ucWatermarkWarned = pdFALSE;
+	}
+	#endif /* configUSE_STACK_WATERMARK_SCANNER */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -972,8 +1604,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1017,6 +1652,8 @@ UBaseType_t x;
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES == 1 )
+
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 {
 	/* Ensure interrupts don't access the task lists while the lists are being
@@ -1076,6 +1713,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		prvAddTaskToReadyList( pxNewTCB );
 
+		#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		{
+			vListInsertEnd( &xStackWatermarkList, &( pxNewTCB->xWatermarkListItem ) );
+		}
+		#endif
+
 		portSETUP_TCB( pxNewTCB );
 	}
 	taskEXIT_CRITICAL();
@@ -1098,6 +1741,85 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		mtCOVERAGE_TEST_MARKER();
 	}
 }
+
+#else /* configNUMBER_OF_CORES */
+
+static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
+{
+	/* Ensure interrupts, and the other cores, don't access the task lists
+	while the lists are being updated. */
+	taskENTER_CRITICAL();
+	{
+		uxCurrentNumberOfTasks++;
+
+		if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+		{
+			/* This is the first task to be created so do the preliminary
+			initialisation required. */
+			prvInitialiseTaskLists();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Each core starts by running its idle task, which yields to whichever
+		task is of highest priority as soon as it runs.  The idle tasks are
+		created in core order by vTaskStartScheduler(). */
+		if( ( xSchedulerRunning == pdFALSE ) && ( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) )
+		{
+		BaseType_t xCoreID;
+
+			for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				if( pxCurrentTCBs[ xCoreID ] == NULL )
+				{
+					pxNewTCB->xTaskRunState = xCoreID;
+					pxCurrentTCBs[ xCoreID ] = pxNewTCB;
+					break;
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxTaskNumber++;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			/* Add a counter into the TCB for tracing only. */
+			pxNewTCB->uxTCBNumber = uxTaskNumber;
+		}
+		#endif /* configUSE_TRACE_FACILITY */
+		traceTASK_CREATE( pxNewTCB );
+
+		prvAddTaskToReadyList( pxNewTCB );
+
+		#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		{
+			vListInsertEnd( &xStackWatermarkList, &( pxNewTCB->xWatermarkListItem ) );
+		}
+		#endif
+
+		portSETUP_TCB( pxNewTCB );
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The new task runs straight away if a core is running a task of
+			lower priority. */
+			taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -1105,6 +1827,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	void vTaskDelete( TaskHandle_t xTaskToDelete )
 	{
 	TCB_t *pxTCB;
+	BaseType_t xTaskIsRunning, xDeleteTCB = pdFALSE;
+
+		#if( configTASK_CLEANUP_THRESHOLD > 0 )
+		{
+			/* This is done before the task is deleted, so a task deleting
+			itself is not on the termination list yet. */
+			prvReclaimDeletedTasks();
+		}
+		#endif
 
 		taskENTER_CRITICAL();
 		{
@@ -1132,19 +1863,41 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_STACK_WATERMARK_SCANNER == 1 )
+			{
+				/* The idle task does not hold on to the TCB between scans, so
+				the task can be freed as soon as it is out of the list. */
+				( void ) uxListRemove( &( pxTCB->xWatermarkListItem ) );
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			#if( configNUMBER_OF_CORES == 1 )
+			{
+				xTaskIsRunning = ( pxTCB == pxCurrentTCB );
+			}
+			#else
+			{
+				/* The task could be running on any core. */
+				xTaskIsRunning = taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB );
+			}
+			#endif
+
+			if( xTaskIsRunning != pdFALSE )
 			{
 				/* A task is deleting itself.  This cannot complete within the
 				task itself, as a context switch to another task is required.
 				Place the task in the termination list.  The idle task will
 				check the termination list and free up any memory allocated by
-				the scheduler for the TCB and stack of the deleted task. */
+				the scheduler for the TCB and stack of the deleted task.  The
+				list item value is not used by the termination list, so holds
+				the time the task was deleted for vTaskGetCleanupStats(). */
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTickCount );
 				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
 				/* Increment the ucTasksDeleted variable so the idle task knows
@@ -1152,6 +1905,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				check the xTasksWaitingTermination list. */
 				++uxDeletedTasksWaitingCleanUp;
 
+				if( uxDeletedTasksWaitingCleanUp > xTaskCleanupStats.uxMostWaiting )
+				{
+					xTaskCleanupStats.uxMostWaiting = uxDeletedTasksWaitingCleanUp;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
 				/* The pre-delete hook is primarily for the Windows simulator,
 				in which Windows specific clean up operations are performed,
 				after which it is not possible to yield away from this task -
@@ -1162,7 +1924,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			else
 			{
 				--uxCurrentNumberOfTasks;
-				prvDeleteTCB( pxTCB );
+				xDeleteTCB = pdTRUE;
 
 				/* Reset the next expected unblock time in case it referred to
 				the task that has just been deleted. */
@@ -1170,23 +1932,60 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 
 			traceTASK_DELETE( pxTCB );
+
+			#if( configNUMBER_OF_CORES > 1 )
+			{
+				/* Force a reschedule of the core the deleted task is running
+				on.  The calling core yields when the critical section is
+				left. */
+				if( pxTCB == pxCurrentTCB )
+				{
+					configASSERT( uxSchedulerSuspended == 0 );
+					vTaskYieldWithinAPI();
+				}
+				else if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					prvYieldCore( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 		taskEXIT_CRITICAL();
 
-		/* Force a reschedule if it is the currently running task that has just
-		been deleted. */
-		if( xSchedulerRunning != pdFALSE )
+		/* The TCB is freed outside of the critical section as freeing memory
+		can suspend the scheduler, which a multi-core build does not allow
+		from within a critical section. */
+		if( xDeleteTCB != pdFALSE )
 		{
-			if( pxTCB == pxCurrentTCB )
-			{
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
-			}
-			else
+			prvDeleteTCB( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configNUMBER_OF_CORES == 1 )
+		{
+			/* Force a reschedule if it is the currently running task that has
+			just been deleted. */
+			if( xSchedulerRunning != pdFALSE )
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( pxTCB == pxCurrentTCB )
+				{
+					configASSERT( uxSchedulerSuspended == 0 );
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1201,7 +2000,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxPreviousWakeTime );
 		configASSERT( ( xTimeIncrement > 0U ) );
-		configASSERT( uxSchedulerSuspended == 0 );
+		configASSERT( taskGET_SCHEDULER_SUSPENDED() == 0 );
 
 		vTaskSuspendAll();
 		{
@@ -1285,7 +2084,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		/* A delay time of zero just forces a reschedule. */
 		if( xTicksToDelay > ( TickType_t ) 0U )
 		{
-			configASSERT( uxSchedulerSuspended == 0 );
+			configASSERT( taskGET_SCHEDULER_SUSPENDED() == 0 );
 			vTaskSuspendAll();
 			{
 				traceTASK_DELAY();
@@ -1331,7 +2130,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) )
 		{
 			/* The task calling this function is querying its own state. */
 			eReturn = eRunning;
@@ -1363,17 +2162,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1460,14 +2263,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 		{
 			/* If null is passed in here then it is the priority of the calling
 			task that is being queried. */
 			pxTCB = prvGetTCBFromHandle( xTask );
 			uxReturn = pxTCB->uxPriority;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
 		return uxReturn;
 	}
@@ -1483,6 +2286,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
 	BaseType_t xYieldRequired = pdFALSE;
 
+	#if( configNUMBER_OF_CORES > 1 )
+		BaseType_t xYieldForTask = pdFALSE;
+	#endif
+
 		configASSERT( ( uxNewPriority < configMAX_PRIORITIES ) );
 
 		/* Ensure the new priority is valid. */
@@ -1519,28 +2326,38 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				priority than the calling task. */
 				if( uxNewPriority > uxCurrentBasePriority )
 				{
-					if( pxTCB != pxCurrentTCB )
+					#if( configNUMBER_OF_CORES == 1 )
 					{
-						/* The priority of a task other than the currently
-						running task is being raised.  Is the priority being
-						raised above that of the running task? */
-						if( uxNewPriority >= pxCurrentTCB->uxPriority )
+						if( pxTCB != pxCurrentTCB )
 						{
-							xYieldRequired = pdTRUE;
+							/* The priority of a task other than the currently
+							running task is being raised.  Is the priority being
+							raised above that of the running task? */
+							if( uxNewPriority >= pxCurrentTCB->uxPriority )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
 						}
 						else
 						{
-							mtCOVERAGE_TEST_MARKER();
+							/* The priority of the running task is being raised,
+							but the running task must already be the highest
+							priority task able to run so no yield is required. */
 						}
 					}
-					else
+					#else
 					{
-						/* The priority of the running task is being raised,
-						but the running task must already be the highest
-						priority task able to run so no yield is required. */
+						/* The task may now be of higher priority than a task
+						running on one of the cores. */
+						xYieldForTask = pdTRUE;
 					}
+					#endif /* configNUMBER_OF_CORES */
 				}
-				else if( pxTCB == pxCurrentTCB )
+				else if( taskTASK_IS_RUNNING( pxTCB ) )
 				{
 					/* Setting the priority of the running task down means
 					there may now be another task of higher priority that
@@ -1619,14 +2436,35 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
-				if( xYieldRequired != pdFALSE )
+				#if( configNUMBER_OF_CORES == 1 )
 				{
-					taskYIELD_IF_USING_PREEMPTION();
+					if( xYieldRequired != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					if( xYieldRequired != pdFALSE )
+					{
+						/* The priority of a running task was lowered, so the
+						core it is running on yields. */
+						taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+					}
+					else if( xYieldForTask != pdFALSE )
+					{
+						taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUMBER_OF_CORES */
 
 				/* Remove compiler warning about unused variables when the port
 				optimised task selection is not being used. */
@@ -1639,30 +2477,118 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_TIME_SLICE_QUANTA == 1 )
 
-	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	void vTaskSetTimeSlice( UBaseType_t uxPriority, TickType_t xTicks )
 	{
-	TCB_t *pxTCB;
+		configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
+		/* The tick interrupt reads the time slice, and TickType_t may be wider
+		than the port can write atomically. */
 		taskENTER_CRITICAL();
 		{
-			/* If null is passed in here then it is the running task that is
-			being suspended. */
-			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+			xTimeSlices[ uxPriority ] = xTicks;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
 
-			traceTASK_SUSPEND( pxTCB );
+	TickType_t xTaskGetTimeSlice( UBaseType_t uxPriority )
+	{
+	TickType_t xTicks;
 
-			/* Remove task from the ready/delayed list and place in the
-			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-			{
-				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+		configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+		{
+			uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			xTicks = xTimeSlices[ uxPriority ];
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTicks == ( TickType_t ) 0U )
+		{
+			xTicks = configTIME_SLICE_TICKS( uxPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xTicks;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTimeSliceEnded( UBaseType_t uxPriority, TickType_t xTicksInSlice )
+	{
+	TickType_t xTicks = xTimeSlices[ uxPriority ];
+	BaseType_t xReturn;
+
+		if( xTicks == ( TickType_t ) 0U )
+		{
+			xTicks = configTIME_SLICE_TICKS( uxPriority );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xTicks != portMAX_DELAY ) && ( xTicksInSlice >= xTicks ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIME_SLICE_QUANTA */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the running task that is
+			being suspended. */
+			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+			traceTASK_SUSPEND( pxTCB );
+
+			/* Remove task from the ready/delayed list and place in the
+			suspended list. */
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
 			/* Is the task waiting on an event also? */
 			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
@@ -1678,63 +2604,105 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
-		}
-		taskEXIT_CRITICAL();
 
-		if( xSchedulerRunning != pdFALSE )
-		{
-			/* Reset the next expected unblock time in case it referred to the
-			task that is now in the Suspended state. */
-			taskENTER_CRITICAL();
+			#if( configNUMBER_OF_CORES > 1 )
 			{
-				prvResetNextTaskUnblockTime();
+				if( xSchedulerRunning != pdFALSE )
+				{
+					/* Reset the next expected unblock time in case it referred
+					to the task that is now in the Suspended state. */
+					prvResetNextTaskUnblockTime();
+
+					/* Only the idle tasks are given a core before the scheduler
+					is started, and they cannot be suspended, so a core only
+					needs to yield if the scheduler is running. */
+					if( pxTCB == pxCurrentTCB )
+					{
+						configASSERT( uxSchedulerSuspended == 0 );
+						vTaskYieldWithinAPI();
+					}
+					else if( taskTASK_IS_RUNNING( pxTCB ) )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
-			taskEXIT_CRITICAL();
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
+			#endif /* configNUMBER_OF_CORES */
 		}
+		taskEXIT_CRITICAL();
 
-		if( pxTCB == pxCurrentTCB )
+		#if( configNUMBER_OF_CORES == 1 )
 		{
 			if( xSchedulerRunning != pdFALSE )
 			{
-				/* The current task has just been suspended. */
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
+				/* Reset the next expected unblock time in case it referred to
+				the task that is now in the Suspended state. */
+				taskENTER_CRITICAL();
+				{
+					prvResetNextTaskUnblockTime();
+				}
+				taskEXIT_CRITICAL();
 			}
 			else
 			{
-				/* The scheduler is not running, but the task that was pointed
-				to by pxCurrentTCB has just been suspended and pxCurrentTCB
-				must be adjusted to point to a different task. */
-				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxTCB == pxCurrentTCB )
+			{
+				if( xSchedulerRunning != pdFALSE )
 				{
-					/* No other tasks are ready, so set pxCurrentTCB back to
-					NULL so when the next task is created pxCurrentTCB will
-					be set to point to it no matter what its relative priority
-					is. */
-					pxCurrentTCB = NULL;
+					/* The current task has just been suspended. */
+					configASSERT( uxSchedulerSuspended == 0 );
+					portYIELD_WITHIN_API();
 				}
 				else
 				{
-					vTaskSwitchContext();
+					/* The scheduler is not running, but the task that was
+					pointed to by pxCurrentTCB has just been suspended and
+					pxCurrentTCB must be adjusted to point to a different
+					task. */
+					if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+					{
+						/* No other tasks are ready, so set pxCurrentTCB back
+						to NULL so when the next task is created pxCurrentTCB
+						will be set to point to it no matter what its relative
+						priority is. */
+						pxCurrentTCB = NULL;
+					}
+					else
+					{
+						vTaskSwitchContext();
+					}
 				}
 			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1810,18 +2778,26 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					( void ) uxListRemove(  &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
 
-					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					#if( configNUMBER_OF_CORES == 1 )
 					{
-						/* This yield may not cause the task just resumed to run,
-						but will leave the lists in the correct state for the
-						next yield. */
-						taskYIELD_IF_USING_PREEMPTION();
+						/* A higher priority task may have just been resumed. */
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							/* This yield may not cause the task just resumed to
+							run, but will leave the lists in the correct state
+							for the next yield. */
+							taskYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-					else
+					#else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
 					}
+					#endif /* configNUMBER_OF_CORES */
 				}
 				else
 				{
@@ -1868,7 +2844,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
@@ -1879,14 +2855,18 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-					{
-						xYieldRequired = pdTRUE;
-					}
-					else
+					#if( configNUMBER_OF_CORES == 1 )
 					{
-						mtCOVERAGE_TEST_MARKER();
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
+					#endif
 
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
@@ -1898,13 +2878,31 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					unsuspended. */
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
+
+				#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+				{
+					/* Other cores are asked to yield straight away, even if the
+					scheduler is suspended, as they then wait for the scheduler
+					to be resumed before selecting a task. */
+					prvYieldForTask( pxTCB );
+
+					if( xYieldPending != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
@@ -1912,12 +2910,128 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	static BaseType_t prvCreateIdleTasks( void )
+	{
+	BaseType_t xReturn = pdPASS;
+	BaseType_t xCoreID;
+	TaskFunction_t pxIdleTaskFunction;
+	char cIdleName[ configMAX_TASK_NAME_LEN ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	UBaseType_t x;
+
+		#if( configUSE_CORE_AFFINITY == 1 )
+		{
+			/* Each core needs a bit in an affinity mask. */
+			configASSERT( configNUMBER_OF_CORES <= ( sizeof( UBaseType_t ) * ( size_t ) 8 ) );
+		}
+		#endif
+
+		/* The idle task of core 0 keeps configIDLE_TASK_NAME, and the idle
+		task of each other core has the core number appended to the name. */
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+		{
+			cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+
+			if( cIdleName[ x ] == ( char ) 0x00 )
+			{
+				break;
+			}
+		}
+
+		/* Leave room for the core number. */
+		if( x > ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 3 ) )
+		{
+			x = ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 3 );
+		}
+
+		cIdleName[ x ] = ( char ) 0x00;
+
+		/* The idle tasks are created in core order, and each is given the core
+		of the same number by prvAddNewTaskToReadyList(). */
+		for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			if( xCoreID == ( BaseType_t ) 0 )
+			{
+				pxIdleTaskFunction = prvIdleTask;
+			}
+			else
+			{
+				pxIdleTaskFunction = prvPassiveIdleTask;
+
+				if( xCoreID < ( BaseType_t ) 10 )
+				{
+					cIdleName[ x ] = ( char ) ( '0' + xCoreID );
+					cIdleName[ x + 1U ] = ( char ) 0x00;
+				}
+				else
+				{
+					cIdleName[ x ] = ( char ) ( '0' + ( xCoreID / 10 ) );
+					cIdleName[ x + 1U ] = ( char ) ( '0' + ( xCoreID % 10 ) );
+				}
+			}
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+				StackType_t *pxIdleTaskStackBuffer = NULL;
+				uint32_t ulIdleTaskStackSize;
+
+				if( xCoreID == ( BaseType_t ) 0 )
+				{
+					vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+				}
+				else
+				{
+					vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1 );
+				}
+
+				xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic(	pxIdleTaskFunction,
+																	cIdleName,
+																	ulIdleTaskStackSize,
+																	( void * ) NULL, /*lint !e961.  The cast is not redundant for all compilers. */
+																	portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+																	pxIdleTaskStackBuffer,
+																	pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+				if( xIdleTaskHandles[ xCoreID ] == NULL )
+				{
+					xReturn = pdFAIL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+				xReturn = xTaskCreate(	pxIdleTaskFunction,
+										cIdleName,
+										configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+										&xIdleTaskHandles[ xCoreID ] ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskStartScheduler( void )
 {
 BaseType_t xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		/* One idle task for each core. */
+		xReturn = prvCreateIdleTasks();
+	}
+	#elif( configSUPPORT_STATIC_ALLOCATION == 1 )
 	{
 		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
 		StackType_t *pxIdleTaskStackBuffer = NULL;
@@ -1953,7 +3067,7 @@ BaseType_t xReturn;
 								portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
 								&xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 	}
-	#endif /* configSUPPORT_STATIC_ALLOCATION */
+	#endif /* configNUMBER_OF_CORES */
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -1968,6 +3082,19 @@ BaseType_t xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_DEFERRED_WORK == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xDeferredWorkCreateTask();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_DEFERRED_WORK */
+
 	if( xReturn == pdPASS )
 	{
 		/* freertos_tasks_c_additions_init() should only be called if the user
@@ -2006,6 +3133,16 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+		{
+			/* The counter need not start from zero, so start measuring the
+			first task and the first CPU load sample period from its current
+			value. */
+			taskREAD_RUN_TIME_COUNTER( ulTaskSwitchedInTime );
+			ulLastCpuLoadSampleTime = ulTaskSwitchedInTime;
+		}
+		#endif /* configGENERATE_CPU_LOAD_STATS */
+
 		traceTASK_SWITCHED_IN();
 
 		/* Setting up the timer tick is hardware specific and thus in the
@@ -2030,7 +3167,11 @@ BaseType_t xReturn;
 
 	/* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
 	meaning xIdleTaskHandle is not used anywhere else. */
-	( void ) xIdleTaskHandle;
+	#if( configNUMBER_OF_CORES == 1 )
+		( void ) xIdleTaskHandle;
+	#else
+		( void ) xIdleTaskHandles;
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2047,23 +3188,65 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
-}
-/*----------------------------------------------------------*/
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to
+		a post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+		++uxSchedulerSuspended;
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The task lock is held until the scheduler is resumed, so no other
+			core can suspend the scheduler, enter a critical section or switch
+			tasks in the meantime.  Interrupts are masked until the count has
+			been incremented so this core cannot be switched to another task
+			while it holds the lock with the scheduler still running. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0U );
 
-	static TickType_t prvGetExpectedIdleTime( void )
-	{
-	TickType_t xReturn;
-	UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+			portGET_TASK_LOCK();
 
-		/* uxHigherPriorityReadyTasks takes care of the case where
-		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+			if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+			{
+				prvCheckForRunStateChange();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Interrupts on the other cores read the count with only the ISR
+			lock held. */
+			portGET_ISR_LOCK();
+			++uxSchedulerSuspended;
+			portRELEASE_ISR_LOCK();
+
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static TickType_t prvGetExpectedIdleTime( void )
+	{
+	TickType_t xReturn;
+	UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+		/* uxHigherPriorityReadyTasks takes care of the case where
+		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
 		task that are in the Ready state, even though the idle task is
 		running. */
 		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
@@ -2123,67 +3306,50 @@ BaseType_t xTaskResumeAll( void )
 TCB_t *pxTCB = NULL;
 BaseType_t xAlreadyYielded = pdFALSE;
 
-	/* If uxSchedulerSuspended is zero then this function does not match a
-	previous call to vTaskSuspendAll(). */
-	configASSERT( uxSchedulerSuspended );
-
-	/* It is possible that an ISR caused a task to be removed from an event
-	list while the scheduler was suspended.  If this was the case then the
-	removed task will have been added to the xPendingReadyList.  Once the
-	scheduler has been resumed it is safe to move all the pending ready
-	tasks from this list into their appropriate ready list. */
-	taskENTER_CRITICAL();
+	#if( configNUMBER_OF_CORES > 1 )
+		/* vTaskSuspendAll() does nothing until the scheduler has started. */
+		if( xSchedulerRunning != pdFALSE )
+	#endif
 	{
-		--uxSchedulerSuspended;
-
-		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		/* If uxSchedulerSuspended is zero then this function does not match a
+		previous call to vTaskSuspendAll(). */
+		configASSERT( uxSchedulerSuspended );
+
+		/* It is possible that an ISR caused a task to be removed from an event
+		list while the scheduler was suspended.  If this was the case then the
+		removed task will have been added to the xPendingReadyList.  Once the
+		scheduler has been resumed it is safe to move all the pending ready
+		tasks from this list into their appropriate ready list. */
+		taskENTER_CRITICAL();
 		{
-			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
-			{
-				/* Move any readied tasks from the pending list into the
-				appropriate ready list. */
-				while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
-				{
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					prvAddTaskToReadyList( pxTCB );
-
-					/* If the moved task has a priority higher than the current
-					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-					{
-						xYieldPending = pdTRUE;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-				}
+			--uxSchedulerSuspended;
 
-				if( pxTCB != NULL )
-				{
-					/* A task was unblocked while the scheduler was suspended,
-					which may have prevented the next unblock time from being
-					re-calculated, in which case re-calculate it now.  Mainly
-					important for low power tickless implementations, where
-					this can prevent an unnecessary exit from low power
-					state. */
-					prvResetNextTaskUnblockTime();
-				}
+			#if( configNUMBER_OF_CORES > 1 )
+			{
+				/* Drop the hold vTaskSuspendAll() took on the task lock.  The lock
+				is still held by the critical section. */
+				portRELEASE_TASK_LOCK();
+			}
+			#endif
 
-				/* If any ticks occurred while the scheduler was suspended then
-				they should be processed now.  This ensures the tick count does
-				not	slip, and that any delayed tasks are resumed at the correct
-				time. */
+			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			{
+				if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 				{
-					UBaseType_t uxPendedCounts = uxPendedTicks; /* Non-volatile copy. */
-
-					if( uxPendedCounts > ( UBaseType_t ) 0U )
+					/* Move any readied tasks from the pending list into the
+					appropriate ready list. */
+					while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
 					{
-						do
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
+
+						#if( configNUMBER_OF_CORES == 1 )
 						{
-							if( xTaskIncrementTick() != pdFALSE )
+							/* If the moved task has a priority higher than the
+							current task then a yield must be performed. */
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 							{
 								xYieldPending = pdTRUE;
 							}
@@ -2191,38 +3357,79 @@ BaseType_t xAlreadyYielded = pdFALSE;
 							{
 								mtCOVERAGE_TEST_MARKER();
 							}
-							--uxPendedCounts;
-						} while( uxPendedCounts > ( UBaseType_t ) 0U );
+						}
+						#else
+						{
+							/* The cores were asked to yield when the task was
+							readied, but may since have selected other tasks. */
+							taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+						}
+						#endif /* configNUMBER_OF_CORES */
+					}
 
-						uxPendedTicks = 0;
+					if( pxTCB != NULL )
+					{
+						/* A task was unblocked while the scheduler was suspended,
+						which may have prevented the next unblock time from being
+						re-calculated, in which case re-calculate it now.  Mainly
+						important for low power tickless implementations, where
+						this can prevent an unnecessary exit from low power
+						state. */
+						prvResetNextTaskUnblockTime();
 					}
-					else
+
+					/* If any ticks occurred while the scheduler was suspended then
+					they should be processed now.  This ensures the tick count does
+					not	slip, and that any delayed tasks are resumed at the correct
+					time. */
 					{
-						mtCOVERAGE_TEST_MARKER();
+						UBaseType_t uxPendedCounts = uxPendedTicks; /* Non-volatile copy. */
+
+						if( uxPendedCounts > ( UBaseType_t ) 0U )
+						{
+							do
+							{
+								if( xTaskIncrementTick() != pdFALSE )
+								{
+									xYieldPending = pdTRUE;
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+								--uxPendedCounts;
+							} while( uxPendedCounts > ( UBaseType_t ) 0U );
+
+							uxPendedTicks = 0;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 					}
-				}
 
-				if( xYieldPending != pdFALSE )
-				{
-					#if( configUSE_PREEMPTION != 0 )
+					if( xYieldPending != pdFALSE )
+					{
+						#if( configUSE_PREEMPTION != 0 )
+						{
+							xAlreadyYielded = pdTRUE;
+						}
+						#endif
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
 					{
-						xAlreadyYielded = pdTRUE;
+						mtCOVERAGE_TEST_MARKER();
 					}
-					#endif
-					taskYIELD_IF_USING_PREEMPTION();
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		taskEXIT_CRITICAL();
 	}
-	taskEXIT_CRITICAL();
 
 	return xAlreadyYielded;
 }
@@ -2429,7 +3636,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2503,13 +3710,35 @@ TCB_t *pxTCB;
 
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
-	TaskHandle_t xTaskGetIdleTaskHandle( void )
-	{
-		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
-	}
+	#if( configNUMBER_OF_CORES == 1 )
+
+		TaskHandle_t xTaskGetIdleTaskHandle( void )
+		{
+			/* If xTaskGetIdleTaskHandle() is called before the scheduler has
+			been started, then xIdleTaskHandle will be NULL. */
+			configASSERT( ( xIdleTaskHandle != NULL ) );
+			return xIdleTaskHandle;
+		}
+
+	#else
+
+		TaskHandle_t xTaskGetIdleTaskHandle( void )
+		{
+			return xTaskGetIdleTaskHandleForCore( ( BaseType_t ) 0 );
+		}
+		/*-----------------------------------------------------------*/
+
+		TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+		{
+			configASSERT( ( xCoreID >= ( BaseType_t ) 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+			/* If called before the scheduler has been started then the idle
+			task handles will be NULL. */
+			configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+			return xIdleTaskHandles[ xCoreID ];
+		}
+
+	#endif /* configNUMBER_OF_CORES */
 
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
@@ -2578,7 +3807,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 
 				/* A task being unblocked cannot cause an immediate context
 				switch if preemption is turned off. */
-				#if (  configUSE_PREEMPTION == 1 )
+				#if( ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 				{
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
@@ -2594,6 +3823,16 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 						mtCOVERAGE_TEST_MARKER();
 					}
 				}
+				#elif( configUSE_PREEMPTION == 1 )
+				{
+					/* A yield of the calling core is held pending until the
+					scheduler is unsuspended. */
+					taskENTER_CRITICAL();
+					{
+						prvYieldForTask( pxTCB );
+					}
+					taskEXIT_CRITICAL();
+				}
 				#endif /* configUSE_PREEMPTION */
 			}
 			else
@@ -2615,6 +3854,11 @@ TCB_t * pxTCB;
 TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
 
+#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+	BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+	BaseType_t xCoreID;
+#endif
+
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
 	tasks to be unblocked. */
@@ -2638,6 +3882,20 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+		{
+			if( ( TickType_t ) ( xConstTickCount - xLastCpuLoadSampleTick ) >= taskCPU_LOAD_SAMPLE_TICKS )
+			{
+				xLastCpuLoadSampleTick = xConstTickCount;
+				prvSampleCpuLoad();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configGENERATE_CPU_LOAD_STATS */
+
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
 		has been found whose block time has not expired there is no need to
@@ -2700,7 +3958,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 					/* A task being unblocked cannot cause an immediate
 					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
+					#if( ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 					{
 						/* Preemption is on, but a context switch should
 						only be performed if the unblocked task has a
@@ -2715,6 +3973,12 @@ BaseType_t xSwitchRequired = pdFALSE;
 							mtCOVERAGE_TEST_MARKER();
 						}
 					}
+					#elif( configUSE_PREEMPTION == 1 )
+					{
+						/* Any core running a task of lower priority is asked
+						to yield, this core when the interrupt exits. */
+						prvYieldForTask( pxTCB );
+					}
 					#endif /* configUSE_PREEMPTION */
 				}
 			}
@@ -2723,17 +3987,105 @@ BaseType_t xSwitchRequired = pdFALSE;
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 		{
+			#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+			{
+				/* Saturates, so a task that is never time sliced is not
+				switched out when the count would wrap. */
+				if( xTicksInTimeSlice != portMAX_DELAY )
+				{
+					xTicksInTimeSlice++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TIME_SLICE_QUANTA */
+
+			/* The length of the ready list is checked first as the time slice
+			does not matter while no other task shares the priority. */
 			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
 			{
-				xSwitchRequired = pdTRUE;
+				#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+				{
+					if( prvTimeSliceEnded( pxCurrentTCB->uxPriority, xTicksInTimeSlice ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#else
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				#endif /* configUSE_TIME_SLICE_QUANTA */
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#elif ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+			/* A core only time slices if more tasks share the priority of the
+			task it is running than there are cores running that priority. */
+			for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+			const UBaseType_t uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+			UBaseType_t uxRunning = ( UBaseType_t ) 0U;
+			BaseType_t x;
+
+				#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+				{
+					if( xTicksInTimeSlices[ xCoreID ] != portMAX_DELAY )
+					{
+						xTicksInTimeSlices[ xCoreID ]++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_TIME_SLICE_QUANTA */
+
+				for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+				{
+					if( pxCurrentTCBs[ x ]->uxPriority == uxPriority )
+					{
+						uxRunning++;
+					}
+				}
+
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) ) > uxRunning )
+				{
+					#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+					{
+						if( prvTimeSliceEnded( uxPriority, xTicksInTimeSlices[ xCoreID ] ) != pdFALSE )
+						{
+							xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else
+					{
+						xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+					}
+					#endif /* configUSE_TIME_SLICE_QUANTA */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
 		#if ( configUSE_TICK_HOOK == 1 )
@@ -2764,7 +4116,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 		#endif
 	}
 
-	#if ( configUSE_PREEMPTION == 1 )
+	#if( ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 	{
 		if( xYieldPending != pdFALSE )
 		{
@@ -2775,6 +4127,29 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
+	#elif( configUSE_PREEMPTION == 1 )
+	{
+		/* The calling core switches when the tick interrupt exits, the other
+		cores are interrupted now.  Must be called with the ISR lock held. */
+		for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+		{
+			if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+			{
+				if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					prvYieldCore( xCoreID );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
 	#endif /* configUSE_PREEMPTION */
 
 	return xSwitchRequired;
@@ -2873,6 +4248,8 @@ BaseType_t xSwitchRequired = pdFALSE;
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES == 1 )
+
 void vTaskSwitchContext( void )
 {
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
@@ -2888,9 +4265,6 @@ void vTaskSwitchContext( void )
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-			PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
-
 				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
 					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
 				#else
@@ -2924,6 +4298,14 @@ void vTaskSwitchContext( void )
 		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		traceTASK_SWITCHED_IN();
 
+		#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+		{
+			/* Whatever the reason for the switch, the task selected starts a
+			new time slice. */
+			xTicksInTimeSlice = ( TickType_t ) 0U;
+		}
+		#endif
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2933,6 +4315,68 @@ void vTaskSwitchContext( void )
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
 }
+
+#else /* configNUMBER_OF_CORES */
+
+void vTaskSwitchContext( BaseType_t xCoreID )
+{
+	/* Called by the port on core xCoreID, with interrupts disabled and outside
+	of any critical section.  Both locks are taken so no other core can change
+	the ready lists or the scheduler state while a task is selected. */
+	portGET_TASK_LOCK();
+	portGET_ISR_LOCK();
+	{
+		configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0 );
+
+		if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+		{
+			/* The scheduler is suspended by another core, or was suspended by
+			this core before the yield was requested. */
+			xYieldPendings[ xCoreID ] = pdTRUE;
+		}
+		else
+		{
+			xYieldPendings[ xCoreID ] = pdFALSE;
+			traceTASK_SWITCHED_OUT();
+
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTimes[ xCoreID ] );
+				#else
+					ulTotalRunTimes[ xCoreID ] = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+
+				if( ulTotalRunTimes[ xCoreID ] > ulTaskSwitchedInTimes[ xCoreID ] )
+				{
+					pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTimes[ xCoreID ] - ulTaskSwitchedInTimes[ xCoreID ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				ulTaskSwitchedInTimes[ xCoreID ] = ulTotalRunTimes[ xCoreID ];
+			}
+			#endif /* configGENERATE_RUN_TIME_STATS */
+
+			/* Check for stack overflow, if configured. */
+			taskCHECK_FOR_STACK_OVERFLOW();
+
+			taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+			traceTASK_SWITCHED_IN();
+
+			#if ( configUSE_TIME_SLICE_QUANTA == 1 )
+			{
+				xTicksInTimeSlices[ xCoreID ] = ( TickType_t ) 0U;
+			}
+			#endif
+		}
+	}
+	portRELEASE_ISR_LOCK();
+	portRELEASE_TASK_LOCK();
+}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
@@ -2967,9 +4411,10 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 
 	/* Place the event list item of the TCB at the end of the appropriate event
 	list.  It is safe to access the event list here because it is part of an
-	event group implementation - and interrupts don't access event groups
+	event group implementation - and interrupts either don't access event groups
 	directly (instead they access them indirectly by pending function calls to
-	the task level). */
+	the task level), or, if configUSE_EVENT_GROUP_DIRECT_ISR is 1, the event
+	group calls this function from a critical section. */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3043,26 +4488,52 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	#if( configNUMBER_OF_CORES == 1 )
 	{
-		/* Return true if the task removed from the event list has a higher
-		priority than the calling task.  This allows the calling task to know if
-		it should force a context switch now. */
-		xReturn = pdTRUE;
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			/* Return true if the task removed from the event list has a higher
+			priority than the calling task.  This allows the calling task to know
+			if it should force a context switch now. */
+			xReturn = pdTRUE;
 
-		/* Mark that a yield is pending in case the user is not using the
-		"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-		xYieldPending = pdTRUE;
+			/* Mark that a yield is pending in case the user is not using the
+			"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+			function. */
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
 	}
-	else
+	#else /* configNUMBER_OF_CORES */
 	{
 		xReturn = pdFALSE;
-	}
 
-	#if( configUSE_TICKLESS_IDLE != 0 )
-	{
-		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
-		might be set to the blocked task's time out time.  If the task is
+		#if( configUSE_PREEMPTION == 1 )
+		{
+			/* The core running the lowest priority task is asked to yield.
+			Only report a switch if that is the calling core. */
+			prvYieldForTask( pxUnblockedTCB );
+
+			if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PREEMPTION */
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
+		might be set to the blocked task's time out time.  If the task is
 		unblocked for a reason other than a timeout xNextTaskUnblockTime is
 		normally left unchanged, because it is automatically reset to a new
 		value when the tick count equals xNextTaskUnblockTime.  However if
@@ -3100,17 +4571,113 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	#if( configNUMBER_OF_CORES == 1 )
 	{
-		/* The unblocked task has a priority above that of the calling task, so
-		a context switch is required.  This function is called with the
-		scheduler suspended so xYieldPending is set so the context switch
-		occurs immediately that the scheduler is resumed (unsuspended). */
-		xYieldPending = pdTRUE;
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			/* The unblocked task has a priority above that of the calling task,
+			so a context switch is required.  This function is called with the
+			scheduler suspended so xYieldPending is set so the context switch
+			occurs immediately that the scheduler is resumed (unsuspended). */
+			xYieldPending = pdTRUE;
+		}
+	}
+	#elif( configUSE_PREEMPTION == 1 )
+	{
+		/* Other cores can still run while this core holds the scheduler
+		suspended, so the yield is requested under the ISR lock. */
+		taskENTER_CRITICAL();
+		{
+			prvYieldForTask( pxUnblockedTCB );
+		}
+		taskEXIT_CRITICAL();
 	}
+	#endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED.  It is used by
+		the event groups implementation to unblock tasks from an interrupt, so
+		unlike vTaskRemoveFromUnorderedEventList() the scheduler might not be
+		suspended - or might be suspended by the interrupted task. */
+
+		/* Store the new item value in the event list item. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed.  The item value set above is
+			left intact. */
+			vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+		}
+
+		#if( configNUMBER_OF_CORES == 1 )
+		{
+			if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+			{
+				/* Mark that a yield is pending in case the user is not using the
+				"xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+				function. */
+				xReturn = pdTRUE;
+				xYieldPending = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		#else /* configNUMBER_OF_CORES */
+		{
+			xReturn = pdFALSE;
+
+			#if( configUSE_PREEMPTION == 1 )
+			{
+				/* As in xTaskRemoveFromEventList(). */
+				prvYieldForTask( pxUnblockedTCB );
+
+				if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+		}
+		#endif /* configNUMBER_OF_CORES */
+
+		#if( configUSE_TICKLESS_IDLE != 0 )
+		{
+			/* As in xTaskRemoveFromEventList(). */
+			prvResetNextTaskUnblockTime();
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3262,12 +4829,26 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 	any. */
 	portTASK_CALLS_SECURE_FUNCTIONS();
 
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		/* The idle tasks are given a core each when the scheduler starts, so
+		let any application task that is ready run in place of this one. */
+		taskYIELD();
+	}
+	#endif /* configNUMBER_OF_CORES */
+
 	for( ;; )
 	{
 		/* See if any tasks have deleted themselves - if so then the idle task
 		is responsible for freeing the deleted task's TCB and stack. */
 		prvCheckTasksWaitingTermination();
 
+		#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
+		{
+			prvScanStackWatermark();
+		}
+		#endif /* configUSE_STACK_WATERMARK_SCANNER */
+
 		#if ( configUSE_PREEMPTION == 0 )
 		{
 			/* If we are not using preemption we keep forcing a task switch to
@@ -3288,8 +4869,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			A critical region is not required here as we are just reading from
 			the list, and an occasional incorrect value will not matter.  If
 			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			(more than one per core in a multi-core build) then a task other
+			than an idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
 			{
 				taskYIELD();
 			}
@@ -3366,6 +4948,53 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+	{
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		/* The idle task of each core other than core 0.  Deleted tasks are
+		only freed by prvIdleTask(), and tickless idle is not supported in a
+		multi-core build, so all that is left is to give way to other tasks. */
+		taskYIELD();
+
+		for( ;; )
+		{
+			#if ( configUSE_PREEMPTION == 0 )
+			{
+				taskYIELD();
+			}
+			#endif /* configUSE_PREEMPTION */
+
+			#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+			{
+				/* As in prvIdleTask(). */
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+				{
+					taskYIELD();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+			#if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+			{
+				/* As vApplicationIdleHook(), vApplicationPassiveIdleHook() MUST
+				NOT CALL A FUNCTION THAT MIGHT BLOCK. */
+				vApplicationPassiveIdleHook();
+			}
+			#endif /* configUSE_PASSIVE_IDLE_HOOK */
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TICKLESS_IDLE != 0 )
 
 	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3472,8 +5101,21 @@ PRIVILEGED_DATA static List_t xDelayedTaskList2;	/*< Delayed tasks (two lists ar
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	/* Tasks are inserted into the delayed lists in wake time order each time
+	they block with a timeout.  Indexing the delayed lists bounds the cost of
+	the insertion, which is otherwise proportional to the number of tasks that
+	are already delayed. */
+	#if( configUSE_INDEXED_DELAY_LISTS == 1 )
+	{
+		vListInitialiseIndexed( &xDelayedTaskList1 );
+		vListInitialiseIndexed( &xDelayedTaskList2 );
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_INDEXED_DELAY_LISTS */
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3488,6 +5130,12 @@ PRIVILEGED_DATA static List_t xDelayedTaskList2;	/*< Delayed tasks (two lists ar
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
+	{
+		vListInitialise( &xStackWatermarkList );
+	}
+	#endif /* configUSE_STACK_WATERMARK_SCANNER */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3498,11 +5146,13 @@ PRIVILEGED_DATA static List_t xDelayedTaskList2;	/*< Delayed tasks (two lists ar
 static void prvCheckTasksWaitingTermination( void )
 {
 
-	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK, AND FROM
+	prvReclaimDeletedTasks() **/
 
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		TCB_t *pxTCB;
+		TickType_t xWaitTime;
 
 		/* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
 		being called too often in the idle task. */
@@ -3510,13 +5160,64 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			taskENTER_CRITICAL();
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				/* The count is checked again as the list might have been
+				emptied by another task since it was last checked. */
+				if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+				{
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				else
+				{
+					pxTCB = NULL;
+				}
+
+				#if( configNUMBER_OF_CORES > 1 )
+				{
+					/* A task that deleted itself on another core might not
+					have been switched out yet, in which case its stack is still
+					in use and it is left for a later pass. */
+					if( ( pxTCB != NULL ) && ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) )
+					{
+						pxTCB = NULL;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
+
+				if( pxTCB != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+
+					xWaitTime = xTickCount - listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+					xTaskCleanupStats.ulTasksFreed++;
+					xTaskCleanupStats.ulTotalWaitTicks += ( uint32_t ) xWaitTime;
+
+					if( xWaitTime > xTaskCleanupStats.xLongestWait )
+					{
+						xTaskCleanupStats.xLongestWait = xWaitTime;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			taskEXIT_CRITICAL();
 
+			if( pxTCB == NULL )
+			{
+				break;
+			}
+
 			prvDeleteTCB( pxTCB );
 		}
 	}
@@ -3524,6 +5225,50 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( ( INCLUDE_vTaskDelete == 1 ) && ( configTASK_CLEANUP_THRESHOLD > 0 ) )
+
+	static void prvReclaimDeletedTasks( void )
+	{
+		/* The idle task might not run for a long time on a busy system, so
+		once enough deleted tasks are waiting their memory is freed in bulk
+		here, from the task that is creating or deleting a task.  Tasks on the
+		termination list have been switched out, so it is safe to free their
+		stacks from any task. */
+		if( uxDeletedTasksWaitingCleanUp >= ( UBaseType_t ) configTASK_CLEANUP_THRESHOLD )
+		{
+			taskENTER_CRITICAL();
+			{
+				xTaskCleanupStats.ulBulkReclaims++;
+			}
+			taskEXIT_CRITICAL();
+
+			prvCheckTasksWaitingTermination();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_vTaskDelete == 1 )
+
+	void vTaskGetCleanupStats( TaskCleanupStats_t *pxStats )
+	{
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = xTaskCleanupStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TRACE_FACILITY == 1 )
 
 	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
@@ -3564,7 +5309,7 @@ static void prvCheckTasksWaitingTermination( void )
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3701,276 +5446,1784 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
 
-	static void prvDeleteTCB( TCB_t *pxTCB )
+	static void prvScanStackWatermark( void )
 	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
+	TCB_t *pxTCB;
+	StackType_t xFillValue;
+	const StackType_t *pxStackWord;
+	uint32_t ulScanEnd;
+	BaseType_t xScanComplete = pdFALSE;
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up
-		to the task to free any memory allocated at the application level. */
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
-		{
-			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
-		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
+		/* The value of a stack word that has never been written. */
+		( void ) memset( ( void * ) &xFillValue, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillValue ) );
 
-		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-		{
-			/* The task can only have been allocated dynamically - free both
-			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
-		}
-		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		/* The critical section stops the task being deleted during the scan,
+		and is kept short by only checking a few words at a time. */
+		taskENTER_CRITICAL();
 		{
-			/* The task could have been allocated statically or dynamically, so
-			check what was statically allocated before trying to free the
-			memory. */
-			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			if( listLIST_IS_EMPTY( &xStackWatermarkList ) == pdFALSE )
 			{
-				/* Both the stack and TCB were allocated dynamically, so both
-				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
-			}
-			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
-			{
-				/* Only the stack was statically allocated, so the TCB is the
-				only memory that must be freed. */
-				vPortFree( pxTCB );
-			}
-			else
-			{
-				/* Neither the stack nor the TCB were allocated dynamically, so
-				nothing needs to be freed. */
-				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
-				mtCOVERAGE_TEST_MARKER();
-			}
-		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-	}
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xStackWatermarkList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
+				/* The words between the end of the stack and the watermark were
+				unused at the last scan, and the words beyond the watermark have
+				already been used, so only the former are checked.  The scan
+				goes from the end of the stack towards the watermark, as
+				prvTaskCheckFreeStackSpace() does. */
+				ulScanEnd = pxTCB->ulWatermarkCursor + ( uint32_t ) configSTACK_WATERMARK_SCAN_WORDS;
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+				if( ulScanEnd > pxTCB->ulWatermark )
+				{
+					ulScanEnd = pxTCB->ulWatermark;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
-	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+				#if( portSTACK_GROWTH < 0 )
+				{
+					pxStackWord = pxTCB->pxStack + pxTCB->ulWatermarkCursor;
+				}
+				#else
+				{
+					pxStackWord = pxTCB->pxEndOfStack - pxTCB->ulWatermarkCursor;
+				}
+				#endif
+
+				while( ( pxTCB->ulWatermarkCursor < ulScanEnd ) && ( *pxStackWord == xFillValue ) )
+				{
+					pxTCB->ulWatermarkCursor++;
+					pxStackWord -= portSTACK_GROWTH;
+				}
+
+				if( pxTCB->ulWatermarkCursor < ulScanEnd )
+				{
+					/* A word that was unused at the last scan has been written,
+					so the task has used more of its stack. */
+					pxTCB->ulWatermark = pxTCB->ulWatermarkCursor;
+					xScanComplete = pdTRUE;
+				}
+				else if( pxTCB->ulWatermarkCursor == pxTCB->ulWatermark )
+				{
+					/* The watermark has not moved. */
+					xScanComplete = pdTRUE;
+				}
+				else
+				{
+					/* Carry on from the cursor next time. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xScanComplete != pdFALSE )
+				{
+					#if( configSTACK_WATERMARK_WARNING_PERCENT > 0 )
+					{
+						if( ( pxTCB->ucWatermarkWarned == ( uint8_t ) pdFALSE ) &&
+							( ( ( pxTCB->ulStackDepth - pxTCB->ulWatermark ) * 100UL ) >= ( pxTCB->ulStackDepth * ( uint32_t ) configSTACK_WATERMARK_WARNING_PERCENT ) ) )
+						{
+							pxTCB->ucWatermarkWarned = ( uint8_t ) pdTRUE;
+							vApplicationStackWatermarkHook( ( TaskHandle_t ) pxTCB, pxTCB->pcTaskName, pxTCB->ulWatermark );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configSTACK_WATERMARK_WARNING_PERCENT */
+
+					/* Move on to the next task. */
+					pxTCB->ulWatermarkCursor = 0UL;
+					( void ) uxListRemove( &( pxTCB->xWatermarkListItem ) );
+					vListInsertEnd( &xStackWatermarkList, &( pxTCB->xWatermarkListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
 	}
-}
+
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if ( configUSE_STACK_WATERMARK_SCANNER == 1 )
 
-	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	UBaseType_t uxTaskGetAllStackWatermarks( TaskStackWatermark_t * const pxWatermarks, const UBaseType_t uxArraySize )
 	{
-	TaskHandle_t xReturn;
+	const ListItem_t *pxItem;
+	const ListItem_t *pxEnd;
+	TCB_t *pxTCB;
+	UBaseType_t uxTask = 0U;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		configASSERT( pxWatermarks != NULL );
 
-		return xReturn;
+		/* Only the idle task changes the list other than when tasks are
+		created and deleted, so the scheduler being suspended is enough. */
+		vTaskSuspendAll();
+		{
+			pxEnd = listGET_END_MARKER( &xStackWatermarkList );
+
+			for( pxItem = listGET_HEAD_ENTRY( &xStackWatermarkList ); ( pxItem != pxEnd ) && ( uxTask < uxArraySize ); pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				pxWatermarks[ uxTask ].xHandle = ( TaskHandle_t ) pxTCB;
+				pxWatermarks[ uxTask ].pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+				pxWatermarks[ uxTask ].ulStackDepth = pxTCB->ulStackDepth;
+				pxWatermarks[ uxTask ].ulWatermark = pxTCB->ulWatermark;
+				uxTask++;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* configUSE_STACK_WATERMARK_SCANNER */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_HEAP_ACCOUNTING == 1 )
 
-	BaseType_t xTaskGetSchedulerState( void )
+	UBaseType_t uxTaskGetHeapUsage( TaskHandle_t xTask )
 	{
-	BaseType_t xReturn;
+	TCB_t *pxTCB;
 
-		if( xSchedulerRunning == pdFALSE )
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		return ( UBaseType_t ) xPortGetHeapUsage( ( void * ) pxTCB );
+	}
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	static void prvUpdateCpuLoad( uint32_t *pulCpuLoad, configRUN_TIME_COUNTER_TYPE ulRunTime, configRUN_TIME_COUNTER_TYPE ulElapsedTime, uint64_t ullReciprocal )
+	{
+	uint32_t ulSample, ulDifference;
+	UBaseType_t x;
+
+		/* The run time cannot really exceed the elapsed time, but can appear to
+		if the run time counter wrapped while a task was running. */
+		if( ulRunTime > ulElapsedTime )
 		{
-			xReturn = taskSCHEDULER_NOT_STARTED;
+			ulRunTime = ulElapsedTime;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* ullReciprocal is 2^48 / ulElapsedTime, so this is the share of the
+		elapsed time as a fraction of taskCPU_LOAD_ONE (2^24), and the product
+		cannot exceed 2^48. */
+		ulSample = ( uint32_t ) ( ( ( uint64_t ) ulRunTime * ullReciprocal ) >> taskCPU_LOAD_ONE_SHIFT );
+
+		/* The loads and samples are at most 2^24, so dropping 8 bits before
+		applying the 16 bit weight keeps the arithmetic within 32 bits. */
+		for( x = 0; x < ( UBaseType_t ) taskCPU_LOAD_AVERAGES; x++ )
+		{
+			if( ulSample >= pulCpuLoad[ x ] )
 			{
-				xReturn = taskSCHEDULER_RUNNING;
+				ulDifference = ulSample - pulCpuLoad[ x ];
+				pulCpuLoad[ x ] += ( ( ulDifference >> 8 ) * ( uint32_t ) usCpuLoadWeights[ x ] ) >> 8;
 			}
 			else
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				ulDifference = pulCpuLoad[ x ] - ulSample;
+				pulCpuLoad[ x ] -= ( ( ulDifference >> 8 ) * ( uint32_t ) usCpuLoadWeights[ x ] ) >> 8;
 			}
 		}
-
-		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* configGENERATE_CPU_LOAD_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
 
-	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	static void prvSampleCpuLoad( void )
 	{
-	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
+	configRUN_TIME_COUNTER_TYPE ulNow, ulElapsedTime, ulTaskEndTime, ulCurrentRunTime, ulRunTime;
+	uint64_t ullReciprocal;
+	List_t *pxList;
+	ListItem_t const *pxIterator, *pxEndMarker;
+	TCB_t *pxTCB;
+	UBaseType_t uxList, uxNumberOfLists, x;
 
-		/* If the mutex was given back by an interrupt while the queue was
-		locked then the mutex holder might now be NULL.  _RB_ Is this still
-		needed as interrupts can no longer use mutexes? */
-		if( pxMutexHolder != NULL )
+		taskREAD_RUN_TIME_COUNTER( ulNow );
+		ulElapsedTime = ulNow - ulLastCpuLoadSampleTime;
+		ulLastCpuLoadSampleTime = ulNow;
+
+		if( ulElapsedTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
 		{
-			/* If the holder of the mutex has a priority below the priority of
-			the task attempting to obtain the mutex then it will temporarily
-			inherit the priority of the task attempting to obtain the mutex. */
-			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			ullReciprocal = ( ( uint64_t ) 1 << 48 ) / ( uint64_t ) ulElapsedTime;
+
+			/* The running task is not charged for the time it has been running
+			until it is switched out, so add the time it has been running so
+			far.  If the tick interrupt is nested inside other interrupts then
+			the time since the outermost of them was entered is not the task's. */
+			if( uxCpuLoadISRNesting > ( UBaseType_t ) 0U )
 			{
-				/* Adjust the mutex holder state to account for its new
-				priority.  Only reset the event list item value if the value is
-				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				ulTaskEndTime = xISRCpuLoad[ 0 ].ulEnterTime;
+			}
+			else
+			{
+				ulTaskEndTime = ulNow;
+			}
+
+			if( ulTaskEndTime > ulTaskSwitchedInTime )
+			{
+				ulCurrentRunTime = ulTaskEndTime - ulTaskSwitchedInTime;
+			}
+			else
+			{
+				ulCurrentRunTime = 0UL;
+			}
+
+			/* Every task that has not been deleted is referenced from its
+			xStateListItem by a ready, delayed or suspended list.  The lists
+			are walked from their end markers so pxIndex, which the scheduler
+			uses to share time between tasks of equal priority, is not moved. */
+			#if( INCLUDE_vTaskSuspend == 1 )
+			{
+				uxNumberOfLists = ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 3U;
+			}
+			#else
+			{
+				uxNumberOfLists = ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 2U;
+			}
+			#endif
+
+			for( uxList = ( UBaseType_t ) 0U; uxList < uxNumberOfLists; uxList++ )
+			{
+				if( uxList < ( UBaseType_t ) configMAX_PRIORITIES )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					pxList = &( pxReadyTasksLists[ uxList ] );
+				}
+				else if( uxList == ( UBaseType_t ) configMAX_PRIORITIES )
+				{
+					pxList = pxDelayedTaskList;
+				}
+				else if( uxList == ( ( UBaseType_t ) configMAX_PRIORITIES + ( UBaseType_t ) 1U ) )
+				{
+					pxList = pxOverflowDelayedTaskList;
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					#if( INCLUDE_vTaskSuspend == 1 )
+					{
+						pxList = &xSuspendedTaskList;
+					}
+					#else
+					{
+						/* Not reached as uxNumberOfLists excludes this list. */
+						pxList = pxDelayedTaskList;
+					}
+					#endif
 				}
 
-				/* If the task being modified is in the ready state it will need
-				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				pxEndMarker = listGET_END_MARKER( pxList );
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
 				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+					ulRunTime = pxTCB->ulRunTimeCounter;
+
+					if( pxTCB == pxCurrentTCB )
 					{
-						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
+						ulRunTime += ulCurrentRunTime;
 					}
 					else
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
-
-					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxMutexHolderTCB );
+
+					prvUpdateCpuLoad( pxTCB->ulCpuLoad, ulRunTime - pxTCB->ulLoadSampleRunTime, ulElapsedTime, ullReciprocal );
+					pxTCB->ulLoadSampleRunTime = ulRunTime;
+				}
+			}
+
+			for( x = 0; x < ( UBaseType_t ) configCPU_LOAD_ISR_LEVELS; x++ )
+			{
+				ulRunTime = xISRCpuLoad[ x ].ulRunTimeCounter;
+				prvUpdateCpuLoad( xISRCpuLoad[ x ].ulCpuLoad, ulRunTime - xISRCpuLoad[ x ].ulLoadSampleRunTime, ulElapsedTime, ullReciprocal );
+				xISRCpuLoad[ x ].ulLoadSampleRunTime = ulRunTime;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	static UBaseType_t prvReportCpuLoad( const uint32_t *pulCpuLoad, CpuLoad_t * const pxLoad )
+	{
+	uint16_t usLoad[ taskCPU_LOAD_AVERAGES ];
+	UBaseType_t x;
+
+		/* Scale from fractions of 2^24 to hundredths of a percent, rounding to
+		the nearest. */
+		for( x = 0; x < ( UBaseType_t ) taskCPU_LOAD_AVERAGES; x++ )
+		{
+			usLoad[ x ] = ( uint16_t ) ( ( ( pulCpuLoad[ x ] >> 8 ) * 10000UL + 0x8000UL ) >> 16 );
+		}
+
+		if( pxLoad != NULL )
+		{
+			pxLoad->usLoad1s = usLoad[ 0 ];
+			pxLoad->usLoad10s = usLoad[ 1 ];
+			pxLoad->usLoad60s = usLoad[ 2 ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( UBaseType_t ) usLoad[ 0 ];
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	UBaseType_t uxTaskGetCpuLoad( TaskHandle_t xTask, CpuLoad_t * const pxLoad )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		/* The averages are updated from the tick interrupt. */
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = prvReportCpuLoad( pxTCB->ulCpuLoad, pxLoad );
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	UBaseType_t uxTaskGetISRCpuLoad( UBaseType_t uxNestingLevel, CpuLoad_t * const pxLoad )
+	{
+	UBaseType_t uxReturn;
+
+		configASSERT( uxNestingLevel < ( UBaseType_t ) configCPU_LOAD_ISR_LEVELS );
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = prvReportCpuLoad( xISRCpuLoad[ uxNestingLevel ].ulCpuLoad, pxLoad );
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	void vTaskCpuLoadEnterISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		/* Interrupts that nest within this one must not run until the nesting
+		level has been recorded. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			taskREAD_RUN_TIME_COUNTER( ulNow );
+
+			if( uxCpuLoadISRNesting < ( UBaseType_t ) configCPU_LOAD_ISR_LEVELS )
+			{
+				xISRCpuLoad[ uxCpuLoadISRNesting ].ulEnterTime = ulNow;
+				xISRCpuLoad[ uxCpuLoadISRNesting ].ulNestedTime = 0UL;
+			}
+			else
+			{
+				/* Too deeply nested to be timed separately, so the time is
+				counted against the deepest level. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxCpuLoadISRNesting++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CPU_LOAD_STATS == 1 )
+
+	void vTaskCpuLoadExitISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	configRUN_TIME_COUNTER_TYPE ulNow, ulElapsedTime;
+	ISRCpuLoad_t *pxLevel;
+
+		configASSERT( uxCpuLoadISRNesting > ( UBaseType_t ) 0U );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			taskREAD_RUN_TIME_COUNTER( ulNow );
+			uxCpuLoadISRNesting--;
+
+			if( uxCpuLoadISRNesting < ( UBaseType_t ) configCPU_LOAD_ISR_LEVELS )
+			{
+				pxLevel = &( xISRCpuLoad[ uxCpuLoadISRNesting ] );
+				ulElapsedTime = ulNow - pxLevel->ulEnterTime;
+
+				/* Time spent in nested interrupts was counted at the deeper
+				level, and is passed on to this level's parent in turn. */
+				pxLevel->ulRunTimeCounter += ulElapsedTime - pxLevel->ulNestedTime;
+
+				if( uxCpuLoadISRNesting > ( UBaseType_t ) 0U )
+				{
+					xISRCpuLoad[ uxCpuLoadISRNesting - ( UBaseType_t ) 1U ].ulNestedTime += ulElapsedTime;
+				}
+				else
+				{
+					/* Move the time at which the running task was switched in
+					forward so the interrupt is not charged to the task too.  If
+					the task was switched in while the interrupt was running
+					then it started running at the earliest when the interrupt
+					exits. */
+					if( ulTaskSwitchedInTime <= pxLevel->ulEnterTime )
+					{
+						ulTaskSwitchedInTime += ulElapsedTime;
+					}
+					else
+					{
+						ulTaskSwitchedInTime = ulNow;
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_CPU_LOAD_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	static void prvRecordISRLatency( UBaseType_t uxHistogram, configRUN_TIME_COUNTER_TYPE ulTime, configRUN_TIME_COUNTER_TYPE ulNestedTime )
+	{
+	ISRLatency_t *pxLatency = &( xISRLatency[ uxHistogram ] );
+	configRUN_TIME_COUNTER_TYPE ulRemaining = ulTime;
+	UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+		/* The bucket is the number of significant bits in the time, so the
+		loop runs at most configISR_LATENCY_BUCKETS - 1 times however long the
+		time was. */
+		while( ( ulRemaining != 0UL ) && ( uxBucket < ( UBaseType_t ) ( configISR_LATENCY_BUCKETS - 1 ) ) )
+		{
+			ulRemaining >>= 1;
+			uxBucket++;
+		}
+
+		( pxLatency->ulBuckets[ uxBucket ] )++;
+		( pxLatency->ulSamples )++;
+
+		if( ulTime > pxLatency->ulMaxTime )
+		{
+			pxLatency->ulMaxTime = ulTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulNestedTime > pxLatency->ulMaxNestedTime )
+		{
+			pxLatency->ulMaxNestedTime = ulNestedTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	static const char *prvGetISRLatencyName( UBaseType_t uxHistogram )
+	{
+	const char *pcName;
+
+		switch( uxHistogram )
+		{
+			case tskISR_LATENCY_TICK_VECTOR:		pcName = "Tick";
+													break;
+
+			case tskISR_LATENCY_YIELD_VECTOR:		pcName = "Yield";
+													break;
+
+			case tskISR_LATENCY_CRITICAL_SECTION:	pcName = "Critical";
+													break;
+
+			case tskISR_LATENCY_MASK_FROM_ISR:		pcName = "MaskFromISR";
+													break;
+
+			default:								pcName = xISRLatency[ uxHistogram ].pcName;
+													break;
+		}
+
+		return pcName;
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskISRLatencyEnter( UBaseType_t uxVector )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		configASSERT( uxVector < ( UBaseType_t ) configISR_LATENCY_VECTORS );
+
+		/* The untimed mask is used so the timing code does not time itself. */
+		uxSavedInterruptStatus = portRAW_SET_INTERRUPT_MASK_FROM_ISR();
+		{
+			taskREAD_RUN_TIME_COUNTER( ulNow );
+
+			if( uxISRLatencyNesting < ( UBaseType_t ) configISR_LATENCY_NESTING_LEVELS )
+			{
+				xISRLatencyLevels[ uxISRLatencyNesting ].uxVector = uxVector;
+				xISRLatencyLevels[ uxISRLatencyNesting ].ulEnterTime = ulNow;
+				xISRLatencyLevels[ uxISRLatencyNesting ].ulNestedTime = 0UL;
+			}
+			else
+			{
+				/* Too deeply nested to be timed separately, so the time is
+				counted against the interrupt it interrupted. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxISRLatencyNesting++;
+		}
+		portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskISRLatencyExit( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	configRUN_TIME_COUNTER_TYPE ulNow, ulElapsedTime;
+	ISRLatencyLevel_t *pxLevel;
+
+		configASSERT( uxISRLatencyNesting > ( UBaseType_t ) 0U );
+
+		uxSavedInterruptStatus = portRAW_SET_INTERRUPT_MASK_FROM_ISR();
+		{
+			taskREAD_RUN_TIME_COUNTER( ulNow );
+			uxISRLatencyNesting--;
+
+			if( uxISRLatencyNesting < ( UBaseType_t ) configISR_LATENCY_NESTING_LEVELS )
+			{
+				pxLevel = &( xISRLatencyLevels[ uxISRLatencyNesting ] );
+				ulElapsedTime = ulNow - pxLevel->ulEnterTime;
+
+				/* Only the time the interrupt itself ran for is recorded, as
+				the time spent in nested interrupts is recorded against their
+				own vectors. */
+				prvRecordISRLatency( pxLevel->uxVector, ulElapsedTime - pxLevel->ulNestedTime, pxLevel->ulNestedTime );
+
+				if( uxISRLatencyNesting > ( UBaseType_t ) 0U )
+				{
+					xISRLatencyLevels[ uxISRLatencyNesting - ( UBaseType_t ) 1U ].ulNestedTime += ulElapsedTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portRAW_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskISRLatencyMask( BaseType_t xFromISR )
+	{
+		/* Interrupts are already masked, so no critical section is needed. */
+		if( uxISRLatencyMaskNesting == ( UBaseType_t ) 0U )
+		{
+			taskREAD_RUN_TIME_COUNTER( ulISRLatencyMaskTime );
+
+			if( xFromISR != pdFALSE )
+			{
+				uxISRLatencyMaskHistogram = tskISR_LATENCY_MASK_FROM_ISR;
+			}
+			else
+			{
+				uxISRLatencyMaskHistogram = tskISR_LATENCY_CRITICAL_SECTION;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxISRLatencyMaskNesting++;
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskISRLatencyUnmask( void )
+	{
+	configRUN_TIME_COUNTER_TYPE ulNow;
+
+		configASSERT( uxISRLatencyMaskNesting > ( UBaseType_t ) 0U );
+		uxISRLatencyMaskNesting--;
+
+		if( uxISRLatencyMaskNesting == ( UBaseType_t ) 0U )
+		{
+			taskREAD_RUN_TIME_COUNTER( ulNow );
+			prvRecordISRLatency( uxISRLatencyMaskHistogram, ulNow - ulISRLatencyMaskTime, 0UL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	UBaseType_t uxTaskGetISRLatency( UBaseType_t uxHistogram, ISRLatency_t * const pxLatency )
+	{
+	UBaseType_t uxReturn;
+
+		configASSERT( uxHistogram < tskISR_LATENCY_HISTOGRAMS );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxLatency != NULL )
+			{
+				*pxLatency = xISRLatency[ uxHistogram ];
+				pxLatency->pcName = prvGetISRLatencyName( uxHistogram );
+			}
+
+			uxReturn = ( UBaseType_t ) xISRLatency[ uxHistogram ].ulSamples;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskSetISRLatencyName( UBaseType_t uxVector, const char *pcName )
+	{
+		configASSERT( ( uxVector >= tskISR_LATENCY_FIRST_APPLICATION_VECTOR ) && ( uxVector < ( UBaseType_t ) configISR_LATENCY_VECTORS ) );
+
+		taskENTER_CRITICAL();
+		{
+			xISRLatency[ uxVector ].pcName = pcName;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_ISR_LATENCY_STATS == 1 )
+
+	void vTaskClearISRLatency( void )
+	{
+	UBaseType_t uxHistogram;
+	const char *pcName;
+
+		taskENTER_CRITICAL();
+		{
+			for( uxHistogram = ( UBaseType_t ) 0U; uxHistogram < tskISR_LATENCY_HISTOGRAMS; uxHistogram++ )
+			{
+				/* The names set by the application are kept. */
+				pcName = xISRLatency[ uxHistogram ].pcName;
+				( void ) memset( &( xISRLatency[ uxHistogram ] ), 0x00, sizeof( ISRLatency_t ) );
+				xISRLatency[ uxHistogram ].pcName = pcName;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configGENERATE_ISR_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	static void prvDeleteTCB( TCB_t *pxTCB )
+	{
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
+
+		#if ( configUSE_HEAP_ACCOUNTING == 1 )
+		{
+			/* The heap records the handle of the task that allocated each
+			block, and the handle may be reused once the TCB is freed, so the
+			blocks the task still owns are disowned first. */
+			vPortHeapClearOwner( ( void * ) pxTCB );
+		}
+		#endif /* configUSE_HEAP_ACCOUNTING */
+
+		/* Free up the memory allocated by the scheduler for the task.  It is up
+		to the task to free any memory allocated at the application level. */
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+
+		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		{
+			/* The task can only have been allocated dynamically - free both
+			the stack and TCB. */
+			vPortFree( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+		{
+			/* The task could have been allocated statically or dynamically, so
+			check what was statically allocated before trying to free the
+			memory. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				/* Both the stack and TCB were allocated dynamically, so both
+				must be freed. */
+				vPortFree( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				/* Only the stack was statically allocated, so the TCB is the
+				only memory that must be freed. */
+				vPortFree( pxTCB );
+			}
+			else
+			{
+				/* Neither the stack nor the TCB were allocated dynamically, so
+				nothing needs to be freed. */
+				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+TCB_t *pxTCB;
+
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	{
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+		the maximum possible value so it is	extremely unlikely that the
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+		there is an item in the delayed list. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		/* The new current delayed list is not empty, get the value of
+		the item at the head of the delayed list.  This is the time at
+		which the task at the head of the delayed list should be removed
+		from the Blocked state. */
+		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+
+	TaskHandle_t xTaskGetCurrentTaskHandle( void )
+	{
+	TaskHandle_t xReturn;
+
+		/* A critical section is not required as this is not called from
+		an interrupt and the current TCB will always be the same for any
+		individual execution thread.  In a multi-core build pxCurrentTCB masks
+		interrupts itself so the task cannot move core while it is read. */
+		xReturn = pxCurrentTCB;
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configNUMBER_OF_CORES > 1 ) && ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) )
+
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+	{
+	TaskHandle_t xReturn = NULL;
+
+		if( ( xCoreID >= ( BaseType_t ) 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) )
+		{
+			xReturn = pxCurrentTCBs[ xCoreID ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+	BaseType_t xTaskGetSchedulerState( void )
+	{
+	BaseType_t xReturn;
+
+		if( xSchedulerRunning == pdFALSE )
+		{
+			xReturn = taskSCHEDULER_NOT_STARTED;
+		}
+		else
+		{
+			if( taskGET_SCHEDULER_SUSPENDED() == ( UBaseType_t ) pdFALSE )
+			{
+				xReturn = taskSCHEDULER_RUNNING;
+			}
+			else
+			{
+				xReturn = taskSCHEDULER_SUSPENDED;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+
+		/* If the mutex was given back by an interrupt while the queue was
+		locked then the mutex holder might now be NULL.  _RB_ Is this still
+		needed as interrupts can no longer use mutexes? */
+		if( pxMutexHolder != NULL )
+		{
+			/* If the holder of the mutex has a priority below the priority of
+			the task attempting to obtain the mutex then it will temporarily
+			inherit the priority of the task attempting to obtain the mutex. */
+			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			{
+				/* Adjust the mutex holder state to account for its new
+				priority.  Only reset the event list item value if the value is
+				not being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* If the task being modified is in the ready state it will need
+				to be moved into a new list. */
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+				{
+					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Inherit the priority before being moved into the new list. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					prvAddTaskToReadyList( pxMutexHolderTCB );
+				}
+				else
+				{
+					/* Just inherit the priority. */
+					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+				#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+				{
+					/* The mutex holder might itself be waiting for a mutex, in
+					which case the priority is passed on down the chain. */
+					prvPassOnInheritedPriority( pxMutexHolderTCB );
+				}
+				#endif
+
+				/* Inheritance occurred. */
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				{
+					/* The base priority of the mutex holder is lower than the
+					priority of the task attempting to take the mutex, but the
+					current priority of the mutex holder is not lower than the
+					priority of the task attempting to take the mutex.
+					Therefore the mutex holder must have already inherited a
+					priority, but inheritance would have occurred if that had
+					not been the case. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxPriorityToUse;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* A task can only have an inherited priority if it holds the mutex.
+			If the mutex is held by a task then it cannot be given from an
+			interrupt, and if a mutex is given by the holding task then it must
+			be the running state task. */
+			configASSERT( pxTCB == pxCurrentTCB );
+			configASSERT( pxTCB->uxMutexesHeld );
+			( pxTCB->uxMutexesHeld )--;
+
+			/* Has the holder of the mutex inherited the priority of another
+			task? */
+			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			{
+				/* When the mutexes held are listed the priority only drops as
+				far as the mutexes still held allow, otherwise it is only
+				disinherited if no other mutexes are held. */
+				#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+				{
+					uxPriorityToUse = prvGetInheritedPriority( pxTCB );
+				}
+				#else
+				{
+					uxPriorityToUse = pxTCB->uxBasePriority;
+				}
+				#endif
+
+				if( ( pxTCB->uxPriority != uxPriorityToUse ) &&
+					( ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 ) || ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 ) ) )
+				{
+					/* A task can only have an inherited priority if it holds
+					the mutex.  If the mutex is held by a task then it cannot be
+					given from an interrupt, and if a mutex is given by the
+					holding task then it must be the running state task.  Remove
+					the holding task from the ready list. */
+					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+					{
+						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Disinherit the priority before adding the task into the
+					new	ready list. */
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+					pxTCB->uxPriority = uxPriorityToUse;
+
+					/* Reset the event list item value.  It cannot be in use for
+					any other purpose if this task is running, and it must be
+					running to give back the mutex. */
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					prvAddTaskToReadyList( pxTCB );
+
+					/* Return true to indicate that a context switch is required.
+					This is only actually required in the corner case whereby
+					multiple mutexes were held and the mutexes were given back
+					in an order different to that in which they were taken.
+					If a context switch did not occur when the first mutex was
+					returned, even if a task was waiting on it, then a context
+					switch should occur when the last mutex is returned whether
+					a task is waiting on it or not. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+	const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+		if( pxMutexHolder != NULL )
+		{
+			/* If pxMutexHolder is not NULL then the holder must hold at least
+			one mutex. */
+			configASSERT( pxTCB->uxMutexesHeld );
+
+			/* Determine the priority to which the priority of the task that
+			holds the mutex should be set.  This will be the greater of the
+			holding task's base priority and the priority of the highest
+			priority task that is waiting to obtain the mutex - or, when the
+			mutexes held are listed, any of the mutexes it holds. */
+			#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+			{
+				( void ) uxHighestPriorityWaitingTask;
+				uxPriorityToUse = prvGetInheritedPriority( pxTCB );
+			}
+			#else
+			{
+				if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+				{
+					uxPriorityToUse = uxHighestPriorityWaitingTask;
+				}
+				else
+				{
+					uxPriorityToUse = pxTCB->uxBasePriority;
+				}
+			}
+			#endif
+
+			/* Does the priority need to change? */
+			if( pxTCB->uxPriority != uxPriorityToUse )
+			{
+				/* Only disinherit if no other mutexes are held.  This is a
+				simplification in the priority inheritance implementation.  If
+				the task that holds the mutex is also holding other mutexes then
+				the other mutexes may have caused the priority inheritance. */
+				if( ( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld ) || ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 ) )
+				{
+					/* If a task has timed out because it already holds the
+					mutex it was trying to obtain then it cannot of inherited
+					its own priority. */
+					configASSERT( pxTCB != pxCurrentTCB );
+
+					/* Disinherit the priority, remembering the previous
+					priority to facilitate determining the subject task's
+					state. */
+					traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+					uxPriorityUsedOnEntry = pxTCB->uxPriority;
+					pxTCB->uxPriority = uxPriorityToUse;
+
+					/* Only reset the event list item value if the value is not
+					being used for anything else. */
+					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* If the running task is not the task that holds the mutex
+					then the task that holds the mutex could be in either the
+					Ready, Blocked or Suspended states.  Only remove the task
+					from its current state list if it is in the Ready state as
+					the task's priority is going to change and there is one
+					Ready list per priority. */
+					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+						{
+							taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						prvAddTaskToReadyList( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					#if( configNUMBER_OF_CORES > 1 )
+					{
+						/* The mutex holder might be running on another core,
+						which now might have to give way to a ready task. */
+						taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+					}
+					#endif /* configNUMBER_OF_CORES */
+
+					#if( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+					{
+						/* Holders further down the chain no longer need the
+						priority either. */
+						prvPassOnInheritedPriority( pxTCB );
+					}
+					#endif
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			( pxCurrentTCB->uxCriticalNesting )++;
+
+			/* This is not the interrupt safe version of the enter critical
+			function so	assert() if it is being called from an interrupt
+			context.  Only API functions that end in "FromISR" can be used in an
+			interrupt.  Only assert if the critical nesting count is 1 to
+			protect against recursive calls if the assert function also uses a
+			critical section. */
+			if( pxCurrentTCB->uxCriticalNesting == 1 )
+			{
+				portASSERT_IF_IN_ISR();
+
+				#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+				{
+					vTaskISRLatencyMask( pdFALSE );
+				}
+				#endif
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+	void vTaskExitCritical( void )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			{
+				( pxCurrentTCB->uxCriticalNesting )--;
+
+				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				{
+					#if( configGENERATE_ISR_LATENCY_STATS == 1 )
+					{
+						vTaskISRLatencyUnmask();
+					}
+					#endif
+
+					portENABLE_INTERRUPTS();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static TCB_t *prvGetCurrentTCB( void )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+		{
+			/* The calling task could otherwise be moved to another core
+			between reading the core number and reading the array. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+		}
+
+		return pxTCB;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static UBaseType_t prvGetSchedulerSuspended( void )
+	{
+	UBaseType_t uxReturn;
+
+		/* If another core has the scheduler suspended then entering the
+		critical section waits for it to be resumed, so a non-zero value can
+		only mean the scheduler was suspended by the calling task. */
+		taskENTER_CRITICAL();
+		{
+			uxReturn = uxSchedulerSuspended;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+	BaseType_t xTaskScheduled = pdFALSE;
+	BaseType_t xDecrementTopPriority = pdTRUE;
+	TCB_t *pxTCB;
+	TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+
+	#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+		BaseType_t xPriorityDropped = pdFALSE;
+	#endif
+
+		/* The task being switched out is still in its ready list if it is
+		yielding.  Move it to the end of the list so tasks of the same priority
+		that have been waiting longer are selected before it. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+		{
+			( void ) uxListRemove( &( pxPreviousTCB->xStateListItem ) );
+			vListInsertEnd( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		while( xTaskScheduled == pdFALSE )
+		{
+			#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+			{
+				/* Only one priority runs at a time, so a core that cannot run a
+				task of the top ready priority runs an idle task. */
+				if( uxCurrentPriority < uxTopReadyPriority )
+				{
+					uxCurrentPriority = tskIDLE_PRIORITY;
+				}
+			}
+			#endif /* configRUN_MULTIPLE_PRIORITIES */
+
+			if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+			{
+			const List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+			const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxReadyList );
+			const ListItem_t *pxIterator;
+
+				/* A task is ready at this priority, even if it cannot run on
+				this core, so uxTopReadyPriority is not lowered any further. */
+				xDecrementTopPriority = pdFALSE;
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+					{
+						/* Falling back to the idle priority only selects the
+						idle tasks, not application tasks of the idle
+						priority. */
+						if( ( uxCurrentPriority < uxTopReadyPriority ) && ( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U ) )
+						{
+							continue;
+						}
+					}
+					#endif /* configRUN_MULTIPLE_PRIORITIES */
+
+					#if( configUSE_CORE_AFFINITY == 1 )
+						if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+					#endif
+					{
+						if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+						{
+							pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+							pxTCB->xTaskRunState = xCoreID;
+							pxCurrentTCBs[ xCoreID ] = pxTCB;
+							xTaskScheduled = pdTRUE;
+						}
+						else if( pxTCB == pxPreviousTCB )
+						{
+							/* Selected again, which cancels any request for
+							it to yield. */
+							configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+							pxTCB->xTaskRunState = xCoreID;
+							xTaskScheduled = pdTRUE;
+						}
+						else
+						{
+							/* Running on another core. */
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( xTaskScheduled != pdFALSE )
+					{
+						break;
+					}
+				}
+			}
+			else
+			{
+				if( xDecrementTopPriority != pdFALSE )
+				{
+					uxTopReadyPriority--;
+
+					#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+					{
+						xPriorityDropped = pdTRUE;
+					}
+					#endif
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* There is an idle task for each core, so a task is always found
+			by the time the idle priority is searched. */
+			if( uxCurrentPriority > tskIDLE_PRIORITY )
+			{
+				uxCurrentPriority--;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		configASSERT( xTaskScheduled != pdFALSE );
+
+		#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+		{
+			/* The last task of a higher priority has stopped running, so the
+			cores that were kept idle might now have tasks to run. */
+			if( xPriorityDropped != pdFALSE )
+			{
+			BaseType_t x;
+
+				for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+				{
+					if( ( x != xCoreID ) && ( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) )
+					{
+						prvYieldCore( x );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configRUN_MULTIPLE_PRIORITIES */
+
+		#if( ( configUSE_CORE_AFFINITY == 1 ) && ( configUSE_PREEMPTION == 1 ) )
+		{
+			/* A task that was evicted from this core while still ready might
+			be able to run on one of the other cores in its affinity mask. */
+			if( ( pxPreviousTCB != pxCurrentTCBs[ xCoreID ] ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+			{
+			BaseType_t x, xTaskPriority, xLowestPriorityCore = ( BaseType_t ) -1;
+			BaseType_t xLowestPriority = ( BaseType_t ) pxPreviousTCB->uxPriority;
+
+				if( ( pxPreviousTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+				{
+					xLowestPriority--;
+				}
+
+				/* As prvYieldForTask(), which cannot be used here as it must be
+				called from within a critical section. */
+				for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+				{
+					if( ( x != xCoreID ) && ( ( pxPreviousTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) x ) ) != 0U ) )
+					{
+						xTaskPriority = ( BaseType_t ) pxCurrentTCBs[ x ]->uxPriority;
+
+						if( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+						{
+							xTaskPriority--;
+						}
+
+						if( ( xTaskPriority < xLowestPriority ) && ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) ) && ( xYieldPendings[ x ] == pdFALSE ) )
+						{
+							xLowestPriority = xTaskPriority;
+							xLowestPriorityCore = x;
+						}
+					}
+				}
+
+				if( xLowestPriorityCore >= ( BaseType_t ) 0 )
+				{
+					prvYieldCore( xLowestPriorityCore );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_CORE_AFFINITY */
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+
+	static void prvYieldForTask( const TCB_t *pxTCB )
+	{
+	BaseType_t xLowestPriorityToPreempt;
+	BaseType_t xCurrentCoreTaskPriority;
+	BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+	BaseType_t xCoreID;
+
+	#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+		BaseType_t xYieldCount = 0;
+	#endif
+
+		/* The run states of the other cores can only be read from within a
+		critical section. */
+		configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+		#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+			/* No core yields for a task of lower priority than the priority
+			being run. */
+			if( pxTCB->uxPriority >= uxTopReadyPriority )
+		#else
+			/* No core yields for a task that is already running. */
+			if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+		#endif
+		{
+			/* Idle tasks are treated as having a priority one below
+			tskIDLE_PRIORITY, so a task of the idle priority preempts an idle
+			task before any other task of the idle priority.  The subtraction
+			can take the value to -1. */
+			xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
+			--xLowestPriorityToPreempt;
+
+			for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				xCurrentCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xCoreID ]->uxPriority;
+
+				if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+				{
+					xCurrentCoreTaskPriority = xCurrentCoreTaskPriority - ( BaseType_t ) 1;
+				}
+
+				/* Cores that have already been asked to yield are skipped. */
+				if( ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+				{
+					#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+						if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+					#endif
+					{
+						if( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt )
+						{
+							#if( configUSE_CORE_AFFINITY == 1 )
+								if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+							#endif
+							{
+								xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+								xLowestPriorityCore = xCoreID;
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+					{
+						/* Every core running an application task of lower
+						priority has to yield, as only one priority can run
+						at a time. */
+						if( ( xCurrentCoreTaskPriority > ( ( BaseType_t ) tskIDLE_PRIORITY - 1 ) ) && ( xCurrentCoreTaskPriority < ( BaseType_t ) pxTCB->uxPriority ) )
+						{
+							prvYieldCore( xCoreID );
+							xYieldCount++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configRUN_MULTIPLE_PRIORITIES */
 				}
 				else
 				{
-					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					mtCOVERAGE_TEST_MARKER();
 				}
+			}
 
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+			#if( configRUN_MULTIPLE_PRIORITIES == 0 )
+				if( ( xYieldCount == 0 ) && ( xLowestPriorityCore >= ( BaseType_t ) 0 ) )
+			#else
+				if( xLowestPriorityCore >= ( BaseType_t ) 0 )
+			#endif
+			{
+				prvYieldCore( xLowestPriorityCore );
+			}
+		}
+	}
 
-				/* Inheritance occurred. */
-				xReturn = pdTRUE;
+#endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvCheckForRunStateChange( void )
+	{
+	UBaseType_t uxPrevCriticalNesting;
+	const TCB_t *pxThisTCB;
+
+		/* Only called from a task, with interrupts disabled. */
+		portASSERT_IF_IN_ISR();
+		pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+		while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
+		{
+			/* Another core asked this task to yield after the task had
+			disabled interrupts but before it got the locks.  Drop the locks,
+			and the critical nesting count if entering a critical section, so
+			the pending yield interrupt can be taken, then try again once this
+			task runs again.  The scheduler suspended count is only incremented
+			after this function returns, so is not affected. */
+			uxPrevCriticalNesting = portGET_CRITICAL_NESTING_COUNT();
+
+			if( uxPrevCriticalNesting > 0U )
+			{
+				portSET_CRITICAL_NESTING_COUNT( 0U );
+				portRELEASE_ISR_LOCK();
 			}
 			else
 			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
-				{
-					/* The base priority of the mutex holder is lower than the
-					priority of the task attempting to take the mutex, but the
-					current priority of the mutex holder is not lower than the
-					priority of the task attempting to take the mutex.
-					Therefore the mutex holder must have already inherited a
-					priority, but inheritance would have occurred if that had
-					not been the case. */
-					xReturn = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portRELEASE_TASK_LOCK();
+			portMEMORY_BARRIER();
+
+			portENABLE_INTERRUPTS();
+
+			/* The yield interrupt is taken as soon as interrupts are enabled,
+			so by the time execution gets here the task is running again. */
+			configASSERT( pxThisTCB->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD );
+
+			portDISABLE_INTERRUPTS();
+			portGET_TASK_LOCK();
+			portGET_ISR_LOCK();
+
+			portSET_CRITICAL_NESTING_COUNT( uxPrevCriticalNesting );
+
+			if( uxPrevCriticalNesting == 0U )
+			{
+				portRELEASE_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
 			}
+
+			/* The task might now be on another core. */
+			pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vTaskYieldWithinAPI( void )
+	{
+		/* Interrupts are disabled within a critical section, so the task
+		cannot change core between reading the nesting count and the core
+		number. */
+		if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+		{
+			portYIELD();
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
 		}
-
-		return xReturn;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configNUMBER_OF_CORES > 1 )
 
-	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+	void vTaskEnterCritical( void )
 	{
-	TCB_t * const pxTCB = pxMutexHolder;
-	BaseType_t xReturn = pdFALSE;
+		portDISABLE_INTERRUPTS();
 
-		if( pxMutexHolder != NULL )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			/* A task can only have an inherited priority if it holds the mutex.
-			If the mutex is held by a task then it cannot be given from an
-			interrupt, and if a mutex is given by the holding task then it must
-			be the running state task. */
-			configASSERT( pxTCB == pxCurrentTCB );
-			configASSERT( pxTCB->uxMutexesHeld );
-			( pxTCB->uxMutexesHeld )--;
-
-			/* Has the holder of the mutex inherited the priority of another
-			task? */
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			/* The task lock is taken first, as in vTaskSuspendAll(), so a core
+			holding the scheduler suspended can still enter a critical
+			section. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
 			{
-				/* Only disinherit if no other mutexes are held. */
-				if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
-				{
-					/* A task can only have an inherited priority if it holds
-					the mutex.  If the mutex is held by a task then it cannot be
-					given from an interrupt, and if a mutex is given by the
-					holding task then it must be the running state task.  Remove
-					the holding task from the ready list. */
-					if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-					{
-						taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+				portGET_TASK_LOCK();
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-					/* Disinherit the priority before adding the task into the
-					new	ready list. */
-					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					pxTCB->uxPriority = pxTCB->uxBasePriority;
+			portINCREMENT_CRITICAL_NESTING_COUNT();
 
-					/* Reset the event list item value.  It cannot be in use for
-					any other purpose if this task is running, and it must be
-					running to give back the mutex. */
-					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					prvAddTaskToReadyList( pxTCB );
+			/* As the single core vTaskEnterCritical(), only assert if the
+			nesting count is 1 in case configASSERT() also uses a critical
+			section. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+			{
+				portASSERT_IF_IN_ISR();
 
-					/* Return true to indicate that a context switch is required.
-					This is only actually required in the corner case whereby
-					multiple mutexes were held and the mutexes were given back
-					in an order different to that in which they were taken.
-					If a context switch did not occur when the first mutex was
-					returned, even if a task was waiting on it, then a context
-					switch should occur when the last mutex is returned whether
-					a task is waiting on it or not. */
-					xReturn = pdTRUE;
+				if( uxSchedulerSuspended == 0U )
+				{
+					prvCheckForRunStateChange();
 				}
 				else
 				{
@@ -3986,90 +7239,38 @@ TCB_t *pxTCB;
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-
-		return xReturn;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if( configNUMBER_OF_CORES > 1 )
 
-	void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	void vTaskExitCritical( void )
 	{
-	TCB_t * const pxTCB = pxMutexHolder;
-	UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-	const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+	BaseType_t xYieldCurrentTask;
 
-		if( pxMutexHolder != NULL )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			/* If pxMutexHolder is not NULL then the holder must hold at least
-			one mutex. */
-			configASSERT( pxTCB->uxMutexesHeld );
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
 
-			/* Determine the priority to which the priority of the task that
-			holds the mutex should be set.  This will be the greater of the
-			holding task's base priority and the priority of the highest
-			priority task that is waiting to obtain the mutex. */
-			if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
-			{
-				uxPriorityToUse = uxHighestPriorityWaitingTask;
-			}
-			else
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
 			{
-				uxPriorityToUse = pxTCB->uxBasePriority;
-			}
+				portDECREMENT_CRITICAL_NESTING_COUNT();
 
-			/* Does the priority need to change? */
-			if( pxTCB->uxPriority != uxPriorityToUse )
-			{
-				/* Only disinherit if no other mutexes are held.  This is a
-				simplification in the priority inheritance implementation.  If
-				the task that holds the mutex is also holding other mutexes then
-				the other mutexes may have caused the priority inheritance. */
-				if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
 				{
-					/* If a task has timed out because it already holds the
-					mutex it was trying to obtain then it cannot of inherited
-					its own priority. */
-					configASSERT( pxTCB != pxCurrentTCB );
-
-					/* Disinherit the priority, remembering the previous
-					priority to facilitate determining the subject task's
-					state. */
-					traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-					uxPriorityUsedOnEntry = pxTCB->uxPriority;
-					pxTCB->uxPriority = uxPriorityToUse;
+					/* A yield requested from within the critical section was
+					held in xYieldPending until now. */
+					xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
 
-					/* Only reset the event list item value if the value is not
-					being used for anything else. */
-					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-					{
-						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					portRELEASE_ISR_LOCK();
+					portRELEASE_TASK_LOCK();
+					portENABLE_INTERRUPTS();
 
-					/* If the running task is not the task that holds the mutex
-					then the task that holds the mutex could be in either the
-					Ready, Blocked or Suspended states.  Only remove the task
-					from its current state list if it is in the Ready state as
-					the task's priority is going to change and there is one
-					Ready list per priority. */
-					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					if( xYieldCurrentTask != pdFALSE )
 					{
-						if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-						{
-							taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-
-						prvAddTaskToReadyList( pxTCB );
+						portYIELD();
 					}
 					else
 					{
@@ -4092,52 +7293,113 @@ TCB_t *pxTCB;
 		}
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if( configNUMBER_OF_CORES > 1 )
 
-	void vTaskEnterCritical( void )
+	UBaseType_t vTaskEnterCriticalFromISR( void )
 	{
-		portDISABLE_INTERRUPTS();
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* Only the ISR lock is taken, so an interrupt can run while another
+		core holds the scheduler suspended. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 
 		if( xSchedulerRunning != pdFALSE )
 		{
-			( pxCurrentTCB->uxCriticalNesting )++;
-
-			/* This is not the interrupt safe version of the enter critical
-			function so	assert() if it is being called from an interrupt
-			context.  Only API functions that end in "FromISR" can be used in an
-			interrupt.  Only assert if the critical nesting count is 1 to
-			protect against recursive calls if the assert function also uses a
-			critical section. */
-			if( pxCurrentTCB->uxCriticalNesting == 1 )
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
 			{
-				portASSERT_IF_IN_ISR();
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
 			}
+
+			portINCREMENT_CRITICAL_NESTING_COUNT();
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		return uxSavedInterruptStatus;
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if( configNUMBER_OF_CORES > 1 )
 
-	void vTaskExitCritical( void )
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
 	{
 		if( xSchedulerRunning != pdFALSE )
 		{
-			if( pxCurrentTCB->uxCriticalNesting > 0U )
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
 			{
-				( pxCurrentTCB->uxCriticalNesting )--;
+				portDECREMENT_CRITICAL_NESTING_COUNT();
 
-				if( pxCurrentTCB->uxCriticalNesting == 0U )
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+				{
+					portRELEASE_ISR_LOCK();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxPrevCoreAffinityMask;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxPrevCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					/* The task has to move if it can no longer run on the core
+					it is running on. */
+					if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) pxTCB->xTaskRunState ) ) == 0U )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( ( ~uxPrevCoreAffinityMask ) & uxCoreAffinityMask ) != 0U )
 				{
-					portENABLE_INTERRUPTS();
+					/* The task might be able to run on a core it could not run
+					on before. */
+					taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
 				}
 				else
 				{
@@ -4149,13 +7411,30 @@ TCB_t *pxTCB;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		else
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+	UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+	{
+	const TCB_t *pxTCB;
+	UBaseType_t uxCoreAffinityMask;
+
+		taskENTER_CRITICAL();
 		{
-			mtCOVERAGE_TEST_MARKER();
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
 		}
+		taskEXIT_CRITICAL();
+
+		return uxCoreAffinityMask;
 	}
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
@@ -4266,7 +7545,17 @@ TCB_t *pxTCB;
 				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
 				/* Write the rest of the string. */
-				sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				#if ( configUSE_HEAP_ACCOUNTING == 1 )
+				{
+					/* The heap column follows the task number, so existing
+					parsers of the table are not affected. */
+					sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber, ( unsigned int ) uxTaskGetHeapUsage( pxTaskStatusArray[ x ].xHandle ) ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				}
+				#else
+				{
+					sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				}
+				#endif /* configUSE_HEAP_ACCOUNTING */
 				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
 			}
 
@@ -4289,7 +7578,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4358,11 +7647,24 @@ TCB_t *pxTCB;
 					easily. */
 					pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
-					if( ulStatsAsPercentage > 0UL )
+					if( sizeof( configRUN_TIME_COUNTER_TYPE ) > sizeof( unsigned long ) )
+					{
+						/* The run time counter is wider than a long, so cannot
+						be printed with %lu or %u without being truncated. */
+						if( ulStatsAsPercentage > 0UL )
+						{
+							sprintf( pcWriteBuffer, "\t%llu\t\t%u%%\r\n", ( unsigned long long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+						}
+						else
+						{
+							sprintf( pcWriteBuffer, "\t%llu\t\t<1%%\r\n", ( unsigned long long ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+						}
+					}
+					else if( ulStatsAsPercentage > 0UL )
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4378,7 +7680,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4410,6 +7712,80 @@ TCB_t *pxTCB;
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configGENERATE_ISR_LATENCY_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+	void vTaskGetISRLatencyReport( char *pcWriteBuffer )
+	{
+	ISRLatency_t xLatency;
+	UBaseType_t uxHistogram, uxBucket;
+	char cUnnamed[ 16 ];
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, and is used by many
+		 * of the demo applications.  Do not consider it to be part of the
+		 * scheduler.
+		 *
+		 * vTaskGetISRLatencyReport() calls uxTaskGetISRLatency(), then formats
+		 * its output into a human readable table, so has the same dependency
+		 * on sprintf() as vTaskList().
+		 */
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		for( uxHistogram = ( UBaseType_t ) 0U; uxHistogram < tskISR_LATENCY_HISTOGRAMS; uxHistogram++ )
+		{
+			/* Each histogram is read in its own critical section, so the
+			table is not a single snapshot. */
+			( void ) uxTaskGetISRLatency( uxHistogram, &xLatency );
+
+			if( ( xLatency.pcName == NULL ) && ( xLatency.ulSamples != 0UL ) )
+			{
+				sprintf( cUnnamed, "ISR%u", ( unsigned int ) uxHistogram ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				xLatency.pcName = cUnnamed;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Application vectors that have no name and have not been used are
+			left out. */
+			if( xLatency.pcName != NULL )
+			{
+				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, xLatency.pcName );
+
+				sprintf( pcWriteBuffer, "\t%lu\t%lu\t%lu\t", ( unsigned long ) xLatency.ulSamples, ( unsigned long ) xLatency.ulMaxTime, ( unsigned long ) xLatency.ulMaxNestedTime ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configISR_LATENCY_BUCKETS; uxBucket++ )
+				{
+					if( xLatency.ulBuckets[ uxBucket ] != 0UL )
+					{
+						sprintf( pcWriteBuffer, " %u:%lu", ( unsigned int ) uxBucket, ( unsigned long ) xLatency.ulBuckets[ uxBucket ] ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+						pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				strcpy( pcWriteBuffer, "\r\n" );
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* ( ( configGENERATE_ISR_LATENCY_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
 TickType_t uxReturn;
@@ -4441,24 +7817,216 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	TaskHandle_t pvTaskAddHeldMutex( ListItem_t * const pxHeldMutexListItem )
+	{
+		if( pxCurrentTCB != NULL )
+		{
+			/* The list is not kept in any order, so the item value is not
+			used. */
+			vListInsertEnd( &( pxCurrentTCB->xMutexesHeldList ), pxHeldMutexListItem );
+			pxCurrentTCB->pvMutexWaitedFor = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvTaskIncrementMutexHeldCount();
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	void vTaskSetMutexWaitedFor( void *pvMutex )
+	{
+		pxCurrentTCB->pvMutexWaitedFor = pvMutex;
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	static UBaseType_t prvGetInheritedPriority( const TCB_t * const pxTCB )
+	{
+	UBaseType_t uxPriority = pxTCB->uxBasePriority, uxWaitingPriority;
+	const ListItem_t *pxIterator;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( &( pxTCB->xMutexesHeldList ) );
+	const List_t *pxWaitingTasks;
+
+		/* The owner of each held mutex's list item is the list of tasks
+		waiting for the mutex, which is kept in priority order. */
+		for( pxIterator = listGET_HEAD_ENTRY( &( pxTCB->xMutexesHeldList ) ); pxIterator != pxEnd; pxIterator = listGET_NEXT( pxIterator ) )
+		{
+			pxWaitingTasks = ( const List_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+			if( listLIST_IS_EMPTY( pxWaitingTasks ) == pdFALSE )
+			{
+				uxWaitingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWaitingTasks );
+
+				if( uxWaitingPriority > uxPriority )
+				{
+					uxPriority = uxWaitingPriority;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxPriority;
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	static void prvSetInheritedPriority( TCB_t * const pxTCB, UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		if( uxNewPriority > uxPriorityUsedOnEntry )
+		{
+			traceTASK_PRIORITY_INHERIT( pxTCB, uxNewPriority );
+		}
+		else
+		{
+			traceTASK_PRIORITY_DISINHERIT( pxTCB, uxNewPriority );
+		}
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* There is one ready list per priority, so a ready task moves. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( uxPriorityUsedOnEntry );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyList( pxTCB );
+
+			#if( configNUMBER_OF_CORES > 1 )
+			{
+				if( uxNewPriority < uxPriorityUsedOnEntry )
+				{
+					taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+				}
+				else
+				{
+					taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
+		}
+		else
+		{
+			pxTCB->uxPriority = uxNewPriority;
+		}
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_INHERITANCE_CHAINS == 1 )
+
+	static void prvPassOnInheritedPriority( TCB_t *pxTCB )
+	{
+	TCB_t * const pxFirstTCB = pxTCB;
+	TCB_t *pxHolderTCB;
+	List_t *pxWaitingTasks;
+	UBaseType_t uxDepth, uxNewPriority;
+
+		for( uxDepth = 0; uxDepth < ( UBaseType_t ) configPRIORITY_INHERITANCE_CHAIN_DEPTH; uxDepth++ )
+		{
+			if( pxTCB->pvMutexWaitedFor == NULL )
+			{
+				break;
+			}
+
+			/* The event list item value of pxTCB might have changed while it
+			was in the list of tasks waiting for the mutex, so put it back in
+			priority order before the holder looks at the head of the list. */
+			pxWaitingTasks = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+			if( pxWaitingTasks != NULL )
+			{
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				vListInsert( pxWaitingTasks, &( pxTCB->xEventListItem ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A chain that leads back to where it started is a deadlock, and
+			there is nothing more to pass on. */
+			pxHolderTCB = xQueueGetMutexHolderFromISR( ( QueueHandle_t ) pxTCB->pvMutexWaitedFor );
+
+			if( ( pxHolderTCB == NULL ) || ( pxHolderTCB == pxFirstTCB ) )
+			{
+				break;
+			}
+
+			uxNewPriority = prvGetInheritedPriority( pxHolderTCB );
+
+			if( uxNewPriority == pxHolderTCB->uxPriority )
+			{
+				break;
+			}
+
+			prvSetInheritedPriority( pxHolderTCB, uxNewPriority );
+			pxTCB = pxHolderTCB;
+		}
+	}
+
+#endif /* configUSE_PRIORITY_INHERITANCE_CHAINS */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
 					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_TAKE_BLOCK();
+					traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
 
 					/* All ports are written to allow a yield in a critical
 					section (some will yield immediately, others wait until the
@@ -4480,18 +8048,18 @@ TickType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			traceTASK_NOTIFY_TAKE( uxIndexToWait );
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4499,7 +8067,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4511,27 +8079,29 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
 					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_WAIT_BLOCK();
+					traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
 
 					/* All ports are written to allow a yield in a critical
 					section (some will yield immediately, others wait until the
@@ -4553,20 +8123,20 @@ TickType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_WAIT();
+			traceTASK_NOTIFY_WAIT( uxIndexToWait );
 
 			if( pulNotificationValue != NULL )
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4575,11 +8145,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4591,44 +8161,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4646,12 +8217,12 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
 
-			traceTASK_NOTIFY();
+			traceTASK_NOTIFY( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4679,16 +8250,24 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if( configNUMBER_OF_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					taskYIELD_IF_USING_PREEMPTION();
+					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					{
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
 				}
+				#endif /* configNUMBER_OF_CORES */
 			}
 			else
 			{
@@ -4705,7 +8284,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4713,6 +8292,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4734,34 +8314,34 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4779,11 +8359,11 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
-			traceTASK_NOTIFY_FROM_ISR();
+			traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4804,27 +8384,45 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if( configNUMBER_OF_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
+					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
 					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
-					}
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
 
-					/* Mark that a yield is pending in case the user is not
-					using the "xHigherPriorityTaskWoken" parameter to an ISR
-					safe FreeRTOS function. */
-					xYieldPending = pdTRUE;
+						/* Mark that a yield is pending in case the user is not
+						using the "xHigherPriorityTaskWoken" parameter to an ISR
+						safe FreeRTOS function. */
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#elif( configUSE_PREEMPTION == 1 )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* As in xTaskRemoveFromEventList(). */
+					prvYieldForTask( pxTCB );
+
+					if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUMBER_OF_CORES */
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -4834,13 +8432,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4862,16 +8461,16 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
-			traceTASK_NOTIFY_GIVE_FROM_ISR();
+			traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4892,27 +8491,45 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				#if( configNUMBER_OF_CORES == 1 )
 				{
-					/* The notified task has a priority above the currently
-					executing task so a yield is required. */
-					if( pxHigherPriorityTaskWoken != NULL )
+					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
 					{
-						*pxHigherPriorityTaskWoken = pdTRUE;
-					}
+						/* The notified task has a priority above the currently
+						executing task so a yield is required. */
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
 
-					/* Mark that a yield is pending in case the user is not
-					using the "xHigherPriorityTaskWoken" parameter in an ISR
-					safe FreeRTOS function. */
-					xYieldPending = pdTRUE;
+						/* Mark that a yield is pending in case the user is not
+						using the "xHigherPriorityTaskWoken" parameter in an ISR
+						safe FreeRTOS function. */
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#elif( configUSE_PREEMPTION == 1 )
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* As in xTaskRemoveFromEventList(). */
+					prvYieldForTask( pxTCB );
+
+					if( ( xYieldPending != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configNUMBER_OF_CORES */
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -4921,20 +8538,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
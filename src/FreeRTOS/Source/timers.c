@@ -58,6 +58,17 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
 
+#if( configUSE_TIMER_WHEEL == 1 )
+	/* Each level of the timing wheel has tmrWHEEL_SLOTS slots, and each slot of
+	a level spans as many ticks as every slot of the level below together.
+	There are enough levels for the top level to span every value of
+	TickType_t. */
+	#define tmrWHEEL_SLOT_BITS	( 4U )
+	#define tmrWHEEL_SLOTS		( 1U << tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK	( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+	#define tmrWHEEL_LEVELS		( ( sizeof( TickType_t ) * 8U ) / tmrWHEEL_SLOT_BITS )
+#endif
+
 /* The name assigned to the timer service task.  This can be overridden by
 defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 #ifndef configTIMER_SERVICE_TASK_NAME
@@ -125,11 +136,40 @@ typedef struct tmrTimerQueueMessage
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+	/* The tick count when prvSampleTimeNow() last looked at it.  A tick count
+	below this means the tick count has overflowed and the lists have yet to
+	be switched. */
+	PRIVILEGED_DATA static TickType_t xTimeLastSampled = ( TickType_t ) 0U;
+
+#else
+
+	/* Active timers are instead held in the slots of a hierarchical timing
+	wheel, each of which is an unsorted list, so inserting or removing a timer
+	takes the same time however many timers are active.  Timers in a slot of
+	the lowest level all expire on the same tick.  When the wheel reaches the
+	first tick spanned by a slot of a higher level the timers in that slot are
+	moved down to the levels below.  xTimerWheelTime is the tick up to which
+	the wheel has been processed, and is never after the time now.  Only the
+	timer service task is allowed to access the wheel. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint16_t usTimerWheelSlotsInUse[ tmrWHEEL_LEVELS ];
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+#endif /* configUSE_TIMER_WHEEL */
+
+/* Timers that were already due when they were inserted, in the order they were
+inserted.  Their list item value is still the time they were due, so an auto
+reload timer is reloaded relative to that rather than to when it was found to
+be due.  Only the timer service task is allowed to access this list. */
+PRIVILEGED_DATA static List_t xExpiredTimerList;
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -168,23 +208,72 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
  */
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Start, reset, stop, change the period of or delete a timer.  Called for each
+ * timer command received on the timer queue, and by xTimerGenericCommand()
+ * when configUSE_TIMER_DIRECT_COMMANDS is 1 and the caller is the timer service
+ * task itself.  xTimeNow is the tick count sampled by the caller, as only the
+ * timer service task's main loop samples the time with prvSampleTimeNow().
+ */
+static void prvProcessTimerCommand( const DaemonTaskMessage_t * const pxMessage, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow (or into the
+ * timing wheel if configUSE_TIMER_WHEEL is 1).  A timer that has already
+ * expired is inserted so it is processed before the timer service task next
+ * blocks, and pdTRUE is returned.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * Remove an active timer from the list it is in.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Process every active timer whose expire time is at or before xTimeNow, in
+ * expire time order.
+ */
+static void prvProcessExpiredTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * An active timer has reached its expire time.  Reload the timer if it is an
+ * auto reload timer, then call its callback.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Add a timer that expires after xTimerWheelTime to the timing wheel slot
+	 * that spans its expire time.
+	 */
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the number of ticks from xTimerWheelTime to the next tick at which
+	 * the timing wheel has timers to expire or to move down a level, and set
+	 * *pxWheelWasEmpty to pdTRUE if the wheel holds no timers.
+	 */
+	static TickType_t prvGetTicksToNextWheelEvent( BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * xTimerWheelTime has reached the first tick spanned by a slot of one or
+	 * more of the higher levels.  Move the timers in those slots down the
+	 * wheel.
+	 */
+	static void prvCascadeTimerWheel( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -348,6 +437,62 @@ BaseType_t xReturn = pdFAIL;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	BaseType_t xTimerCreateStaticSet( const StaticTimerDefinition_t * const pxTimerDefinitions, const UBaseType_t uxNumberOfTimers )
+	{
+	const StaticTimerDefinition_t *pxDefinition;
+	TimerHandle_t xCreatedTimer;
+	TickType_t xTimeNow;
+	UBaseType_t uxTimer;
+	BaseType_t xReturn = pdPASS;
+
+		/* Only the timer service task can access the active timer lists once
+		the scheduler is running. */
+		configASSERT( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED );
+		configASSERT( pxTimerDefinitions != NULL );
+
+		for( uxTimer = 0U; uxTimer < uxNumberOfTimers; uxTimer++ )
+		{
+			pxDefinition = &( pxTimerDefinitions[ uxTimer ] );
+			xCreatedTimer = xTimerCreateStatic( pxDefinition->pcTimerName, pxDefinition->xTimerPeriodInTicks, pxDefinition->uxAutoReload, pxDefinition->pvTimerID, pxDefinition->pxCallbackFunction, pxDefinition->pxTimerBuffer );
+
+			if( xCreatedTimer == NULL )
+			{
+				xReturn = pdFAIL;
+			}
+			else if( pxDefinition->xAutoStart != pdFALSE )
+			{
+				/* The same as the timer service task processing a start
+				command issued at the time now. */
+				taskENTER_CRITICAL();
+				{
+					xTimeNow = xTaskGetTickCount();
+					( void ) prvInsertTimerInActiveList( xCreatedTimer, xTimeNow + xCreatedTimer->xTimerPeriodInTicks, xTimeNow, xTimeNow );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxDefinition->pxCreatedTimer != NULL )
+			{
+				*( pxDefinition->pxCreatedTimer ) = xCreatedTimer;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 									const TickType_t xTimerPeriodInTicks,
 									const UBaseType_t uxAutoReload,
@@ -379,8 +524,9 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
 {
-BaseType_t xReturn = pdFAIL;
+BaseType_t xReturn = pdFAIL, xProcessCommandNow = pdFALSE;
 DaemonTaskMessage_t xMessage;
+TickType_t xTimeNow = ( TickType_t ) 0U;
 
 	configASSERT( xTimer );
 
@@ -395,7 +541,52 @@ DaemonTaskMessage_t xMessage;
 
 		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			#if( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+			{
+				/* A command from the timer service task itself, which in
+				practice means from a timer callback, is carried out here rather
+				than queued for the same task to receive later - on a queue it
+				would block on forever were the queue full.  If the tick count
+				has overflowed since the timer lists were last switched the
+				command is still queued, as the lists must be switched before
+				either can be used, and that is never done from within a
+				callback.  That includes the callbacks called while the lists
+				are being switched. */
+				if( ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) && ( xTaskGetCurrentTaskHandle() == xTimerTaskHandle ) )
+				{
+					xTimeNow = xTaskGetTickCount();
+
+					#if( configUSE_TIMER_WHEEL == 0 )
+					{
+						if( xTimeNow >= xTimeLastSampled )
+						{
+							xProcessCommandNow = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else
+					{
+						/* The timing wheel wraps with the tick count. */
+						xProcessCommandNow = pdTRUE;
+					}
+					#endif /* configUSE_TIMER_WHEEL */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+			if( xProcessCommandNow != pdFALSE )
+			{
+				prvProcessTimerCommand( &xMessage, xTimeNow );
+				xReturn = pdPASS;
+			}
+			else if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
 			{
 				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 			}
@@ -458,14 +649,90 @@ Timer_t *pxTimer = xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+static void prvProcessExpiredTimers( const TickType_t xTimeNow )
 {
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+Timer_t *pxTimer;
+
+	#if( configUSE_TIMER_WHEEL == 0 )
+	{
+		/* All the timers that are due are processed in one pass, those that
+		were already due when they were inserted first.  Callbacks can start,
+		stop and delete timers directly when configUSE_TIMER_DIRECT_COMMANDS is
+		1, so the heads of the lists are looked at afresh each time.  The lists
+		are never switched by a callback. */
+		for( ;; )
+		{
+			if( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else if( ( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList ) <= xTimeNow ) )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else
+			{
+				break;
+			}
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			prvProcessExpiredTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), xTimeNow );
+		}
+	}
+	#else
+	{
+	List_t *pxSlot;
+	TickType_t xTicksToNextEvent;
+	BaseType_t xWheelWasEmpty;
+
+		for( ;; )
+		{
+			/* Timers that were already due when they were inserted are
+			processed before the wheel is moved on. */
+			while( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				prvProcessExpiredTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), xTimeNow );
+			}
+
+			/* Move the wheel on to the next tick at which it has work to do,
+			or to the time now if that is sooner. */
+			xTicksToNextEvent = prvGetTicksToNextWheelEvent( &xWheelWasEmpty );
+
+			if( ( xWheelWasEmpty != pdFALSE ) || ( xTicksToNextEvent > ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+			{
+				xTimerWheelTime = xTimeNow;
+				break;
+			}
+
+			xTimerWheelTime += xTicksToNextEvent;
+
+			if( ( xTimerWheelTime & tmrWHEEL_SLOT_MASK ) == ( TickType_t ) 0U )
+			{
+				prvCascadeTimerWheel();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Every timer in the lowest level slot for this tick expires now. */
+			pxSlot = &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_SLOT_MASK ] );
+
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				prvProcessExpiredTimer( pxTimer, xTimerWheelTime, xTimeNow );
+			}
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessExpiredTimer( Timer_t * const pxTimer, const TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+	/* Remove the timer from the list of active timers. */
+	prvRemoveTimerFromActiveList( pxTimer );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -474,26 +741,18 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 	{
 		/* The timer is inserted into a list using a time relative to anything
 		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		correct list relative to the time this task thinks it is now.  If the
+		next expiry time has also passed then the timer is inserted as already
+		due, so is processed again before this task next blocks. */
+		( void ) prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	/* Call the timer callback. */
+	/* Call the timer callback.  This is the last use of pxTimer, as the
+	callback might delete the timer. */
 	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 }
 /*-----------------------------------------------------------*/
@@ -537,7 +796,7 @@ BaseType_t xListWasEmpty;
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
-BaseType_t xTimerListsWereSwitched;
+BaseType_t xTimerListsWereSwitched, xNextExpireTimeReached;
 
 	vTaskSuspendAll();
 	{
@@ -550,10 +809,23 @@ BaseType_t xTimerListsWereSwitched;
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#if( configUSE_TIMER_WHEEL == 0 )
+			{
+				xNextExpireTimeReached = ( xNextExpireTime <= xTimeNow ) ? pdTRUE : pdFALSE;
+			}
+			#else
+			{
+				/* The wheel wraps with the tick count, so times are compared
+				relative to xTimerWheelTime, which is never after the time
+				now. */
+				xNextExpireTimeReached = ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) ? pdTRUE : pdFALSE;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
+
+			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTimeReached != pdFALSE ) )
 			{
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimers( xTimeNow );
 			}
 			else
 			{
@@ -563,12 +835,16 @@ BaseType_t xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				if( xListWasEmpty != pdFALSE )
+				#if( configUSE_TIMER_WHEEL == 0 )
 				{
-					/* The current timer list is empty - is the overflow list
-					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* The current timer list is empty - is the overflow
+						list also empty? */
+						xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					}
 				}
+				#endif /* configUSE_TIMER_WHEEL */
 
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -605,16 +881,44 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 0 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		if( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+		{
+			/* Timers that were already due when they were inserted are
+			processed without blocking. */
+			*pxListWasEmpty = pdFALSE;
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
+		else
+		{
+			*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+			if( *pxListWasEmpty == pdFALSE )
+			{
+				xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+			}
+			else
+			{
+				/* Ensure the task unblocks when the tick count rolls over. */
+				xNextExpireTime = ( TickType_t ) 0U;
+			}
+		}
 	}
-	else
+	#else
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+		/* The timing wheel has no lists to switch, so when it is empty the
+		task can block indefinitely. */
+		if( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+		{
+			*pxListWasEmpty = pdFALSE;
+			xNextExpireTime = xTimerWheelTime;
+		}
+		else
+		{
+			xNextExpireTime = xTimerWheelTime + prvGetTicksToNextWheelEvent( pxListWasEmpty );
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -623,21 +927,29 @@ TickType_t xNextExpireTime;
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
+	#if( configUSE_TIMER_WHEEL == 0 )
 	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
+		if( xTimeNow < xTimeLastSampled )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		xTimeLastSampled = xTimeNow;
 	}
-	else
+	#else
 	{
+		/* The timing wheel wraps with the tick count. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
-
-	xLastTime = xTimeNow;
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -662,7 +974,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				prvInsertTimerInWheel( pxTimer );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 	else
@@ -676,21 +996,92 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				prvInsertTimerInWheel( pxTimer );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 
+	if( xProcessTimerNow != pdFALSE )
+	{
+		/* The timer has already expired.  Rather than call its callback here,
+		it is inserted where prvProcessExpiredTimers() will find it before this
+		task next blocks.  Its list item value remains the time it expired,
+		which might be from before the tick count overflowed, so an auto reload
+		timer is reloaded relative to that, and callbacks are never called from
+		within a command. */
+		vListInsertEnd( &xExpiredTimerList, &( pxTimer->xTimerListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
 	return xProcessTimerNow;
 }
 /*-----------------------------------------------------------*/
 
+static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+{
+	#if( configUSE_TIMER_WHEEL == 0 )
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	#else
+	{
+	List_t * const pxList = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+	UBaseType_t uxIndex;
+
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+		/* Note when a wheel slot becomes empty, so it is skipped when looking
+		for the next tick at which the wheel has work to do. */
+		if( ( pxList != &xExpiredTimerList ) && ( listLIST_IS_EMPTY( pxList ) != pdFALSE ) )
+		{
+			uxIndex = ( UBaseType_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+			usTimerWheelSlotsInUse[ uxIndex / tmrWHEEL_SLOTS ] &= ( uint16_t ) ~( 1U << ( uxIndex % tmrWHEEL_SLOTS ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
-Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
+BaseType_t xTimerListsWereSwitched;
 TickType_t xTimeNow;
 
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+	BaseType_t xWheelWasEmpty;
+
+		/* Nothing in an empty wheel can be missed, so it is brought up to the
+		time now.  That keeps the timers inserted below close to the wheel time
+		however long this task was blocked. */
+		( void ) prvGetTicksToNextWheelEvent( &xWheelWasEmpty );
+
+		if( ( xWheelWasEmpty != pdFALSE ) && ( listLIST_IS_EMPTY( &xExpiredTimerList ) != pdFALSE ) )
+		{
+			xTimerWheelTime = xTaskGetTickCount();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
@@ -719,118 +1110,107 @@ TickType_t xTimeNow;
 		function calls. */
 		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
 		{
-			/* The messages uses the xTimerParameters member to work on a
-			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			/* In this case the xTimerListsWereSwitched parameter is not used,
+			but it must be present in the function call.  prvSampleTimeNow()
+			must be called after the message is received from xTimerQueue so
+			there is no possibility of a higher priority task adding a message
+			to the message queue with a time that is ahead of the timer daemon
+			task (because it pre-empted the timer daemon task after the xTimeNow
+			value was set). */
+			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+			prvProcessTimerCommand( &xMessage, xTimeNow );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
 
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
-			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+static void prvProcessTimerCommand( const DaemonTaskMessage_t * const pxMessage, const TickType_t xTimeNow )
+{
+Timer_t * const pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+const TickType_t xMessageValue = pxMessage->u.xTimerParameters.xMessageValue;
 
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+	/* The messages uses the xTimerParameters member to work on a software
+	timer. */
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	{
+		/* The timer is in a list, remove it. */
+		prvRemoveTimerFromActiveList( pxTimer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+	traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, xMessageValue );
 
-			switch( xMessage.xMessageID )
+	switch( pxMessage->xMessageID )
+	{
+		case tmrCOMMAND_START :
+	    case tmrCOMMAND_START_FROM_ISR :
+	    case tmrCOMMAND_RESET :
+	    case tmrCOMMAND_RESET_FROM_ISR :
+		case tmrCOMMAND_START_DONT_TRACE :
+			/* Start or restart a timer.  A timer that expired before the
+			command was processed is left for prvProcessExpiredTimers(). */
+			( void ) prvInsertTimerInActiveList( pxTimer,  xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessageValue );
+			break;
+
+		case tmrCOMMAND_STOP :
+		case tmrCOMMAND_STOP_FROM_ISR :
+			/* The timer has already been removed from the active list.
+			There is nothing to do here. */
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+		case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+			pxTimer->xTimerPeriodInTicks = xMessageValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+			/* The new period does not really have a reference, and can
+			be longer or shorter than the old one.  The command time is
+			therefore set to the current time, and as the period cannot
+			be zero the next expiry time can only be in the future,
+			meaning (unlike for the xTimerStart() case above) there is
+			no fail case that needs to be handled here. */
+			( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			/* The timer has already been removed from the active list,
+			just free up the memory if the memory was dynamically
+			allocated. */
+			#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 			{
-				case tmrCOMMAND_START :
-			    case tmrCOMMAND_START_FROM_ISR :
-			    case tmrCOMMAND_RESET :
-			    case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-					break;
-
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list.
-					There is nothing to do here. */
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can
-					be longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot
-					be zero the next expiry time can only be in the future,
-					meaning (unlike for the xTimerStart() case above) there is
-					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					/* The timer has already been removed from the active list,
-					just free up the memory if the memory was dynamically
-					allocated. */
-					#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-					{
-						/* The timer can only have been allocated dynamically -
-						free it again. */
-						vPortFree( pxTimer );
-					}
-					#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-					{
-						/* The timer could have been allocated statically or
-						dynamically, so check before attempting to free the
-						memory. */
-						if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-						{
-							vPortFree( pxTimer );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-					break;
-
-				default	:
-					/* Don't expect to get here. */
-					break;
+				/* The timer can only have been allocated dynamically -
+				free it again. */
+				vPortFree( pxTimer );
 			}
-		}
+			#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+			{
+				/* The timer could have been allocated statically or
+				dynamically, so check before attempting to free the
+				memory. */
+				if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+				{
+					vPortFree( pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+			break;
+
+		default	:
+			/* Don't expect to get here. */
+			break;
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -841,7 +1221,10 @@ BaseType_t xResult;
 	/* The tick count has overflowed.  The timer lists must be switched.
 	If there are any timers still referenced from the current timer list
 	then they must have expired and should be processed before the lists
-	are switched. */
+	are switched.  The callbacks called below, and the commands sent to
+	restart auto-reload timers, see the tick count as having overflowed since
+	it was last sampled, so their commands are queued rather than carried out
+	directly. */
 	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
 	{
 		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
@@ -888,12 +1271,156 @@ BaseType_t xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+	{
+	const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	const TickType_t xTicksToExpiry = ( TickType_t ) ( xExpiryTime - xTimerWheelTime );
+	UBaseType_t uxLevel = 0U, uxSlot;
+
+		if( xTicksToExpiry == ( TickType_t ) 0U )
+		{
+			/* Only happens when a slot is moved down the wheel on the tick
+			that one of its timers expires. */
+			vListInsertEnd( &xExpiredTimerList, &( pxTimer->xTimerListItem ) );
+		}
+		else
+		{
+			/* Use the lowest level whose slots between them span the ticks
+			remaining, then the slot of that level that spans the expiry
+			time. */
+			while( ( uxLevel < ( tmrWHEEL_LEVELS - 1U ) ) && ( ( xTicksToExpiry >> ( tmrWHEEL_SLOT_BITS * ( uxLevel + 1U ) ) ) != ( TickType_t ) 0U ) )
+			{
+				uxLevel++;
+			}
+
+			uxSlot = ( UBaseType_t ) ( ( xExpiryTime >> ( tmrWHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+			vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+			usTimerWheelSlotsInUse[ uxLevel ] |= ( uint16_t ) ( 1U << uxSlot );
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static TickType_t prvGetTicksToNextWheelEvent( BaseType_t * const pxWheelWasEmpty )
+	{
+	TickType_t xTicksToNextEvent = portMAX_DELAY, xTicksToSlot, xLevelMask;
+	UBaseType_t uxLevel, uxSlot;
+
+		*pxWheelWasEmpty = pdTRUE;
+
+		for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			if( usTimerWheelSlotsInUse[ uxLevel ] != ( uint16_t ) 0U )
+			{
+				*pxWheelWasEmpty = pdFALSE;
+
+				/* The ticks spanned by the whole level. */
+				xLevelMask = ( ( TickType_t ) ~( ( TickType_t ) 0U ) ) >> ( tmrWHEEL_SLOT_BITS * ( tmrWHEEL_LEVELS - 1U - uxLevel ) );
+
+				for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+				{
+					if( ( usTimerWheelSlotsInUse[ uxLevel ] & ( 1U << uxSlot ) ) != 0U )
+					{
+						/* The wheel reaches a slot when the bits of its time
+						that select the slot at this level match, and all the
+						bits below are zero.  The slot that was reached at
+						xTimerWheelTime itself has been processed already, so
+						holds timers for the next time round. */
+						xTicksToSlot = ( TickType_t ) ( ( ( TickType_t ) uxSlot << ( tmrWHEEL_SLOT_BITS * uxLevel ) ) - xTimerWheelTime ) & xLevelMask;
+
+						if( xTicksToSlot == ( TickType_t ) 0U )
+						{
+							xTicksToSlot = xLevelMask + ( TickType_t ) 1U;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( xTicksToSlot < xTicksToNextEvent )
+						{
+							xTicksToNextEvent = xTicksToSlot;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return xTicksToNextEvent;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvCascadeTimerWheel( void )
+	{
+	UBaseType_t uxLevel, uxSlot;
+	List_t *pxSlot;
+	Timer_t *pxTimer;
+
+		for( uxLevel = 1U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			uxSlot = ( UBaseType_t ) ( ( xTimerWheelTime >> ( tmrWHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_SLOT_MASK );
+			pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+
+			/* Every timer in the slot now expires within the span of a lower
+			level, or expires now. */
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				prvInsertTimerInWheel( pxTimer );
+			}
+
+			usTimerWheelSlotsInUse[ uxLevel ] &= ( uint16_t ) ~( 1U << uxSlot );
+
+			/* The slots of the next level up are only reached when this
+			level has also gone all the way round. */
+			if( uxSlot != 0U )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
 {
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
+#if( configUSE_TIMER_WHEEL == 0 )
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+#else
+	UBaseType_t uxLevel, uxSlot;
+#endif
 
 	/* Check that the list from which active timers are referenced, and the
 	queue used to communicate with the timer service, have been
@@ -902,10 +1429,30 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#else
+			{
+				for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+
+					usTimerWheelSlotsInUse[ uxLevel ] = ( uint16_t ) 0U;
+				}
+
+				xTimerWheelTime = xTaskGetTickCount();
+			}
+			#endif /* configUSE_TIMER_WHEEL */
+
+			vListInitialise( &xExpiredTimerList );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -0,0 +1,527 @@
+/*
+ * FreeRTOS Kernel V10.0.1
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_TRACE_RECORDER == 1 )
+
+#if( ( configTRACE_RECORDER_BUFFER_RECORDS & ( configTRACE_RECORDER_BUFFER_RECORDS - 1 ) ) != 0 )
+	#error configTRACE_RECORDER_BUFFER_RECORDS must be a power of 2.
+#endif
+
+/* Names are written four characters to a record, and the offset of the
+characters within the name is held in four bits. */
+#define traceNAME_CHUNKS			( ( configMAX_TASK_NAME_LEN + 3 ) / 4 )
+#define traceNAME_LENGTH			( traceNAME_CHUNKS * 4 )
+
+#if( traceNAME_CHUNKS > 16 )
+	#error configMAX_TASK_NAME_LEN is too long for the trace recorder, which records names of up to 64 characters.
+#endif
+
+#define traceRING_INDEX_MASK		( ( uint32_t ) configTRACE_RECORDER_BUFFER_RECORDS - 1UL )
+
+/* An entry in the table of names.  A task is identified by its TCB number,
+and any other object by its address. */
+typedef struct xTRACE_NAME
+{
+	uint32_t ulObject;
+	uint8_t ucObjectType;
+	uint8_t ucInUse;
+	char cName[ traceNAME_LENGTH ];	/* Padded with nulls. */
+} TraceName_t;
+
+/*-----------------------------------------------------------*/
+
+/* The ring of records.  ulTraceHead and ulTraceTail count the records written
+and the records removed since the recorder was started, so the number of
+records held is their difference and the ring position is given by the bottom
+bits.  Both only change with interrupts masked. */
+PRIVILEGED_DATA static TraceRecord_t xTraceRing[ configTRACE_RECORDER_BUFFER_RECORDS ];
+PRIVILEGED_DATA static volatile uint32_t ulTraceHead = 0UL;
+PRIVILEGED_DATA static volatile uint32_t ulTraceTail = 0UL;
+
+/* The number of records dropped since the last traceEVENT_DROPPED record was
+written.  Only records written in streaming mode are dropped. */
+PRIVILEGED_DATA static uint32_t ulTraceDropped = 0UL;
+
+PRIVILEGED_DATA static eTraceRecorderMode eTraceMode = eTraceSnapshot;
+PRIVILEGED_DATA static volatile BaseType_t xTraceRunning = pdFALSE;
+
+PRIVILEGED_DATA static TraceName_t xTraceNames[ configTRACE_RECORDER_NAMES ];
+PRIVILEGED_DATA static UBaseType_t uxNextNameToReplace = 0;
+
+/* The classes of events being recorded, which is zero while the recorder is
+stopped, and the TCB number of the task that is running.  Both are read by the
+trace macros in trace_recorder.h. */
+PRIVILEGED_DATA volatile uint32_t ulTraceRecorderMask = 0UL;
+PRIVILEGED_DATA volatile uint16_t usTraceRecorderTask = 0U;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write a record to the ring, overwriting the oldest record or dropping the
+ * new one if the ring is full, depending on the mode.  Must be called with
+ * interrupts masked.
+ */
+static void prvWriteRecord( uint8_t ucEvent, uint8_t ucParameter, uint16_t usTask, uint32_t ulObject, uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * A TraceRecorderWriteFunction_t that writes records to the ring, used to put
+ * the header and names at the start of a stream.  Must be called with
+ * interrupts masked.
+ */
+static void prvWriteRecordsToRing( const TraceRecord_t *pxRecords, size_t xNumberOfRecords, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pass the header record, then the records for every name in the name table,
+ * to pxWrite().
+ */
+static void prvWritePreamble( TraceRecorderWriteFunction_t pxWrite, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pass the records for one name, up to and including the four characters that
+ * hold its terminating null, to pxWrite().
+ */
+static void prvWriteName( const TraceName_t *pxName, TraceRecorderWriteFunction_t pxWrite, void *pvParameter ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvWriteRecord( uint8_t ucEvent, uint8_t ucParameter, uint16_t usTask, uint32_t ulObject, uint32_t ulValue )
+{
+TraceRecord_t *pxRecord;
+uint32_t ulHead = ulTraceHead;
+uint32_t ulFree = ( uint32_t ) configTRACE_RECORDER_BUFFER_RECORDS - ( ulHead - ulTraceTail );
+
+	if( eTraceMode == eTraceStreaming )
+	{
+		if( ulTraceDropped != 0UL )
+		{
+			/* Records have been dropped since the last record written, so a
+			record saying how many must be written first, which needs two free
+			records. */
+			if( ulFree < 2UL )
+			{
+				ulTraceDropped++;
+				return;
+			}
+			else
+			{
+				pxRecord = &( xTraceRing[ ulHead & traceRING_INDEX_MASK ] );
+				pxRecord->ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+				pxRecord->ucEvent = traceEVENT_DROPPED;
+				pxRecord->ucParameter = 0U;
+				pxRecord->usTask = usTraceRecorderTask;
+				pxRecord->ulObject = 0UL;
+				pxRecord->ulValue = ulTraceDropped;
+				ulHead++;
+				ulTraceDropped = 0UL;
+			}
+		}
+		else if( ulFree == 0UL )
+		{
+			ulTraceDropped++;
+			return;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else if( ulFree == 0UL )
+	{
+		/* Snapshot mode, so discard the oldest record. */
+		ulTraceTail++;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The head is only read and written once, as it is volatile. */
+	pxRecord = &( xTraceRing[ ulHead & traceRING_INDEX_MASK ] );
+	pxRecord->ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+	pxRecord->ucEvent = ucEvent;
+	pxRecord->ucParameter = ucParameter;
+	pxRecord->usTask = usTask;
+	pxRecord->ulObject = ulObject;
+	pxRecord->ulValue = ulValue;
+	ulTraceHead = ulHead + 1UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteRecordsToRing( const TraceRecord_t *pxRecords, size_t xNumberOfRecords, void *pvParameter )
+{
+size_t x;
+
+	( void ) pvParameter;
+
+	for( x = 0; x < xNumberOfRecords; x++ )
+	{
+		prvWriteRecord( pxRecords[ x ].ucEvent, pxRecords[ x ].ucParameter, pxRecords[ x ].usTask, pxRecords[ x ].ulObject, pxRecords[ x ].ulValue );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteName( const TraceName_t *pxName, TraceRecorderWriteFunction_t pxWrite, void *pvParameter )
+{
+TraceRecord_t xRecord;
+UBaseType_t uxChunk;
+const uint8_t *pucCharacters;
+
+	xRecord.ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+	xRecord.ucEvent = traceEVENT_NAME;
+	xRecord.usTask = usTraceRecorderTask;
+	xRecord.ulObject = pxName->ulObject;
+
+	for( uxChunk = 0; uxChunk < traceNAME_CHUNKS; uxChunk++ )
+	{
+		/* The characters are packed first character lowest, so the decoder
+		does not need to know the byte order of the target. */
+		pucCharacters = ( const uint8_t * ) &( pxName->cName[ uxChunk * 4 ] );
+		xRecord.ucParameter = ( uint8_t ) ( ( pxName->ucObjectType << 4 ) | uxChunk );
+		xRecord.ulValue = ( ( uint32_t ) pucCharacters[ 0 ] ) | ( ( ( uint32_t ) pucCharacters[ 1 ] ) << 8 ) | ( ( ( uint32_t ) pucCharacters[ 2 ] ) << 16 ) | ( ( ( uint32_t ) pucCharacters[ 3 ] ) << 24 );
+		pxWrite( &xRecord, 1, pvParameter );
+
+		if( ( pucCharacters[ 0 ] == 0U ) || ( pucCharacters[ 1 ] == 0U ) || ( pucCharacters[ 2 ] == 0U ) || ( pucCharacters[ 3 ] == 0U ) )
+		{
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWritePreamble( TraceRecorderWriteFunction_t pxWrite, void *pvParameter )
+{
+TraceRecord_t xRecord;
+TraceName_t xName;
+UBaseType_t uxSavedInterruptStatus, x;
+
+	xRecord.ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+	xRecord.ucEvent = traceEVENT_HEADER;
+	xRecord.ucParameter = traceRECORDER_VERSION;
+	xRecord.usTask = ( uint16_t ) sizeof( TraceRecord_t );
+	xRecord.ulObject = traceRECORDER_MAGIC;
+	xRecord.ulValue = ( uint32_t ) configTRACE_RECORDER_TIMESTAMP_HZ;
+	pxWrite( &xRecord, 1, pvParameter );
+
+	for( x = 0; x < ( UBaseType_t ) configTRACE_RECORDER_NAMES; x++ )
+	{
+		/* Names can be added by tasks that run while the records are being
+		written, so each is copied as a whole before it is written. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xName = xTraceNames[ x ];
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xName.ucInUse != pdFALSE )
+		{
+			prvWriteName( &xName, pxWrite, pvParameter );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( eTraceRecorderMode eMode, uint32_t ulClassMask )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		ulTraceRecorderMask = 0UL;
+		ulTraceHead = 0UL;
+		ulTraceTail = 0UL;
+		ulTraceDropped = 0UL;
+		eTraceMode = eMode;
+
+		/* A snapshot is written out with the header and the names that are
+		current at the time, but a stream is read as it is written, so must
+		start with them. */
+		if( eMode == eTraceStreaming )
+		{
+			prvWritePreamble( prvWriteRecordsToRing, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xTraceRunning = pdTRUE;
+		ulTraceRecorderMask = ulClassMask;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xTraceRunning = pdFALSE;
+		ulTraceRecorderMask = 0UL;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderSetMask( uint32_t ulClassMask )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( xTraceRunning != pdFALSE )
+		{
+			ulTraceRecorderMask = ulClassMask;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderWrite( uint8_t ucEvent, uint32_t ulObject, uint32_t ulValue )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* The recorder might have been stopped after the trace macro checked
+		the mask, and nothing must be written once it has, as the records might
+		be being read out. */
+		if( xTraceRunning != pdFALSE )
+		{
+			prvWriteRecord( ucEvent, 0U, usTraceRecorderTask, ulObject, ulValue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderWriteMasked( uint8_t ucEvent, uint32_t ulObject, uint32_t ulValue )
+{
+	/* As vTraceRecorderWrite(), but the caller has already masked
+	interrupts. */
+	if( xTraceRunning != pdFALSE )
+	{
+		prvWriteRecord( ucEvent, 0U, usTraceRecorderTask, ulObject, ulValue );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderUserEvent( uint32_t ulEventID, uint32_t ulValue )
+{
+	traceRECORD( traceCLASS_USER, traceEVENT_USER, ulEventID, ulValue );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderName( uint8_t ucObjectType, uint32_t ulObject, const char *pcName )
+{
+UBaseType_t uxSavedInterruptStatus, x, uxEntry = ( UBaseType_t ) configTRACE_RECORDER_NAMES;
+TraceName_t *pxName;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Use the entry that already names the object if there is one, then
+		the first free entry.  Otherwise replace the entries in turn, so the
+		oldest names are lost first. */
+		for( x = 0; x < ( UBaseType_t ) configTRACE_RECORDER_NAMES; x++ )
+		{
+			if( xTraceNames[ x ].ucInUse == pdFALSE )
+			{
+				if( uxEntry == ( UBaseType_t ) configTRACE_RECORDER_NAMES )
+				{
+					uxEntry = x;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( ( xTraceNames[ x ].ucObjectType == ucObjectType ) && ( xTraceNames[ x ].ulObject == ulObject ) )
+			{
+				uxEntry = x;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( uxEntry == ( UBaseType_t ) configTRACE_RECORDER_NAMES )
+		{
+			uxEntry = uxNextNameToReplace;
+			uxNextNameToReplace = ( uxNextNameToReplace + 1 ) % ( UBaseType_t ) configTRACE_RECORDER_NAMES;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxName = &( xTraceNames[ uxEntry ] );
+		pxName->ulObject = ulObject;
+		pxName->ucObjectType = ucObjectType;
+		pxName->ucInUse = pdTRUE;
+		memset( pxName->cName, 0x00, sizeof( pxName->cName ) );
+
+		if( pcName != NULL )
+		{
+			for( x = 0; ( x < ( UBaseType_t ) ( configMAX_TASK_NAME_LEN - 1 ) ) && ( pcName[ x ] != 0x00 ); x++ )
+			{
+				pxName->cName[ x ] = pcName[ x ];
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Name the object in the records too, so a stream that started before
+		the object was created names it. */
+		if( xTraceRunning != pdFALSE )
+		{
+			prvWriteName( pxName, prvWriteRecordsToRing, NULL );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWrite, void *pvParameter )
+{
+uint32_t ulTail, ulHead, ulRecords;
+
+	/* The records must not change while they are written out. */
+	configASSERT( xTraceRunning == pdFALSE );
+
+	prvWritePreamble( pxWrite, pvParameter );
+
+	ulTail = ulTraceTail;
+	ulHead = ulTraceHead;
+
+	/* The oldest records run to the end of the ring, and the newest wrap round
+	to its start. */
+	while( ulTail != ulHead )
+	{
+		ulRecords = ( uint32_t ) configTRACE_RECORDER_BUFFER_RECORDS - ( ulTail & traceRING_INDEX_MASK );
+
+		if( ulRecords > ( ulHead - ulTail ) )
+		{
+			ulRecords = ulHead - ulTail;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxWrite( &( xTraceRing[ ulTail & traceRING_INDEX_MASK ] ), ( size_t ) ulRecords, pvParameter );
+		ulTail += ulRecords;
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xTraceRecorderRead( TraceRecord_t *pxRecords, size_t xMaxRecords )
+{
+UBaseType_t uxSavedInterruptStatus;
+uint32_t ulTail, ulHead;
+size_t xRecordsRead = 0;
+
+	configASSERT( eTraceMode == eTraceStreaming );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		ulHead = ulTraceHead;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	/* In streaming mode the records between the tail and the head are not
+	written again until the tail has moved past them, so can be copied with
+	interrupts enabled. */
+	ulTail = ulTraceTail;
+
+	while( ( ulTail != ulHead ) && ( xRecordsRead < xMaxRecords ) )
+	{
+		pxRecords[ xRecordsRead ] = xTraceRing[ ulTail & traceRING_INDEX_MASK ];
+		xRecordsRead++;
+		ulTail++;
+	}
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		ulTraceTail = ulTail;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xRecordsRead;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file. */
+#endif /* configUSE_TRACE_RECORDER == 1 */
+